@@ -0,0 +1,17 @@
+FetchContent_Declare(
+    googlebenchmark_content
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG v1.8.3
+    GIT_SHALLOW TRUE
+)
+
+FetchContent_GetProperties(googlebenchmark_content)
+if(NOT googlebenchmark_content_POPULATED)
+    FetchContent_Populate(googlebenchmark_content)
+    # Only the library itself is needed, skip benchmark's own tests and install rules
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_WERROR OFF CACHE BOOL "" FORCE)
+    add_subdirectory(${googlebenchmark_content_SOURCE_DIR} ${googlebenchmark_content_BINARY_DIR} EXCLUDE_FROM_ALL)
+endif()
@@ -35,14 +35,14 @@ struct CharacterInfo;
 
 struct GameSetupStructBase
 {
-    static const int  LEGACY_GAME_NAME_LENGTH = 50;
-    static const int  MAX_OPTIONS = 100;
-    static const int  NUM_INTS_RESERVED = 16;
+    static const int  LEGACY_GAME_NAME_LENGTH = LEGACY_MAX_GAME_NAME_LENGTH;
+    static const int  MAX_OPTIONS = MAX_GAME_OPTIONS;
+    static const int  NUM_INTS_RESERVED = NUM_GAME_INTS_RESERVED;
 
     Common::String    gamename;
     int               options[MAX_OPTIONS];
-    uint8_t           paluses[256];
-    RGB               defpal[256];
+    uint8_t           paluses[GAME_PALETTE_SIZE];
+    RGB               defpal[GAME_PALETTE_SIZE];
     int               numviews;
     int               numcharacters;
     int               playercharacter;
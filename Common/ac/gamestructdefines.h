@@ -28,6 +28,11 @@
 #define GLOBALMESLENGTH     500
 #define MAXLANGUAGE         5
 #define LEGACY_MAX_FONTS    30
+// Sizes of the fixed arrays in the main game data's header
+#define LEGACY_MAX_GAME_NAME_LENGTH 50
+#define MAX_GAME_OPTIONS    100
+#define NUM_GAME_INTS_RESERVED 16
+#define GAME_PALETTE_SIZE   256
 
 // General game options
 #define OPT_DEBUGMODE       0
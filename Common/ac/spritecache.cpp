@@ -52,6 +52,7 @@ SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &cal
     _callbacks.InitSprite = (callbacks.InitSprite) ? callbacks.InitSprite : DummyInitSprite;
     _callbacks.PostInitSprite = (callbacks.PostInitSprite) ? callbacks.PostInitSprite : DummyPostInitSprite;
     _callbacks.PrewriteSprite = (callbacks.PrewriteSprite) ? callbacks.PrewriteSprite : DummyPrewriteSprite;
+    _callbacks.GetConversion = (callbacks.GetConversion) ? callbacks.GetConversion : DummyGetConversion;
 
     // Generate a placeholder sprite: 1x1 transparent bitmap
     _placeholder.reset(BitmapHelper::CreateTransparentBitmap(1, 1));
@@ -322,7 +323,8 @@ Bitmap *SpriteCache::LoadSprite(sprkey_t index, bool lock)
     assert((_spriteData[index].Flags & SPRCACHEFLAG_ISASSET) != 0);
 
     Bitmap *image{};
-    HError err = _file.LoadSprite(index, image);
+    HError err = _file.LoadSprite(index, image,
+        _callbacks.GetConversion(index, _sprInfos[index].Flags));
     if (!image)
     {
         Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
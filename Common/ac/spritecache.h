@@ -72,6 +72,7 @@ public:
     typedef std::function<Bitmap*(sprkey_t index, Bitmap *image, uint32_t &sprite_flags)> PfnInitSprite;
     typedef std::function<void(sprkey_t index)> PfnPostInitSprite;
     typedef std::function<void(Bitmap *image)> PfnPrewriteSprite;
+    typedef std::function<SpriteConversion(sprkey_t index, const uint32_t sprite_flags)> PfnGetSpriteConversion;
 
     struct Callbacks
     {
@@ -79,6 +80,7 @@ public:
         PfnInitSprite InitSprite;
         PfnPostInitSprite PostInitSprite;
         PfnPrewriteSprite PrewriteSprite;
+        PfnGetSpriteConversion GetConversion;
     };
 
 
@@ -186,6 +188,7 @@ private:
     static Bitmap* DummyInitSprite(sprkey_t, Bitmap *image, uint32_t&) { return image; }
     static void DummyPostInitSprite(sprkey_t) { /* do nothing */ }
     static void DummyPrewriteSprite(Bitmap*) { /* do nothing */ }
+    static SpriteConversion DummyGetConversion(sprkey_t, const uint32_t) { return SpriteConversion(); }
 
 
     // Information required for the sprite streaming
@@ -136,6 +136,50 @@ static void UnpackIndexedBitmap(Bitmap *image, const uint8_t *data, size_t data_
     }
 }
 
+// Converts 16-bit color to 32-bit, same as blitting between bitmaps of these formats
+static inline uint32_t HiColorToTrueColor(uint32_t col)
+{
+    return makecol32(getr16(col), getg16(col), getb16(col));
+}
+
+// Applies requested conversion to the palette colors, which have source image's format
+static void ConvertPalette(std::array<uint32_t, 256> &palette, uint32_t pal_count,
+                           int src_bpp, const SpriteConversion &conv)
+{
+    if (src_bpp == 2 && conv.HiColorToDepth == 32)
+    {
+        for (uint32_t i = 0; i < pal_count; ++i)
+            palette[i] = HiColorToTrueColor(palette[i]);
+    }
+    else if (src_bpp == 4 && conv.AlphaToMask)
+    {
+        for (uint32_t i = 0; i < pal_count; ++i)
+            if (geta32(palette[i]) == 0)
+                palette[i] = MASK_COLOR_32;
+    }
+}
+
+// Applies requested conversion to the unpacked pixels, writing them into the image;
+// source data may be either a separate buffer, or the image's own pixels
+static void ConvertPixels(Bitmap *image, const uint8_t *data, int src_bpp, const SpriteConversion &conv)
+{
+    const size_t num_pixels = image->GetWidth() * image->GetHeight();
+    if (src_bpp == 2 && image->GetBPP() == 4)
+    {
+        const uint16_t *src = reinterpret_cast<const uint16_t*>(data);
+        uint32_t *dst = reinterpret_cast<uint32_t*>(image->GetDataForWriting());
+        for (size_t i = 0; i < num_pixels; ++i)
+            dst[i] = HiColorToTrueColor(src[i]);
+    }
+    else if (src_bpp == 4 && conv.AlphaToMask)
+    {
+        uint32_t *px = reinterpret_cast<uint32_t*>(image->GetDataForWriting());
+        for (size_t i = 0; i < num_pixels; ++i)
+            if (geta32(px[i]) == 0)
+                px[i] = MASK_COLOR_32;
+    }
+}
+
 
 static inline SpriteFormat PaletteFormatForBPP(int bpp)
 {
@@ -383,7 +427,7 @@ HError SpriteFile::RebuildSpriteIndex(Stream *in, sprkey_t topmost, std::vector<
     return HError::None();
 }
 
-HError SpriteFile::LoadSprite(sprkey_t index, Common::Bitmap *&sprite)
+HError SpriteFile::LoadSprite(sprkey_t index, Common::Bitmap *&sprite, const SpriteConversion &conv)
 {
     sprite = nullptr;
     if (index < 0 || (size_t)index >= _spriteData.size())
@@ -400,11 +444,13 @@ HError SpriteFile::LoadSprite(sprkey_t index, Common::Bitmap *&sprite)
     ReadSprHeader(hdr, _stream.get(), _version, _compress);
     if (hdr.BPP == 0) return HError::None(); // empty slot, this is normal
     int bpp = hdr.BPP, w = hdr.Width, h = hdr.Height;
-    std::unique_ptr<Bitmap> image(BitmapHelper::CreateBitmap(w, h, bpp * 8));
+    // The final image may have different color depth, if conversion was requested
+    const int dst_bpp = (bpp == 2 && conv.HiColorToDepth == 32) ? 4 : bpp;
+    std::unique_ptr<Bitmap> image(BitmapHelper::CreateBitmap(w, h, dst_bpp * 8));
     if (image == nullptr)
     {
         return new Error(String::FromFormat("LoadSprite: failed to allocate bitmap %d (%dx%d%d).",
-            index, w, h, bpp * 8));
+            index, w, h, dst_bpp * 8));
     }
     ImBufferPtr im_data(image->GetDataForWriting(), w * h * bpp, bpp);
     // (Optional) Handle storage options, reverse
@@ -421,9 +467,18 @@ HError SpriteFile::LoadSprite(sprkey_t index, Common::Bitmap *&sprite)
             break;
         default: assert(0); break;
         }
+        // indexed pixels are converted by converting only the palette
+        ConvertPalette(palette, hdr.PalCount, bpp, conv);
         indexed_buf.resize(w * h);
         im_data = ImBufferPtr(&indexed_buf[0], indexed_buf.size(), 1);
     }
+    // (Optional) Unpack into the temp buffer, if pixels are converted to another color depth
+    std::vector<uint8_t> conv_buf;
+    if (pal_bpp == 0 && dst_bpp != bpp)
+    {
+        conv_buf.resize(w * h * bpp);
+        im_data = ImBufferPtr(&conv_buf[0], conv_buf.size(), bpp);
+    }
     // (Optional) Decompress the image data into the temp buffer
     size_t in_data_size =
         ((_version >= kSprfVersion_StorageFormats) || _compress != kSprCompress_None) ?
@@ -469,11 +524,15 @@ HError SpriteFile::LoadSprite(sprkey_t index, Common::Bitmap *&sprite)
         default: assert(0); break;
         }
     }
-    // Finally revert storage options
+    // Finally revert storage options, and convert pixels if requested
     if (pal_bpp > 0)
     {
         UnpackIndexedBitmap(image.get(), im_data.Buf, im_data.Size, palette, hdr.PalCount);
     }
+    else
+    {
+        ConvertPixels(image.get(), im_data.Buf, bpp, conv);
+    }
 
     sprite = image.release(); // FIXME: pass unique_ptr in this function
     _curPos = index + 1; // mark correct pos
@@ -89,6 +89,18 @@ enum SpriteCompression
 
 typedef int32_t sprkey_t;
 
+// SpriteConversion tells which pixel format conversions the sprite reader
+// may do right while unpacking the image, in order to save extra passes
+// over the pixels and intermediate bitmaps later.
+struct SpriteConversion
+{
+    // Color depth to convert hi-color sprites to;
+    // 0 means keep as is, only 32 is supported at the moment
+    int  HiColorToDepth = 0;
+    // Replace fully transparent pixels of 32-bit sprites with the mask color
+    bool AlphaToMask = false;
+};
+
 // SpriteFileIndex contains sprite file's table of contents
 struct SpriteFileIndex
 {
@@ -147,8 +159,10 @@ public:
                                     int expectedFileID, soff_t spr_initial_offs,
                                     sprkey_t topmost, std::vector<Size> &metrics);
 
-    // Loads an image data and creates a ready bitmap
-    HError      LoadSprite(sprkey_t index, Bitmap *&sprite);
+    // Loads an image data and creates a ready bitmap,
+    // optionally converting pixels to the requested format
+    HError      LoadSprite(sprkey_t index, Bitmap *&sprite,
+                           const SpriteConversion &conv = SpriteConversion());
     // Loads a raw sprite element data into the buffer, stores header info separately
     HError      LoadRawData(sprkey_t index, SpriteDatHeader &hdr, std::vector<uint8_t> &data);
 
@@ -0,0 +1,97 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "ac/gamestructdefines.h"
+#include "ac/spritecache.h"
+#include "ac/spritefile.h"
+#include "gfx/bitmap.h"
+#include "util/memory_compat.h"
+#include "util/memorystream.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+
+// Common library expects the program to provide the AGS color conversion;
+// the benchmarks only use colors already in the bitmap's format
+void __my_setcolor(int *ctset, int newcol, int /*wantColDep*/) {
+    ctset[0] = newcol;
+}
+
+static const int SpriteCount = 64;
+static const int SpriteSize = 64;
+
+// Writes a sprite file with a number of 32-bit sprites into the memory buffer
+static void MakeSpriteFile(std::vector<uint8_t> &membuf, SpriteCompression compress) {
+    SpriteFileWriter writer(std::make_unique<Stream>(
+        std::make_unique<VectorStream>(membuf, kStream_Write)));
+    writer.Begin(0, compress, SpriteCount);
+    writer.WriteEmptySlot(); // sprite 0 is reserved
+    for (int i = 1; i <= SpriteCount; ++i) {
+        std::unique_ptr<Bitmap> image(BitmapHelper::CreateBitmap(SpriteSize, SpriteSize, 32));
+        image->ClearTransparent();
+        image->FillRect(Rect(i % 16, i % 16, SpriteSize - i % 16, SpriteSize / 2), 0xFF000000 | (i * 0x030507));
+        writer.WriteBitmap(image.get());
+    }
+    writer.Finalize();
+}
+
+class SpriteCacheFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State &state) override {
+        MakeSpriteFile(_membuf, static_cast<SpriteCompression>(state.range(0)));
+        _cache.reset(new SpriteCache(_sprInfos, SpriteCache::Callbacks()));
+        _cache->InitFile(std::make_unique<Stream>(std::make_unique<VectorStream>(_membuf)), nullptr);
+    }
+
+    void TearDown(const benchmark::State &) override {
+        _cache.reset();
+        _sprInfos.clear();
+        _membuf.clear();
+    }
+
+protected:
+    std::vector<uint8_t> _membuf;
+    std::vector<SpriteInfo> _sprInfos;
+    std::unique_ptr<SpriteCache> _cache;
+};
+
+// All sprites fit in the cache, so every access after the first round is a hit
+BENCHMARK_DEFINE_F(SpriteCacheFixture, Hit)(benchmark::State &state) {
+    for (int i = 1; i <= SpriteCount; ++i)
+        (*_cache)[i];
+    sprkey_t index = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((*_cache)[index]);
+        index = index % SpriteCount + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The cache only holds a couple of sprites, so cycling through all of them
+// makes every access a miss which loads and decompresses the sprite
+BENCHMARK_DEFINE_F(SpriteCacheFixture, Miss)(benchmark::State &state) {
+    _cache->SetMaxCacheSize(SpriteSize * SpriteSize * 4 * 2);
+    sprkey_t index = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((*_cache)[index]);
+        index = index % SpriteCount + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(SpriteCacheFixture, Hit)->Arg(kSprCompress_None);
+BENCHMARK_REGISTER_F(SpriteCacheFixture, Miss)
+    ->Arg(kSprCompress_None)->Arg(kSprCompress_RLE)->Arg(kSprCompress_LZW)->Arg(kSprCompress_Deflate);
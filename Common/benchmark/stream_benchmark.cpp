@@ -0,0 +1,156 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "util/bufferedstream.h"
+#include "util/compress.h"
+#include "util/file.h"
+#include "util/filestream.h"
+#include "util/memory_compat.h"
+#include "util/memorystream.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+
+static const char *DummyFile = "dummy_bench.dat";
+static const size_t DummyFileSize = 1024u * 1024u;
+
+// Writes a dummy file of the fixed size, filled with incrementing ints
+static void MakeDummyFile() {
+    Stream out(std::make_unique<FileStream>(DummyFile, kFile_CreateAlways, kStream_Write));
+    for (size_t i = 0; i < DummyFileSize / sizeof(int32_t); ++i)
+        out.WriteInt32(static_cast<int32_t>(i));
+}
+
+static void BM_BufferedStream_ReadInt32(benchmark::State &state) {
+    MakeDummyFile();
+    for (auto _ : state) {
+        Stream in(std::make_unique<BufferedStream>(
+            std::make_unique<FileStream>(DummyFile, kFile_Open, kStream_Read)));
+        int32_t sum = 0;
+        for (size_t i = 0; i < DummyFileSize / sizeof(int32_t); ++i)
+            sum += in.ReadInt32();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * DummyFileSize);
+    File::DeleteFile(DummyFile);
+}
+BENCHMARK(BM_BufferedStream_ReadInt32);
+
+// Reads the file in chunks of the given size
+static void BM_BufferedStream_ReadChunks(benchmark::State &state) {
+    MakeDummyFile();
+    std::vector<uint8_t> buf(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Stream in(std::make_unique<BufferedStream>(
+            std::make_unique<FileStream>(DummyFile, kFile_Open, kStream_Read)));
+        while (in.Read(buf.data(), buf.size()) == buf.size());
+        benchmark::DoNotOptimize(buf.data());
+    }
+    state.SetBytesProcessed(state.iterations() * DummyFileSize);
+    File::DeleteFile(DummyFile);
+}
+BENCHMARK(BM_BufferedStream_ReadChunks)->Arg(64)->Arg(4096)->Arg(64 * 1024);
+
+// Seeks back and forth within a small range, which should be served from the buffer
+static void BM_BufferedStream_SeekRead(benchmark::State &state) {
+    MakeDummyFile();
+    Stream in(std::make_unique<BufferedStream>(
+        std::make_unique<FileStream>(DummyFile, kFile_Open, kStream_Read)));
+    int32_t sum = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < 64; ++i) {
+            in.Seek((i * 37) % 1024 * sizeof(int32_t), kSeekBegin);
+            sum += in.ReadInt32();
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * 64);
+    in.Close();
+    File::DeleteFile(DummyFile);
+}
+BENCHMARK(BM_BufferedStream_SeekRead);
+
+//-----------------------------------------------------------------------------
+// Image compression
+//-----------------------------------------------------------------------------
+
+static const int ImageWidth = 320;
+static const int ImageHeight = 200;
+
+// Generates a pseudo sprite image: areas of transparent color, horizontal
+// color runs and some noise, which is roughly how the game graphics compress
+static std::vector<uint8_t> MakeImageData(int bpp) {
+    std::vector<uint8_t> data(ImageWidth * ImageHeight * bpp);
+    uint32_t seed = 12345u;
+    for (int y = 0; y < ImageHeight; ++y) {
+        for (int x = 0; x < ImageWidth; ++x) {
+            uint32_t col;
+            if (x < ImageWidth / 4 || x >= ImageWidth * 3 / 4)
+                col = 0;
+            else if (y % 16 < 12)
+                col = 0x10 + (x / 8) * 0x010203;
+            else
+                col = (seed = seed * 1103515245u + 12345u) >> 8;
+            for (int b = 0; b < bpp; ++b)
+                data[(y * ImageWidth + x) * bpp + b] = static_cast<uint8_t>(col >> (b * 8));
+        }
+    }
+    return data;
+}
+
+typedef bool(*PfnCompress)(const uint8_t *data, size_t data_sz, int image_bpp, Stream *out);
+typedef bool(*PfnDecompress)(uint8_t *data, size_t data_sz, int image_bpp, Stream *in, size_t in_sz);
+
+// RLE decompression does not take input size, so wrap it for the common signature
+static bool rle_decompress_sz(uint8_t *data, size_t data_sz, int image_bpp, Stream *in, size_t /*in_sz*/) {
+    return rle_decompress(data, data_sz, image_bpp, in);
+}
+
+static void BM_Compress(benchmark::State &state, PfnCompress compress) {
+    const int bpp = static_cast<int>(state.range(0));
+    const std::vector<uint8_t> data = MakeImageData(bpp);
+    std::vector<uint8_t> membuf;
+    for (auto _ : state) {
+        membuf.clear();
+        Stream s(std::make_unique<VectorStream>(membuf, kStream_Write));
+        compress(data.data(), data.size(), bpp, &s);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.counters["ratio"] = membuf.empty() ? 0.0 : static_cast<double>(data.size()) / membuf.size();
+}
+
+static void BM_Decompress(benchmark::State &state, PfnCompress compress, PfnDecompress decompress) {
+    const int bpp = static_cast<int>(state.range(0));
+    std::vector<uint8_t> data = MakeImageData(bpp);
+    std::vector<uint8_t> membuf;
+    {
+        Stream s(std::make_unique<VectorStream>(membuf, kStream_Write));
+        compress(data.data(), data.size(), bpp, &s);
+    }
+    for (auto _ : state) {
+        Stream s(std::make_unique<VectorStream>(membuf));
+        decompress(data.data(), data.size(), bpp, &s, membuf.size());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_CAPTURE(BM_Compress, RLE, rle_compress)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK_CAPTURE(BM_Compress, LZW, lzw_compress)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK_CAPTURE(BM_Compress, Deflate, deflate_compress)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK_CAPTURE(BM_Decompress, RLE, rle_compress, rle_decompress_sz)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK_CAPTURE(BM_Decompress, LZW, lzw_compress, lzw_decompress)->Arg(1)->Arg(2)->Arg(4);
+BENCHMARK_CAPTURE(BM_Decompress, Deflate, deflate_compress, inflate_decompress)->Arg(1)->Arg(2)->Arg(4);
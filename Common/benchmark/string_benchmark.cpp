@@ -0,0 +1,60 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "benchmark/benchmark.h"
+#include "util/string.h"
+
+using namespace AGS::Common;
+
+static void BM_String_FromFormat(benchmark::State &state) {
+    for (auto _ : state) {
+        String s = String::FromFormat("%s: %d, %d (%0.2f)", "Character", 1024, -35, 0.75f);
+        benchmark::DoNotOptimize(s.GetCStr());
+    }
+}
+BENCHMARK(BM_String_FromFormat);
+
+static void BM_String_AppendFmt(benchmark::State &state) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        String s;
+        for (int i = 0; i < count; ++i)
+            s.AppendFmt("%d,", i);
+        benchmark::DoNotOptimize(s.GetCStr());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_String_AppendFmt)->Arg(16)->Arg(256);
+
+static void BM_String_Compare(benchmark::State &state) {
+    // Strings of equal length, which only differ at the last character
+    const size_t len = static_cast<size_t>(state.range(0));
+    String s1 = String::FromFormat("%s%c", String('x', len - 1).GetCStr(), 'a');
+    String s2 = String::FromFormat("%s%c", String('x', len - 1).GetCStr(), 'b');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s1.Compare(s2));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_String_Compare)->Arg(16)->Arg(1024);
+
+static void BM_String_CompareNoCase(benchmark::State &state) {
+    const size_t len = static_cast<size_t>(state.range(0));
+    String s1 = String::FromFormat("%s%c", String('x', len - 1).GetCStr(), 'a');
+    String s2 = String::FromFormat("%s%c", String('X', len - 1).GetCStr(), 'b');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s1.CompareNoCase(s2));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_String_CompareNoCase)->Arg(16)->Arg(1024);
@@ -110,6 +110,9 @@ public:
     virtual void GetFontMetrics(int fontNumber, FontMetrics *metrics) = 0;
     // Perform any necessary adjustments when the AA mode is toggled
     virtual void AdjustFontForAntiAlias(int fontNumber, bool aa_mode) = 0;
+    // Tells if the text width is always a plain sum of its characters' widths
+    // (no kerning, etc), which lets the caller measure text incrementally
+    virtual bool IsTextWidthAdditive(int fontNumber) = 0;
 
 protected:
     IAGSFontRendererInternal() = default;
@@ -13,6 +13,7 @@
 //=============================================================================
 #include <algorithm>
 #include <cstdio>
+#include <unordered_map>
 #include <vector>
 #include <alfont.h>
 #include "ac/common.h" // set_our_eip
@@ -50,6 +51,15 @@ struct Font
     FontMetrics         Metrics;
     // Precalculated linespacing, based on font properties and compat settings
     int                 LineSpacingCalc = 0;
+    // Tells whether the text width is a plain sum of character advances,
+    // in which case the text may be measured incrementally
+    bool                AdditiveWidth = false;
+    // Cached character advances: a table for the lower 256 codes
+    // (-1 marks not yet measured ones) and a map for the rest
+    std::vector<int>    AdvanceCache;
+    std::unordered_map<int, int> AdvanceCacheExt;
+    // Text format (ascii or utf-8) which the cached advances belong to
+    int                 AdvanceFormat = 0;
 
     // Outline buffers
     Bitmap TextStencil, TextStencilSub;
@@ -111,10 +121,20 @@ bool is_font_loaded(size_t fontNumber)
     return fontNumber < fonts.size() && fonts[fontNumber].Renderer != nullptr;
 }
 
+// Drops cached character advances, and tests whether they may be used
+static void font_reset_advances(size_t fontNumber)
+{
+    Font &font = fonts[fontNumber];
+    font.AdvanceCache.clear();
+    font.AdvanceCacheExt.clear();
+    font.AdditiveWidth = font.Renderer && font.RendererInt && font.RendererInt->IsTextWidthAdditive(fontNumber);
+}
+
 // Finish font's initialization
 static void font_post_init(size_t fontNumber)
 {
     Font &font = fonts[fontNumber];
+    font_reset_advances(fontNumber);
     // If no font height property was provided, then try several methods,
     // depending on which interface is available
     if ((font.Metrics.NominalHeight == 0) && font.Renderer)
@@ -281,6 +301,61 @@ int get_text_width_outlined(const char *text, size_t font_number)
     return std::max(self_width, outline_width);
 }
 
+// Returns the advance of a single character, measuring it on first request
+static int get_char_advance(size_t font_number, int uch)
+{
+    Font &font = fonts[font_number];
+    // Same character code may refer to a different glyph depending on
+    // the text format, so the cache is only valid for the one it was made in
+    const int uformat = get_uformat();
+    if (font.AdvanceFormat != uformat)
+    {
+        font.AdvanceCache.clear();
+        font.AdvanceCacheExt.clear();
+        font.AdvanceFormat = uformat;
+    }
+    if (uch >= 0 && uch < 256)
+    {
+        if (font.AdvanceCache.empty())
+            font.AdvanceCache.resize(256, -1);
+        int &advance = font.AdvanceCache[uch];
+        if (advance < 0)
+        {
+            char ch_buf[Utf8::UtfSz + 1]{};
+            usetc(ch_buf, uch);
+            advance = font.Renderer->GetTextWidth(ch_buf, font_number);
+        }
+        return advance;
+    }
+
+    auto it = font.AdvanceCacheExt.find(uch);
+    if (it != font.AdvanceCacheExt.end())
+        return it->second;
+    char ch_buf[Utf8::UtfSz + 1]{};
+    usetc(ch_buf, uch);
+    int advance = font.Renderer->GetTextWidth(ch_buf, font_number);
+    font.AdvanceCacheExt.insert(std::make_pair(uch, advance));
+    return advance;
+}
+
+// Tells if the outlined text width may be accumulated from the character
+// advances; also assigns the outline font index, or -1 if there's none
+static bool can_measure_by_advances(size_t font_number, int &outline_font)
+{
+    outline_font = -1;
+    if (font_number >= fonts.size() || !fonts[font_number].Renderer
+        || !fonts[font_number].AdditiveWidth)
+        return false;
+    int outline = fonts[font_number].Info.Outline;
+    if (outline < 0)
+        return true; // FONT_OUTLINE_AUTO or FONT_OUTLINE_NONE
+    if (static_cast<size_t>(outline) >= fonts.size() || !fonts[outline].Renderer
+        || !fonts[outline].AdditiveWidth)
+        return false;
+    outline_font = outline;
+    return true;
+}
+
 int get_font_outline(size_t font_number)
 {
     if (font_number >= fonts.size())
@@ -447,6 +522,14 @@ size_t split_lines(const char *todis, SplitLines &lines, int wii, int fonnt, siz
     const char *prev_ptr = scan_ptr; // previous scan pos
     const char *last_whitespace = nullptr; // last found whitespace
 
+    // If the font's text width is a sum of its character advances, then
+    // accumulate the line width as we go, instead of remeasuring the whole
+    // test buffer after each added character.
+    int outline_font = -1;
+    const bool by_advances = can_measure_by_advances(fonnt, outline_font);
+    const int outline_thick = by_advances ? fonts[fonnt].Info.AutoOutlineThickness : 0;
+    int self_width = 0, outline_width = 0;
+
     while (true) {
         if (scan_ptr == end_ptr) {
             // end of the text, add the last line if necessary
@@ -470,9 +553,22 @@ size_t split_lines(const char *todis, SplitLines &lines, int wii, int fonnt, siz
         } else {
             // copy next character to the test buffer and calculate its width
             char uch[Utf8::UtfSz + 1]{};
-            usetc(uch, ugetxc(&scan_ptr)); // this advances scan_ptr
+            const int ch = ugetxc(&scan_ptr); // this advances scan_ptr
+            usetc(uch, ch);
             test_buf.append(uch);
-            if (get_text_width_outlined(test_buf.c_str(), fonnt) > wii) {
+            int line_width;
+            if (by_advances) {
+                self_width += get_char_advance(fonnt, ch);
+                if (outline_font >= 0) {
+                    outline_width += get_char_advance(outline_font, ch);
+                    line_width = std::max(self_width, outline_width);
+                } else {
+                    line_width = self_width + 2 * outline_thick;
+                }
+            } else {
+                line_width = get_text_width_outlined(test_buf.c_str(), fonnt);
+            }
+            if (line_width > wii) {
                 // line is too wide, order the split
                 if (last_whitespace)
                     // revert to the last whitespace
@@ -507,6 +603,8 @@ size_t split_lines(const char *todis, SplitLines &lines, int wii, int fonnt, siz
             scan_ptr = theline;
             prev_ptr = theline;
             last_whitespace = nullptr;
+            self_width = 0;
+            outline_width = 0;
         }
     }
     return lines.Count();
@@ -644,7 +742,10 @@ void adjust_fonts_for_render_mode(bool aa_mode)
     for (size_t i = 0; i < fonts.size(); ++i)
     {
         if (fonts[i].RendererInt)
+        {
             fonts[i].RendererInt->AdjustFontForAntiAlias(i, aa_mode);
+            font_reset_advances(i);
+        }
     }
 }
 
@@ -661,6 +762,7 @@ void wfreefont(size_t fontNumber)
     fonts[fontNumber].Renderer->FreeMemory(fontNumber);
 
   fonts[fontNumber].Renderer = nullptr;
+  font_reset_advances(fontNumber);
 }
 
 void free_all_fonts()
@@ -80,6 +80,13 @@ bool TTFFontRenderer::IsBitmapFont()
     return false;
 }
 
+bool TTFFontRenderer::IsTextWidthAdditive(int /*fontNumber*/)
+{
+    // alfont_text_length sums glyph advances: kerning is disabled in our
+    // alfont build, and we never enable fixed-width or italic styles
+    return true;
+}
+
 static int GetAlfontFlags(int load_mode)
 {
   int flags = ALFONT_FLG_FORCE_RESIZE | ALFONT_FLG_SELECT_NOMINAL_SZ;
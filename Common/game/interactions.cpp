@@ -340,6 +340,16 @@ void InteractionVariable::Write(Common::Stream *out) const
 
 //-----------------------------------------------------------------------------
 
+void InteractionScripts::UpdateHandlerMask()
+{
+    HandlerMask = 0u;
+    for (size_t i = 0; i < ScriptFuncNames.size() && i < MAX_NEWINTERACTION_EVENTS; ++i)
+    {
+        if (!ScriptFuncNames[i].IsEmpty())
+            HandlerMask |= (1u << i);
+    }
+}
+
 InteractionScripts *InteractionScripts::CreateFromStream(Stream *in)
 {
     const size_t evt_count = in->ReadInt32();
@@ -355,6 +365,7 @@ InteractionScripts *InteractionScripts::CreateFromStream(Stream *in)
         String name = String::FromStream(in);
         scripts->ScriptFuncNames.push_back(name);
     }
+    scripts->UpdateHandlerMask();
     return scripts;
 }
 
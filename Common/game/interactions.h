@@ -185,7 +185,20 @@ struct InteractionScripts
 {
     StringV ScriptFuncNames;
 
+    // Tells if there's a script function assigned to the given event
+    inline bool HasHandler(int evt) const
+    {
+        return (evt >= 0) && (evt < MAX_NEWINTERACTION_EVENTS) && ((HandlerMask >> evt) & 1u);
+    }
+    // Recalculates the mask of the assigned event handlers,
+    // must be called whenever ScriptFuncNames are modified
+    void UpdateHandlerMask();
+
     static InteractionScripts *CreateFromStream(Stream *in);
+
+private:
+    // Bit flags of events that have a script function assigned
+    uint32_t HandlerMask = 0u;
 };
 
 typedef std::shared_ptr<InteractionScripts> PInteractionScripts;
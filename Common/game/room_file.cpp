@@ -26,6 +26,11 @@
 #include "util/compress.h"
 #include "util/data_ext.h"
 #include "util/string_utils.h"
+#if !defined(AGS_DISABLE_THREADS)
+#include <atomic>
+#include <system_error>
+#include <thread>
+#endif
 
 // default number of hotspots to read from the room file
 #define MIN_ROOM_HOTSPOTS  20
@@ -81,8 +86,69 @@ void WriteRoomObject(const RoomObjectInfo &obj, Stream *out)
 }
 
 
+// PendingRoomImage is a room image which data was read, but not unpacked yet
+struct PendingRoomImage
+{
+    PBitmap *Dest = nullptr;
+    PackedImage Image;
+};
+
+typedef std::vector<PendingRoomImage> PendingRoomImages;
+
+// Reads compressed room image, and schedules it for unpacking
+HError ReadPackedImage(Stream *in, RoomFileVersion data_ver, int bpp, PBitmap &dest,
+    RGB (*pal)[256], PendingRoomImages &images)
+{
+    PendingRoomImage img;
+    img.Dest = &dest;
+    const bool read_ok = (data_ver >= kRoomVersion_362) ?
+        read_deflate_packed(in, img.Image, pal) :
+        read_lzw_packed(in, bpp, img.Image, pal);
+    if (!read_ok)
+        return new RoomFileError(kRoomFileErr_InconsistentData, "Failed to read compressed room image.");
+    images.push_back(std::move(img));
+    return HError::None();
+}
+
+// Unpacks all the room images which were read from the file;
+// decompressing large backgrounds may take a noticeable time,
+// so the images are distributed among several threads when possible.
+HError UnpackRoomImages(PendingRoomImages &images)
+{
+#if defined(AGS_DISABLE_THREADS)
+    for (auto &img : images)
+        *img.Dest = unpack_image(img.Image);
+#else
+    std::atomic<size_t> next_image(0);
+    auto unpack_worker = [&images, &next_image]()
+    {
+        for (size_t i = next_image++; i < images.size(); i = next_image++)
+            *images[i].Dest = unpack_image(images[i].Image);
+    };
+    const size_t num_threads = std::min<size_t>(images.size(),
+        std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        try { threads.emplace_back(unpack_worker); }
+        catch (const std::system_error &) { break; } // let the current thread do the rest
+    }
+    unpack_worker();
+    for (auto &thread : threads)
+        thread.join();
+#endif
+
+    for (const auto &img : images)
+    {
+        if (!*img.Dest)
+            return new RoomFileError(kRoomFileErr_InconsistentData, "Failed to unpack room image.");
+    }
+    images.clear();
+    return HError::None();
+}
+
 // Main room data
-HError ReadMainBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver)
+HError ReadMainBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver, PendingRoomImages &images)
 {
     int bpp;
     if (data_ver >= kRoomVersion_208)
@@ -315,12 +381,31 @@ HError ReadMainBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver)
             room->Regions[i].Tint = in->ReadInt32();
     }
 
+    // Primary background and area masks compressed with Deflate;
+    // these are unpacked after the whole room data is read
+    if (data_ver >= kRoomVersion_362)
+    {
+        HError err = ReadPackedImage(in, data_ver, room->BackgroundBPP, room->BgFrames[0].Graphic, &room->Palette, images);
+        if (!err) return err;
+        PBitmap *masks[] = { &room->RegionMask, &room->WalkAreaMask, &room->WalkBehindMask, &room->HotspotMask };
+        for (auto *mask : masks)
+        {
+            err = ReadPackedImage(in, data_ver, 1, *mask, nullptr, images);
+            if (!err) return err;
+        }
+        return HError::None();
+    }
+
     // Primary background (LZW or RLE compressed depending on format)
     if (data_ver >= kRoomVersion_pre114_5)
-        room->BgFrames[0].Graphic =
-            load_lzw(in, room->BackgroundBPP, &room->Palette);
+    {
+        HError err = ReadPackedImage(in, data_ver, room->BackgroundBPP, room->BgFrames[0].Graphic, &room->Palette, images);
+        if (!err) return err;
+    }
     else
+    {
         room->BgFrames[0].Graphic = load_rle_bitmap8(in);
+    }
 
     // Area masks
     if (data_ver >= kRoomVersion_255b)
@@ -391,7 +476,7 @@ HError ReadObjScNamesBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ve
 }
 
 // Secondary backgrounds
-HError ReadAnimBgBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver)
+HError ReadAnimBgBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver, PendingRoomImages &images)
 {
     room->BgFrameCount = in->ReadInt8();
     if (room->BgFrameCount > MAX_ROOM_BGFRAMES)
@@ -406,8 +491,8 @@ HError ReadAnimBgBlock(RoomStruct *room, Stream *in, RoomFileVersion data_ver)
 
     for (size_t i = 1; i < room->BgFrameCount; ++i)
     {
-        room->BgFrames[i].Graphic =
-            load_lzw(in, room->BackgroundBPP, &room->BgFrames[i].Palette);
+        HError err = ReadPackedImage(in, data_ver, room->BackgroundBPP, room->BgFrames[i].Graphic, &room->BgFrames[i].Palette, images);
+        if (!err) return err;
     }
     return HError::None();
 }
@@ -432,7 +517,7 @@ HError ReadPropertiesBlock(RoomStruct *room, Stream *in, RoomFileVersion /*data_
 }
 
 HError ReadRoomBlock(RoomStruct *room, Stream *in, RoomFileBlock block, const String &ext_id,
-    soff_t block_len, RoomFileVersion data_ver)
+    soff_t block_len, RoomFileVersion data_ver, PendingRoomImages &images)
 {
     //
     // First check classic block types, identified with a numeric id
@@ -440,7 +525,7 @@ HError ReadRoomBlock(RoomStruct *room, Stream *in, RoomFileBlock block, const St
     switch (block)
     {
     case kRoomFblk_Main:
-        return ReadMainBlock(room, in, data_ver);
+        return ReadMainBlock(room, in, data_ver, images);
     case kRoomFblk_Script:
         in->Seek(block_len); // no longer read source script text into RoomStruct
         return HError::None();
@@ -451,7 +536,7 @@ HError ReadRoomBlock(RoomStruct *room, Stream *in, RoomFileBlock block, const St
     case kRoomFblk_ObjectScNames:
         return ReadObjScNamesBlock(room, in, data_ver);
     case kRoomFblk_AnimBg:
-        return ReadAnimBgBlock(room, in, data_ver);
+        return ReadAnimBgBlock(room, in, data_ver, images);
     case kRoomFblk_Properties:
         return ReadPropertiesBlock(room, in, data_ver);
     case kRoomFblk_CompScript:
@@ -501,6 +586,12 @@ public:
         return err;
     }
 
+    // Unpacks the room images, which were read but left compressed
+    HError UnpackImages()
+    {
+        return UnpackRoomImages(_images);
+    }
+
 private:
     String GetOldBlockName(int block_id) const override
     { return GetRoomBlockName((RoomFileBlock)block_id); }
@@ -508,11 +599,12 @@ private:
         soff_t block_len, bool &read_next) override
     {
         read_next = true;
-        return ReadRoomBlock(_room, in, (RoomFileBlock)block_id, ext_id, block_len, _dataVer);
+        return ReadRoomBlock(_room, in, (RoomFileBlock)block_id, ext_id, block_len, _dataVer, _images);
     }
 
     RoomStruct *_room {};
     RoomFileVersion _dataVer {};
+    PendingRoomImages _images;
 };
 
 
@@ -521,6 +613,8 @@ HRoomFileError ReadRoomData(RoomStruct *room, std::unique_ptr<Stream> &&in, Room
     room->DataVersion = data_ver;
     RoomBlockReader reader(room, data_ver, std::move(in));
     HError err = reader.Read();
+    if (err)
+        err = reader.UnpackImages();
     return err ? HRoomFileError::None() : new RoomFileError(kRoomFileErr_BlockListFailed, err);
 }
 
@@ -710,7 +804,7 @@ void WriteInteractionScripts(const InteractionScripts *interactions, Stream *out
         interactions->ScriptFuncNames[i].Write(out);
 }
 
-void WriteMainBlock(const RoomStruct *room, Stream *out)
+void WriteMainBlock(const RoomStruct *room, Stream *out, RoomFileVersion data_ver)
 {
     out->WriteInt32(room->BackgroundBPP);
     out->WriteInt16((int16_t)room->WalkBehindCount);
@@ -800,11 +894,22 @@ void WriteMainBlock(const RoomStruct *room, Stream *out)
     for (size_t i = 0; i < (size_t)MAX_ROOM_REGIONS; ++i)
         out->WriteInt32(room->Regions[i].Tint);
 
-    save_lzw(out, room->BgFrames[0].Graphic.get(), &room->Palette);
-    save_rle_bitmap8(out, room->RegionMask.get());
-    save_rle_bitmap8(out, room->WalkAreaMask.get());
-    save_rle_bitmap8(out, room->WalkBehindMask.get());
-    save_rle_bitmap8(out, room->HotspotMask.get());
+    if (data_ver >= kRoomVersion_362)
+    {
+        save_deflate_bitmap(out, room->BgFrames[0].Graphic.get(), &room->Palette);
+        save_deflate_bitmap(out, room->RegionMask.get());
+        save_deflate_bitmap(out, room->WalkAreaMask.get());
+        save_deflate_bitmap(out, room->WalkBehindMask.get());
+        save_deflate_bitmap(out, room->HotspotMask.get());
+    }
+    else
+    {
+        save_lzw(out, room->BgFrames[0].Graphic.get(), &room->Palette);
+        save_rle_bitmap8(out, room->RegionMask.get());
+        save_rle_bitmap8(out, room->WalkAreaMask.get());
+        save_rle_bitmap8(out, room->WalkBehindMask.get());
+        save_rle_bitmap8(out, room->HotspotMask.get());
+    }
 }
 
 void WriteCompSc3Block(const RoomStruct *room, Stream *out)
@@ -826,7 +931,7 @@ void WriteObjScNamesBlock(const RoomStruct *room, Stream *out)
         Common::StrUtil::WriteString(obj.ScriptName, out);
 }
 
-void WriteAnimBgBlock(const RoomStruct *room, Stream *out)
+void WriteAnimBgBlock(const RoomStruct *room, Stream *out, RoomFileVersion data_ver)
 {
     out->WriteByte((int8_t)room->BgFrameCount);
     out->WriteByte(room->BgAnimSpeed);
@@ -834,7 +939,12 @@ void WriteAnimBgBlock(const RoomStruct *room, Stream *out)
     for (size_t i = 0; i < room->BgFrameCount; ++i)
         out->WriteInt8(room->BgFrames[i].IsPaletteShared ? 1 : 0);
     for (size_t i = 1; i < room->BgFrameCount; ++i)
-        save_lzw(out, room->BgFrames[i].Graphic.get(), &room->BgFrames[i].Palette);
+    {
+        if (data_ver >= kRoomVersion_362)
+            save_deflate_bitmap(out, room->BgFrames[i].Graphic.get(), &room->BgFrames[i].Palette);
+        else
+            save_lzw(out, room->BgFrames[i].Graphic.get(), &room->BgFrames[i].Palette);
+    }
 }
 
 void WritePropertiesBlock(const RoomStruct *room, Stream *out)
@@ -854,13 +964,18 @@ void WriteStrOptions(const RoomStruct *room, Stream *out)
 
 HRoomFileError WriteRoomData(const RoomStruct *room, Stream *out, RoomFileVersion data_ver)
 {
-    if (data_ver < kRoomVersion_Current)
+    // NOTE: 3.5.0.8 format is still supported for writing, for the tools
+    // which have to produce rooms compatible with the older engines
+    if (data_ver < kRoomVersion_3508)
         return new RoomFileError(kRoomFileErr_FormatNotSupported, "We no longer support saving room in the older format.");
+    if (data_ver > kRoomVersion_Current)
+        return new RoomFileError(kRoomFileErr_FormatNotSupported, String::FromFormat("Unknown room format version: %d.", data_ver));
 
     // Header
     out->WriteInt16(data_ver);
     // Main data
-    WriteRoomBlock(room, kRoomFblk_Main, WriteMainBlock, out);
+    WriteRoomBlock(room, kRoomFblk_Main,
+        [data_ver](const RoomStruct *room, Stream *out) { WriteMainBlock(room, out, data_ver); }, out);
     // Compiled script
     if (room->CompiledScript)
         WriteRoomBlock(room, kRoomFblk_CompScript3, WriteCompSc3Block, out);
@@ -872,7 +987,8 @@ HRoomFileError WriteRoomData(const RoomStruct *room, Stream *out, RoomFileVersio
     }
     // Secondary background frames
     if (room->BgFrameCount > 1)
-        WriteRoomBlock(room, kRoomFblk_AnimBg, WriteAnimBgBlock, out);
+        WriteRoomBlock(room, kRoomFblk_AnimBg,
+            [data_ver](const RoomStruct *room, Stream *out) { WriteAnimBgBlock(room, out, data_ver); }, out);
     // Custom properties
     WriteRoomBlock(room, kRoomFblk_Properties, WritePropertiesBlock, out);
 
@@ -81,7 +81,8 @@ enum RoomFileVersion
     kRoomVersion_3415 = 31,
     kRoomVersion_350 = 32,
     kRoomVersion_3508 = 33,
-    kRoomVersion_Current = kRoomVersion_3508
+    kRoomVersion_362 = 34,
+    kRoomVersion_Current = kRoomVersion_362
 };
 
 #endif // __AGS_CN_AC__ROOMVERSION_H
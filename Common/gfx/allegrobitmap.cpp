@@ -12,9 +12,13 @@
 //
 //=============================================================================
 
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 #include <string.h> // memcpy
+#include <vector>
 #include <aastr.h>
 #include "gfx/allegrobitmap.h"
 #include "util/filestream.h"
@@ -74,7 +78,7 @@ bool Bitmap::Create(int width, int height, int color_depth)
 
     size_t need_size;
     create_bitmap_userdata(color_depth, width, height, nullptr, 0u, 0u, &need_size);
-    std::unique_ptr<uint8_t[]> data(new uint8_t[need_size]);
+    PixelDataPtr data(BitmapPool::Allocate(need_size), PixelDataDeleter(true));
     BITMAP *bitmap = create_bitmap_userdata(color_depth, width, height, data.get(), need_size, 0u, nullptr);
     if (!bitmap)
         return false;
@@ -102,14 +106,14 @@ bool Bitmap::Create(PixelBuffer &&pxbuf)
     const int color_depth = PixelFormatToPixelBits(pxbuf.GetFormat());
     const int width = pxbuf.GetWidth(), height = pxbuf.GetHeight();
     size_t data_sz = pxbuf.GetDataSize();
-    std::unique_ptr<uint8_t[]> data = pxbuf.ReleaseData();
+    PixelDataPtr data(pxbuf.ReleaseData().release());
     // Do safety check, if provided data buffer is not long enough for Allegro BITMAP,
     // then create a correct one and copy contents over.
     size_t need_size;
     create_bitmap_userdata(color_depth, width, height, nullptr, 0u, 0u, &need_size);
     if (need_size > data_sz)
     {
-        std::unique_ptr<uint8_t[]> copy_buf(new uint8_t[need_size]);
+        PixelDataPtr copy_buf(BitmapPool::Allocate(need_size), PixelDataDeleter(true));
         std::copy(data.get(), data.get() + data_sz, copy_buf.get());
         data = std::move(copy_buf);
         data_sz = need_size;
@@ -449,6 +453,54 @@ void Bitmap::DrawLine(const Line &ln, color_t color)
 	line(_alBitmap, ln.X1, ln.Y1, ln.X2, ln.Y2, color);
 }
 
+// Horizontal extents of a one-pixel line's rows, collected by do_line()
+struct LineRows
+{
+	int Y0 = 0;
+	std::vector<std::pair<int, int>> Rows; // min and max X of each row, from Y0
+};
+
+// do_line() callback; receives LineRows in place of the bitmap
+static void AddLinePoint(BITMAP *bmp, int x, int y, int /*d*/)
+{
+	LineRows &lr = *reinterpret_cast<LineRows*>(bmp);
+	auto &row = lr.Rows[y - lr.Y0];
+	row.first = std::min(row.first, x);
+	row.second = std::max(row.second, x);
+}
+
+void Bitmap::DrawThickLine(const Line &ln, int thickness, color_t color)
+{
+	if (thickness <= 1)
+	{
+		if (thickness == 1)
+			line(_alBitmap, ln.X1, ln.Y1, ln.X2, ln.Y2, color);
+		return;
+	}
+
+	// The line is a trace of the square brush moved along the one-pixel line,
+	// that is the same pixels as the one-pixel line drawn at each brush offset.
+	// Every row of the one-pixel line is stretched by the brush size; as the
+	// neighbouring rows are connected, each row of the result is a single span.
+	const int off1 = -(thickness / 2);
+	const int off2 = off1 + thickness - 1;
+	LineRows lr;
+	lr.Y0 = std::min(ln.Y1, ln.Y2);
+	lr.Rows.resize(std::abs(ln.Y2 - ln.Y1) + 1, std::make_pair(INT_MAX, INT_MIN));
+	do_line(reinterpret_cast<BITMAP*>(&lr), ln.X1, ln.Y1, ln.X2, ln.Y2, 0, AddLinePoint);
+	const int rows = static_cast<int>(lr.Rows.size());
+	for (int y = off1; y <= rows - 1 + off2; ++y)
+	{
+		int x1 = INT_MAX, x2 = INT_MIN;
+		for (int r = std::max(0, y - off2); r <= std::min(rows - 1, y - off1); ++r)
+		{
+			x1 = std::min(x1, lr.Rows[r].first);
+			x2 = std::max(x2, lr.Rows[r].second);
+		}
+		hline(_alBitmap, x1 + off1, lr.Y0 + y, x2 + off2, color);
+	}
+}
+
 void Bitmap::DrawTriangle(const Triangle &tr, color_t color)
 {
 	triangle(_alBitmap,
@@ -470,6 +522,20 @@ void Bitmap::FillCircle(const Circle &circle, color_t color)
 	circlefill(_alBitmap, circle.X, circle.Y, circle.Radius, color);
 }
 
+void Bitmap::FillPolygon(const Point *points, size_t count, color_t color)
+{
+	if (count < 3)
+		return;
+	// allegro's polygon takes a flat array of coordinates
+	std::vector<int> coords(count * 2);
+	for (size_t i = 0; i < count; ++i)
+	{
+		coords[i * 2] = points[i].X;
+		coords[i * 2 + 1] = points[i].Y;
+	}
+	polygon(_alBitmap, static_cast<int>(count), coords.data(), color);
+}
+
 void Bitmap::Fill(color_t color)
 {
 	if (color)
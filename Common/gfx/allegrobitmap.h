@@ -26,6 +26,7 @@
 #include "core/types.h"
 #include "gfx/bitmap.h"
 #include "gfx/bitmapdata.h"
+#include "gfx/bitmappool.h"
 #include "util/string.h"
 
 namespace AGS
@@ -229,10 +230,15 @@ public:
     // Vector drawing operations
     //=========================================================================
     void    DrawLine(const Line &ln, color_t color);
+    // Draws a line of the given thickness, as if painted by a square brush;
+    // matches the one-pixel line drawn at each brush offset, filled by row spans
+    void    DrawThickLine(const Line &ln, int thickness, color_t color);
     void    DrawTriangle(const Triangle &tr, color_t color);
     void    DrawRect(const Rect &rc, color_t color);
     void    FillRect(const Rect &rc, color_t color);
     void    FillCircle(const Circle &circle, color_t color);
+    // Fills a polygon, defined by a sequence of vertices
+    void    FillPolygon(const Point *points, size_t count, color_t color);
     // Fills the whole bitmap with given color
     void    Fill(color_t color);
     void    FillTransparent();
@@ -257,7 +263,7 @@ public:
     void    SetScanLine(int index, unsigned char *data, int data_size = -1);
 
 private:
-    std::unique_ptr<uint8_t[]> _pixelData;
+    PixelDataPtr _pixelData;
     BITMAP *_alBitmap = nullptr;
     bool    _isDataOwner = false;
 };
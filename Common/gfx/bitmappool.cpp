@@ -0,0 +1,220 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "gfx/bitmappool.h"
+#include <stdlib.h>
+#include <mutex>
+#include <vector>
+
+namespace AGS
+{
+namespace Common
+{
+
+namespace BitmapPool
+{
+
+// Smallest size class, sizes below are rounded up to it
+const int    MinClassShift = 8;
+const size_t MinClassSize = (size_t)1 << MinClassShift;
+// Buffers of this size and above are not pooled
+const int    MaxClassShift = 28;
+// Number of size classes per power of two
+const int    ClassSteps = 4;
+const int    NumClasses = (MaxClassShift - MinClassShift) * ClassSteps + 1;
+
+// Header stored right before each returned buffer
+struct BufferHeader
+{
+    void   *Raw;      // actual allocated memory
+    size_t  Capacity; // usable buffer size
+    int     Class;    // size class, or -1 if not pooled
+};
+
+static_assert(sizeof(BufferHeader) <= BufferAlignment, "buffer header must fit into alignment");
+
+struct PoolState
+{
+    std::mutex Mutex;
+    std::vector<uint8_t*> FreeLists[NumClasses];
+    size_t   MaxPooledSize = DefaultMaxPooledSize;
+    size_t   PooledSize = 0u;
+    size_t   PooledCount = 0u;
+    uint64_t Hits = 0u;
+    uint64_t Misses = 0u;
+    uint64_t Rejects = 0u;
+};
+
+// NOTE: the pool is never destroyed, because bitmaps may be freed by
+// the static object destructors at the program exit
+static PoolState &GetPool()
+{
+    static PoolState *pool = new PoolState();
+    return *pool;
+}
+
+static inline BufferHeader *GetHeader(uint8_t *buf)
+{
+    return reinterpret_cast<BufferHeader*>(buf - sizeof(BufferHeader));
+}
+
+// Finds the size class for the given size; returns class index and
+// the size of the class, or -1 if the size is too large for pooling
+static int GetSizeClass(size_t size, size_t &class_size)
+{
+    if (size <= MinClassSize)
+    {
+        class_size = MinClassSize;
+        return 0;
+    }
+    // find the range of (2^shift, 2^(shift + 1)], and a step within it
+    int shift = MinClassShift;
+    while (((size_t)1 << (shift + 1)) < size)
+        shift++;
+    if (shift >= MaxClassShift)
+    {
+        class_size = size;
+        return -1;
+    }
+    const size_t base = (size_t)1 << shift;
+    const size_t step = base / ClassSteps;
+    const size_t sub = (size - base + step - 1) / step;
+    class_size = base + sub * step;
+    return (shift - MinClassShift) * ClassSteps + static_cast<int>(sub);
+}
+
+static uint8_t *AllocateNew(size_t capacity, int size_class)
+{
+    void *raw = malloc(capacity + BufferAlignment * 2);
+    if (!raw)
+        return nullptr;
+    // leave at least one alignment block for the header
+    const uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + BufferAlignment * 2 - 1)
+        & ~(uintptr_t)(BufferAlignment - 1);
+    uint8_t *buf = reinterpret_cast<uint8_t*>(aligned);
+    BufferHeader *hdr = GetHeader(buf);
+    hdr->Raw = raw;
+    hdr->Capacity = capacity;
+    hdr->Class = size_class;
+    return buf;
+}
+
+static void ReleaseBuffer(uint8_t *buf)
+{
+    free(GetHeader(buf)->Raw);
+}
+
+// Frees the kept buffers, starting from the largest ones,
+// until their total size fits the limit; pool must be locked
+static void TrimPool(PoolState &pool, size_t max_size)
+{
+    for (int cls = NumClasses - 1; cls >= 0 && pool.PooledSize > max_size; --cls)
+    {
+        auto &list = pool.FreeLists[cls];
+        while (!list.empty() && pool.PooledSize > max_size)
+        {
+            uint8_t *buf = list.back();
+            list.pop_back();
+            pool.PooledSize -= GetHeader(buf)->Capacity;
+            pool.PooledCount--;
+            ReleaseBuffer(buf);
+        }
+    }
+}
+
+uint8_t *Allocate(size_t size)
+{
+    size_t class_size;
+    const int cls = GetSizeClass(size, class_size);
+    PoolState &pool = GetPool();
+    if (cls >= 0)
+    {
+        std::lock_guard<std::mutex> lk(pool.Mutex);
+        auto &list = pool.FreeLists[cls];
+        if (!list.empty())
+        {
+            uint8_t *buf = list.back();
+            list.pop_back();
+            pool.PooledSize -= class_size;
+            pool.PooledCount--;
+            pool.Hits++;
+            return buf;
+        }
+        pool.Misses++;
+    }
+    return AllocateNew(class_size, cls);
+}
+
+void Free(uint8_t *buf)
+{
+    if (!buf)
+        return;
+    const BufferHeader *hdr = GetHeader(buf);
+    if (hdr->Class >= 0)
+    {
+        PoolState &pool = GetPool();
+        std::lock_guard<std::mutex> lk(pool.Mutex);
+        if (pool.PooledSize + hdr->Capacity <= pool.MaxPooledSize)
+        {
+            pool.FreeLists[hdr->Class].push_back(buf);
+            pool.PooledSize += hdr->Capacity;
+            pool.PooledCount++;
+            return;
+        }
+        pool.Rejects++;
+    }
+    ReleaseBuffer(buf);
+}
+
+void SetMaxPooledSize(size_t max_size)
+{
+    PoolState &pool = GetPool();
+    std::lock_guard<std::mutex> lk(pool.Mutex);
+    pool.MaxPooledSize = max_size;
+    TrimPool(pool, max_size);
+}
+
+void Clear()
+{
+    PoolState &pool = GetPool();
+    std::lock_guard<std::mutex> lk(pool.Mutex);
+    TrimPool(pool, 0u);
+}
+
+Stats GetStats()
+{
+    PoolState &pool = GetPool();
+    std::lock_guard<std::mutex> lk(pool.Mutex);
+    Stats stats;
+    stats.Hits = pool.Hits;
+    stats.Misses = pool.Misses;
+    stats.Rejects = pool.Rejects;
+    stats.PooledCount = pool.PooledCount;
+    stats.PooledSize = pool.PooledSize;
+    stats.MaxPooledSize = pool.MaxPooledSize;
+    return stats;
+}
+
+void ResetStats()
+{
+    PoolState &pool = GetPool();
+    std::lock_guard<std::mutex> lk(pool.Mutex);
+    pool.Hits = 0u;
+    pool.Misses = 0u;
+    pool.Rejects = 0u;
+}
+
+} // namespace BitmapPool
+
+} // namespace Common
+} // namespace AGS
@@ -0,0 +1,96 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// BitmapPool is a program-wide allocator of the bitmap pixel buffers.
+//
+// Requested sizes are rounded up to size classes (four classes per power of
+// two), and freed buffers are kept in the per-class lists, so that the
+// temporary bitmaps created over and over again reuse the same memory.
+// The total size of the kept buffers is limited; buffers that do not fit
+// are released to the system.
+//
+// All buffers begin at the BufferAlignment boundary.
+//
+//=============================================================================
+#ifndef __AGS_CN_GFX__BITMAPPOOL_H
+#define __AGS_CN_GFX__BITMAPPOOL_H
+
+#include <memory>
+#include "core/types.h"
+
+namespace AGS
+{
+namespace Common
+{
+
+namespace BitmapPool
+{
+    // Alignment of the buffer's beginning, in bytes
+    const size_t BufferAlignment = 64;
+    // Default limit for the total size of the kept free buffers, in bytes
+    const size_t DefaultMaxPooledSize = 32 * 1024 * 1024;
+
+    struct Stats
+    {
+        // Number of allocations served from the pool
+        uint64_t Hits = 0u;
+        // Number of allocations which required a new buffer
+        uint64_t Misses = 0u;
+        // Number of freed buffers which did not fit into the pool
+        uint64_t Rejects = 0u;
+        // Number and total size of the buffers currently kept in the pool
+        size_t   PooledCount = 0u;
+        size_t   PooledSize = 0u;
+        size_t   MaxPooledSize = 0u;
+    };
+
+    // Allocates a buffer of at least the given size; returns null on failure
+    uint8_t *Allocate(size_t size);
+    // Returns the buffer to the pool, or releases it if the pool is full
+    void     Free(uint8_t *buf);
+    // Sets the limit of the total size of the kept buffers, and frees
+    // the excess buffers if needed
+    void     SetMaxPooledSize(size_t max_size);
+    // Releases all the kept buffers
+    void     Clear();
+    // Gets the pool's usage statistics
+    Stats    GetStats();
+    // Resets hit and miss counters
+    void     ResetStats();
+} // namespace BitmapPool
+
+// Deleter for the bitmap pixel data, which may be either allocated
+// by the BitmapPool, or by a regular new[]
+struct PixelDataDeleter
+{
+    bool Pooled = false;
+
+    PixelDataDeleter() = default;
+    PixelDataDeleter(bool pooled) : Pooled(pooled) {}
+
+    void operator()(uint8_t *buf) const
+    {
+        if (Pooled)
+            BitmapPool::Free(buf);
+        else
+            delete [] buf;
+    }
+};
+
+typedef std::unique_ptr<uint8_t[], PixelDataDeleter> PixelDataPtr;
+
+} // namespace Common
+} // namespace AGS
+
+#endif // __AGS_CN_GFX__BITMAPPOOL_H
@@ -0,0 +1,635 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "gfx/image_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#if !defined(AGS_DISABLE_THREADS)
+#include <system_error>
+#include <thread>
+#endif
+#include "gfx/bitmap.h"
+
+namespace AGS
+{
+namespace Common
+{
+
+namespace ImageFilter
+{
+
+// Minimal number of pixels worth processing on a separate thread
+static const int MinPixelsPerThread = 32 * 1024;
+
+// Calls fn(y_from, y_to) for the ranges of rows, which together cover the
+// whole height; large images are split among several threads.
+// The function must only write to the rows within its range.
+template <typename TRowsFn>
+static void ForEachRows(int width, int height, const TRowsFn &fn)
+{
+#if defined(AGS_DISABLE_THREADS)
+    (void)width;
+    fn(0, height);
+#else
+    const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int num_threads = std::min(std::min(max_threads, height),
+        std::max(1, (width * height) / MinPixelsPerThread));
+    if (num_threads <= 1)
+    {
+        fn(0, height);
+        return;
+    }
+
+    const int rows_per_thread = (height + num_threads - 1) / num_threads;
+    std::vector<std::thread> threads;
+    int y = rows_per_thread; // first range is left for the current thread
+    for (; y < height; y += rows_per_thread)
+    {
+        try { threads.emplace_back(fn, y, std::min(y + rows_per_thread, height)); }
+        catch (const std::system_error &) { break; } // let the current thread do the rest
+    }
+    fn(0, rows_per_thread);
+    if (y < height)
+        fn(y, height);
+    for (auto &thread : threads)
+        thread.join();
+#endif
+}
+
+// Positions of the channels in a 32-bit pixel
+struct ChannelShifts
+{
+    const int R = _rgb_r_shift_32;
+    const int G = _rgb_g_shift_32;
+    const int B = _rgb_b_shift_32;
+    const int A = _rgb_a_shift_32;
+};
+
+// A row of pixels split into the separate float channels
+struct RowChannels
+{
+    std::vector<float> Data;
+    float *R, *G, *B, *A;
+    float *Ch[4];
+
+    explicit RowChannels(int width)
+        : Data(width * 4)
+    {
+        R = Ch[0] = Data.data();
+        G = Ch[1] = R + width;
+        B = Ch[2] = G + width;
+        A = Ch[3] = B + width;
+    }
+};
+
+// NOTE: the value is clamped after converting to integer, because the float
+// comparisons are not turned into vector instructions without fast-math;
+// the filters must keep the values within the int range.
+inline uint32_t ClampToByte(float v)
+{
+    int i = static_cast<int>(v + 0.5f);
+    i = i > 0 ? i : 0;
+    i = i < 255 ? i : 255;
+    return static_cast<uint32_t>(i);
+}
+
+// Max absolute value of the user-provided factors, which keeps
+// the filtered values within the int range
+static const float MaxFactor = 256.f;
+static const float MaxOffset = 65536.f;
+
+inline float ClampFactor(float f, float max_value)
+{
+    return std::isfinite(f) ? std::min(std::max(f, -max_value), max_value) : 0.f;
+}
+
+// Splits the pixels into the channels, in 0-255 range,
+// starting at the given offset in the row
+static void UnpackRow(const uint32_t *px, int width, const ChannelShifts &sh,
+    RowChannels &row, int offset = 0)
+{
+    float *r = row.R + offset, *g = row.G + offset, *b = row.B + offset, *a = row.A + offset;
+    for (int x = 0; x < width; ++x)
+    {
+        const uint32_t p = px[x];
+        r[x] = static_cast<float>((p >> sh.R) & 0xFF);
+        g[x] = static_cast<float>((p >> sh.G) & 0xFF);
+        b[x] = static_cast<float>((p >> sh.B) & 0xFF);
+        a[x] = static_cast<float>((p >> sh.A) & 0xFF);
+    }
+}
+
+// Joins the channels back into pixels, clamping the values to 0-255 range
+static void PackRow(uint32_t *px, int width, const ChannelShifts &sh, const RowChannels &row)
+{
+    const float *r = row.R, *g = row.G, *b = row.B, *a = row.A;
+    // local copies, as the shifts could otherwise alias the written pixels
+    const int r_shift = sh.R, g_shift = sh.G, b_shift = sh.B, a_shift = sh.A;
+    for (int x = 0; x < width; ++x)
+    {
+        px[x] = (ClampToByte(r[x]) << r_shift) | (ClampToByte(g[x]) << g_shift) |
+            (ClampToByte(b[x]) << b_shift) | (ClampToByte(a[x]) << a_shift);
+    }
+}
+
+// Multiplies the colors by alpha, so that the transparent pixels
+// do not contribute their color when mixed with the others
+static void PremultiplyRow(RowChannels &row, int width, int offset = 0)
+{
+    float *r = row.R + offset, *g = row.G + offset, *b = row.B + offset;
+    const float *a = row.A + offset;
+    for (int x = 0; x < width; ++x)
+    {
+        const float f = a[x] * (1.f / 255.f);
+        r[x] *= f;
+        g[x] *= f;
+        b[x] *= f;
+    }
+}
+
+static void UnpremultiplyRow(RowChannels &row, int width)
+{
+    float *r = row.R, *g = row.G, *b = row.B;
+    const float *a = row.A;
+    for (int x = 0; x < width; ++x)
+    {
+        // premultiplied colors never exceed alpha, and are zero when it's zero;
+        // small addition is used instead of checking for zero, for vectorization
+        const float f = 255.f / (a[x] + 0.001f);
+        r[x] *= f;
+        g[x] *= f;
+        b[x] *= f;
+    }
+}
+
+inline bool IsFilterable(const Bitmap *bmp)
+{
+    return bmp && (bmp->GetColorDepth() == 32);
+}
+
+inline const uint32_t *GetPixelRow(const Bitmap *bmp, int y)
+{
+    return reinterpret_cast<const uint32_t*>(bmp->GetScanLine(y));
+}
+
+inline uint32_t *GetPixelRowForWriting(Bitmap *bmp, int y)
+{
+    return reinterpret_cast<uint32_t*>(bmp->GetScanLineForWriting(y));
+}
+
+// Applies the 1D kernel along the rows, then along the columns;
+// the colors are mixed premultiplied by alpha.
+static void SeparableBlur(Bitmap *bmp, const std::vector<float> &weights)
+{
+    const int width = bmp->GetWidth(), height = bmp->GetHeight();
+    const int radius = static_cast<int>(weights.size() / 2);
+    const size_t plane_size = static_cast<size_t>(width) * height;
+    const ChannelShifts sh;
+    std::vector<float> planes(plane_size * 4);
+
+    // Horizontal pass: from the bitmap into the channel planes;
+    // each row is padded by repeating its edge pixels
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        const int padded_width = width + radius * 2;
+        RowChannels row(padded_width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            UnpackRow(GetPixelRow(bmp, y), width, sh, row, radius);
+            PremultiplyRow(row, width, radius);
+            for (int c = 0; c < 4; ++c)
+            {
+                float *line = row.Ch[c];
+                std::fill(line, line + radius, line[radius]);
+                std::fill(line + radius + width, line + padded_width, line[radius + width - 1]);
+                float *out = &planes[c * plane_size + y * width];
+                std::fill(out, out + width, 0.f);
+                for (size_t k = 0; k < weights.size(); ++k)
+                {
+                    const float f = weights[k];
+                    const float *in = line + k;
+                    for (int x = 0; x < width; ++x)
+                        out[x] += f * in[x];
+                }
+            }
+        }
+    });
+
+    // Vertical pass: from the planes back into the bitmap,
+    // rows above and below the image repeat the edge rows
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels row(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                float *out = row.Ch[c];
+                std::fill(out, out + width, 0.f);
+                for (size_t k = 0; k < weights.size(); ++k)
+                {
+                    const float f = weights[k];
+                    const int src_y = std::min(std::max(y + static_cast<int>(k) - radius, 0), height - 1);
+                    const float *in = &planes[c * plane_size + src_y * width];
+                    for (int x = 0; x < width; ++x)
+                        out[x] += f * in[x];
+                }
+            }
+            UnpremultiplyRow(row, width);
+            PackRow(GetPixelRowForWriting(bmp, y), width, sh, row);
+        }
+    });
+}
+
+bool BoxBlur(Bitmap *bmp, int radius)
+{
+    if (!IsFilterable(bmp) || radius < 0)
+        return false;
+    radius = std::min(radius, std::max(bmp->GetWidth(), bmp->GetHeight()));
+    if (radius == 0)
+        return true;
+    std::vector<float> weights(radius * 2 + 1, 1.f / (radius * 2 + 1));
+    SeparableBlur(bmp, weights);
+    return true;
+}
+
+bool GaussianBlur(Bitmap *bmp, int radius)
+{
+    if (!IsFilterable(bmp) || radius < 0)
+        return false;
+    radius = std::min(radius, std::max(bmp->GetWidth(), bmp->GetHeight()));
+    if (radius == 0)
+        return true;
+    // The radius covers two standard deviations, beyond which
+    // the weights are too small to make a visible difference
+    const float sigma = radius / 2.f;
+    std::vector<float> weights(radius * 2 + 1);
+    float sum = 0.f;
+    for (int k = -radius; k <= radius; ++k)
+    {
+        const float w = std::exp(-(k * k) / (2.f * sigma * sigma));
+        weights[k + radius] = w;
+        sum += w;
+    }
+    for (auto &w : weights)
+        w /= sum;
+    SeparableBlur(bmp, weights);
+    return true;
+}
+
+bool Convolve(Bitmap *bmp, const float *kernel, int kernel_w, int kernel_h, float bias)
+{
+    if (!IsFilterable(bmp) || !kernel ||
+        (kernel_w < 1) || (kernel_w > MaxKernelSize) || (kernel_w % 2 == 0) ||
+        (kernel_h < 1) || (kernel_h > MaxKernelSize) || (kernel_h % 2 == 0))
+        return false;
+
+    std::vector<float> factors(kernel_w * kernel_h);
+    for (size_t i = 0; i < factors.size(); ++i)
+        factors[i] = ClampFactor(kernel[i], MaxFactor);
+    bias = ClampFactor(bias, MaxOffset);
+
+    const int width = bmp->GetWidth(), height = bmp->GetHeight();
+    const int radius_x = kernel_w / 2, radius_y = kernel_h / 2;
+    const int padded_width = width + radius_x * 2;
+    const size_t plane_size = static_cast<size_t>(padded_width) * height;
+    const ChannelShifts sh;
+    std::vector<float> planes(plane_size * 3);
+
+    // Copy the color channels into the planes, padded by the edge pixels
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels row(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            UnpackRow(GetPixelRow(bmp, y), width, sh, row);
+            for (int c = 0; c < 3; ++c)
+            {
+                float *line = &planes[c * plane_size + y * padded_width];
+                std::copy(row.Ch[c], row.Ch[c] + width, line + radius_x);
+                std::fill(line, line + radius_x, line[radius_x]);
+                std::fill(line + radius_x + width, line + padded_width, line[radius_x + width - 1]);
+            }
+        }
+    });
+
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels row(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            uint32_t *px = GetPixelRowForWriting(bmp, y);
+            UnpackRow(px, width, sh, row); // for the alpha channel
+            for (int c = 0; c < 3; ++c)
+            {
+                float *out = row.Ch[c];
+                std::fill(out, out + width, bias);
+                for (int ky = 0; ky < kernel_h; ++ky)
+                {
+                    const int src_y = std::min(std::max(y + ky - radius_y, 0), height - 1);
+                    const float *line = &planes[c * plane_size + src_y * padded_width];
+                    for (int kx = 0; kx < kernel_w; ++kx)
+                    {
+                        const float f = factors[ky * kernel_w + kx];
+                        if (f == 0.f)
+                            continue;
+                        const float *in = line + kx;
+                        for (int x = 0; x < width; ++x)
+                            out[x] += f * in[x];
+                    }
+                }
+            }
+            PackRow(px, width, sh, row);
+        }
+    });
+    return true;
+}
+
+bool ApplyColorMatrix(Bitmap *bmp, const float *matrix)
+{
+    if (!IsFilterable(bmp) || !matrix)
+        return false;
+
+    float factors[ColorMatrixSize];
+    for (int i = 0; i < ColorMatrixSize; ++i)
+        factors[i] = ClampFactor(matrix[i], (i % 5 == 4) ? MaxOffset : MaxFactor);
+
+    const int width = bmp->GetWidth(), height = bmp->GetHeight();
+    const ChannelShifts sh;
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels in(width), out(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            uint32_t *px = GetPixelRowForWriting(bmp, y);
+            UnpackRow(px, width, sh, in);
+            for (int c = 0; c < 4; ++c)
+            {
+                const float *m = factors + c * 5;
+                const float *r = in.R, *g = in.G, *b = in.B, *a = in.A;
+                float *o = out.Ch[c];
+                for (int x = 0; x < width; ++x)
+                    o[x] = m[0] * r[x] + m[1] * g[x] + m[2] * b[x] + m[3] * a[x] + m[4];
+            }
+            PackRow(px, width, sh, out);
+        }
+    });
+    return true;
+}
+
+bool Threshold(Bitmap *bmp, int level)
+{
+    if (!IsFilterable(bmp))
+        return false;
+
+    const int width = bmp->GetWidth(), height = bmp->GetHeight();
+    const ChannelShifts sh;
+    const uint32_t alpha_mask = 0xFFu << sh.A;
+    const uint32_t white = (0xFFu << sh.R) | (0xFFu << sh.G) | (0xFFu << sh.B);
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        // local copies, as the captured values could alias the written pixels
+        const int r_shift = sh.R, g_shift = sh.G, b_shift = sh.B;
+        const int row_width = width, min_luma = level;
+        const uint32_t a_mask = alpha_mask, on_color = white;
+        for (int y = y_from; y < y_to; ++y)
+        {
+            uint32_t *px = GetPixelRowForWriting(bmp, y);
+            for (int x = 0; x < row_width; ++x)
+            {
+                const uint32_t p = px[x];
+                // Integer approximation of the luma (0.299 R + 0.587 G + 0.114 B)
+                const int luma = static_cast<int>((((p >> r_shift) & 0xFF) * 77 +
+                    ((p >> g_shift) & 0xFF) * 150 + ((p >> b_shift) & 0xFF) * 29) >> 8);
+                px[x] = (p & a_mask) | (luma >= min_luma ? on_color : 0u);
+            }
+        }
+    });
+    return true;
+}
+
+bool HighPass(Bitmap *bmp, int radius)
+{
+    if (!IsFilterable(bmp) || radius < 0)
+        return false;
+
+    std::unique_ptr<Bitmap> blurred(BitmapHelper::CreateBitmapCopy(bmp));
+    if (!blurred || !GaussianBlur(blurred.get(), radius))
+        return false;
+
+    const int width = bmp->GetWidth(), height = bmp->GetHeight();
+    const ChannelShifts sh;
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels row(width), low(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            uint32_t *px = GetPixelRowForWriting(bmp, y);
+            UnpackRow(px, width, sh, row);
+            UnpackRow(GetPixelRow(blurred.get(), y), width, sh, low);
+            for (int c = 0; c < 3; ++c)
+            {
+                float *o = row.Ch[c];
+                const float *l = low.Ch[c];
+                for (int x = 0; x < width; ++x)
+                    o[x] = o[x] - l[x] + 128.f;
+            }
+            PackRow(px, width, sh, row);
+        }
+    });
+    return true;
+}
+
+// Separable blend functions, which take the backdrop (destination) and the
+// source colors in 0-1 range, and return the mixed color
+struct BlendNormal
+{
+    inline float operator()(float, float s) const { return s; }
+};
+
+struct BlendMultiply
+{
+    inline float operator()(float b, float s) const { return b * s; }
+};
+
+struct BlendScreen
+{
+    inline float operator()(float b, float s) const { return b + s - b * s; }
+};
+
+struct BlendHardLight
+{
+    inline float operator()(float b, float s) const
+    {
+        return s <= 0.5f ? b * 2.f * s : BlendScreen()(b, 2.f * s - 1.f);
+    }
+};
+
+struct BlendOverlay
+{
+    inline float operator()(float b, float s) const { return BlendHardLight()(s, b); }
+};
+
+struct BlendDarken
+{
+    inline float operator()(float b, float s) const { return std::min(b, s); }
+};
+
+struct BlendLighten
+{
+    inline float operator()(float b, float s) const { return std::max(b, s); }
+};
+
+struct BlendAdd
+{
+    inline float operator()(float b, float s) const { return std::min(b + s, 1.f); }
+};
+
+struct BlendSubtract
+{
+    inline float operator()(float b, float s) const { return std::max(b - s, 0.f); }
+};
+
+struct BlendDifference
+{
+    inline float operator()(float b, float s) const { return std::fabs(b - s); }
+};
+
+struct BlendExclusion
+{
+    inline float operator()(float b, float s) const { return b + s - 2.f * b * s; }
+};
+
+struct BlendColorDodge
+{
+    inline float operator()(float b, float s) const
+    {
+        const float q = b / std::max(1.f - s, 1e-6f);
+        return b <= 0.f ? 0.f : std::min(q, 1.f);
+    }
+};
+
+struct BlendColorBurn
+{
+    inline float operator()(float b, float s) const
+    {
+        const float q = (1.f - b) / std::max(s, 1e-6f);
+        return b >= 1.f ? 1.f : 1.f - std::min(q, 1.f);
+    }
+};
+
+struct BlendSoftLight
+{
+    inline float operator()(float b, float s) const
+    {
+        const float d = b <= 0.25f ? ((16.f * b - 12.f) * b + 4.f) * b : std::sqrt(b);
+        return s <= 0.5f ?
+            b - (1.f - 2.f * s) * b * (1.f - b) :
+            b + (2.f * s - 1.f) * (d - b);
+    }
+};
+
+// Mixes the source row with the destination row, using the blend function,
+// and composites the result over the destination;
+// opacity is an extra source alpha factor, in 0-1 range.
+template <typename TBlendFn>
+static void BlendRow(const RowChannels &src, RowChannels &dst, int width, float opacity)
+{
+    const TBlendFn blend_fn;
+    const float k = 1.f / 255.f;
+    const float MinAlpha = 1e-6f; // co is zero when ao is zero
+    const float *src_a = src.A;
+    float *dst_a = dst.A;
+    for (int c = 0; c < 3; ++c)
+    {
+        const float *src_c = src.Ch[c];
+        float *dst_c = dst.Ch[c];
+        for (int x = 0; x < width; ++x)
+        {
+            const float as = src_a[x] * k * opacity;
+            const float ab = dst_a[x] * k;
+            const float ao = as + ab * (1.f - as);
+            const float cs = src_c[x] * k;
+            const float cb = dst_c[x] * k;
+            const float co = as * (1.f - ab) * cs + as * ab * blend_fn(cb, cs) + (1.f - as) * ab * cb;
+            dst_c[x] = co * 255.f / (ao + MinAlpha);
+        }
+    }
+    for (int x = 0; x < width; ++x)
+    {
+        const float as = src_a[x] * k * opacity;
+        dst_a[x] += src_a[x] * opacity - as * dst_a[x];
+    }
+}
+
+template <typename TBlendFn>
+static void BlendRect(Bitmap *dst, const Bitmap *src, int dst_x, int dst_y,
+    const Rect &rc, float opacity)
+{
+    const int width = rc.GetWidth(), height = rc.GetHeight();
+    const ChannelShifts sh;
+    ForEachRows(width, height, [&](int y_from, int y_to)
+    {
+        RowChannels src_row(width), dst_row(width);
+        for (int y = y_from; y < y_to; ++y)
+        {
+            uint32_t *dst_px = GetPixelRowForWriting(dst, rc.Top + y) + rc.Left;
+            const uint32_t *src_px = GetPixelRow(src, rc.Top + y - dst_y) + (rc.Left - dst_x);
+            UnpackRow(src_px, width, sh, src_row);
+            UnpackRow(dst_px, width, sh, dst_row);
+            BlendRow<TBlendFn>(src_row, dst_row, width, opacity);
+            PackRow(dst_px, width, sh, dst_row);
+        }
+    });
+}
+
+bool Blend(Bitmap *dst, const Bitmap *src, int dst_x, int dst_y, ImageBlendMode mode, int alpha)
+{
+    if (!IsFilterable(dst) || !IsFilterable(src) ||
+        (mode < kImageBlend_Normal) || (mode >= kNumImageBlendModes))
+        return false;
+
+    const Rect rc(std::max(dst_x, 0), std::max(dst_y, 0),
+        std::min(dst_x + src->GetWidth(), dst->GetWidth()) - 1,
+        std::min(dst_y + src->GetHeight(), dst->GetHeight()) - 1);
+    if (rc.IsEmpty() || (alpha <= 0))
+        return true; // nothing to draw
+    const float opacity = std::min(alpha, 0xFF) / 255.f;
+
+    switch (mode)
+    {
+    case kImageBlend_Normal: BlendRect<BlendNormal>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Multiply: BlendRect<BlendMultiply>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Screen: BlendRect<BlendScreen>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Overlay: BlendRect<BlendOverlay>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Darken: BlendRect<BlendDarken>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Lighten: BlendRect<BlendLighten>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Add: BlendRect<BlendAdd>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Subtract: BlendRect<BlendSubtract>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Difference: BlendRect<BlendDifference>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_Exclusion: BlendRect<BlendExclusion>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_ColorDodge: BlendRect<BlendColorDodge>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_ColorBurn: BlendRect<BlendColorBurn>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_HardLight: BlendRect<BlendHardLight>(dst, src, dst_x, dst_y, rc, opacity); break;
+    case kImageBlend_SoftLight: BlendRect<BlendSoftLight>(dst, src, dst_x, dst_y, rc, opacity); break;
+    default: return false;
+    }
+    return true;
+}
+
+} // namespace ImageFilter
+
+} // namespace Common
+} // namespace AGS
@@ -0,0 +1,89 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Image filters: blurs, convolutions, color transforms and blend modes.
+//
+// All filters work with 32-bit ARGB bitmaps only, and modify the bitmap
+// in place. The pixels are processed as rows of separate float channels,
+// so that the inner loops may be vectorized by the compiler; large images
+// are split by rows among several threads.
+//
+//=============================================================================
+#ifndef __AGS_CN_GFX__IMAGE_FILTER_H
+#define __AGS_CN_GFX__IMAGE_FILTER_H
+
+#include "core/types.h"
+
+namespace AGS
+{
+namespace Common
+{
+
+class Bitmap;
+
+// Photoshop-style blend modes, which define how the source color is combined
+// with the destination color before the result is alpha-composited over it
+enum ImageBlendMode
+{
+    kImageBlend_Normal,
+    kImageBlend_Multiply,
+    kImageBlend_Screen,
+    kImageBlend_Overlay,
+    kImageBlend_Darken,
+    kImageBlend_Lighten,
+    kImageBlend_Add,
+    kImageBlend_Subtract,
+    kImageBlend_Difference,
+    kImageBlend_Exclusion,
+    kImageBlend_ColorDodge,
+    kImageBlend_ColorBurn,
+    kImageBlend_HardLight,
+    kImageBlend_SoftLight,
+    kNumImageBlendModes
+};
+
+namespace ImageFilter
+{
+    // Number of elements in a color matrix: 4 rows (R, G, B, A) of 5 factors,
+    // applied to the source R, G, B, A and a constant offset (in 0-255 range)
+    const int ColorMatrixSize = 20;
+    // Max width or height of a convolution kernel
+    const int MaxKernelSize = 15;
+
+    // Blurs the image by averaging each pixel with its neighbours within radius
+    bool BoxBlur(Bitmap *bmp, int radius);
+    // Blurs the image using gaussian weights, which fall to near zero at radius
+    bool GaussianBlur(Bitmap *bmp, int radius);
+    // Applies a convolution kernel to the color channels, adding bias to the
+    // result; alpha channel is kept. Kernel is given as rows of factors,
+    // and its width and height must be odd numbers not larger than MaxKernelSize.
+    bool Convolve(Bitmap *bmp, const float *kernel, int kernel_w, int kernel_h, float bias = 0.f);
+    // Transforms each pixel by the color matrix (see ColorMatrixSize)
+    bool ApplyColorMatrix(Bitmap *bmp, const float *matrix);
+    // Turns pixels with the brightness at or above level white, and the rest
+    // black; alpha channel is kept.
+    bool Threshold(Bitmap *bmp, int level);
+    // Subtracts a gaussian blur of given radius from the image, leaving the
+    // fine details over the neutral gray; alpha channel is kept.
+    bool HighPass(Bitmap *bmp, int radius);
+    // Blends the source image over the destination at the given position,
+    // using the blend mode and an extra opacity factor (0-255).
+    bool Blend(Bitmap *dst, const Bitmap *src, int dst_x, int dst_y,
+        ImageBlendMode mode, int alpha = 0xFF);
+} // namespace ImageFilter
+
+} // namespace Common
+} // namespace AGS
+
+#endif // __AGS_CN_GFX__IMAGE_FILTER_H
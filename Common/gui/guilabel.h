@@ -38,6 +38,9 @@ public:
     Rect CalcGraphicRect(bool clipped) override;
     void Draw(Bitmap *ds, int x = 0, int y = 0) override;
     void SetText(const String &text);
+    // Tells if the text resolved from the Text property (translated, with
+    // macros replaced) is different from the one that was last prepared for drawing
+    bool IsTextOutdated() const;
 
     // Serialization
     void ReadFromFile(Stream *in, GuiVersion gui_version) override;
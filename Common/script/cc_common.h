@@ -29,6 +29,7 @@
 #define SCOPT_LEFTTORIGHT 0x40   // left-to-right operator precedance
 #define SCOPT_OLDSTRINGS  0x80   // allow old-style strings
 #define SCOPT_UTF8        0x100  // UTF-8 text mode
+#define SCOPT_OPTIMIZE    0x200  // optimize compiled bytecode
 
 extern void ccSetOption(int, int);
 extern int ccGetOption(int);
@@ -0,0 +1,59 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <string.h>
+#include <memory>
+#include "gtest/gtest.h"
+#include "gfx/bitmap.h"
+
+using namespace AGS::Common;
+
+// Draws the thick line the old way, as a number of offset one-pixel lines
+static void DrawOffsetLines(Bitmap *bmp, const Line &ln, int thickness, color_t color)
+{
+    for (int i = 0; i < thickness; ++i)
+    {
+        const int xx = i - thickness / 2;
+        for (int j = 0; j < thickness; ++j)
+        {
+            const int yy = j - thickness / 2;
+            bmp->DrawLine(Line(ln.X1 + xx, ln.Y1 + yy, ln.X2 + xx, ln.Y2 + yy), color);
+        }
+    }
+}
+
+TEST(Bitmap, DrawThickLineMatchesOffsetLines) {
+    const int w = 64, h = 48;
+    std::unique_ptr<Bitmap> expect(BitmapHelper::CreateClearBitmap(w, h, 8));
+    std::unique_ptr<Bitmap> actual(BitmapHelper::CreateClearBitmap(w, h, 8));
+    uint32_t seed = 12345;
+    auto rand_coord = [&seed](int range)
+    {
+        seed = seed * 1103515245 + 12345;
+        // let some of the lines go past the bitmap's edges
+        return static_cast<int>((seed >> 16) % (range + 20)) - 10;
+    };
+    for (int test = 0; test < 500; ++test)
+    {
+        const Line ln(rand_coord(w), rand_coord(h), rand_coord(w), rand_coord(h));
+        const int thickness = test % 8;
+        SCOPED_TRACE(::testing::Message() << "line " << ln.X1 << "," << ln.Y1 << " - "
+            << ln.X2 << "," << ln.Y2 << ", thickness " << thickness);
+        expect->ClearTransparent();
+        actual->ClearTransparent();
+        DrawOffsetLines(expect.get(), ln, thickness, 15);
+        actual->DrawThickLine(ln, thickness, 15);
+        for (int y = 0; y < h; ++y)
+            ASSERT_EQ(0, memcmp(expect->GetScanLine(y), actual->GetScanLine(y), w));
+    }
+}
@@ -0,0 +1,114 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include "gtest/gtest.h"
+#include "gfx/bitmap.h"
+#include "gfx/bitmappool.h"
+
+using namespace AGS::Common;
+
+static bool IsAligned(const void *ptr)
+{
+    return (reinterpret_cast<uintptr_t>(ptr) % BitmapPool::BufferAlignment) == 0;
+}
+
+TEST(BitmapPool, AllocateAligned) {
+    BitmapPool::Clear();
+    for (size_t size : { 1u, 100u, 256u, 257u, 1000u, 65536u, 100000u })
+    {
+        uint8_t *buf = BitmapPool::Allocate(size);
+        ASSERT_NE(buf, nullptr);
+        ASSERT_TRUE(IsAligned(buf));
+        // the whole requested size must be writable
+        buf[0] = 1;
+        buf[size - 1] = 1;
+        BitmapPool::Free(buf);
+    }
+    BitmapPool::Clear();
+}
+
+TEST(BitmapPool, ReuseSameClass) {
+    BitmapPool::SetMaxPooledSize(BitmapPool::DefaultMaxPooledSize);
+    BitmapPool::Clear();
+    BitmapPool::ResetStats();
+
+    uint8_t *buf1 = BitmapPool::Allocate(1000);
+    BitmapPool::Free(buf1);
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 1u);
+    // a slightly different size falls into the same class
+    uint8_t *buf2 = BitmapPool::Allocate(990);
+    ASSERT_EQ(buf2, buf1);
+    // a much larger size requires a new buffer
+    uint8_t *buf3 = BitmapPool::Allocate(5000);
+    ASSERT_NE(buf3, buf1);
+
+    const auto stats = BitmapPool::GetStats();
+    ASSERT_EQ(stats.Hits, 1u);
+    ASSERT_EQ(stats.Misses, 2u);
+    ASSERT_EQ(stats.PooledCount, 0u);
+    ASSERT_EQ(stats.PooledSize, 0u);
+    BitmapPool::Free(buf2);
+    BitmapPool::Free(buf3);
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 2u);
+    BitmapPool::Clear();
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 0u);
+    ASSERT_EQ(BitmapPool::GetStats().PooledSize, 0u);
+}
+
+TEST(BitmapPool, SizeLimit) {
+    BitmapPool::Clear();
+    BitmapPool::ResetStats();
+    BitmapPool::SetMaxPooledSize(0u);
+
+    uint8_t *buf = BitmapPool::Allocate(1000);
+    BitmapPool::Free(buf);
+    auto stats = BitmapPool::GetStats();
+    ASSERT_EQ(stats.PooledCount, 0u);
+    ASSERT_EQ(stats.Rejects, 1u);
+
+    // lowering the limit frees the kept buffers
+    BitmapPool::SetMaxPooledSize(BitmapPool::DefaultMaxPooledSize);
+    BitmapPool::Free(BitmapPool::Allocate(1000));
+    BitmapPool::Free(BitmapPool::Allocate(100000));
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 2u);
+    BitmapPool::SetMaxPooledSize(2000u);
+    stats = BitmapPool::GetStats();
+    ASSERT_EQ(stats.PooledCount, 1u);
+    ASSERT_LE(stats.PooledSize, 2000u);
+
+    BitmapPool::SetMaxPooledSize(BitmapPool::DefaultMaxPooledSize);
+    BitmapPool::Clear();
+}
+
+TEST(BitmapPool, BitmapReusesPixels) {
+    BitmapPool::SetMaxPooledSize(BitmapPool::DefaultMaxPooledSize);
+    BitmapPool::Clear();
+    BitmapPool::ResetStats();
+
+    std::unique_ptr<Bitmap> bmp(new Bitmap(33, 17, 32));
+    const uint8_t *data = bmp->GetData();
+    ASSERT_TRUE(IsAligned(data));
+    bmp.reset();
+    bmp.reset(new Bitmap(33, 17, 32));
+    ASSERT_EQ(bmp->GetData(), data);
+    ASSERT_EQ(BitmapPool::GetStats().Hits, 1u);
+
+    // a sub-bitmap does not own the pixels
+    std::unique_ptr<Bitmap> sub(new Bitmap(bmp.get(), RectWH(1, 1, 10, 10)));
+    sub.reset();
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 0u);
+    bmp.reset();
+    ASSERT_EQ(BitmapPool::GetStats().PooledCount, 1u);
+    BitmapPool::Clear();
+}
@@ -0,0 +1,172 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <string.h>
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gfx/bitmap.h"
+#include "util/compress.h"
+#include "util/memory_compat.h"
+#include "util/memorystream.h"
+
+using namespace AGS::Common;
+
+// Makes an image with smooth gradients and some noise over them,
+// so that the "sub" filter has something to work with
+static std::unique_ptr<Bitmap> CreateTestImage(int w, int h, int color_depth)
+{
+    std::unique_ptr<Bitmap> bmp(BitmapHelper::CreateBitmap(w, h, color_depth));
+    const int bpp = bmp->GetBPP();
+    uint32_t seed = 12345;
+    for (int y = 0; y < h; ++y)
+    {
+        uint8_t *row = bmp->GetScanLineForWriting(y);
+        for (int x = 0; x < w * bpp; ++x)
+        {
+            seed = seed * 1103515245 + 12345;
+            row[x] = static_cast<uint8_t>(x / bpp + y * 2 + (x % bpp) * 40 + ((seed >> 16) & 0x3));
+        }
+    }
+    return bmp;
+}
+
+// Writes the image in the deflate bitmap format without any pixel filter
+// (save_deflate_bitmap always uses "sub" filter for hi-color images)
+static void SaveDeflateUnfiltered(Stream *out, const Bitmap *bmp)
+{
+    const int w = bmp->GetWidth(), h = bmp->GetHeight(), bpp = bmp->GetBPP();
+    out->WriteInt32(w);
+    out->WriteInt32(h);
+    out->WriteInt8(bpp);
+    out->WriteInt8(0); // no filter
+    out->WriteInt8(0); // no palette
+    out->WriteInt8(0); // reserved
+    std::vector<uint8_t> buf(w * h * bpp);
+    for (int y = 0; y < h; ++y)
+        memcpy(&buf[y * w * bpp], bmp->GetScanLine(y), w * bpp);
+    std::vector<uint8_t> packed;
+    {
+        Stream mem_out(std::make_unique<VectorStream>(packed, kStream_Write));
+        ASSERT_TRUE(deflate_compress(buf.data(), buf.size(), bpp, &mem_out));
+    }
+    out->WriteInt32(static_cast<int32_t>(packed.size()));
+    out->Write(packed.data(), packed.size());
+}
+
+static void AssertImagesEqual(const Bitmap *expect, const Bitmap *actual)
+{
+    ASSERT_NE(actual, nullptr);
+    ASSERT_EQ(expect->GetWidth(), actual->GetWidth());
+    ASSERT_EQ(expect->GetHeight(), actual->GetHeight());
+    ASSERT_EQ(expect->GetColorDepth(), actual->GetColorDepth());
+    const size_t row_sz = expect->GetWidth() * expect->GetBPP();
+    for (int y = 0; y < expect->GetHeight(); ++y)
+        ASSERT_EQ(0, memcmp(expect->GetScanLine(y), actual->GetScanLine(y), row_sz));
+}
+
+TEST(Compress, DeflateBitmapRoundTrip) {
+    const int depths[] = { 8, 16, 32 };
+    for (int depth : depths)
+    {
+        SCOPED_TRACE(depth);
+        auto bmp = CreateTestImage(37, 23, depth);
+        std::vector<uint8_t> membuf;
+        {
+            Stream out(std::make_unique<VectorStream>(membuf, kStream_Write));
+            save_deflate_bitmap(&out, bmp.get());
+        }
+        Stream in(std::make_unique<VectorStream>(membuf));
+        auto loaded = load_deflate_bitmap(&in);
+        AssertImagesEqual(bmp.get(), loaded.get());
+        ASSERT_EQ(static_cast<soff_t>(membuf.size()), in.GetPosition());
+    }
+}
+
+TEST(Compress, DeflateBitmapUnfiltered) {
+    const int depths[] = { 8, 16, 32 };
+    for (int depth : depths)
+    {
+        SCOPED_TRACE(depth);
+        auto bmp = CreateTestImage(37, 23, depth);
+        std::vector<uint8_t> membuf;
+        {
+            Stream out(std::make_unique<VectorStream>(membuf, kStream_Write));
+            SaveDeflateUnfiltered(&out, bmp.get());
+        }
+        Stream in(std::make_unique<VectorStream>(membuf));
+        auto loaded = load_deflate_bitmap(&in);
+        AssertImagesEqual(bmp.get(), loaded.get());
+    }
+}
+
+TEST(Compress, DeflateBitmapPalette) {
+    RGB pal[256];
+    for (int i = 0; i < 256; ++i)
+    {
+        pal[i].r = i / 4;
+        pal[i].g = 63 - i / 4;
+        pal[i].b = i % 64;
+    }
+    auto bmp = CreateTestImage(16, 16, 8);
+    std::vector<uint8_t> membuf;
+    {
+        Stream out(std::make_unique<VectorStream>(membuf, kStream_Write));
+        save_deflate_bitmap(&out, bmp.get(), &pal);
+    }
+    RGB loaded_pal[256];
+    Stream in(std::make_unique<VectorStream>(membuf));
+    auto loaded = load_deflate_bitmap(&in, &loaded_pal);
+    AssertImagesEqual(bmp.get(), loaded.get());
+    for (int i = 0; i < 256; ++i)
+    {
+        ASSERT_EQ(pal[i].r, loaded_pal[i].r);
+        ASSERT_EQ(pal[i].g, loaded_pal[i].g);
+        ASSERT_EQ(pal[i].b, loaded_pal[i].b);
+    }
+}
+
+TEST(Compress, DeflateBitmapTruncated) {
+    auto bmp = CreateTestImage(37, 23, 32);
+    std::vector<uint8_t> membuf;
+    {
+        Stream out(std::make_unique<VectorStream>(membuf, kStream_Write));
+        save_deflate_bitmap(&out, bmp.get());
+    }
+    // header: width, height, bpp, filter, has palette, reserved, compressed size
+    const size_t header_sz = 4 + 4 + 1 + 1 + 1 + 1 + 4;
+    ASSERT_GT(membuf.size(), header_sz + 16);
+
+    // Stream ends before the compressed data does
+    {
+        std::vector<uint8_t> cut(membuf.begin(), membuf.end() - 16);
+        Stream in(std::make_unique<VectorStream>(cut));
+        PackedImage packed;
+        ASSERT_FALSE(read_deflate_packed(&in, packed));
+        Stream in2(std::make_unique<VectorStream>(cut));
+        ASSERT_EQ(nullptr, load_deflate_bitmap(&in2));
+    }
+    // Compressed data itself is cut, with its size changed to match
+    {
+        const size_t comp_sz = (membuf.size() - header_sz) / 2;
+        std::vector<uint8_t> cut(membuf.begin(), membuf.begin() + header_sz + comp_sz);
+        cut[header_sz - 4] = static_cast<uint8_t>(comp_sz);
+        cut[header_sz - 3] = static_cast<uint8_t>(comp_sz >> 8);
+        cut[header_sz - 2] = static_cast<uint8_t>(comp_sz >> 16);
+        cut[header_sz - 1] = static_cast<uint8_t>(comp_sz >> 24);
+        Stream in(std::make_unique<VectorStream>(cut));
+        PackedImage packed;
+        ASSERT_TRUE(read_deflate_packed(&in, packed));
+        ASSERT_EQ(nullptr, unpack_image(packed));
+    }
+}
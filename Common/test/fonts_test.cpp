@@ -0,0 +1,188 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "core/platform.h"
+#include "ac/game_version.h"
+#include "ac/gamestructdefines.h"
+#include "core/assetmanager.h"
+#include "font/agsfontrenderer.h"
+#include "font/fonts.h"
+#include "util/file.h"
+#include "util/stream.h"
+#include "util/utf8.h"
+
+using namespace AGS::Common;
+
+// Symbols that the font module expects from the program
+GameDataVersion loaded_game_file_version = kGameVersion_Current;
+bool ShouldAntiAliasText()
+{
+    return false;
+}
+void quit(const char *)
+{
+    // do nothing
+}
+
+#if (AGS_PLATFORM_TEST_FILE_IO)
+
+static const char *DummyFontFile = "agsfnt0.wfn";
+
+// Writes a WFN font with 256 characters of varied width
+static void WriteDummyWFNFont(const char *filename)
+{
+    const int CharCount = 256;
+    const int CharHeight = 1;
+    std::vector<int16_t> widths(CharCount);
+    for (int i = 0; i < CharCount; ++i)
+        widths[i] = static_cast<int16_t>(1 + (i * 37) % 9);
+
+    auto out = File::CreateFile(filename);
+    ASSERT_TRUE(out);
+    out->Write("WGT Font File  ", 15);
+    size_t data_sz = 0;
+    for (int i = 0; i < CharCount; ++i)
+        data_sz += sizeof(int16_t) * 2 + (widths[i] + 7) / 8 * CharHeight;
+    const size_t data_off = 15 + sizeof(uint16_t);
+    out->WriteInt16(static_cast<int16_t>(data_off + data_sz));
+    std::vector<int16_t> offsets(CharCount);
+    size_t off = data_off;
+    for (int i = 0; i < CharCount; ++i)
+    {
+        offsets[i] = static_cast<int16_t>(off);
+        out->WriteInt16(widths[i]);
+        out->WriteInt16(CharHeight);
+        const size_t pixel_sz = (widths[i] + 7) / 8 * CharHeight;
+        for (size_t b = 0; b < pixel_sz; ++b)
+            out->WriteInt8(0x55);
+        off += sizeof(int16_t) * 2 + pixel_sz;
+    }
+    out->WriteArrayOfInt16(offsets.data(), CharCount);
+}
+
+// Plugin-like renderer which passes all calls to another renderer;
+// split_lines measures the whole line with such renderers.
+class PassThroughFontRenderer : public IAGSFontRenderer
+{
+public:
+    PassThroughFontRenderer(IAGSFontRenderer *base) : _base(base) {}
+
+    bool LoadFromDisk(int fontNumber, int fontSize) override { return _base->LoadFromDisk(fontNumber, fontSize); }
+    void FreeMemory(int fontNumber) override { _base->FreeMemory(fontNumber); }
+    bool SupportsExtendedCharacters(int fontNumber) override { return _base->SupportsExtendedCharacters(fontNumber); }
+    int GetTextWidth(const char *text, int fontNumber) override { return _base->GetTextWidth(text, fontNumber); }
+    int GetTextHeight(const char *text, int fontNumber) override { return _base->GetTextHeight(text, fontNumber); }
+    void RenderText(const char *text, int fontNumber, BITMAP *destination, int x, int y, int colour) override
+        { _base->RenderText(text, fontNumber, destination, x, y, colour); }
+    void AdjustYCoordinateForFont(int *ycoord, int fontNumber) override { _base->AdjustYCoordinateForFont(ycoord, fontNumber); }
+    void EnsureTextValidForFont(char *text, int fontNumber) override { _base->EnsureTextValidForFont(text, fontNumber); }
+
+private:
+    IAGSFontRenderer *_base;
+};
+
+class FontsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        _oldUFormat = get_uformat();
+        WriteDummyWFNFont(DummyFontFile);
+        _amgr.AddLibrary(".");
+        init_font_renderer(&_amgr);
+    }
+
+    void TearDown() override {
+        shutdown_font_renderer();
+        _amgr.RemoveAllLibraries();
+        File::DeleteFile(DummyFontFile);
+        set_uformat(_oldUFormat);
+    }
+
+    AssetManager _amgr;
+    int _oldUFormat = 0;
+};
+
+// Generates a random text of words with random characters
+static std::string MakeRandomText(std::mt19937 &rng, bool utf8)
+{
+    std::uniform_int_distribution<int> len_dist(0, 120);
+    std::uniform_int_distribution<int> kind_dist(0, 19);
+    std::uniform_int_distribution<int> lower_dist('a', 'z');
+    std::uniform_int_distribution<int> high_dist(128, utf8 ? 0x44F : 255);
+    std::string text;
+    const int len = len_dist(rng);
+    for (int i = 0; i < len; ++i)
+    {
+        int uch;
+        switch (kind_dist(rng))
+        {
+        case 0: case 1: case 2: uch = ' '; break;
+        case 3: uch = '\n'; break;
+        case 4: case 5: uch = high_dist(rng); break;
+        default: uch = lower_dist(rng); break;
+        }
+        char ch_buf[Utf8::UtfSz + 1]{};
+        usetc(ch_buf, uch);
+        text.append(ch_buf);
+    }
+    return text;
+}
+
+TEST_F(FontsTest, SplitLinesByAdvances) {
+    // Font 0 is measured by cached character advances; font 1 uses the same
+    // font data, but through a plugin renderer, which is measured by the
+    // whole line; font 2 is used as an outline font
+    FontInfo finfo;
+    ASSERT_TRUE(load_font_size(0, finfo));
+    ASSERT_TRUE(load_font_size(1, finfo));
+    ASSERT_TRUE(load_font_size(2, finfo));
+    IAGSFontRenderer *wfn_renderer = font_replace_renderer(1, static_cast<IAGSFontRenderer*>(nullptr));
+    PassThroughFontRenderer pass_renderer(wfn_renderer);
+    font_replace_renderer(1, &pass_renderer);
+
+    struct OutlineSetup { int Outline; int Thickness; };
+    const OutlineSetup outlines[] = {
+        { FONT_OUTLINE_NONE, 0 }, { FONT_OUTLINE_AUTO, 2 }, { 2, 0 } };
+
+    std::mt19937 rng(4321);
+    std::uniform_int_distribution<int> width_dist(5, 200);
+    SplitLines lines_ref, lines_test;
+    // Test both text formats, switching between them in turn
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        const bool utf8 = (pass % 2) == 0;
+        set_uformat(utf8 ? U_UTF8 : U_ASCII);
+        for (const auto &ol : outlines)
+        {
+            set_font_outline(0, ol.Outline, FontInfo::kSquared, ol.Thickness);
+            set_font_outline(1, ol.Outline, FontInfo::kSquared, ol.Thickness);
+            for (int test = 0; test < 200; ++test)
+            {
+                const std::string text = MakeRandomText(rng, utf8);
+                const int width = width_dist(rng);
+                const size_t count_ref = split_lines(text.c_str(), lines_ref, width, 1);
+                const size_t count = split_lines(text.c_str(), lines_test, width, 0);
+                ASSERT_EQ(count_ref, count) << "text: \"" << text << "\", width: " << width;
+                for (size_t i = 0; i < count; ++i)
+                    ASSERT_STREQ(lines_ref[i].GetCStr(), lines_test[i].GetCStr());
+            }
+        }
+    }
+
+    font_replace_renderer(1, wfn_renderer);
+}
+
+#endif // AGS_PLATFORM_TEST_FILE_IO
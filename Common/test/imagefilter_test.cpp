@@ -0,0 +1,94 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include "gtest/gtest.h"
+#include "gfx/bitmap.h"
+#include "gfx/image_filter.h"
+
+using namespace AGS::Common;
+
+// Common library expects the program to provide the AGS color conversion;
+// the tests only use colors already in the bitmap's format
+void __my_setcolor(int *ctset, int newcol, int /*wantColDep*/) {
+    ctset[0] = newcol;
+}
+
+static std::unique_ptr<Bitmap> CreateFilled(int w, int h, int color)
+{
+    return std::unique_ptr<Bitmap>(BitmapHelper::CreateClearBitmap(w, h, 32, color));
+}
+
+TEST(ImageFilter, BlurKeepsUniformImage) {
+    // Large enough to be split among threads
+    auto bmp = CreateFilled(300, 200, makeacol32(10, 100, 200, 255));
+    ASSERT_TRUE(ImageFilter::GaussianBlur(bmp.get(), 5));
+    ASSERT_TRUE(ImageFilter::BoxBlur(bmp.get(), 3));
+    for (int y = 0; y < bmp->GetHeight(); y += 13)
+        for (int x = 0; x < bmp->GetWidth(); x += 17)
+            ASSERT_EQ(makeacol32(10, 100, 200, 255), bmp->GetPixel(x, y));
+}
+
+TEST(ImageFilter, BlurIgnoresTransparentColor) {
+    // Transparent pixels must not bleed their color into the visible ones
+    auto bmp = CreateFilled(8, 1, makeacol32(255, 0, 255, 0));
+    bmp->PutPixel(3, 0, makeacol32(0, 0, 200, 255));
+    bmp->PutPixel(4, 0, makeacol32(0, 0, 200, 255));
+    ASSERT_TRUE(ImageFilter::BoxBlur(bmp.get(), 1));
+    const int px = bmp->GetPixel(2, 0);
+    ASSERT_EQ(0, getr32(px));
+    ASSERT_EQ(200, getb32(px));
+    ASSERT_EQ(85, geta32(px));
+    ASSERT_EQ(170, geta32(bmp->GetPixel(3, 0)));
+    ASSERT_EQ(0, geta32(bmp->GetPixel(0, 0)));
+}
+
+TEST(ImageFilter, ConvolveAndThreshold) {
+    auto bmp = CreateFilled(5, 5, makeacol32(0, 0, 0, 255));
+    bmp->PutPixel(2, 2, makeacol32(100, 100, 100, 255));
+    const float shift_left[3] = { 0.f, 0.f, 1.f };
+    ASSERT_TRUE(ImageFilter::Convolve(bmp.get(), shift_left, 3, 1, 20.f));
+    ASSERT_EQ(makeacol32(120, 120, 120, 255), bmp->GetPixel(1, 2));
+    ASSERT_EQ(makeacol32(20, 20, 20, 255), bmp->GetPixel(2, 2));
+    ASSERT_FALSE(ImageFilter::Convolve(bmp.get(), shift_left, 2, 1));
+
+    ASSERT_TRUE(ImageFilter::Threshold(bmp.get(), 100));
+    ASSERT_EQ(makeacol32(255, 255, 255, 255), bmp->GetPixel(1, 2));
+    ASSERT_EQ(makeacol32(0, 0, 0, 255), bmp->GetPixel(2, 2));
+}
+
+TEST(ImageFilter, ColorMatrix) {
+    auto bmp = CreateFilled(4, 4, makeacol32(10, 20, 30, 128));
+    // Swap red and blue, invert green, make opaque
+    const float matrix[ImageFilter::ColorMatrixSize] = {
+        0.f, 0.f, 1.f, 0.f, 0.f,
+        0.f, -1.f, 0.f, 0.f, 255.f,
+        1.f, 0.f, 0.f, 0.f, 0.f,
+        0.f, 0.f, 0.f, 0.f, 255.f };
+    ASSERT_TRUE(ImageFilter::ApplyColorMatrix(bmp.get(), matrix));
+    ASSERT_EQ(makeacol32(30, 235, 10, 255), bmp->GetPixel(3, 3));
+}
+
+TEST(ImageFilter, BlendModes) {
+    auto dst = CreateFilled(4, 4, makeacol32(200, 100, 0, 255));
+    auto src = CreateFilled(2, 2, makeacol32(128, 255, 255, 255));
+    ASSERT_TRUE(ImageFilter::Blend(dst.get(), src.get(), 3, -1, kImageBlend_Multiply));
+    ASSERT_EQ(makeacol32(100, 100, 0, 255), dst->GetPixel(3, 0));
+    ASSERT_EQ(makeacol32(200, 100, 0, 255), dst->GetPixel(3, 1));
+    ASSERT_TRUE(ImageFilter::Blend(dst.get(), src.get(), 0, 0, kImageBlend_Screen));
+    ASSERT_EQ(makeacol32(228, 255, 255, 255), dst->GetPixel(0, 0));
+    // Half-transparent source over transparent destination keeps its color
+    auto empty = CreateFilled(2, 2, makeacol32(0, 0, 0, 0));
+    ASSERT_TRUE(ImageFilter::Blend(empty.get(), src.get(), 0, 0, kImageBlend_Difference, 128));
+    ASSERT_EQ(makeacol32(128, 255, 255, 128), empty->GetPixel(1, 1));
+}
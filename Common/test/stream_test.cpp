@@ -13,6 +13,7 @@
 //=============================================================================
 #include <array>
 #include <memory>
+#include <random>
 #include <vector>
 #include "gtest/gtest.h"
 #include "util/bufferedstream.h"
@@ -266,6 +267,104 @@ TEST(Stream, DataStreamSection) {
     in.Close();
 }
 
+// Memory stream which returns less data than requested, at random
+class ShortReadStream : public VectorStream
+{
+public:
+    ShortReadStream(const std::vector<uint8_t> &cbuf, std::mt19937 &rng)
+        : VectorStream(cbuf), _rng(rng) {}
+
+    size_t Read(void *buffer, size_t size) override
+    {
+        std::uniform_int_distribution<size_t> dist(1, 300);
+        return VectorStream::Read(buffer, std::min(size, dist(_rng)));
+    }
+
+private:
+    std::mt19937 &_rng;
+};
+
+// Reference line reader, which reads one character at a time
+static bool ReadTextLineByChar(char *buf, Stream *in, size_t buf_len)
+{
+    if (buf_len == 0) return false;
+    for (size_t i = 0; i < buf_len - 1; ++i)
+    {
+        int c = in->ReadByte();
+        if (c < 0 || c == '\n') // EOF or LF
+        {
+            buf[i] = 0;
+            return true;
+        }
+        if (c == '\r') // CR or CRLF
+        {
+            c = in->ReadByte();
+            if (c >= 0 && c != '\n') in->Seek(-1, kSeekCurrent);
+            buf[i] = 0;
+            return true;
+        }
+        buf[i] = c;
+    }
+    buf[buf_len - 1] = 0;
+    return false;
+}
+
+TEST(Stream, ReadTextLine) {
+    char buf[8];
+    std::vector<uint8_t> text = { 'a', 'b', '\r', '\n', 'c', '\r', 'd', '\n', '\n', 'e' };
+    Stream in(std::make_unique<VectorStream>(text));
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("ab", buf);
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("c", buf);
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("d", buf);
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("", buf);
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("e", buf);
+    ASSERT_TRUE(in.EOS());
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, sizeof(buf)));
+    ASSERT_STREQ("", buf);
+    // Not enough buffer
+    in.Seek(0, kSeekBegin);
+    ASSERT_FALSE(StrUtil::ReadTextLine(buf, &in, 2));
+    ASSERT_STREQ("a", buf);
+    ASSERT_FALSE(StrUtil::ReadTextLine(buf, &in, 2));
+    ASSERT_STREQ("b", buf);
+    ASSERT_TRUE(StrUtil::ReadTextLine(buf, &in, 2));
+    ASSERT_STREQ("", buf);
+    ASSERT_EQ(4, in.GetPosition());
+}
+
+TEST(Stream, ReadTextLineRandom) {
+    // Compare with the char-by-char reader, over random texts with mixed
+    // linebreaks, random buffer sizes and random chunk boundaries
+    std::mt19937 rng(12345);
+    const char chars[] = { 'a', 'b', ' ', '\r', '\n' };
+    std::discrete_distribution<int> char_dist({ 40, 40, 10, 5, 5 });
+    std::uniform_int_distribution<size_t> text_len_dist(0, 3000);
+    std::uniform_int_distribution<size_t> buf_len_dist(2, 700);
+    std::vector<char> buf1(700), buf2(700);
+    for (int test = 0; test < 200; ++test)
+    {
+        std::vector<uint8_t> text(text_len_dist(rng));
+        for (auto &c : text)
+            c = chars[char_dist(rng)];
+        Stream ref_in(std::make_unique<VectorStream>(text));
+        Stream in(std::make_unique<ShortReadStream>(text, rng));
+        while (!ref_in.EOS())
+        {
+            const size_t buf_len = buf_len_dist(rng);
+            const bool ref_res = ReadTextLineByChar(buf1.data(), &ref_in, buf_len);
+            const bool res = StrUtil::ReadTextLine(buf2.data(), &in, buf_len);
+            ASSERT_EQ(ref_res, res);
+            ASSERT_STREQ(buf1.data(), buf2.data());
+            ASSERT_EQ(ref_in.GetPosition(), in.GetPosition());
+        }
+    }
+}
+
 #if (AGS_PLATFORM_TEST_FILE_IO)
 
 static const char *DummyFile = "dummy.dat";
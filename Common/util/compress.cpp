@@ -403,7 +403,7 @@ void save_lzw(Stream *out, const Bitmap *bmpp, const RGB (*pal)[256])
   out->Seek(toret, kSeekBegin);
 }
 
-std::unique_ptr<Bitmap> load_lzw(Stream *in, int dst_bpp, RGB (*pal)[256])
+bool read_lzw_packed(Stream *in, int dst_bpp, PackedImage &packed, RGB (*pal)[256])
 {
   // NOTE: old format saves full RGB struct here (4 bytes, including the filler)
   if (pal)
@@ -412,15 +412,25 @@ std::unique_ptr<Bitmap> load_lzw(Stream *in, int dst_bpp, RGB (*pal)[256])
     in->Seek(sizeof(RGB) * 256);
   const size_t uncomp_sz = in->ReadInt32();
   const size_t comp_sz = in->ReadInt32();
-  const soff_t end_pos = in->GetPosition() + comp_sz;
 
+  packed.Type = kPackedImage_LZW;
+  packed.Width = 0; // stored inside the compressed data
+  packed.Height = 0;
+  packed.BPP = dst_bpp;
+  packed.Filter = 0;
+  packed.UnpackedSize = uncomp_sz;
+  packed.Data.resize(comp_sz);
+  return in->Read(packed.Data.data(), comp_sz) == comp_sz;
+}
+
+static std::unique_ptr<Bitmap> unpack_lzw(const PackedImage &packed)
+{
   // First decompress data into the memory buffer
-  std::vector<uint8_t> inbuf(comp_sz);
-  std::vector<uint8_t> membuf(uncomp_sz);
-  in->Read(inbuf.data(), comp_sz);
-  lzwexpand(inbuf.data(), comp_sz, membuf.data(), uncomp_sz);
+  std::vector<uint8_t> membuf(packed.UnpackedSize);
+  lzwexpand(packed.Data.data(), packed.Data.size(), membuf.data(), membuf.size());
 
   // Open same buffer for reading and get params and pixels
+  const int dst_bpp = packed.BPP;
   Stream mem_in(std::make_unique<VectorStream>(membuf));
   int stride = mem_in.ReadInt32(); // width * bpp
   int height = mem_in.ReadInt32();
@@ -436,13 +446,17 @@ std::unique_ptr<Bitmap> load_lzw(Stream *in, int dst_bpp, RGB (*pal)[256])
   case 4: mem_in.ReadArrayOfInt32(reinterpret_cast<int32_t*>(bmp_data), num_pixels); break;
   default: assert(0); break;
   }
-
-  if (in->GetPosition() != end_pos)
-    in->Seek(end_pos, kSeekBegin);
-
   return bmm;
 }
 
+std::unique_ptr<Bitmap> load_lzw(Stream *in, int dst_bpp, RGB (*pal)[256])
+{
+  PackedImage packed;
+  if (!read_lzw_packed(in, dst_bpp, packed, pal))
+    return nullptr;
+  return unpack_lzw(packed);
+}
+
 //-----------------------------------------------------------------------------
 // Deflate
 //-----------------------------------------------------------------------------
@@ -507,10 +521,10 @@ bool z_inflate(const uint8_t* src, size_t src_sz, uint8_t* dst, size_t dst_sz) {
                 stream.next_out = dst + (dst_sz - stream.avail_out);
                 break;
         }
-    } while (stream.avail_out > 0);
+    } while (stream.avail_out > 0 && ret != Z_STREAM_END);
 
     (void)inflateEnd(&stream);
-    return true;
+    return stream.avail_out == 0;
 }
 
 bool deflate_compress(const uint8_t* data, size_t data_sz, int /*image_bpp*/, Stream* out)
@@ -525,3 +539,170 @@ bool inflate_decompress(uint8_t* data, size_t data_sz, int /*image_bpp*/, Stream
     in->Read(in_buf.data(), in_sz);
     return z_inflate(in_buf.data(), in_sz, data, data_sz);
 }
+
+// Deflate bitmap format:
+//   int32 width, int32 height, int8 bytes per pixel, int8 pixel filter,
+//   int8 has palette, int8 reserved;
+//   [256 x RGB (3 bytes each), if has palette];
+//   int32 compressed size, compressed pixel rows (little-endian).
+enum DeflatePixelFilter
+{
+  kDeflateFilter_None = 0,
+  // "Sub" filter stores each byte as a difference with the same byte of the
+  // previous pixel in a row, which makes smooth gradients pack much better
+  kDeflateFilter_Sub = 1
+};
+
+#if AGS_PLATFORM_ENDIAN_BIG
+static void swap_pixel_bytes(uint8_t *data, size_t num_pixels, int bpp)
+{
+  switch (bpp)
+  {
+  case 2:
+    for (int16_t *p = reinterpret_cast<int16_t*>(data), *end = p + num_pixels; p < end; ++p)
+      *p = BBOp::SwapBytesInt16(*p);
+    break;
+  case 4:
+    for (int32_t *p = reinterpret_cast<int32_t*>(data), *end = p + num_pixels; p < end; ++p)
+      *p = BBOp::SwapBytesInt32(*p);
+    break;
+  default: break;
+  }
+}
+#endif
+
+void save_deflate_bitmap(Stream *out, const Bitmap *bmp, const RGB (*pal)[256])
+{
+  const int w = bmp->GetWidth(), h = bmp->GetHeight(), bpp = bmp->GetBPP();
+  const int filter = (bpp > 1) ? kDeflateFilter_Sub : kDeflateFilter_None;
+  out->WriteInt32(w);
+  out->WriteInt32(h);
+  out->WriteInt8(bpp);
+  out->WriteInt8(filter);
+  out->WriteInt8(pal ? 1 : 0);
+  out->WriteInt8(0); // reserved
+  if (pal)
+  {
+    const RGB *ppal = *pal;
+    for (int i = 0; i < 256; ++i)
+    {
+      out->WriteInt8(ppal[i].r);
+      out->WriteInt8(ppal[i].g);
+      out->WriteInt8(ppal[i].b);
+    }
+  }
+
+  // Prepare the pixel rows for compression
+  const size_t row_sz = w * bpp;
+  std::vector<uint8_t> buf(row_sz * h);
+  for (int y = 0; y < h; ++y)
+  {
+    uint8_t *row = &buf[y * row_sz];
+    memcpy(row, bmp->GetScanLine(y), row_sz);
+#if AGS_PLATFORM_ENDIAN_BIG
+    swap_pixel_bytes(row, w, bpp);
+#endif
+    if (filter == kDeflateFilter_Sub)
+    {
+      for (size_t x = row_sz; x > (size_t)bpp; --x)
+        row[x - 1] -= row[x - 1 - bpp];
+    }
+  }
+
+  // reserve space for compressed size
+  soff_t cmpsz_at = out->GetPosition();
+  out->WriteInt32(0);
+  if (buf.size() > 0)
+    deflate_compress(buf.data(), buf.size(), bpp, out);
+  soff_t toret = out->GetPosition();
+  out->Seek(cmpsz_at, kSeekBegin);
+  soff_t compressed_sz = (toret - cmpsz_at) - sizeof(uint32_t);
+  out->WriteInt32(compressed_sz); // write compressed size
+  // seek back to the end of the output stream
+  out->Seek(toret, kSeekBegin);
+}
+
+bool read_deflate_packed(Stream *in, PackedImage &packed, RGB (*pal)[256])
+{
+  packed.Type = kPackedImage_Deflate;
+  packed.Width = in->ReadInt32();
+  packed.Height = in->ReadInt32();
+  packed.BPP = in->ReadInt8();
+  packed.Filter = in->ReadInt8();
+  const bool has_pal = in->ReadInt8() != 0;
+  in->ReadInt8(); // reserved
+  if (has_pal)
+  {
+    if (pal)
+    {
+      RGB *ppal = *pal;
+      for (int i = 0; i < 256; ++i)
+      {
+        ppal[i].r = in->ReadInt8();
+        ppal[i].g = in->ReadInt8();
+        ppal[i].b = in->ReadInt8();
+      }
+    }
+    else
+    {
+      in->Seek(3 * 256);
+    }
+  }
+
+  const size_t comp_sz = static_cast<uint32_t>(in->ReadInt32());
+  packed.UnpackedSize = 0;
+  if (packed.Width > 0 && packed.Height > 0 && packed.BPP > 0)
+    packed.UnpackedSize = packed.Width * packed.Height * packed.BPP;
+  packed.Data.resize(comp_sz);
+  return in->Read(packed.Data.data(), comp_sz) == comp_sz;
+}
+
+static std::unique_ptr<Bitmap> unpack_deflate(const PackedImage &packed)
+{
+  if (packed.UnpackedSize == 0)
+    return nullptr;
+  std::unique_ptr<Bitmap> bmp(BitmapHelper::CreateBitmap(packed.Width, packed.Height, packed.BPP * 8));
+  if (!bmp) return nullptr; // out of mem?
+
+  // Pixels are inflated right into the bitmap, then the filter is reverted in place
+  uint8_t *bmp_data = bmp->GetDataForWriting();
+  if (!z_inflate(packed.Data.data(), packed.Data.size(), bmp_data, packed.UnpackedSize))
+    return nullptr;
+  const int bpp = packed.BPP;
+  const size_t row_sz = packed.Width * bpp;
+  for (int y = 0; y < packed.Height; ++y)
+  {
+    uint8_t *row = bmp->GetScanLineForWriting(y);
+    if (packed.Filter == kDeflateFilter_Sub)
+    {
+      for (size_t x = bpp; x < row_sz; ++x)
+        row[x] += row[x - bpp];
+    }
+#if AGS_PLATFORM_ENDIAN_BIG
+    swap_pixel_bytes(row, packed.Width, bpp);
+#endif
+  }
+  return bmp;
+}
+
+std::unique_ptr<Bitmap> load_deflate_bitmap(Stream *in, RGB (*pal)[256])
+{
+  PackedImage packed;
+  if (!read_deflate_packed(in, packed, pal))
+    return nullptr;
+  return unpack_deflate(packed);
+}
+
+//-----------------------------------------------------------------------------
+// Packed images
+//-----------------------------------------------------------------------------
+
+std::unique_ptr<Bitmap> unpack_image(const PackedImage &packed)
+{
+  switch (packed.Type)
+  {
+  case kPackedImage_LZW: return unpack_lzw(packed);
+  case kPackedImage_Deflate: return unpack_deflate(packed);
+  default: assert(0); return nullptr;
+  }
+}
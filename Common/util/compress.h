@@ -44,5 +44,38 @@ std::unique_ptr<Common::Bitmap> load_lzw(Common::Stream *in, int dst_bpp, RGB (*
 // Deflate compression
 bool deflate_compress(const uint8_t* data, size_t data_sz, int image_bpp, Common::Stream* out);
 bool inflate_decompress(uint8_t* data, size_t data_sz, int image_bpp, Common::Stream* in, size_t in_sz);
+// Saves bitmap with an optional palette compressed by Deflate
+void save_deflate_bitmap(Common::Stream *out, const Common::Bitmap *bmp, const RGB (*pal)[256] = nullptr);
+// Loads bitmap compressed by Deflate, and an optional palette
+std::unique_ptr<Common::Bitmap> load_deflate_bitmap(Common::Stream *in, RGB (*pal)[256] = nullptr);
+
+// Packed image types
+enum PackedImageType
+{
+    kPackedImage_LZW,
+    kPackedImage_Deflate
+};
+
+// PackedImage contains compressed image data which was read from the stream,
+// but not unpacked yet. This lets to separate reading from the (slower)
+// decompression, which may be done later, and on any thread.
+struct PackedImage
+{
+    PackedImageType Type = kPackedImage_LZW;
+    int Width = 0; // NOTE: LZW image's size is only known after unpacking
+    int Height = 0;
+    int BPP = 0; // bytes per pixel
+    int Filter = 0; // pixel filter applied before compression
+    size_t UnpackedSize = 0;
+    std::vector<uint8_t> Data;
+};
+
+// Reads a LZW-compressed bitmap and an optional palette, without unpacking the pixels
+bool read_lzw_packed(Common::Stream *in, int dst_bpp, PackedImage &packed, RGB (*pal)[256] = nullptr);
+// Reads a Deflate-compressed bitmap and an optional palette, without unpacking the pixels
+bool read_deflate_packed(Common::Stream *in, PackedImage &packed, RGB (*pal)[256] = nullptr);
+// Unpacks previously read image data into the new bitmap;
+// this function does not use any shared state and is safe to call from any thread
+std::unique_ptr<Common::Bitmap> unpack_image(const PackedImage &packed);
 
 #endif // __AC_COMPRESS_H
@@ -197,8 +197,9 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz)
   if (dst_sz == 0)
     return false; // nowhere to expand to
 
-  lzbuffer = (uint8_t *)malloc(N);
-  if (lzbuffer == nullptr) {
+  // NOTE: using a local buffer makes expanding safe to run on multiple threads
+  uint8_t *ringbuf = (uint8_t *)malloc(N);
+  if (ringbuf == nullptr) {
     return false; // not enough memory
   }
   i = N - F;
@@ -224,13 +225,13 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz)
           break; // not enough dest buffer
 
         while (len--) {
-          *(dst_ptr++) = (lzbuffer[i] = lzbuffer[j]);
+          *(dst_ptr++) = (ringbuf[i] = ringbuf[j]);
           j = (j + 1) & (N - 1);
           i = (i + 1) & (N - 1);
         }
       } else {
         ch = *(src_ptr++);
-        *(dst_ptr++) = (lzbuffer[i] = static_cast<uint8_t>(ch));
+        *(dst_ptr++) = (ringbuf[i] = static_cast<uint8_t>(ch));
         i = (i + 1) & (N - 1);
       }
 
@@ -241,6 +242,6 @@ bool lzwexpand(const uint8_t *src, size_t src_sz, uint8_t *dst, size_t dst_sz)
     } // end for mask
   }
 
-  free(lzbuffer);
+  free(ringbuf);
   return (src_ptr - src) == src_sz;
 }
@@ -12,6 +12,7 @@
 //
 //=============================================================================
 #include "util/string_utils.h"
+#include <algorithm>
 #include <errno.h>
 #include <regex>
 #include <string.h>
@@ -222,6 +223,56 @@ void StrUtil::ReadCStrCount(char *buf, Stream *in, size_t count)
     buf[count - 1] = 0; // for safety
 }
 
+bool StrUtil::ReadTextLine(char *buf, Stream *in, size_t buf_len)
+{
+    if (buf_len == 0) return false;
+    // The text is read by chunks, which are scanned for the linebreak;
+    // the stream is then rewound to the first character past the line's end.
+    const size_t ReadChunkSize = 256u;
+    const size_t max_len = buf_len - 1;
+    size_t len = 0;
+    while (len < max_len)
+    {
+        char *chunk = buf + len;
+        size_t read_sz = in->Read(chunk, std::min(max_len - len, ReadChunkSize));
+        if (read_sz == 0) // EOF
+        {
+            buf[len] = 0;
+            return true;
+        }
+        // Find the first LF or CR, whichever comes first
+        const char *lf = static_cast<const char*>(memchr(chunk, '\n', read_sz));
+        const char *cr = static_cast<const char*>(memchr(chunk, '\r', lf ? (lf - chunk) : read_sz));
+        const char *brk = cr ? cr : lf;
+        if (!brk)
+        {
+            len += read_sz;
+            continue;
+        }
+
+        size_t used_sz = (brk - chunk) + 1;
+        buf[len + (brk - chunk)] = 0;
+        if (brk == cr) // CR or CRLF
+        {
+            // Look for '\n', but it may be missing, which is also a valid case
+            if (used_sz < read_sz)
+            {
+                if (chunk[used_sz] == '\n') used_sz++;
+            }
+            else
+            {
+                int c = in->ReadByte();
+                if (c >= 0 && c != '\n') in->Seek(-1, kSeekCurrent);
+            }
+        }
+        if (used_sz < read_sz)
+            in->Seek(-static_cast<soff_t>(read_sz - used_sz), kSeekCurrent);
+        return true;
+    }
+    buf[max_len] = 0;
+    return false; // not enough buffer
+}
+
 char *StrUtil::ReadMallocCStrOrNull(Stream *in)
 {
     char buf[1024];
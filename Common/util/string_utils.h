@@ -77,6 +77,12 @@ namespace StrUtil
     // Reads N characters into the provided buffer.
     // Guarantees that output buffer will contain a null-terminator.
     void            ReadCStrCount(char *buf, Stream *in, size_t count);
+    // Reads a line of text until a linebreak (LF, CR or CRLF) is met, or the
+    // buffer is filled; the linebreak is consumed but not written to buffer.
+    // Returns whether reached the end of line or stream (false if not enough
+    // buffer). Guarantees that output buffer will contain a null-terminator.
+    // Reads the stream by chunks, so the stream must support seeking back.
+    bool            ReadTextLine(char *buf, Stream *in, size_t buf_len);
     // Reads a null-terminated string and !! mallocs !! a char buffer for it;
     // returns nullptr if the read string is empty.
     // Buffer is hard-limited to 1024 bytes, including null-terminator.
@@ -98,6 +98,7 @@ void CompilerOptions::PrintToStdout() const {
     if (Flags.EnforceNewStrings) printf("EnforceNewStrings; ");
     if (Flags.EnforceNewAudio) printf("EnforceNewAudio; ");
     if (Flags.UseOldCustomDialogOptionsAPI) printf("UseOldCustomDialogOptionsAPI; ");
+    if (Flags.Optimize) printf("Optimize; ");
     if(DebugMode) printf("\nDebugMode\n");
 }
 
@@ -182,6 +183,7 @@ int Compile(const CompilerOptions& comp_opts)
 
     ccSetOption(SCOPT_LEFTTORIGHT, comp_opts.Flags.LeftToRightPrecedence);
     ccSetOption(SCOPT_OLDSTRINGS, !comp_opts.Flags.EnforceNewStrings);
+    ccSetOption(SCOPT_OPTIMIZE, comp_opts.Flags.Optimize);
 
     ccRemoveDefaultHeaders();
 
@@ -38,6 +38,7 @@ class CompilerOptions{
         bool EnforceNewStrings = true;        // do not allow old-style strings
         bool EnforceNewAudio = true;
         bool UseOldCustomDialogOptionsAPI = false;
+        bool Optimize = false;                // optimize compiled bytecode
     };
 
     struct ScriptAPI {
@@ -41,6 +41,7 @@ const char *HELP_STRING = R"EOS(Usage: agscc [options] <INPUT.asc>
 -fforcenewstrings[=0]        Enforce new strings                    (default:1)
 -fforcenewaudio[=0]          Enforce new audio system               (default:1)
 -foldcustomdialogopt[=0]     Use old custom dialog API
+-foptimize[=0]               Optimize compiled bytecode
 -g                           Generate debug information
 --tell-api-versions          Returns supported Script API Versions
 -o <OUT.o>, --output <OUT.o> Place output in specified file.  (default:INPUT.o)
@@ -236,6 +237,10 @@ ParsedOptions parser_to_compiler_opts(const ParseResult& parseResult)
                 compilerOptions.Flags.UseOldCustomDialogOptionsAPI = flag_value;
                 continue;
             }
+            if(flag_name == "optimize") {
+                compilerOptions.Flags.Optimize = flag_value;
+                continue;
+            }
         }
     }
 
@@ -25,11 +25,18 @@ bool MacroTable::contains(const String &name) {
     return _macro_table.count(name) > 0;
 }
 String MacroTable::get_macro(const String &name) {
-    if(_macro_table.count(name)) {
-        return _macro_table[name];
+    auto it = _macro_table.find(name);
+    if (it != _macro_table.end()) {
+        return it->second;
     }
     return nullptr;
 }
+const String *MacroTable::find(const char *name, size_t len) {
+    _lookup_name.assign(name, name + len);
+    _lookup_name.push_back(0);
+    auto it = _macro_table.find(String::Wrapper(_lookup_name.data()));
+    return (it != _macro_table.end()) ? &it->second : nullptr;
+}
 void MacroTable::add(const String &macroname, const String &value) {
     if (this->contains(macroname)) {
         cc_error("macro '%s' already defined",macroname.GetCStr());
@@ -14,17 +14,25 @@
 #ifndef __CC_MACROTABLE_H
 #define __CC_MACROTABLE_H
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 #include "util/string.h"
+#include "util/string_types.h"
 
 typedef AGS::Common::String AGString;
 
 struct MacroTable {
 private:
-    std::map<AGString,AGString> _macro_table;
+    std::unordered_map<AGString,AGString> _macro_table;
+    // null-terminated copy of the name being looked up by find()
+    std::vector<char> _lookup_name;
 public:
     bool contains(const AGString &name);
     AGString get_macro(const AGString &name) ;
+    // Looks up a macro by the name given as a range of characters;
+    // returns its value, or nullptr if there's no such macro.
+    // The returned pointer is valid until the macro is removed.
+    const AGString *find(const char *name, size_t len);
     void add(const AGString &macroname, const AGString &value);
     void remove(AGString &macroname);
     void merge(MacroTable & macro_table);
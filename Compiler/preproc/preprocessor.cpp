@@ -13,11 +13,10 @@
 //=============================================================================
 #include <algorithm>
 #include <cctype>
+#include <string.h>
 #include "script/cs_parser_common.h"
 #include "preproc/preprocessor.h"
 #include "script/cc_common.h"
-#include "util/textstreamwriter.h"
-#include "util/textreader.h"
 
 #define STRINGIFY2(X) #X
 #define STRINGIFY(X) STRINGIFY2(X)
@@ -37,79 +36,60 @@ namespace Preprocessor {
     static const char * li_end = "\n";
 #endif
 
-    size_t FindIndexOfMatchingCharacter(String text, size_t indexOfFirstSpeechMark, int charToMatch)
+    struct StrView
     {
-        size_t endOfString = NOT_FOUND;
-        size_t checkFrom = indexOfFirstSpeechMark + 1;
-        for (size_t i = checkFrom; i < text.GetLength(); i++)
+        const char *Ptr = nullptr;
+        size_t Len = 0;
+
+        StrView() = default;
+        StrView(const char *ptr, size_t len) : Ptr(ptr), Len(len) {}
+        StrView(const String &str) : Ptr(str.GetCStr()), Len(str.GetLength()) {}
+
+        char operator[](size_t index) const { return Ptr[index]; }
+        bool operator==(const char *cstr) const
         {
-            if (text[i] == '\\')
-            {
-                i++;  // ignore next char
-            }
-            else if (text[i] == charToMatch)
-            {
-                endOfString = i;
-                break;
-            }
+            return (strncmp(Ptr, cstr, Len) == 0) && (cstr[Len] == 0);
         }
+        bool operator!=(const char *cstr) const { return !(*this == cstr); }
 
-        return endOfString;
-    }
+        bool EndsWith(const char *cstr) const
+        {
+            size_t len = strlen(cstr);
+            return (Len >= len) && (strncmp(Ptr + Len - len, cstr, len) == 0);
+        }
 
-    class StringBuilder : TextWriter {
-    private:
-        String _str = nullptr;
-    public:
-        explicit StringBuilder(size_t size) {
-            _str.Reserve(size);
+        void ClipLeft(size_t count)
+        {
+            count = std::min(count, Len);
+            Ptr += count;
+            Len -= count;
         }
 
-        void WriteLine(const String& str) override { _str.Append(str); _str.Append(li_end); }
-        bool IsValid() const override { return true; }
-        void WriteChar(char c) override {  _str.AppendChar(c); }
-        void WriteString(const String &str) override { _str.Append(str);}
-        void WriteFormat(const char *fmt, ...) override { va_list argptr; va_start(argptr, fmt); _str.Append(String::FromFormatV(fmt, argptr)); va_end(argptr);}
-        void WriteLineBreak() override { _str.Append(li_end); }
+        void Trim()
+        {
+            for (; (Len > 0) && std::isspace(static_cast<uint8_t>(*Ptr)); ++Ptr, --Len);
+            for (; (Len > 0) && std::isspace(static_cast<uint8_t>(Ptr[Len - 1])); --Len);
+        }
 
-        String GetString () {return _str;}
+        String ToString() const { return String(Ptr, Len); }
     };
 
-    class StringReader : TextReader{
-    private:
-        String _str = nullptr;
-        size_t _idx = 0;
-    public:
-        StringReader(const String& str) {
-            _str = str;
-            _idx = 0;
-        }
-
-        bool IsValid() const override { return _idx < _str.GetLength(); }
-        char ReadChar() override { return _str.GetAt(_idx++); }
-        String ReadString(size_t length) override { String res = _str.Mid(_idx, length); _idx+=res.GetLength(); return res;}
-        String ReadLine() override {
-            if(_idx >= _str.GetLength()) return nullptr;
-
-            size_t newPos = _str.FindChar('\n', _idx);
-            if(newPos != NOT_FOUND) {
-                size_t length = newPos - _idx;
-                size_t idx = _idx;
-                _idx = newPos+1;
-                if (length == 0) return String("");
-                return _str.Mid(idx,length);
-            } else {
-                return ReadAll();
+    static size_t FindIndexOfMatchingCharacter(const StrView &text, size_t indexOfFirstSpeechMark, int charToMatch)
+    {
+        for (size_t i = indexOfFirstSpeechMark + 1; i < text.Len; i++)
+        {
+            if (text[i] == '\\')
+            {
+                i++;  // ignore next char
+            }
+            else if (text[i] == charToMatch)
+            {
+                return i;
             }
         }
-        String ReadAll() override { size_t idx = _idx; _idx = _str.GetLength(); return _str.Mid(idx, _str.GetLength() - idx); }
-    };
-
-    static bool Contains(const std::vector<String> &v, const String &s) {
-        return std::find(v.rbegin(), v.rend(), s) != v.rend();
+        return NOT_FOUND;
     }
 
-
     void Preprocessor::LogError(ErrorCode error, const String& message) {
         if(message == nullptr) {
             switch (error) {
@@ -141,12 +121,12 @@ namespace Preprocessor {
         }
     }
 
-    void Preprocessor::ProcessConditionalDirective(String &directive, String &line)
+    void Preprocessor::ProcessConditionalDirective(const StrView &directive, StrView &line)
     {
-        String macroName = GetNextWord(line, true, true);
-        if (macroName.GetLength() == 0)
+        StrView macroName = GetNextWord(line, true, true);
+        if (macroName.Len == 0)
         {
-            LogError(ErrorCode::MacroNameMissing, String::FromFormat("Expected something after '%s'", directive.GetCStr()));
+            LogError(ErrorCode::MacroNameMissing, String::FromFormat("Expected something after '%s'", directive.ToString().GetCStr()));
             return;
         }
 
@@ -156,9 +136,9 @@ namespace Preprocessor {
         {
             includeCodeBlock = false;
         }
-        else if (directive.CompareRight("def") == 0)
+        else if (directive.EndsWith("def"))
         {
-            includeCodeBlock = _macros.contains(macroName.GetCStr());
+            includeCodeBlock = _macros.find(macroName.Ptr, macroName.Len) != nullptr;
             if (directive == "ifndef")
             {
                 includeCodeBlock = !includeCodeBlock;
@@ -167,9 +147,9 @@ namespace Preprocessor {
         else if (directive == "ifver" || directive == "ifnver")
         {
             // Compare provided version number with the current application version
-            Version macroVersion = Version(macroName);
+            Version macroVersion = Version(macroName.ToString());
             if(macroVersion.Major == 0) {
-                LogError(ErrorCode::InvalidVersionNumber, String::FromFormat("Cannot parse version number: %s", macroName.GetCStr()));
+                LogError(ErrorCode::InvalidVersionNumber, String::FromFormat("Cannot parse version number: %s", macroName.ToString().GetCStr()));
             }
             includeCodeBlock = _applicationVersion.AsLongNumber() >= macroVersion.AsLongNumber();
             if(directive == "ifnver" )
@@ -186,15 +166,15 @@ namespace Preprocessor {
         return ((!_conditionalStatements.empty()) && !_conditionalStatements.top());
     }
 
-    String Preprocessor::GetNextWord(String &text, bool trimText, bool includeDots) {
+    StrView Preprocessor::GetNextWord(StrView &text, bool trimText, bool includeDots) {
         size_t i = 0;
-        while ((i < text.GetLength()) &&
-               (IsScriptWordChar(text[i]) ||
+        while ((i < text.Len) &&
+               (IsScriptWordChar(static_cast<uint8_t>(text[i])) ||
                 (includeDots && (text[i] == '.')))
                 ) {
             i++;
         }
-        String word = text.Left(i);
+        StrView word(text.Ptr, i);
         text.ClipLeft(i);
         if (trimText) {
             text.Trim();
@@ -202,67 +182,49 @@ namespace Preprocessor {
         return word;
     }
 
-    String Preprocessor::RemoveComments(String text)
+    void Preprocessor::RemoveComments(const StrView &text, String &output)
     {
-        if (_inMultiLineComment)
-        {
-            size_t commentEnd = text.FindString("*/",0);
-            if (commentEnd == NOT_FOUND)
-            {
-                return String("");
-            }
-            text = text.Mid(commentEnd + 2, text.GetLength() - (commentEnd + 2));
-            _inMultiLineComment = false;
-        }
-
-        StringBuilder output = StringBuilder(text.GetLength());
-        for (size_t i = 0; i < text.GetLength(); i++)
+        for (size_t i = 0; i < text.Len; i++)
         {
             if (!_inMultiLineComment)
             {
                 if ((text[i] == '"') || (text[i] == '\''))
                 {
                     size_t endOfString = FindIndexOfMatchingCharacter(text, i, text[i]);
-                    if (endOfString == NOT_FOUND) //size_t is unsigned but it's alright
+                    if (endOfString == NOT_FOUND)
                     {
                         LogError(ErrorCode::UnterminatedString, "Unterminated string");
                         break;
                     }
-                    endOfString++;
-                    output.WriteString(text.Mid(i, endOfString - i));
-                    text = text.Mid(endOfString, text.GetLength() - endOfString);
-                    i = -1;
+                    output.Append(text.Ptr + i, endOfString + 1 - i);
+                    i = endOfString;
                 }
-                else if ((i < text.GetLength() - 1) && (text[i] == '/') && (text[i + 1] == '/'))
+                else if ((i + 1 < text.Len) && (text[i] == '/') && (text[i + 1] == '/'))
                 {
                     break;
                 }
-                else if ((i < text.GetLength() - 1) && (text[i] == '/') && (text[i + 1] == '*'))
+                else if ((i + 1 < text.Len) && (text[i] == '/') && (text[i + 1] == '*'))
                 {
                     _inMultiLineComment = true;
                     i++;
                 }
                 else
                 {
-                    output.WriteChar(text[i]);
+                    output.AppendChar(text[i]);
                 }
             }
-            else if ((i < text.GetLength() - 1) && (text[i] == '*') && (text[i + 1] == '/'))
+            else if ((i + 1 < text.Len) && (text[i] == '*') && (text[i + 1] == '/'))
             {
                 _inMultiLineComment = false;
                 i++;
             }
         }
-
-        String out = output.GetString();
-        out.Trim();
-        return out;
     }
 
-    String Preprocessor::PreProcessDirective(String &line)
+    void Preprocessor::PreProcessDirective(StrView &line)
     {
         line.ClipLeft(1);
-        String directive = GetNextWord(line);
+        StrView directive = GetNextWord(line);
 
         if ((directive == "ifdef") || (directive == "ifndef") ||
             (directive == "ifver") || (directive == "ifnver"))
@@ -300,28 +262,27 @@ namespace Preprocessor {
         }
         else if (directive == "define")
         {
-            String macroName = GetNextWord(line);
+            String macroName = GetNextWord(line).ToString();
             if (macroName.GetLength() == 0)
             {
                 LogError(ErrorCode::MacroNameMissing);
-                return String("");
             }
-            else if (std::isdigit(macroName[0]))
+            else if (std::isdigit(static_cast<uint8_t>(macroName[0])))
             {
                 LogError(ErrorCode::MacroNameInvalid, String::FromFormat("Macro name '%s' cannot start with a digit", macroName.GetCStr()));
             }
-            else if (_macros.contains(macroName.GetCStr()))
+            else if (_macros.contains(macroName))
             {
                 LogError(ErrorCode::MacroAlreadyExists, String::FromFormat("Macro '%s' is already defined", macroName.GetCStr()));
             }
             else
             {
-                _macros.add(macroName, line);
+                _macros.add(macroName, line.ToString());
             }
         }
         else if (directive == "undef")
         {
-            String macroName = GetNextWord(line);
+            String macroName = GetNextWord(line).ToString();
             if (macroName.GetLength() == 0)
             {
                 LogError(ErrorCode::MacroNameMissing);
@@ -337,7 +298,7 @@ namespace Preprocessor {
         }
         else if (directive == "error")
         {
-            LogError(ErrorCode::UserDefinedError, String::FromFormat("User error: %s", line.GetCStr()));
+            LogError(ErrorCode::UserDefinedError, String::FromFormat("User error: %s", line.ToString().GetCStr()));
         }
         else if ((directive == "sectionstart") || (directive == "sectionend"))
         {
@@ -349,10 +310,8 @@ namespace Preprocessor {
         }
         else
         {
-            LogError(ErrorCode::UnknownPreprocessorDirective, String::FromFormat("Unknown preprocessor directive '%s'", directive.GetCStr()));
+            LogError(ErrorCode::UnknownPreprocessorDirective, String::FromFormat("Unknown preprocessor directive '%s'", directive.ToString().GetCStr()));
         }
-
-        return String("");  // replace the directive with a blank line
     }
 
     void Preprocessor::DefineMacro(const String& name, const String& value)
@@ -360,103 +319,84 @@ namespace Preprocessor {
         _macros.add(name, value);
     }
 
-    String Preprocessor::PreProcessLine(const String& lineToProcess)
+    void Preprocessor::PreProcessLine(const StrView &line, String &output)
     {
-        if (DeletingCurrentLine())
-        {
-            return String("");
-        }
-
-        std::vector<StringBuilder> previousOutput = std::vector<StringBuilder>();
-        std::vector<String> previousLine = std::vector<String>();
-        StringBuilder output = StringBuilder(lineToProcess.GetLength());
-        String line = lineToProcess;
-        std::vector<String> ignored = std::vector<String>();
-        while (line.GetLength() > 0)
+        size_t pos = 0;
+        while (pos < line.Len)
         {
-            size_t i = 0;
-            while ((i < line.GetLength()) && (!std::isalnum(line[i])))
+            // Copy everything up to the next word, skipping string literals
+            size_t i = pos;
+            while ((i < line.Len) && (!std::isalnum(static_cast<uint8_t>(line[i]))))
             {
                 if ((line[i] == '"') || (line[i] == '\''))
                 {
                     i = FindIndexOfMatchingCharacter(line, i, line[i]);
                     if (i == NOT_FOUND)
                     {
-                        i = line.GetLength();
+                        i = line.Len;
                         break;
                     }
                 }
                 i++;
             }
 
-            output.WriteString(line.Mid(0, i));
-
-            if (i < line.GetLength())
-            {
-                bool precededByDot = false;
-                if (i > 0) precededByDot = (line[i - 1] == '.');
-
-                line = line.Mid(i, line.GetLength() - i);
+            output.Append(line.Ptr + pos, i - pos);
+            if (i >= line.Len)
+                break;
 
-                String theWord = GetNextWord(line, false, false);
+            const bool precededByDot = (i > pos) && (line[i - 1] == '.');
+            size_t wordEnd = i;
+            while ((wordEnd < line.Len) && IsScriptWordChar(static_cast<uint8_t>(line[wordEnd])))
+                wordEnd++;
 
-                if ((!precededByDot) && (!Contains(ignored, theWord)) && (_macros.contains(theWord.GetCStr())))
-                {
-                    previousOutput.push_back(output);
-                    previousLine.push_back(line);
-                    ignored.push_back(theWord);
-                    line = _macros.get_macro(theWord.GetCStr());
-                    output = StringBuilder(line.GetLength());
-                }
-                else
-                {
-                    output.WriteString(theWord);
-                }
+            const String *macro = precededByDot ? nullptr : _macros.find(line.Ptr + i, wordEnd - i);
+            if (macro && (std::find(_expandingMacros.begin(), _expandingMacros.end(), macro) == _expandingMacros.end()))
+            {
+                _expandingMacros.push_back(macro);
+                PreProcessLine(StrView(*macro), output);
+                _expandingMacros.pop_back();
             }
             else
-                line = "";
-
-            while (line.GetLength() == 0 && !previousOutput.empty())
             {
-                String result = output.GetString();
-                output = previousOutput.back();
-                previousOutput.pop_back();
-                line = previousLine.back();
-                previousLine.pop_back();
-                ignored.pop_back();
-                output.WriteString(result);
+                output.Append(line.Ptr + i, wordEnd - i);
             }
-
+            pos = wordEnd;
         }
-
-        return output.GetString();
     }
 
 
     String Preprocessor::Preprocess(const String& script, const String& scriptName)
     {
-        StringBuilder output = StringBuilder(script.GetLength());
+        String output;
+        output.Reserve(script.GetLength() + scriptName.GetLength() + 64);
         currentline = _lineNumber = 0;
-        output.WriteLine(String::FromFormat("%s%s\"", NEW_SCRIPT_TOKEN_PREFIX, scriptName.GetCStr()));
-        StringReader reader = StringReader(script);
+        output.AppendFmt("%s%s\"", NEW_SCRIPT_TOKEN_PREFIX, scriptName.GetCStr());
+        output.Append(li_end);
         _scriptName = scriptName;
-        while (reader.IsValid())
+
+        const char *script_end = script.GetCStr() + script.GetLength();
+        for (const char *line_start = script.GetCStr(); line_start < script_end;)
         {
             currentline = ++_lineNumber;
-            String thisLine = reader.ReadLine();
-            thisLine = RemoveComments(thisLine);
-            if (thisLine.GetLength() > 0)
+            const char *line_end = std::find(line_start, script_end, '\n');
+            _lineBuffer.Empty();
+            RemoveComments(StrView(line_start, line_end - line_start), _lineBuffer);
+            StrView line(_lineBuffer);
+            line.Trim();
+            if (line.Len > 0)
             {
-                if (thisLine[0] != '#')
+                if (line[0] != '#')
                 {
-                    thisLine = PreProcessLine(thisLine);
+                    if (!DeletingCurrentLine())
+                        PreProcessLine(line, output);
                 }
                 else
                 {
-                    thisLine = PreProcessDirective(thisLine);
+                    PreProcessDirective(line);
                 }
             }
-            output.WriteLine(thisLine);
+            output.Append(li_end);
+            line_start = line_end + 1;
         }
 
 
@@ -465,7 +405,7 @@ namespace Preprocessor {
             LogError(ErrorCode::IfWithoutEndIf);
         }
 
-        return output.GetString();
+        return output;
     }
 
     void Preprocessor::MergeMacros(MacroTable &macros) {
@@ -12,6 +12,7 @@
 //
 //=============================================================================
 #include <stack>
+#include <vector>
 #include "preproc/cc_macrotable.h"
 #include "util/string.h"
 #include "util/version.h"
@@ -35,6 +36,9 @@ namespace Preprocessor {
         UnterminatedString
     };
 
+    // A non-owning view of a range of characters
+    struct StrView;
+
     class Preprocessor {
     private:
         bool _inMultiLineComment = false;
@@ -43,20 +47,26 @@ namespace Preprocessor {
         String _scriptName;
         Version _applicationVersion;
         std::stack<bool> _conditionalStatements;
+        // Macros which are being expanded at the moment, used to prevent recursion
+        std::vector<const String*> _expandingMacros;
+        // Text of the current line without comments
+        String _lineBuffer;
 
         static void LogError(ErrorCode error, const String &message = nullptr);
 
-        void ProcessConditionalDirective(String &directive, String &line);
+        void ProcessConditionalDirective(const StrView &directive, StrView &line);
 
         bool DeletingCurrentLine();
 
-        static String GetNextWord(String &text, bool trimText = true, bool includeDots = false);
+        static StrView GetNextWord(StrView &text, bool trimText = true, bool includeDots = false);
 
-        String RemoveComments(String text);
+        // Writes the text without comments into the output buffer
+        void RemoveComments(const StrView &text, String &output);
 
-        String PreProcessDirective(String &line);
+        void PreProcessDirective(StrView &line);
 
-        String PreProcessLine(const String& lineToProcess);
+        // Writes the line with all the macros expanded into the output buffer
+        void PreProcessLine(const StrView &line, String &output);
 
     public:
         void SetAppVersion(const String& version);
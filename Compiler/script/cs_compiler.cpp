@@ -19,6 +19,7 @@
 #include "script/cc_symboltable.h"
 #include "script/cc_common.h"
 #include "script/cc_internal.h"
+#include "script/cs_optimizer.h"
 #include "script/cs_parser.h"
 
 const char *ccSoftwareVersion = "1.0";
@@ -117,6 +118,9 @@ ccScript* ccCompileText(const char *texo, const char *scriptName) {
         }
     }
 
+    if (ccGetOption(SCOPT_OPTIMIZE))
+        cc_optimize(cctemp);
+
     cctemp->free_extra();
     return cctemp;
 }
@@ -0,0 +1,996 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <algorithm>
+#include <limits.h>
+#include <stdint.h>
+#include <vector>
+#include "script/cs_optimizer.h"
+#include "script/cc_internal.h"
+
+// Number of arguments of each bytecode instruction
+static const int sccmd_argcount[CC_NUM_SCCMDS] =
+{
+    0, // (none)
+    2, // SCMD_ADD
+    2, // SCMD_SUB
+    2, // SCMD_REGTOREG
+    2, // SCMD_WRITELIT
+    0, // SCMD_RET
+    2, // SCMD_LITTOREG
+    1, // SCMD_MEMREAD
+    1, // SCMD_MEMWRITE
+    2, // SCMD_MULREG
+    2, // SCMD_DIVREG
+    2, // SCMD_ADDREG
+    2, // SCMD_SUBREG
+    2, // SCMD_BITAND
+    2, // SCMD_BITOR
+    2, // SCMD_ISEQUAL
+    2, // SCMD_NOTEQUAL
+    2, // SCMD_GREATER
+    2, // SCMD_LESSTHAN
+    2, // SCMD_GTE
+    2, // SCMD_LTE
+    2, // SCMD_AND
+    2, // SCMD_OR
+    1, // SCMD_CALL
+    1, // SCMD_MEMREADB
+    1, // SCMD_MEMREADW
+    1, // SCMD_MEMWRITEB
+    1, // SCMD_MEMWRITEW
+    1, // SCMD_JZ
+    1, // SCMD_PUSHREG
+    1, // SCMD_POPREG
+    1, // SCMD_JMP
+    2, // SCMD_MUL
+    1, // SCMD_CALLEXT
+    1, // SCMD_PUSHREAL
+    1, // SCMD_SUBREALSTACK
+    1, // SCMD_LINENUM
+    1, // SCMD_CALLAS
+    1, // SCMD_THISBASE
+    1, // SCMD_NUMFUNCARGS
+    2, // SCMD_MODREG
+    2, // SCMD_XORREG
+    1, // SCMD_NOTREG
+    2, // SCMD_SHIFTLEFT
+    2, // SCMD_SHIFTRIGHT
+    1, // SCMD_CALLOBJ
+    2, // SCMD_CHECKBOUNDS
+    1, // SCMD_MEMWRITEPTR
+    1, // SCMD_MEMREADPTR
+    0, // SCMD_MEMZEROPTR
+    1, // SCMD_MEMINITPTR
+    1, // SCMD_LOADSPOFFS
+    0, // SCMD_CHECKNULL
+    2, // SCMD_FADD
+    2, // SCMD_FSUB
+    2, // SCMD_FMULREG
+    2, // SCMD_FDIVREG
+    2, // SCMD_FADDREG
+    2, // SCMD_FSUBREG
+    2, // SCMD_FGREATER
+    2, // SCMD_FLESSTHAN
+    2, // SCMD_FGTE
+    2, // SCMD_FLTE
+    1, // SCMD_ZEROMEMORY
+    1, // SCMD_CREATESTRING
+    2, // SCMD_STRINGSEQUAL
+    2, // SCMD_STRINGSNOTEQ
+    1, // SCMD_CHECKNULLREG
+    0, // SCMD_LOOPCHECKOFF
+    0, // SCMD_MEMZEROPTRND
+    1, // SCMD_JNZ
+    1, // SCMD_DYNAMICBOUNDS
+    3, // SCMD_NEWARRAY
+    2, // SCMD_NEWUSEROBJECT
+};
+
+// Max number of times all the optimizations are repeated
+static const int MaxOptimizePasses = 8;
+// Max number of instructions in the replaced sequence
+static const int MaxPatternLength = 6;
+// Max number of jumps followed when threading a jump
+static const int MaxJumpHops = 16;
+// Max number of instructions looked through to find if register is unused
+static const int MaxLivenessScan = 32;
+
+// Decoded bytecode instruction
+struct OptInstr
+{
+    int32_t Code = 0;
+    int32_t Args[MAX_SCMD_ARGS] = {};
+    char    Fixups[MAX_SCMD_ARGS] = {}; // fixup type of each argument
+    int     Target = -1;  // referenced instruction, for jumps and code addresses
+    bool    Removed = false;
+};
+
+// Reference to the fixup's location in the decoded code
+struct OptFixup
+{
+    int     Instr = -1; // instruction index, or -1 if not in code
+    int     Arg = 0;
+};
+
+static inline bool is_jump(int32_t code)
+{
+    return (code == SCMD_JMP) || (code == SCMD_JZ) || (code == SCMD_JNZ);
+}
+
+// Tells whether instruction has a code address argument
+static inline bool has_code_ref(const OptInstr &ins)
+{
+    return is_jump(ins.Code) || (ins.Code == SCMD_THISBASE) ||
+        ((ins.Code == SCMD_LITTOREG) && (ins.Fixups[1] == FIXUP_FUNCTION));
+}
+
+// Index of the argument which holds code address
+static inline int code_ref_arg(const OptInstr &ins)
+{
+    return (ins.Code == SCMD_LITTOREG) ? 1 : 0;
+}
+
+// Returns register's bit for the usage mask; invalid registers
+// mark all of them, which makes any check conservative
+static inline uint32_t reg_bit(int32_t reg)
+{
+    return ((reg > 0) && (reg < CC_NUM_REGISTERS)) ? (1u << reg) : ~0u;
+}
+
+// Gets registers which the instruction reads and writes; returns false
+// if the instruction transfers control, or its register use is not known
+static bool get_reg_usage(const OptInstr &ins, uint32_t &reads, uint32_t &writes)
+{
+    reads = 0u;
+    writes = 0u;
+    switch (ins.Code)
+    {
+    case SCMD_ADD:
+    case SCMD_SUB:
+    case SCMD_MUL:
+    case SCMD_FADD:
+    case SCMD_FSUB:
+    case SCMD_NOTREG:
+    case SCMD_CREATESTRING:
+    case SCMD_NEWARRAY:
+        reads = writes = reg_bit(ins.Args[0]);
+        return true;
+    case SCMD_MULREG:
+    case SCMD_DIVREG:
+    case SCMD_ADDREG:
+    case SCMD_SUBREG:
+    case SCMD_BITAND:
+    case SCMD_BITOR:
+    case SCMD_ISEQUAL:
+    case SCMD_NOTEQUAL:
+    case SCMD_GREATER:
+    case SCMD_LESSTHAN:
+    case SCMD_GTE:
+    case SCMD_LTE:
+    case SCMD_AND:
+    case SCMD_OR:
+    case SCMD_MODREG:
+    case SCMD_XORREG:
+    case SCMD_SHIFTLEFT:
+    case SCMD_SHIFTRIGHT:
+    case SCMD_FMULREG:
+    case SCMD_FDIVREG:
+    case SCMD_FADDREG:
+    case SCMD_FSUBREG:
+    case SCMD_FGREATER:
+    case SCMD_FLESSTHAN:
+    case SCMD_FGTE:
+    case SCMD_FLTE:
+    case SCMD_STRINGSEQUAL:
+    case SCMD_STRINGSNOTEQ:
+        reads = reg_bit(ins.Args[0]) | reg_bit(ins.Args[1]);
+        writes = reg_bit(ins.Args[0]);
+        return true;
+    case SCMD_REGTOREG:
+        reads = reg_bit(ins.Args[0]);
+        writes = reg_bit(ins.Args[1]);
+        return true;
+    case SCMD_LITTOREG:
+    case SCMD_NEWUSEROBJECT:
+        writes = reg_bit(ins.Args[0]);
+        return true;
+    case SCMD_MEMREAD:
+    case SCMD_MEMREADB:
+    case SCMD_MEMREADW:
+    case SCMD_MEMREADPTR:
+        reads = reg_bit(SREG_MAR);
+        writes = reg_bit(ins.Args[0]);
+        return true;
+    case SCMD_MEMWRITE:
+    case SCMD_MEMWRITEB:
+    case SCMD_MEMWRITEW:
+    case SCMD_MEMWRITEPTR:
+    case SCMD_MEMINITPTR:
+    case SCMD_DYNAMICBOUNDS:
+        reads = reg_bit(ins.Args[0]) | reg_bit(SREG_MAR);
+        return true;
+    case SCMD_WRITELIT:
+    case SCMD_MEMZEROPTR:
+    case SCMD_CHECKNULL:
+    case SCMD_ZEROMEMORY:
+        reads = reg_bit(SREG_MAR);
+        return true;
+    case SCMD_MEMZEROPTRND:
+        reads = reg_bit(SREG_MAR) | reg_bit(SREG_AX);
+        return true;
+    case SCMD_PUSHREG:
+        reads = reg_bit(ins.Args[0]) | reg_bit(SREG_SP);
+        writes = reg_bit(SREG_SP);
+        return true;
+    case SCMD_POPREG:
+        reads = reg_bit(SREG_SP);
+        writes = reg_bit(ins.Args[0]) | reg_bit(SREG_SP);
+        return true;
+    case SCMD_LOADSPOFFS:
+        reads = reg_bit(SREG_SP);
+        writes = reg_bit(SREG_MAR);
+        return true;
+    case SCMD_CHECKBOUNDS:
+    case SCMD_CHECKNULLREG:
+    case SCMD_PUSHREAL:
+        reads = reg_bit(ins.Args[0]);
+        return true;
+    case SCMD_CALLOBJ:
+        reads = reg_bit(ins.Args[0]);
+        writes = reg_bit(SREG_OP);
+        return true;
+    case SCMD_LINENUM:
+    case SCMD_THISBASE:
+    case SCMD_NUMFUNCARGS:
+    case SCMD_SUBREALSTACK:
+    case SCMD_LOOPCHECKOFF:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Calculates integer operation the same way the script interpreter does;
+// returns false if the operation should be left for the run time
+static bool fold_int_op(int32_t code, int32_t v1, int32_t v2, int32_t &result)
+{
+    const uint32_t u1 = static_cast<uint32_t>(v1);
+    const uint32_t u2 = static_cast<uint32_t>(v2);
+    switch (code)
+    {
+    case SCMD_ADDREG: result = static_cast<int32_t>(u1 + u2); return true;
+    case SCMD_SUBREG: result = static_cast<int32_t>(u1 - u2); return true;
+    case SCMD_MULREG: result = static_cast<int32_t>(u1 * u2); return true;
+    case SCMD_DIVREG:
+    case SCMD_MODREG:
+        // leave the division errors to the run time
+        if ((v2 == 0) || ((v1 == INT32_MIN) && (v2 == -1)))
+            return false;
+        result = (code == SCMD_DIVREG) ? (v1 / v2) : (v1 % v2);
+        return true;
+    case SCMD_BITAND: result = v1 & v2; return true;
+    case SCMD_BITOR: result = v1 | v2; return true;
+    case SCMD_XORREG: result = v1 ^ v2; return true;
+    case SCMD_SHIFTLEFT:
+        if ((v2 < 0) || (v2 >= 32))
+            return false;
+        result = static_cast<int32_t>(u1 << v2);
+        return true;
+    case SCMD_SHIFTRIGHT:
+        if ((v2 < 0) || (v2 >= 32))
+            return false;
+        result = v1 >> v2;
+        return true;
+    case SCMD_ISEQUAL: result = (v1 == v2) ? 1 : 0; return true;
+    case SCMD_NOTEQUAL: result = (v1 != v2) ? 1 : 0; return true;
+    case SCMD_GREATER: result = (v1 > v2) ? 1 : 0; return true;
+    case SCMD_LESSTHAN: result = (v1 < v2) ? 1 : 0; return true;
+    case SCMD_GTE: result = (v1 >= v2) ? 1 : 0; return true;
+    case SCMD_LTE: result = (v1 <= v2) ? 1 : 0; return true;
+    case SCMD_AND: result = (v1 && v2) ? 1 : 0; return true;
+    case SCMD_OR: result = (v1 || v2) ? 1 : 0; return true;
+    default: return false;
+    }
+}
+
+
+class ScriptOptimizer
+{
+public:
+    // Decodes script's bytecode; returns false if it cannot be analyzed
+    bool Decode(const ccCompiledScript &scrip);
+    // Runs optimization passes; returns whether anything has changed
+    bool Optimize();
+    // Writes the optimized code back to the script, relocating all references
+    void Encode(ccCompiledScript &scrip) const;
+    // Gets the number of instructions visited by the optimization passes
+    size_t GetSteps() const { return Steps; }
+
+private:
+    // Finds next instruction which was not removed
+    int  Next(int at) const;
+    // Finds the instruction which was not removed, located given number of them behind
+    int  Prev(int at, int count) const;
+    // Finds the first instruction which was not removed, starting with the given one
+    int  Resolve(int at) const;
+    // Tells if the instruction is a jump target, or referenced by other means
+    bool IsLabel(int at) const { return Labels[at] > 0; }
+    // Fills the sequence of consecutive instructions starting with the given one
+    int  GetSequence(int at, int *seq, int count) const;
+    // Tells if none of the instructions in sequence, except the first one, is a label
+    bool NoLabels(const int *seq, int count) const;
+    // Tells if the register gets overwritten after the given instruction
+    // before it is read by anything
+    bool IsRegDeadAfter(int at, int32_t reg) const;
+    // Replaces instruction with a register move
+    void SetRegToReg(int at, int32_t reg1, int32_t reg2);
+    // Changes the instruction referenced by the given one
+    void SetTarget(int at, int target);
+    // Removes instruction; references to it will lead to the next one
+    void Remove(int at);
+
+    // Counts references to each instruction; these counts are updated
+    // by each change afterwards, so this is only done once
+    void MarkLabels();
+    bool Peephole();
+    bool PeepholeAt(int at);
+    bool FoldConstantResult(const int *seq, int count, int32_t value);
+    bool RemoveRedundantStackLoads();
+    bool ThreadJumps();
+    bool RemoveUnreachable();
+
+    std::vector<OptInstr> Instrs;
+    std::vector<int> Labels;      // number of references to each instruction
+    std::vector<int> InstrPos;    // original position of each instruction
+    std::vector<OptFixup> Fixups; // original fixups
+    std::vector<int> ExportInstr; // exported function's instruction, or -1 for data
+    std::vector<int> SectionInstr;
+    std::vector<int> FuncInstr;
+    mutable size_t Steps = 0;     // number of instructions visited
+};
+
+bool ScriptOptimizer::Decode(const ccCompiledScript &scrip)
+{
+    const auto &code = scrip.code;
+    const int codesize = static_cast<int>(code.size());
+    std::vector<int> pos_to_instr(codesize + 1, -1);
+    std::vector<int> arg_owner(codesize, -1);
+    for (int pc = 0; pc < codesize;)
+    {
+        const int32_t op = code[pc];
+        if ((op <= 0) || (op >= CC_NUM_SCCMDS))
+            return false;
+        const int argc = sccmd_argcount[op];
+        if (pc + argc >= codesize)
+            return false;
+        const int idx = static_cast<int>(Instrs.size());
+        OptInstr ins;
+        ins.Code = op;
+        for (int a = 0; a < argc; ++a)
+        {
+            ins.Args[a] = code[pc + 1 + a];
+            arg_owner[pc + 1 + a] = idx;
+        }
+        pos_to_instr[pc] = idx;
+        InstrPos.push_back(pc);
+        Instrs.push_back(ins);
+        pc += argc + 1;
+    }
+    const int end_idx = static_cast<int>(Instrs.size());
+    pos_to_instr[codesize] = end_idx;
+    InstrPos.push_back(codesize);
+
+    for (size_t i = 0; i < scrip.fixups.size(); ++i)
+    {
+        OptFixup fx;
+        const int32_t loc = scrip.fixups[i];
+        if (scrip.fixuptypes[i] != FIXUP_DATADATA)
+        {
+            if ((loc < 0) || (loc >= codesize) || (arg_owner[loc] < 0))
+                return false;
+            fx.Instr = arg_owner[loc];
+            fx.Arg = loc - InstrPos[fx.Instr] - 1;
+            Instrs[fx.Instr].Fixups[fx.Arg] = scrip.fixuptypes[i];
+        }
+        Fixups.push_back(fx);
+    }
+
+    for (int idx = 0; idx < end_idx; ++idx)
+    {
+        OptInstr &ins = Instrs[idx];
+        if (!has_code_ref(ins))
+            continue;
+        int32_t addr = ins.Args[code_ref_arg(ins)];
+        if (is_jump(ins.Code))
+            addr += InstrPos[idx] + 2;
+        if ((addr < 0) || (addr > codesize) || (pos_to_instr[addr] < 0))
+            return false;
+        ins.Target = pos_to_instr[addr];
+    }
+
+    for (size_t i = 0; i < scrip.exports.size(); ++i)
+    {
+        const int32_t etype = (scrip.export_addr[i] >> 24) & 0xff;
+        const int32_t addr = scrip.export_addr[i] & 0x00ffffff;
+        int idx = -1;
+        if (etype == EXPORT_FUNCTION)
+        {
+            if ((addr >= codesize) || (pos_to_instr[addr] < 0))
+                return false;
+            idx = pos_to_instr[addr];
+        }
+        ExportInstr.push_back(idx);
+    }
+    for (const auto offset : scrip.sectionOffsets)
+    {
+        if ((offset < 0) || (offset > codesize) || (pos_to_instr[offset] < 0))
+            return false;
+        SectionInstr.push_back(pos_to_instr[offset]);
+    }
+    for (const auto offset : scrip.funccodeoffs)
+    {
+        if ((offset < 0) || (offset >= codesize) || (pos_to_instr[offset] < 0))
+            return false;
+        FuncInstr.push_back(pos_to_instr[offset]);
+    }
+    return true;
+}
+
+int ScriptOptimizer::Next(int at) const
+{
+    const int end_idx = static_cast<int>(Instrs.size());
+    for (++at, ++Steps; (at < end_idx) && Instrs[at].Removed; ++at, ++Steps);
+    return at;
+}
+
+int ScriptOptimizer::Prev(int at, int count) const
+{
+    for (int i = at - 1; (i >= 0) && (count > 0); --i, ++Steps)
+    {
+        if (!Instrs[i].Removed)
+        {
+            at = i;
+            count--;
+        }
+    }
+    return at;
+}
+
+int ScriptOptimizer::Resolve(int at) const
+{
+    const int end_idx = static_cast<int>(Instrs.size());
+    for (++Steps; (at < end_idx) && Instrs[at].Removed; ++at, ++Steps);
+    return at;
+}
+
+int ScriptOptimizer::GetSequence(int at, int *seq, int count) const
+{
+    const int end_idx = static_cast<int>(Instrs.size());
+    int n = 0;
+    for (; (n < count) && (at < end_idx); ++n, at = Next(at))
+        seq[n] = at;
+    return n;
+}
+
+bool ScriptOptimizer::NoLabels(const int *seq, int count) const
+{
+    for (int i = 1; i < count; ++i)
+    {
+        if (IsLabel(seq[i]))
+            return false;
+    }
+    return true;
+}
+
+bool ScriptOptimizer::IsRegDeadAfter(int at, int32_t reg) const
+{
+    const uint32_t bit = reg_bit(reg);
+    const int end_idx = static_cast<int>(Instrs.size());
+    at = Next(at);
+    for (int n = 0; (n < MaxLivenessScan) && (at < end_idx); ++n, at = Next(at))
+    {
+        uint32_t reads, writes;
+        if (IsLabel(at) || !get_reg_usage(Instrs[at], reads, writes))
+            return false;
+        if (reads & bit)
+            return false;
+        if (writes & bit)
+            return true;
+    }
+    return false;
+}
+
+void ScriptOptimizer::SetRegToReg(int at, int32_t reg1, int32_t reg2)
+{
+    OptInstr &ins = Instrs[at];
+    if (ins.Target >= 0)
+        Labels[Resolve(ins.Target)]--;
+    ins = OptInstr();
+    ins.Code = SCMD_REGTOREG;
+    ins.Args[0] = reg1;
+    ins.Args[1] = reg2;
+}
+
+void ScriptOptimizer::SetTarget(int at, int target)
+{
+    OptInstr &ins = Instrs[at];
+    Labels[Resolve(ins.Target)]--;
+    Labels[Resolve(target)]++;
+    ins.Target = target;
+}
+
+void ScriptOptimizer::Remove(int at)
+{
+    OptInstr &ins = Instrs[at];
+    if (ins.Target >= 0)
+        Labels[Resolve(ins.Target)]--;
+    ins.Removed = true;
+    if (Labels[at] > 0)
+    {
+        Labels[Next(at)] += Labels[at];
+        Labels[at] = 0;
+    }
+}
+
+void ScriptOptimizer::MarkLabels()
+{
+    const int end_idx = static_cast<int>(Instrs.size());
+    Labels.assign(end_idx + 1, 0);
+    Steps += end_idx;
+    for (const auto &ins : Instrs)
+    {
+        if (!ins.Removed && (ins.Target >= 0))
+            Labels[Resolve(ins.Target)]++;
+    }
+    for (const auto idx : ExportInstr)
+    {
+        if (idx >= 0)
+            Labels[Resolve(idx)]++;
+    }
+    for (const auto idx : FuncInstr)
+        Labels[Resolve(idx)]++;
+}
+
+// Replaces the expression sequence, which was calculating value in AX
+// and leaving a copy in BX, with the precalculated value
+bool ScriptOptimizer::FoldConstantResult(const int *seq, int count, int32_t value)
+{
+    Instrs[seq[0]].Args[1] = value;
+    int first_removed = 1;
+    if (!IsRegDeadAfter(seq[count - 1], SREG_BX))
+    {
+        SetRegToReg(seq[1], SREG_AX, SREG_BX);
+        first_removed = 2;
+    }
+    for (int i = first_removed; i < count; ++i)
+        Remove(seq[i]);
+    return true;
+}
+
+bool ScriptOptimizer::PeepholeAt(int at)
+{
+    int seq[MaxPatternLength];
+    const int count = GetSequence(at, seq, MaxPatternLength);
+    OptInstr &i0 = Instrs[seq[0]];
+    OptInstr *i1 = (count > 1) ? &Instrs[seq[1]] : nullptr;
+    OptInstr *i2 = (count > 2) ? &Instrs[seq[2]] : nullptr;
+    OptInstr *i3 = (count > 3) ? &Instrs[seq[3]] : nullptr;
+    const bool i0_const = (i0.Code == SCMD_LITTOREG) && (i0.Fixups[1] == FIXUP_NOFIXUP);
+
+    // movl ax, c1; push ax; movl ax, c2; pop bx; <op> bx, ax; mov bx, ax
+    //   => movl ax, (c1 <op> c2)
+    if (i0_const && (count >= 6) && (i0.Args[0] == SREG_AX) && NoLabels(seq, 6))
+    {
+        const OptInstr &i4 = Instrs[seq[4]];
+        const OptInstr &i5 = Instrs[seq[5]];
+        int32_t value;
+        if ((i1->Code == SCMD_PUSHREG) && (i1->Args[0] == SREG_AX) &&
+            (i2->Code == SCMD_LITTOREG) && (i2->Args[0] == SREG_AX) && (i2->Fixups[1] == FIXUP_NOFIXUP) &&
+            (i3->Code == SCMD_POPREG) && (i3->Args[0] == SREG_BX) &&
+            (i4.Args[0] == SREG_BX) && (i4.Args[1] == SREG_AX) &&
+            (i5.Code == SCMD_REGTOREG) && (i5.Args[0] == SREG_BX) && (i5.Args[1] == SREG_AX) &&
+            fold_int_op(i4.Code, i0.Args[1], i2->Args[1], value))
+        {
+            return FoldConstantResult(seq, 6, value);
+        }
+    }
+    // movl ax, c; movl bx, 0; sub bx, ax; mov bx, ax  => movl ax, -c
+    if (i0_const && (count >= 4) && (i0.Args[0] == SREG_AX) && NoLabels(seq, 4) &&
+        (i1->Code == SCMD_LITTOREG) && (i1->Args[0] == SREG_BX) && (i1->Args[1] == 0) &&
+        (i1->Fixups[1] == FIXUP_NOFIXUP) &&
+        (i2->Code == SCMD_SUBREG) && (i2->Args[0] == SREG_BX) && (i2->Args[1] == SREG_AX) &&
+        (i3->Code == SCMD_REGTOREG) && (i3->Args[0] == SREG_BX) && (i3->Args[1] == SREG_AX))
+    {
+        return FoldConstantResult(seq, 4, static_cast<int32_t>(0u - static_cast<uint32_t>(i0.Args[1])));
+    }
+    if (i0_const && (count >= 2) && NoLabels(seq, 2) && (i1->Args[0] == i0.Args[0]))
+    {
+        // movl r, c; not r  => movl r, !c
+        if (i1->Code == SCMD_NOTREG)
+        {
+            i0.Args[1] = (i0.Args[1] == 0) ? 1 : 0;
+            Remove(seq[1]);
+            return true;
+        }
+        // movl r, c; addi/subi/muli r, k  => movl r, (c <op> k)
+        if (((i1->Code == SCMD_ADD) || (i1->Code == SCMD_SUB) || (i1->Code == SCMD_MUL)) &&
+            (i0.Args[0] != SREG_SP) && (i1->Fixups[1] == FIXUP_NOFIXUP))
+        {
+            const uint32_t c = static_cast<uint32_t>(i0.Args[1]);
+            const uint32_t k = static_cast<uint32_t>(i1->Args[1]);
+            const uint32_t value = (i1->Code == SCMD_ADD) ? (c + k) :
+                (i1->Code == SCMD_SUB) ? (c - k) : (c * k);
+            i0.Args[1] = static_cast<int32_t>(value);
+            Remove(seq[1]);
+            return true;
+        }
+        // movl r, c; checkbounds r, n  => movl r, c  (if c is within bounds)
+        if ((i1->Code == SCMD_CHECKBOUNDS) && (i1->Fixups[1] == FIXUP_NOFIXUP) &&
+            (i0.Args[1] >= 0) && (i0.Args[1] < i1->Args[1]))
+        {
+            Remove(seq[1]);
+            return true;
+        }
+    }
+    // movl ax, c; jz/jnz L  => jmp L, or nothing, depending on value;
+    // only forward jumps are made unconditional, because the backward
+    // unconditional jumps are counted by the script's loop check
+    if (i0_const && (count >= 2) && (i0.Args[0] == SREG_AX) && NoLabels(seq, 2) &&
+        ((i1->Code == SCMD_JZ) || (i1->Code == SCMD_JNZ)))
+    {
+        const bool taken = (i1->Code == SCMD_JZ) == (i0.Args[1] == 0);
+        if (!taken)
+        {
+            Remove(seq[1]);
+            return true;
+        }
+        if (Resolve(i1->Target) > seq[1])
+        {
+            i1->Code = SCMD_JMP;
+            return true;
+        }
+    }
+
+    if ((i0.Code == SCMD_PUSHREG) && (i0.Args[0] != SREG_SP) && (count >= 2))
+    {
+        const int32_t reg1 = i0.Args[0];
+        // push r1; pop r2  => mov r1, r2
+        if ((i1->Code == SCMD_POPREG) && (i1->Args[0] != SREG_SP) && NoLabels(seq, 2))
+        {
+            SetRegToReg(seq[0], reg1, i1->Args[0]);
+            Remove(seq[1]);
+            return true;
+        }
+        // push r1; movl r3, c; pop r2  => mov r1, r2; movl r3, c
+        if ((count >= 3) && (i1->Code == SCMD_LITTOREG) &&
+            (i2->Code == SCMD_POPREG) && (i2->Args[0] != SREG_SP) && (i2->Args[0] != i1->Args[0]) &&
+            NoLabels(seq, 3))
+        {
+            SetRegToReg(seq[0], reg1, i2->Args[0]);
+            Remove(seq[2]);
+            return true;
+        }
+        // push r1; load.sp.offs n; memread r3; pop r2
+        //   => mov r1, r2; load.sp.offs (n - 4); memread r3
+        if ((count >= 4) && (i1->Code == SCMD_LOADSPOFFS) && (i1->Fixups[0] == FIXUP_NOFIXUP) &&
+            (i1->Args[0] > 4) &&
+            ((i2->Code == SCMD_MEMREAD) || (i2->Code == SCMD_MEMREADB) ||
+             (i2->Code == SCMD_MEMREADW) || (i2->Code == SCMD_MEMREADPTR)) &&
+            (i3->Code == SCMD_POPREG) && (i3->Args[0] != i2->Args[0]) &&
+            (i3->Args[0] != SREG_MAR) && (i3->Args[0] != SREG_SP) && (reg1 != SREG_MAR) &&
+            NoLabels(seq, 4))
+        {
+            SetRegToReg(seq[0], reg1, i3->Args[0]);
+            i1->Args[0] -= 4;
+            Remove(seq[3]);
+            return true;
+        }
+    }
+
+    if (i0.Code == SCMD_REGTOREG)
+    {
+        // mov r, r  => (nothing)
+        if (i0.Args[0] == i0.Args[1])
+        {
+            Remove(seq[0]);
+            return true;
+        }
+        // mov r1, r2; mov r2, r1  => mov r1, r2
+        if ((count >= 2) && (i1->Code == SCMD_REGTOREG) && NoLabels(seq, 2) &&
+            (i1->Args[0] == i0.Args[1]) && (i1->Args[1] == i0.Args[0]))
+        {
+            Remove(seq[1]);
+            return true;
+        }
+    }
+
+    // movl/memread/pop r1; mov r1, r2  => movl/memread/pop r2  (if r1 is not used after)
+    if ((count >= 2) && (i1->Code == SCMD_REGTOREG) && (i1->Args[0] == i0.Args[0]) &&
+        (i1->Args[0] != i1->Args[1]) && (i1->Args[0] != SREG_SP) && (i1->Args[1] != SREG_SP) &&
+        NoLabels(seq, 2))
+    {
+        const int32_t reg2 = i1->Args[1];
+        const bool reads_mar = (i0.Code == SCMD_MEMREAD) || (i0.Code == SCMD_MEMREADB) ||
+            (i0.Code == SCMD_MEMREADW) || (i0.Code == SCMD_MEMREADPTR);
+        if (((i0.Code == SCMD_LITTOREG) || (i0.Code == SCMD_POPREG) ||
+             (reads_mar && (reg2 != SREG_MAR))) &&
+            IsRegDeadAfter(seq[1], i0.Args[0]))
+        {
+            i0.Args[0] = reg2;
+            Remove(seq[1]);
+            return true;
+        }
+    }
+
+    // jmp/jz/jnz to the next instruction  => (nothing)
+    if (is_jump(i0.Code) && (Resolve(i0.Target) == Next(seq[0])))
+    {
+        Remove(seq[0]);
+        return true;
+    }
+    return false;
+}
+
+bool ScriptOptimizer::Peephole()
+{
+    bool changed = false;
+    const int end_idx = static_cast<int>(Instrs.size());
+    for (int at = Resolve(0); at < end_idx;)
+    {
+        if (!PeepholeAt(at))
+        {
+            at = Next(at);
+            continue;
+        }
+        changed = true;
+        // step back, as the change may complete a longer pattern before
+        at = Resolve(Prev(at, MaxPatternLength - 1));
+    }
+    return changed;
+}
+
+// Removes stack address loads to MAR when MAR already has the same address
+bool ScriptOptimizer::RemoveRedundantStackLoads()
+{
+    bool changed = false;
+    const int end_idx = static_cast<int>(Instrs.size());
+    bool known = false;
+    int32_t known_offset = 0;
+    for (int at = Resolve(0); at < end_idx; at = Next(at))
+    {
+        const OptInstr &ins = Instrs[at];
+        if (IsLabel(at))
+            known = false;
+        if ((ins.Code == SCMD_LOADSPOFFS) && (ins.Fixups[0] == FIXUP_NOFIXUP))
+        {
+            if (known && (known_offset == ins.Args[0]))
+            {
+                Remove(at);
+                changed = true;
+            }
+            else
+            {
+                known = true;
+                known_offset = ins.Args[0];
+            }
+            continue;
+        }
+        uint32_t reads, writes;
+        if (!get_reg_usage(ins, reads, writes) ||
+            (writes & (reg_bit(SREG_MAR) | reg_bit(SREG_SP))))
+            known = false;
+    }
+    return changed;
+}
+
+// Redirects jumps which lead to other jumps to their final destination.
+// The number of backward unconditional jumps on the way must stay the same,
+// because these are counted by the script's loop check.
+bool ScriptOptimizer::ThreadJumps()
+{
+    bool changed = false;
+    const int end_idx = static_cast<int>(Instrs.size());
+    for (int at = Resolve(0); at < end_idx; at = Next(at))
+    {
+        OptInstr &ins = Instrs[at];
+        if (!is_jump(ins.Code))
+            continue;
+        const int first = Resolve(ins.Target);
+        int target = first;
+        int from = at;
+        int back_jumps = 0;
+        int dest = first;
+        for (int hop = 0; (hop < MaxJumpHops) && (target < end_idx) && (target != at); ++hop)
+        {
+            const OptInstr &tj = Instrs[target];
+            int next;
+            if ((tj.Code == SCMD_JMP) || ((tj.Code == ins.Code) && (ins.Code != SCMD_JMP)))
+                next = Resolve(tj.Target);
+            else if (((ins.Code == SCMD_JZ) && (tj.Code == SCMD_JNZ)) ||
+                     ((ins.Code == SCMD_JNZ) && (tj.Code == SCMD_JZ)))
+                next = Next(target);
+            else
+                break;
+            if (next == target)
+                break;
+            if ((Instrs[from].Code == SCMD_JMP) && (target <= from))
+                back_jumps++;
+            from = target;
+            target = next;
+            // only accept the destination if it keeps the count of the backward jumps
+            const int new_back_jumps = ((ins.Code == SCMD_JMP) && (target <= at)) ? 1 : 0;
+            const int old_back_jumps = back_jumps +
+                (((Instrs[from].Code == SCMD_JMP) && (target <= from)) ? 1 : 0);
+            if (new_back_jumps == old_back_jumps)
+                dest = target;
+        }
+        if (dest != first)
+        {
+            SetTarget(at, dest);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// Removes instructions which may not be reached from any function's entry
+bool ScriptOptimizer::RemoveUnreachable()
+{
+    const int end_idx = static_cast<int>(Instrs.size());
+    std::vector<int> work;
+    for (const auto idx : FuncInstr)
+        work.push_back(idx);
+    for (const auto idx : ExportInstr)
+    {
+        if (idx >= 0)
+            work.push_back(idx);
+    }
+    if (work.empty())
+        return false; // no known entry points
+
+    std::vector<char> reached(end_idx, 0);
+    while (!work.empty())
+    {
+        const int at = Resolve(work.back());
+        work.pop_back();
+        if ((at >= end_idx) || reached[at])
+            continue;
+        reached[at] = 1;
+        const OptInstr &ins = Instrs[at];
+        if (ins.Target >= 0)
+            work.push_back(ins.Target);
+        if ((ins.Code != SCMD_JMP) && (ins.Code != SCMD_RET))
+            work.push_back(Next(at));
+    }
+
+    bool changed = false;
+    Steps += end_idx;
+    for (int at = 0; at < end_idx; ++at)
+    {
+        if (!Instrs[at].Removed && !reached[at])
+        {
+            Remove(at);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool ScriptOptimizer::Optimize()
+{
+    bool changed = false;
+    MarkLabels();
+    for (int pass = 0; pass < MaxOptimizePasses; ++pass)
+    {
+        bool pass_changed = false;
+        pass_changed |= Peephole();
+        pass_changed |= RemoveRedundantStackLoads();
+        pass_changed |= ThreadJumps();
+        pass_changed |= RemoveUnreachable();
+        if (!pass_changed)
+            break;
+        changed = true;
+    }
+    return changed;
+}
+
+void ScriptOptimizer::Encode(ccCompiledScript &scrip) const
+{
+    // removed instructions get the position of the next remaining one
+    const int end_idx = static_cast<int>(Instrs.size());
+    std::vector<int32_t> new_pos(end_idx + 1);
+    int32_t pos = 0;
+    for (int idx = 0; idx < end_idx; ++idx)
+    {
+        new_pos[idx] = pos;
+        if (!Instrs[idx].Removed)
+            pos += 1 + sccmd_argcount[Instrs[idx].Code];
+    }
+    new_pos[end_idx] = pos;
+
+    std::vector<int32_t> code;
+    code.reserve(pos);
+    for (int idx = 0; idx < end_idx; ++idx)
+    {
+        const OptInstr &ins = Instrs[idx];
+        if (ins.Removed)
+            continue;
+        int32_t args[MAX_SCMD_ARGS];
+        std::copy(ins.Args, ins.Args + MAX_SCMD_ARGS, args);
+        if (has_code_ref(ins))
+        {
+            int32_t addr = new_pos[ins.Target];
+            if (is_jump(ins.Code))
+                addr -= new_pos[idx] + 2;
+            args[code_ref_arg(ins)] = addr;
+        }
+        code.push_back(ins.Code);
+        for (int a = 0; a < sccmd_argcount[ins.Code]; ++a)
+            code.push_back(args[a]);
+    }
+
+    std::vector<int32_t> fixups;
+    std::vector<char> fixuptypes;
+    for (size_t i = 0; i < Fixups.size(); ++i)
+    {
+        const OptFixup &fx = Fixups[i];
+        const char type = scrip.fixuptypes[i];
+        if (fx.Instr < 0)
+        {
+            fixups.push_back(scrip.fixups[i]);
+            fixuptypes.push_back(type);
+        }
+        else if (!Instrs[fx.Instr].Removed && (Instrs[fx.Instr].Fixups[fx.Arg] == type))
+        {
+            fixups.push_back(new_pos[fx.Instr] + 1 + fx.Arg);
+            fixuptypes.push_back(type);
+        }
+    }
+
+    for (size_t i = 0; i < ExportInstr.size(); ++i)
+    {
+        if (ExportInstr[i] >= 0)
+            scrip.export_addr[i] = (scrip.export_addr[i] & 0xff000000) | new_pos[ExportInstr[i]];
+    }
+    for (size_t i = 0; i < SectionInstr.size(); ++i)
+        scrip.sectionOffsets[i] = new_pos[SectionInstr[i]];
+    for (size_t i = 0; i < FuncInstr.size(); ++i)
+        scrip.funccodeoffs[i] = new_pos[FuncInstr[i]];
+
+    scrip.code = std::move(code);
+    scrip.fixups = std::move(fixups);
+    scrip.fixuptypes = std::move(fixuptypes);
+    scrip.codeallocated = static_cast<int32_t>(scrip.code.size());
+}
+
+bool cc_optimize(ccCompiledScript *scrip, size_t *steps)
+{
+    ScriptOptimizer opt;
+    if (!opt.Decode(*scrip))
+        return false;
+    const bool changed = opt.Optimize();
+    if (steps)
+        *steps = opt.GetSteps();
+    if (!changed)
+        return false;
+    opt.Encode(*scrip);
+    return true;
+}
+
+int cc_get_instruction_argcount(int32_t code)
+{
+    if ((code <= 0) || (code >= CC_NUM_SCCMDS))
+        return -1;
+    return sccmd_argcount[code];
+}
@@ -0,0 +1,42 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Bytecode optimizer, run over the compiled script after code generation.
+//
+// Folds constant integer expressions, rewrites redundant instruction
+// sequences (push/pop pairs, register moves, repeated stack address loads,
+// bound checks of constant indexes), threads jumps to jumps, and removes
+// the code which may never be reached. Jumps, code references, fixups,
+// exports and section offsets are relocated to the new code layout;
+// line number instructions are kept where the code is still reachable.
+//
+//-----------------------------------------------------------------------------
+//  Should be used only internally by cs_compiler.cpp
+//-----------------------------------------------------------------------------
+#ifndef __CS_OPTIMIZER_H
+#define __CS_OPTIMIZER_H
+
+#include "cc_compiledscript.h"
+
+// Optimizes compiled script's bytecode in place; the script is left
+// untouched if its code could not be analyzed.
+// Optionally reports the number of instructions visited, which tells
+// the amount of work done regardless of the machine's speed.
+// Returns whether the code was changed.
+extern bool cc_optimize(ccCompiledScript *scrip, size_t *steps = nullptr);
+// Returns number of arguments of the bytecode instruction,
+// or -1 if it is not a valid instruction
+extern int cc_get_instruction_argcount(int32_t code);
+
+#endif // __CS_OPTIMIZER_H
@@ -0,0 +1,253 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test/cc_test_helper.h"
+#include "script/cc_internal.h"
+#include "script/cs_optimizer.h"
+#include "script/cs_parser.h"
+
+extern ccCompiledScript *newScriptFixture();
+
+// Counts instructions of the given type in the script's code
+static int countInstructions(const ccCompiledScript *scrip, int32_t cmd)
+{
+    int count = 0;
+    for (size_t pc = 0; pc < scrip->code.size(); )
+    {
+        const int32_t code = scrip->code[pc];
+        const int argc = cc_get_instruction_argcount(code);
+        if (argc < 0)
+            return -1;
+        if (code == cmd)
+            count++;
+        pc += 1 + argc;
+    }
+    return count;
+}
+
+// Tells if the script has a "movl reg, value" instruction
+static bool hasLiteral(const ccCompiledScript *scrip, int32_t reg, int32_t value)
+{
+    for (size_t pc = 0; pc < scrip->code.size(); )
+    {
+        const int32_t code = scrip->code[pc];
+        if (code == SCMD_LITTOREG && scrip->code[pc + 1] == reg && scrip->code[pc + 2] == value)
+            return true;
+        pc += 1 + cc_get_instruction_argcount(code);
+    }
+    return false;
+}
+
+static std::unique_ptr<ccCompiledScript> compileOptimized(const char *inpl)
+{
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    clear_error();
+    if (cc_compile(inpl, scrip.get()) < 0)
+        return nullptr;
+    cc_optimize(scrip.get());
+    return scrip;
+}
+
+TEST(Optimize, FoldsConstantExpression) {
+    const char *inpl = ""
+        "int Func()"
+        "{"
+        "  return (3 + 4) * 2;"
+        "}";
+
+    auto scrip = compileOptimized(inpl);
+    ASSERT_NE(nullptr, scrip);
+    EXPECT_TRUE(hasLiteral(scrip.get(), SREG_AX, 14));
+    EXPECT_EQ(0, countInstructions(scrip.get(), SCMD_ADDREG));
+    EXPECT_EQ(0, countInstructions(scrip.get(), SCMD_MULREG));
+    EXPECT_EQ(0, countInstructions(scrip.get(), SCMD_PUSHREG));
+}
+
+TEST(Optimize, KeepsDivisionByZero) {
+    const char *inpl = ""
+        "int Func()"
+        "{"
+        "  return 5 / 0;"
+        "}";
+
+    auto scrip = compileOptimized(inpl);
+    ASSERT_NE(nullptr, scrip);
+    EXPECT_EQ(1, countInstructions(scrip.get(), SCMD_DIVREG));
+}
+
+TEST(Optimize, RemovesConstantIndexBoundsCheck) {
+    const char *inpl = ""
+        "int arr[5];"
+        "int Func(int i)"
+        "{"
+        "  return arr[3] + arr[i];"
+        "}";
+
+    auto scrip = compileOptimized(inpl);
+    ASSERT_NE(nullptr, scrip);
+    // only the check of the variable index should remain
+    EXPECT_EQ(1, countInstructions(scrip.get(), SCMD_CHECKBOUNDS));
+}
+
+TEST(Optimize, RemovesConstantCondition) {
+    const char *inpl = ""
+        "int Func()"
+        "{"
+        "  if (1)"
+        "    return 2;"
+        "  return 3;"
+        "}";
+
+    auto scrip = compileOptimized(inpl);
+    ASSERT_NE(nullptr, scrip);
+    EXPECT_EQ(0, countInstructions(scrip.get(), SCMD_JZ));
+    EXPECT_TRUE(hasLiteral(scrip.get(), SREG_AX, 2));
+}
+
+TEST(Optimize, RelocatesReferences) {
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    int idx;
+    scrip->add_new_function("Func", &idx);
+    scrip->start_new_section("Main");
+    scrip->write_cmd1(SCMD_THISBASE, 0);
+    scrip->write_cmd2(SCMD_REGTOREG, SREG_AX, SREG_AX);
+    scrip->start_new_section("Second");
+    scrip->write_cmd2(SCMD_LITTOREG, SREG_MAR, 8);
+    scrip->fixup_previous(FIXUP_GLOBALDATA);
+    scrip->write_cmd(SCMD_MEMREAD);
+    scrip->write_code(SREG_AX);
+    scrip->write_cmd1(SCMD_JZ, 3);
+    scrip->write_cmd2(SCMD_LITTOREG, SREG_AX, 1);
+    scrip->write_cmd(SCMD_RET);
+    scrip->add_fixup(0, FIXUP_DATADATA);
+    scrip->add_new_export("Func", EXPORT_FUNCTION, 0, 0);
+    ASSERT_EQ(16u, scrip->code.size());
+
+    ASSERT_TRUE(cc_optimize(scrip.get()));
+    const std::vector<int32_t> expect_code = {
+        SCMD_THISBASE, 0,
+        SCMD_LITTOREG, SREG_MAR, 8,
+        SCMD_MEMREAD, SREG_AX,
+        SCMD_JZ, 3,
+        SCMD_LITTOREG, SREG_AX, 1,
+        SCMD_RET };
+    EXPECT_EQ(expect_code, scrip->code);
+    ASSERT_EQ(2u, scrip->fixups.size());
+    EXPECT_EQ(4, scrip->fixups[0]);
+    EXPECT_EQ(FIXUP_GLOBALDATA, scrip->fixuptypes[0]);
+    EXPECT_EQ(0, scrip->fixups[1]);
+    EXPECT_EQ(FIXUP_DATADATA, scrip->fixuptypes[1]);
+    ASSERT_EQ(2u, scrip->sectionOffsets.size());
+    EXPECT_EQ(0, scrip->sectionOffsets[0]);
+    EXPECT_EQ(2, scrip->sectionOffsets[1]);
+    EXPECT_EQ(0, scrip->funccodeoffs[0]);
+    EXPECT_EQ(EXPORT_FUNCTION << 24, scrip->export_addr[0]);
+}
+
+TEST(Optimize, ThreadsJumpsAndRemovesUnreachable) {
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    int idx;
+    scrip->add_new_function("Func", &idx);
+    scrip->write_cmd1(SCMD_JZ, 1);   // to the jmp below
+    scrip->write_cmd(SCMD_RET);
+    scrip->write_cmd1(SCMD_JMP, 3);  // to the last ret
+    scrip->write_cmd2(SCMD_LITTOREG, SREG_AX, 1);
+    scrip->write_cmd(SCMD_RET);
+
+    ASSERT_TRUE(cc_optimize(scrip.get()));
+    const std::vector<int32_t> expect_code = {
+        SCMD_JZ, 1,
+        SCMD_RET,
+        SCMD_RET };
+    EXPECT_EQ(expect_code, scrip->code);
+}
+
+TEST(Optimize, KeepsBackwardJumpCount) {
+    // The loop check counts backward unconditional jumps,
+    // so jumping directly to the loop's start would skip the count
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    int idx;
+    scrip->add_new_function("Func", &idx);
+    scrip->write_cmd1(SCMD_LINENUM, 1);
+    scrip->write_cmd1(SCMD_JMP, 2);  // to the jmp below
+    scrip->write_cmd1(SCMD_LINENUM, 2);
+    scrip->write_cmd1(SCMD_JMP, -4); // to the previous linenum
+    const std::vector<int32_t> code = scrip->code;
+
+    ASSERT_FALSE(cc_optimize(scrip.get()));
+    EXPECT_EQ(code, scrip->code);
+}
+
+TEST(Optimize, InvalidCodeUnchanged) {
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    int idx;
+    scrip->add_new_function("Func", &idx);
+    scrip->write_cmd2(SCMD_REGTOREG, SREG_AX, SREG_AX);
+    scrip->write_cmd1(SCMD_JMP, 1); // to the middle of instruction
+    scrip->write_cmd2(SCMD_LITTOREG, SREG_AX, 1);
+    scrip->write_cmd(SCMD_RET);
+    const std::vector<int32_t> code = scrip->code;
+
+    ASSERT_FALSE(cc_optimize(scrip.get()));
+    EXPECT_EQ(code, scrip->code);
+}
+
+// Makes a script with the given number of small functions, which have
+// plenty of things for the optimizer to change and jumps around them
+static std::string makeLargeScript(int func_count)
+{
+    std::string script;
+    char buf[256];
+    for (int i = 0; i < func_count; ++i)
+    {
+        snprintf(buf, sizeof(buf),
+            "int Func%d(int a)"
+            "{"
+            "  int b = (3 + %d) * 2;"
+            "  if (a > 1) b = b + a; else b = -5;"
+            "  while (b > 100) b = b - 1;"
+            "  return b;"
+            "}", i, i);
+        script += buf;
+    }
+    return script;
+}
+
+// Returns number of instructions visited when optimizing the compiled script
+static size_t optimizeSteps(const std::string &inpl)
+{
+    std::unique_ptr<ccCompiledScript> scrip(newScriptFixture());
+    clear_error();
+    if (cc_compile(inpl.c_str(), scrip.get()) < 0)
+        return 0;
+    size_t steps = 0;
+    cc_optimize(scrip.get(), &steps);
+    return steps;
+}
+
+TEST(Optimize, ScalesLinearly) {
+    // 8 times more code should take about 8 times more work;
+    // quadratic behavior would make it 64 times
+    const int small_count = 250;
+    const int large_count = small_count * 8;
+    const size_t small_steps = optimizeSteps(makeLargeScript(small_count));
+    ASSERT_GT(small_steps, 0u);
+    const size_t large_steps = optimizeSteps(makeLargeScript(large_count));
+    ASSERT_GT(large_steps, 0u);
+    EXPECT_LT(large_steps, small_steps * 10);
+}
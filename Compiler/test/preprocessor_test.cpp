@@ -141,6 +141,30 @@ Display("f: %d", MACRO4);
 }
 
 
+TEST(Preprocess, DefineRecursiveAndMembers) {
+    Preprocessor pp = Preprocessor();
+    const char* inpl = R"EOS(
+#define LOOP1 LOOP2 + 1
+#define LOOP2 LOOP1 * 2
+#define WIDTH 320
+int a = LOOP1;
+int b = obj.WIDTH + WIDTH;
+String s = "WIDTH"; /* WIDTH */ int c = WIDTH; // WIDTH
+)EOS";
+
+    clear_error();
+    String res = pp.Preprocess(inpl, "ScriptDefineRecursive");
+
+    EXPECT_STREQ(last_seen_cc_error(), "");
+
+    std::vector<AGSString> lines = SplitLines(res);
+    ASSERT_EQ(lines.size(), 9);
+    ASSERT_STREQ(lines[5].GetCStr(), "int a = LOOP1 * 2 + 1;");
+    ASSERT_STREQ(lines[6].GetCStr(), "int b = obj.WIDTH + 320;");
+    ASSERT_STREQ(lines[7].GetCStr(), "String s = \"WIDTH\";  int c = 320;");
+}
+
+
 TEST(Preprocess, ReDefine) {
     Preprocessor pp = Preprocessor();
     const char* inpl = R"EOS(
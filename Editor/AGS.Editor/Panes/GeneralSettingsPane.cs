@@ -115,6 +115,12 @@ namespace AGS.Editor
             {
                 Factory.Events.OnGameSettingsChanged();
             }
+            else if (e.ChangedItem.Label == AGS.Types.Settings.PROPERTY_COMPRESS_ROOM_IMAGES)
+            {
+                // All rooms have to be saved again in the chosen format
+                Factory.Events.OnGameSettingsChanged();
+                Factory.AGSEditor.CurrentGame.WorkspaceState.RequiresRebuild = true;
+            }
             else if (e.ChangedItem.Label == AGS.Types.Settings.PROPERTY_DIALOG_SCRIPT_SAYFN ||
                 e.ChangedItem.Label == AGS.Types.Settings.PROPERTY_DIALOG_SCRIPT_NARRATEFN)
             {
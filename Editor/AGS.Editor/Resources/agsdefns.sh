@@ -1277,6 +1277,12 @@ builtin managed struct File {
   import static String ResolvePath(const string filename);   // $AUTOCOMPLETESTATICONLY$
   /// Gets the path to opened file.
   readonly import attribute String Path;
+#endif
+#ifdef SCRIPT_API_v362
+  /// Reads the given number of bytes, or the rest of the file if count is negative, as a raw text.
+  import String ReadRawText(int count = -1);
+  /// Reads the given number of bytes, or the rest of the file if count is negative, into a new array.
+  import char[] ReadRawBytes(int count = -1);
 #endif
   int reserved[2];   // $AUTOCOMPLETEIGNORE$
 };
@@ -1365,6 +1371,85 @@ builtin managed struct Overlay {
 #endif
 };
 
+#ifdef SCRIPT_API_v362
+enum BlendMode {
+  eBlendNormal = 0,
+  eBlendMultiply,
+  eBlendScreen,
+  eBlendOverlay,
+  eBlendDarken,
+  eBlendLighten,
+  eBlendAdd,
+  eBlendSubtract,
+  eBlendDifference,
+  eBlendExclusion,
+  eBlendColorDodge,
+  eBlendColorBurn,
+  eBlendHardLight,
+  eBlendSoftLight
+};
+#endif
+
+#ifdef SCRIPT_API_v362
+builtin struct Lighting {
+  /// Gets/sets how dark the room is where there is no light, from 0 (no darkness) to 100 (full darkness). Persists when the player changes rooms.
+  import static attribute int DarknessLevel;
+  /// Gets/sets the color of the room's darkness.
+  import static attribute int DarknessColor;
+  /// Adds a round light at the given room position, which fades out over the falloff distance towards its edge. Radius may be up to 2048, and up to 1000 lights may exist at once. Lights are removed when the player leaves the room. Returns the light's ID.
+  import static int  AddLight(int x, int y, int radius, int falloff=0);  // $AUTOCOMPLETESTATICONLY$
+  /// Adds a light shaped after the sprite's alpha channel, centered at the given room position. Lights are removed when the player leaves the room. Returns the light's ID.
+  import static int  AddSpriteLight(int x, int y, int sprite);  // $AUTOCOMPLETESTATICONLY$
+  /// Moves the light's center to the given room position.
+  import static void SetLightPosition(int light, int x, int y);  // $AUTOCOMPLETESTATICONLY$
+  /// Sets the light's intensity, from 0 (no light) to 100 (full light).
+  import static void SetLightIntensity(int light, int intensity);  // $AUTOCOMPLETESTATICONLY$
+  /// Removes the light.
+  import static void RemoveLight(int light);  // $AUTOCOMPLETESTATICONLY$
+  /// Removes all the lights.
+  import static void RemoveAllLights();  // $AUTOCOMPLETESTATICONLY$
+};
+
+builtin managed struct ParticleEmitter {
+  /// Creates a particle emitter at the given room position, which spawns particles using the sprite. The emitter belongs to the current room, and is paused and hidden while other rooms are displayed.
+  import static ParticleEmitter* Create(int x, int y, int sprite);  // $AUTOCOMPLETESTATICONLY$
+  /// Spawns the given number of particles at once.
+  import void Burst(int count);
+  /// Removes all the live particles.
+  import void Clear();
+  /// Sets the range of the particle's lifetime, in game loops.
+  import void SetLifetime(int minLoops, int maxLoops);
+  /// Sets the range of the particle's velocity, in pixels per game loop.
+  import void SetVelocity(float minVX, float maxVX, float minVY, float maxVY);
+  /// Makes the particles animate using the view's loop, changing frames every given number of game loops.
+  import void SetView(int view, int loop, int delay=5);
+  /// Gets/sets the baseline used to sort the particles among other room sprites; 0 means the bottom of the spawn area.
+  import attribute int Baseline;
+  /// Gets/sets whether the emitter spawns new particles at its Rate.
+  import attribute bool Enabled;
+  /// Gets/sets whether the particles fade out towards the end of their life. Only works in 32-bit games.
+  import attribute bool Fade;
+  /// Gets/sets the vertical acceleration of the particles, in pixels per game loop.
+  import attribute float Gravity;
+  /// Gets/sets the height of the spawn area.
+  import attribute int Height;
+  /// Gets/sets the maximal number of live particles.
+  import attribute int MaxParticles;
+  /// Gets the number of live particles.
+  readonly import attribute int ParticleCount;
+  /// Gets/sets the number of particles spawned per second.
+  import attribute int Rate;
+  /// Gets/sets the particle's sprite; setting it stops the view animation.
+  import attribute int Sprite;
+  /// Gets/sets the width of the spawn area.
+  import attribute int Width;
+  /// Gets/sets the X position of the spawn area.
+  import attribute int X;
+  /// Gets/sets the Y position of the spawn area.
+  import attribute int Y;
+};
+#endif
+
 builtin managed struct DynamicSprite {
   /// Creates a blank dynamic sprite of the specified size.
   import static DynamicSprite* Create(int width, int height, bool hasAlphaChannel=false);    // $AUTOCOMPLETESTATICONLY$
@@ -1408,6 +1493,22 @@ builtin managed struct DynamicSprite {
   readonly import attribute int Height;
   /// Gets the width of this sprite.
   readonly import attribute int Width;
+#ifdef SCRIPT_API_v362
+  /// Blurs the sprite by averaging each pixel with its neighbours within the radius.
+  import void BoxBlur(int radius);
+  /// Blurs the sprite smoothly, using gaussian weights within the radius.
+  import void GaussianBlur(int radius);
+  /// Keeps only the fine details of the sprite over the neutral gray, removing the blur of the given radius.
+  import void HighPass(int radius);
+  /// Turns pixels with the brightness at or above the level (0-255) white, and the rest black.
+  import void Threshold(int level);
+  /// Applies a convolution kernel of the given odd size (up to 15 x 15), given as rows of factors, to the sprite's colors.
+  import void Convolve(float kernel[], int width, int height, int bias = 0);
+  /// Transforms the sprite's colors by the 4 x 5 matrix: rows for R, G, B, A made of factors for R, G, B, A and an offset (0-255).
+  import void ApplyColorMatrix(float matrix[]);
+  /// Blends another sprite over this one at the given position, using the blend mode.
+  import void BlendSprite(int slot, BlendMode mode, int x = 0, int y = 0, int transparency = 0);
+#endif
 };
 
 // Palette FX
@@ -3237,6 +3338,23 @@ builtin struct Screen {
 };
 #endif
 
+#ifdef SCRIPT_API_v362
+builtin managed struct Coroutine {
+  /// Starts running the script function with the given parameter as a coroutine, beginning on the next game loop.
+  import static Coroutine* Start(const string functionName, int param = 0);  // $AUTOCOMPLETESTATICONLY$
+  /// Pauses the current coroutine for the given number of game loops, letting the game continue.
+  import static void Wait(int loops);  // $AUTOCOMPLETESTATICONLY$
+  /// Pauses the current coroutine until the character stops moving and animating.
+  import static void WaitForCharacter(Character *theCharacter);  // $AUTOCOMPLETESTATICONLY$
+  /// Pauses the current coroutine until the object stops moving and animating.
+  import static void WaitForObject(Object *theObject);  // $AUTOCOMPLETESTATICONLY$
+  /// Stops the coroutine.
+  import void Stop();
+  /// Gets whether the coroutine is still running.
+  import readonly attribute bool IsRunning;
+};
+#endif
+
 
 
 import readonly Character *player;
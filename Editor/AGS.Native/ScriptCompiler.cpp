@@ -82,6 +82,7 @@ namespace AGS
 			  ccSetOption(SCOPT_LEFTTORIGHT, game->Settings->LeftToRightPrecedence);
 			  ccSetOption(SCOPT_OLDSTRINGS, !game->Settings->EnforceNewStrings);
 			  ccSetOption(SCOPT_UTF8, game->UnicodeMode);
+			  ccSetOption(SCOPT_OPTIMIZE, game->Settings->OptimizeScripts);
 
         if (exceptionToThrow == nullptr)
         {
@@ -114,6 +114,8 @@ const char *TEMPLATE_LOCK_FILE = "template.dta";
 const char *ROOM_TEMPLATE_ID_FILE = "rtemplate.dat";
 const int ROOM_TEMPLATE_ID_FILE_SIGNATURE = 0x74673812;
 bool spritesModified = false;
+// Whether room images are saved with deflate, which requires the 3.6.2 room format
+bool compressRoomImages = false;
 RoomStruct thisroom;
 
 GameDataVersion loaded_game_file_version = kGameVersion_Current;
@@ -2025,6 +2027,7 @@ void GameUpdated(Game ^game, bool forceUpdate) {
   thisgame.options[OPT_RELATIVEASSETRES] = game->Settings->AllowRelativeAssetResolutions;
   thisgame.options[OPT_ANTIALIASFONTS] = game->Settings->AntiAliasFonts;
   thisgame.options[OPT_CLIPGUICONTROLS] = game->Settings->ClipGUIControls;
+  compressRoomImages = game->Settings->CompressRoomImages;
   thisgame.options[OPT_GAMETEXTENCODING] = game->TextEncoding->CodePage;
   antiAliasFonts = thisgame.options[OPT_ANTIALIASFONTS];
 
@@ -3955,6 +3958,7 @@ PInteractionScripts convert_interaction_scripts(Interactions ^interactions)
 	{
         native_scripts->ScriptFuncNames.push_back(TextHelper::ConvertASCII(funcName));
 	}
+    native_scripts->UpdateHandlerMask();
     return PInteractionScripts(native_scripts);
 }
 
@@ -3982,7 +3986,10 @@ void convert_room_interactions_to_native(Room ^room, RoomStruct &rs)
 // Fixups and saves the native room struct into the file
 void save_room_file(RoomStruct &rs, const AGSString &path)
 {
-    rs.DataVersion = kRoomVersion_Current;
+    // Deflate compression of the room images is only supported by the newer engines,
+    // so unless enabled, rooms are saved in the last format which does not use it
+    const RoomFileVersion room_ver = compressRoomImages ? kRoomVersion_362 : kRoomVersion_3508;
+    rs.DataVersion = room_ver;
     calculate_walkable_areas(rs);
 
     rs.BackgroundBPP = rs.BgFrames[0].Graphic->GetBPP();
@@ -3997,7 +4004,7 @@ void save_room_file(RoomStruct &rs, const AGSString &path)
     if (out == NULL)
         quit("save_room: unable to open room file for writing.");
 
-    AGS::Common::HRoomFileError err = AGS::Common::WriteRoomData(&rs, out.get(), kRoomVersion_Current);
+    AGS::Common::HRoomFileError err = AGS::Common::WriteRoomData(&rs, out.get(), room_ver);
     if (!err)
         quit(AGSString::FromFormat("save_room: unable to write room data, error was:\r\n%s", err->FullMessage()));
 
@@ -26,6 +26,7 @@ namespace AGS.Types
         public const string PROPERTY_BUILD_TARGETS = "Build target platforms";
         public const string PROPERTY_RENDERATSCREENRES = "Render sprites at screen resolution";
         public const string PROPERTY_CLIPGUICONTROLS = "GUI controls clip their contents";
+        public const string PROPERTY_COMPRESS_ROOM_IMAGES = "Compress room images";
         public const string PROPERTY_DIALOG_SCRIPT_SAYFN = "Custom Say function in dialog scripts";
         public const string PROPERTY_DIALOG_SCRIPT_NARRATEFN = "Custom Narrate function in dialog scripts";
         public const string REGEX_FOUR_PART_VERSION = @"^(\d+)\.(\d+)\.(\d+)\.(\d+)$";
@@ -69,6 +70,7 @@ namespace AGS.Types
         private bool _saveScreenshots = false;
         private SpriteCompression _compressSprites = SpriteCompression.None;
         private bool _optimizeSpriteStorage = true;
+        private bool _compressRoomImages = false;
         private bool _inventoryCursors = true;
         private bool _handleInvInScript = false;
         private bool _displayMultipleInv = false;
@@ -78,6 +80,7 @@ namespace AGS.Types
         private ScriptAPIVersion _scriptCompatLevelReal = Utilities.GetActualAPI(ScriptAPIVersion.Highest);
         private bool _enforceObjectScripting = true;
         private bool _leftToRightPrecedence = true;
+        private bool _optimizeScripts = true;
         private bool _enforceNewStrings = true;
         private bool _enforceNewAudio = true;
         private bool _oldCustomDlgOptsAPI = false;
@@ -371,6 +374,16 @@ namespace AGS.Types
             set { _optimizeSpriteStorage = value; }
         }
 
+        [DisplayName(PROPERTY_COMPRESS_ROOM_IMAGES)]
+        [Description("Save room backgrounds and masks with deflate compression, which makes room files smaller and faster to load. Rooms saved this way can only be run by the engine 3.6.2 or later. Changing this setting rebuilds all rooms.")]
+        [DefaultValue(false)]
+        [Category("Compiler")]
+        public bool CompressRoomImages
+        {
+            get { return _compressRoomImages; }
+            set { _compressRoomImages = value; }
+        }
+
         [DisplayName("Save screenshots in save games")]
         [Description("A screenshot of the player's current position will be saved into the save games")]
         [DefaultValue(false)]
@@ -643,6 +656,16 @@ namespace AGS.Types
             set { _debugMode = value; }
         }
 
+        [DisplayName("Optimize compiled scripts")]
+        [Description("Optimize the compiled script code, which makes scripts run faster without changing what they do")]
+        [DefaultValue(true)]
+        [Category("Compiler")]
+        public bool OptimizeScripts
+        {
+            get { return _optimizeScripts; }
+            set { _optimizeScripts = value; }
+        }
+
         [DisplayName("Use selected inventory graphic for cursor")]
         [Description("When in Use Inventory mode, the mouse cursor will be the selected inventory item rather than a fixed cursor")]
         [DefaultValue(true)]
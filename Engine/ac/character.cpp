@@ -179,14 +179,9 @@ void Character_AddWaypoint(CharacterInfo *chaa, int x, int y) {
     }
 
     MoveList *cmls = &mls[chaa->walking % TURNING_AROUND];
-    if (cmls->numstage >= MAXNEEDSTAGES)
-    {
-        debug_script_warn("Character::AddWaypoint: move is too complex, cannot add any further paths");
-        return;
-    }
 
     // They're already walking there anyway
-    const Point &last_pos = cmls->GetLastPos();
+    const Point last_pos = cmls->GetLastPos();
     if (last_pos == Point(x, y))
         return;
 
@@ -209,6 +204,11 @@ void Character_AddWaypoint(CharacterInfo *chaa, int x, int y) {
     {
         convert_move_path_to_room_resolution(cmls, last_stage, last_stage + 1);
     }
+    else
+    {
+        cmls->pos[last_stage] = last_pos;
+        debug_script_warn("Character::AddWaypoint: move is too complex, cannot add any further paths");
+    }
 }
 
 void Character_Animate(CharacterInfo *chaa, int loop, int delay, int repeat,
@@ -2481,10 +2481,11 @@ void _displayspeech(const char*texx, int aschar, int xx, int yy, int widd, int i
     {
         // remove any background speech
         auto &overs = get_overlays();
-        for (auto &over : overs)
+        const auto &over_ids = get_active_overlays();
+        for (size_t i = over_ids.size(); i-- > 0;)
         {
-            if (over.timeout > 0)
-                remove_screen_overlay(over.type);
+            if (overs[over_ids[i]].timeout > 0)
+                remove_screen_overlay(over_ids[i]);
         }
     }
     said_text = 1;
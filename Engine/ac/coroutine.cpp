@@ -0,0 +1,341 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/coroutine.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "ac/character.h"
+#include "ac/characterinfo.h"
+#include "ac/common.h"
+#include "ac/gamesetupstruct.h"
+#include "ac/gamestate.h"
+#include "ac/global_object.h"
+#include "ac/object.h"
+#include "ac/dynobj/dynobj_manager.h"
+#include "ac/dynobj/scriptobject.h"
+#include "debug/debug_log.h"
+#include "script/cc_common.h"
+#include "script/script.h"
+#include "util/string.h"
+
+using namespace AGS::Common;
+
+extern GameSetupStruct game;
+
+// Max number of coroutines which may exist at the same time;
+// each one takes a script instance slot and has its own stack
+static const size_t MaxCoroutines = 64;
+
+enum CoroutineWait
+{
+    kCoroutineWait_None,
+    kCoroutineWait_Loops,
+    kCoroutineWait_Character,
+    kCoroutineWait_Object
+};
+
+struct Coroutine
+{
+    int         ID = 0;
+    String      FnName;
+    UInstance   Inst;       // own script thread, forked from the owning script
+    bool        RoomScript = false;
+    RuntimeScriptValue Param;
+    bool        Started = false;
+    bool        Finished = false;
+    CoroutineWait WaitType = kCoroutineWait_None;
+    int         WaitData = 0; // loops left, character or object index
+};
+
+static std::vector<std::unique_ptr<Coroutine>> coroutines;
+// Coroutine which is being run by the scheduler
+static Coroutine *cur_coroutine = nullptr;
+static int last_coroutine_id = 0;
+static bool updating_coroutines = false;
+
+
+static Coroutine *find_coroutine(int id)
+{
+    for (auto &co : coroutines)
+    {
+        if (co->ID == id && !co->Finished)
+            return co.get();
+    }
+    return nullptr;
+}
+
+// Tells if the coroutine may continue running
+static bool is_wait_over(Coroutine &co)
+{
+    switch (co.WaitType)
+    {
+    case kCoroutineWait_Loops:
+        return --co.WaitData <= 0;
+    case kCoroutineWait_Character:
+    {
+        const CharacterInfo &chi = game.chars[co.WaitData];
+        return (chi.walking == 0) && !chi.is_animating();
+    }
+    case kCoroutineWait_Object:
+        // the object may be gone if the room has changed
+        return !is_valid_object(co.WaitData) ||
+            ((IsObjectMoving(co.WaitData) == 0) && (IsObjectAnimating(co.WaitData) == 0));
+    default:
+        return true;
+    }
+}
+
+// Marks coroutine finished, and frees its script thread unless it is running
+static void stop_coroutine(Coroutine &co)
+{
+    if (co.Finished)
+        return;
+    co.Finished = true;
+    if (&co == cur_coroutine)
+    {
+        co.Inst->Abort();
+        return;
+    }
+    // release the managed objects held by the suspended function's locals
+    co.Inst->CancelSuspended();
+    co.Inst.reset();
+}
+
+static void remove_finished_coroutines()
+{
+    coroutines.erase(std::remove_if(coroutines.begin(), coroutines.end(),
+        [](const std::unique_ptr<Coroutine> &co) { return co->Finished; }), coroutines.end());
+}
+
+// Finds the loaded script which the coroutine's function belongs to,
+// checking the calling script first
+static ccInstance *find_coroutine_script(const char *fn_name, bool &room_script)
+{
+    std::vector<ccInstance*> insts;
+    if (roominst)
+        insts.push_back(roominst.get());
+    if (gameinst)
+        insts.push_back(gameinst.get());
+    for (const auto &inst : moduleInst)
+        insts.push_back(inst.get());
+
+    const ccInstance *caller = ccInstance::GetCurrentInstance();
+    if (caller)
+    {
+        auto it_caller = std::find_if(insts.begin(), insts.end(),
+            [caller](const ccInstance *inst) { return inst->instanceof == caller->instanceof; });
+        if (it_caller != insts.end())
+            std::rotate(insts.begin(), it_caller, it_caller + 1);
+    }
+
+    for (auto *inst : insts)
+    {
+        if (!inst->GetSymbolAddress(fn_name).IsNull())
+        {
+            room_script = (inst == roominst.get());
+            return inst;
+        }
+    }
+    return nullptr;
+}
+
+ScriptCoroutine *Coroutine_Start(const char *fn_name, int param)
+{
+    if (!fn_name || !fn_name[0])
+        quit("!Coroutine.Start: function name is not specified");
+    if (coroutines.size() >= MaxCoroutines)
+        quitprintf("!Coroutine.Start: too many coroutines running (max %zu)", MaxCoroutines);
+
+    bool room_script = false;
+    ccInstance *owner = find_coroutine_script(fn_name, room_script);
+    if (!owner)
+        quitprintf("!Coroutine.Start: function '%s' not found in any script", fn_name);
+    UInstance inst(owner->Fork());
+    if (!inst)
+        quitprintf("!Coroutine.Start: failed to create script thread: %s", cc_get_error().ErrorString.GetCStr());
+    inst->TrackStackRefs();
+
+    std::unique_ptr<Coroutine> co(new Coroutine());
+    co->ID = ++last_coroutine_id;
+    co->FnName = fn_name;
+    co->Inst = std::move(inst);
+    co->RoomScript = room_script;
+    co->Param.SetInt32(param);
+    const int id = co->ID;
+    // the coroutine will be run first time on the next update
+    coroutines.push_back(std::move(co));
+
+    ScriptCoroutine *sco = new ScriptCoroutine(id);
+    ccRegisterManagedObject(sco, sco);
+    return sco;
+}
+
+// Suspends the running coroutine until the given wait is over
+static void coroutine_suspend(const char *apiname, CoroutineWait wait_type, int wait_data)
+{
+    if (!cur_coroutine || (ccInstance::GetCurrentInstance() != cur_coroutine->Inst.get()))
+        quitprintf("!%s: this function may only be called within a coroutine", apiname);
+    if (!cur_coroutine->Inst->Suspend())
+        quitprintf("!%s: cannot wait inside a function imported from another script", apiname);
+    cur_coroutine->WaitType = wait_type;
+    cur_coroutine->WaitData = wait_data;
+}
+
+void Coroutine_Wait(int loops)
+{
+    coroutine_suspend("Coroutine.Wait", kCoroutineWait_Loops, std::max(1, loops));
+}
+
+void Coroutine_WaitForCharacter(CharacterInfo *chaa)
+{
+    coroutine_suspend("Coroutine.WaitForCharacter", kCoroutineWait_Character, chaa->index_id);
+}
+
+void Coroutine_WaitForObject(ScriptObject *objj)
+{
+    coroutine_suspend("Coroutine.WaitForObject", kCoroutineWait_Object, objj->id);
+}
+
+void Coroutine_Stop(ScriptCoroutine *co)
+{
+    Coroutine *coroutine = find_coroutine(co->GetID());
+    if (coroutine)
+        stop_coroutine(*coroutine);
+}
+
+bool Coroutine_GetIsRunning(ScriptCoroutine *co)
+{
+    return find_coroutine(co->GetID()) != nullptr;
+}
+
+void update_coroutines()
+{
+    if (coroutines.empty() || updating_coroutines)
+        return;
+
+    updating_coroutines = true;
+    const int room_changes_was = play.room_changes;
+    // coroutines started during this update will run on the next one
+    const size_t count = coroutines.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        Coroutine &co = *coroutines[i];
+        if (co.Finished || !is_wait_over(co))
+            continue;
+
+        co.WaitType = kCoroutineWait_None;
+        cur_coroutine = &co;
+        no_blocking_functions++;
+        int result;
+        if (co.Started)
+        {
+            result = co.Inst->Resume();
+        }
+        else
+        {
+            co.Started = true;
+            result = co.Inst->CallScriptFunction(co.FnName.GetCStr(), 1, &co.Param);
+        }
+        no_blocking_functions--;
+        cur_coroutine = nullptr;
+
+        if (result != CC_RUN_SUSPENDED)
+        {
+            co.Finished = true;
+            co.Inst.reset();
+            if ((result != 0) && (result != 100))
+                quit_with_script_error(co.FnName.GetCStr());
+        }
+        cc_clear_error();
+
+        if (room_changes_was != play.room_changes)
+            break;
+    }
+    remove_finished_coroutines();
+    updating_coroutines = false;
+}
+
+void stop_room_coroutines()
+{
+    for (auto &co : coroutines)
+    {
+        if (co->RoomScript)
+            stop_coroutine(*co);
+    }
+    if (!updating_coroutines)
+        remove_finished_coroutines();
+}
+
+void stop_all_coroutines()
+{
+    for (auto &co : coroutines)
+        stop_coroutine(*co);
+    if (!updating_coroutines)
+        remove_finished_coroutines();
+}
+
+//=============================================================================
+//
+// Script API Functions
+//
+//=============================================================================
+
+#include "debug/out.h"
+#include "script/script_api.h"
+#include "script/script_runtime.h"
+
+RuntimeScriptValue Sc_Coroutine_Start(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_OBJAUTO_POBJ_PINT(ScriptCoroutine, Coroutine_Start, const char);
+}
+
+RuntimeScriptValue Sc_Coroutine_Wait(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT(Coroutine_Wait);
+}
+
+RuntimeScriptValue Sc_Coroutine_WaitForCharacter(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_POBJ(Coroutine_WaitForCharacter, CharacterInfo);
+}
+
+RuntimeScriptValue Sc_Coroutine_WaitForObject(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_POBJ(Coroutine_WaitForObject, ScriptObject);
+}
+
+RuntimeScriptValue Sc_Coroutine_Stop(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID(ScriptCoroutine, Coroutine_Stop);
+}
+
+RuntimeScriptValue Sc_Coroutine_GetIsRunning(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_BOOL(ScriptCoroutine, Coroutine_GetIsRunning);
+}
+
+void RegisterCoroutineAPI()
+{
+    ScFnRegister coroutine_api[] = {
+        { "Coroutine::Start^2",             API_FN_PAIR(Coroutine_Start) },
+        { "Coroutine::Wait^1",              API_FN_PAIR(Coroutine_Wait) },
+        { "Coroutine::WaitForCharacter^1",  API_FN_PAIR(Coroutine_WaitForCharacter) },
+        { "Coroutine::WaitForObject^1",     API_FN_PAIR(Coroutine_WaitForObject) },
+
+        { "Coroutine::Stop^0",              API_FN_PAIR(Coroutine_Stop) },
+        { "Coroutine::get_IsRunning",       API_FN_PAIR(Coroutine_GetIsRunning) },
+    };
+
+    ccAddExternalFunctions(coroutine_api);
+}
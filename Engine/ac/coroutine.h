@@ -0,0 +1,47 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Coroutines are script functions which run on their own script thread,
+// and may wait for a number of game loops, or for a character or object
+// to stop, without blocking the game. Waiting suspends the script thread,
+// and the scheduler resumes it once per game loop, when the wait is over.
+//
+// Coroutines are run right after repeatedly_execute_always, and same as it
+// cannot call blocking functions. They are not written to saves, and those
+// started by the room script are stopped when the room is unloaded.
+//
+//=============================================================================
+#ifndef __AGS_EE_AC__COROUTINE_H
+#define __AGS_EE_AC__COROUTINE_H
+
+#include "ac/dynobj/scriptcoroutine.h"
+
+struct CharacterInfo;
+struct ScriptObject;
+
+ScriptCoroutine *Coroutine_Start(const char *fn_name, int param);
+void Coroutine_Wait(int loops);
+void Coroutine_WaitForCharacter(CharacterInfo *chaa);
+void Coroutine_WaitForObject(ScriptObject *objj);
+void Coroutine_Stop(ScriptCoroutine *co);
+bool Coroutine_GetIsRunning(ScriptCoroutine *co);
+
+// Runs all the coroutines which are not waiting, once
+void update_coroutines();
+// Stops coroutines started by the room script
+void stop_room_coroutines();
+// Stops all the coroutines
+void stop_all_coroutines();
+
+#endif // __AGS_EE_AC__COROUTINE_H
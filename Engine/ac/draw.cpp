@@ -32,9 +32,11 @@
 #include "ac/global_gui.h"
 #include "ac/global_region.h"
 #include "ac/gui.h"
+#include "ac/lighting.h"
 #include "ac/mouse.h"
 #include "ac/movelist.h"
 #include "ac/overlay.h"
+#include "ac/particleemitter.h"
 #include "ac/sys_events.h"
 #include "ac/roomobject.h"
 #include "ac/roomstatus.h"
@@ -81,10 +83,13 @@ extern int displayed_room;
 extern CharacterInfo*playerchar;
 extern int eip_guinum;
 extern int cur_mode,cur_cursor;
-extern IDriverDependantBitmap *mouse_cur_ddb;
 extern int hotx,hoty;
 extern int bg_just_changed;
 
+// Render stage used to apply the lighting layer in the software mode;
+// this is a value above any of the plugin event ids
+const int kRenderStage_Lighting = AGSE_TOOHIGH;
+
 
 // TODO: refactor the draw unit into a virtual interface with
 // two implementations: for software and video-texture render,
@@ -124,6 +129,12 @@ COLOR_MAP maincoltable;
 IGraphicsDriver *gfxDriver = nullptr;
 IDriverDependantBitmap *blankImage = nullptr;
 IDriverDependantBitmap *blankSidebarImage = nullptr;
+// Current mouse cursor texture
+IDriverDependantBitmap *mouse_cur_ddb = nullptr;
+// Textures of generated mouse cursor variants; these are not kept in the
+// software mode, where the cursor's bitmap is used directly
+static const size_t MaxCursorVariants = 8;
+static std::vector<std::pair<CursorVariantKey, std::shared_ptr<Texture>>> cursor_variants;
 
 // ObjTexture is a helper struct that pairs a raw bitmap with
 // a renderer's texture and an optional position
@@ -383,6 +394,38 @@ std::vector<Point> overcache;
 IDriverDependantBitmap* roomBackgroundBmp = nullptr;
 // Whether room bg was modified
 bool current_background_is_dirty = false;
+// Resident texture set of a room background frame
+struct BgFrameTextures
+{
+    IDriverDependantBitmap *Bg = nullptr;
+    std::vector<ObjTexture> WalkBehinds;
+    bool HasWalkBehinds = false;
+
+    BgFrameTextures() = default;
+    BgFrameTextures(BgFrameTextures &&o) { *this = std::move(o); }
+    ~BgFrameTextures()
+    {
+        if (Bg)
+            gfxDriver->DestroyDDB(Bg);
+    }
+
+    BgFrameTextures &operator =(BgFrameTextures &&o)
+    {
+        if (Bg)
+            gfxDriver->DestroyDDB(Bg);
+        Bg = o.Bg;
+        o.Bg = nullptr;
+        WalkBehinds = std::move(o.WalkBehinds);
+        HasWalkBehinds = o.HasWalkBehinds;
+        return *this;
+    }
+};
+// Textures of the inactive room background frames (3D renderers only);
+// these are kept while all the room's frames fit into the memory budget,
+// and let switch the frames by swapping the texture sets.
+std::vector<BgFrameTextures> bgFrameTxs;
+// Background frame which textures are in roomBackgroundBmp and walkbehindobj
+int bgFrameTxNum = -1;
 
 
 // Buffer and info flags for viewport/camera pairs rendering in software mode
@@ -407,12 +450,16 @@ struct SpriteListEntry
     int id = -1; // user identifier, for any custom purpose
     IDriverDependantBitmap *ddb = nullptr;
     int x = 0, y = 0;
+    // Size of the sprite as it will be drawn (after scaling)
+    int width = 0, height = 0;
     int zorder = 0;
     // Tells if this item should take priority during sort if z1 == z2
     // TODO: this is some compatibility feature - find out if may be omited and done without extra struct?
     bool takesPriorityIfEqual = false;
     // Mark for the render stage callback (if >= 0 other fields are ignored)
     int renderStage = -1;
+    // Index of the particle emitter, which particles are drawn in place of ddb
+    int emitter = -1;
 };
 
 // Two lists of sprites to push into renderer during next render pass
@@ -795,6 +842,7 @@ void dispose_game_drawdata()
     if (mouse_cur_ddb)
         gfxDriver->DestroyDDB(mouse_cur_ddb);
     mouse_cur_ddb = nullptr;
+    cursor_variants.clear();
 
     charcache.clear();
     actsps.clear();
@@ -807,6 +855,8 @@ void dispose_game_drawdata()
     guiobjddbref.clear();
 
     dispose_engine_overlay();
+    dispose_lighting_drawdata();
+    dispose_particle_emitters_drawdata();
 }
 
 static void dispose_debug_room_drawdata()
@@ -819,6 +869,8 @@ void dispose_room_drawdata()
 {
     CameraDrawData.clear();
     dispose_invalid_regions(true);
+    reset_background_frame_cache();
+    dispose_lighting_drawdata();
 }
 
 void clear_drawobj_cache()
@@ -839,6 +891,7 @@ void clear_drawobj_cache()
     // cleanup Character + Room object textures
     for (auto &o : actsps) o = ObjTexture();
     for (auto &o : walkbehindobj) o = ObjTexture();
+    reset_background_frame_cache();
     // cleanup GUI and controls textures
     for (auto &o : guibg) o = ObjTexture();
     for (auto &tex : gui_render_tex)
@@ -1065,6 +1118,12 @@ void notify_sprite_changed(int sprnum, bool deleted)
     else
         update_shared_texture(sprnum);
 
+    // Drop any generated mouse cursor variants made of this sprite
+    cursor_variants.erase(std::remove_if(cursor_variants.begin(), cursor_variants.end(),
+        [sprnum](const std::pair<CursorVariantKey, std::shared_ptr<Texture>> &v)
+            { return v.first.Sprite == sprnum || v.first.DotSprite == sprnum; }),
+        cursor_variants.end());
+
     // For texture-based renderers updating a shared texture will already
     // update all the related drawn objects on screen; software renderer
     // will need to know to redraw active cached sprite for objects.
@@ -1132,6 +1191,61 @@ void texturecache_precache(uint32_t sprite_id)
     texturecache.GetOrLoad(sprite_id, nullptr, has_alpha, false);
 }
 
+// Attaches the texture to the mouse cursor, creating a cursor DDB if necessary
+static void attach_mouse_cursor_texture(std::shared_ptr<Texture> txdata, bool opaque = false)
+{
+    if (mouse_cur_ddb)
+        mouse_cur_ddb->AttachData(txdata, opaque);
+    else
+        mouse_cur_ddb = gfxDriver->CreateDDB(txdata, opaque);
+}
+
+void update_mouse_cursor_texture(uint32_t sprite_id, Bitmap *bmp, bool has_alpha)
+{
+    if (drawstate.SoftwareRender)
+    {
+        mouse_cur_ddb = recycle_ddb_bitmap(mouse_cur_ddb, bmp, has_alpha);
+        return;
+    }
+
+    // NOTE: we never update the cursor texture in place, because it may be
+    // shared with other objects; instead we attach either a shared sprite's
+    // texture, which is only uploaded if it's not in cache yet, or a new one.
+    std::shared_ptr<Texture> txdata;
+    if (sprite_id != UINT32_MAX)
+        txdata = texturecache.GetOrLoad(sprite_id, bmp, has_alpha, false);
+    if (!txdata)
+        txdata.reset(gfxDriver->CreateTexture(bmp, has_alpha, false));
+    attach_mouse_cursor_texture(txdata);
+}
+
+bool use_cached_cursor_variant(const CursorVariantKey &key)
+{
+    if (drawstate.SoftwareRender)
+        return false;
+    auto it = std::find_if(cursor_variants.begin(), cursor_variants.end(),
+        [&key](const std::pair<CursorVariantKey, std::shared_ptr<Texture>> &v) { return v.first == key; });
+    if (it == cursor_variants.end())
+        return false;
+    attach_mouse_cursor_texture(it->second);
+    return true;
+}
+
+void update_cursor_variant(const CursorVariantKey &key, Bitmap *bmp, bool has_alpha)
+{
+    if (drawstate.SoftwareRender)
+    {
+        mouse_cur_ddb = recycle_ddb_bitmap(mouse_cur_ddb, bmp, has_alpha);
+        return;
+    }
+
+    std::shared_ptr<Texture> txdata(gfxDriver->CreateTexture(bmp, has_alpha, false));
+    if (cursor_variants.size() >= MaxCursorVariants)
+        cursor_variants.erase(cursor_variants.begin()); // drop the oldest one
+    cursor_variants.push_back(std::make_pair(key, txdata));
+    attach_mouse_cursor_texture(txdata);
+}
+
 void mark_screen_dirty()
 {
     drawstate.ScreenIsDirty = true;
@@ -1172,6 +1286,76 @@ void mark_current_background_dirty()
     current_background_is_dirty = true;
 }
 
+void mark_background_frame_dirty(int frame)
+{
+    if (frame == play.bg_frame)
+    {
+        mark_current_background_dirty();
+        return;
+    }
+    if (static_cast<size_t>(frame) < bgFrameTxs.size())
+        bgFrameTxs[frame] = BgFrameTextures();
+    if (frame == bgFrameTxNum)
+        bgFrameTxNum = -1; // don't keep active textures when switching from this frame
+    if (frame == walkBehindsCachedForBgNum)
+        walkBehindsCachedForBgNum = -1;
+}
+
+void reset_background_frame_cache()
+{
+    bgFrameTxs.clear();
+    bgFrameTxNum = -1;
+}
+
+// Tells whether textures of all the room background frames may be kept at once
+static bool can_keep_background_frames()
+{
+    if (drawstate.SoftwareRender || (thisroom.BgFrameCount < 2) ||
+        (game.GetColorDepth() == 8)) // 8-bit textures depend on the current palette
+        return false;
+    // Reserve same amount of memory for the walk-behinds, which may take up to the whole frame
+    const Bitmap *bg = thisroom.BgFrames[0].Graphic.get();
+    const size_t frame_size = bg->GetWidth() * bg->GetHeight() * 4 /* 32-bit texture */ * 2;
+    return frame_size * thisroom.BgFrameCount <= usetup.BgFrameCacheSize * 1024;
+}
+
+// Puts away the active room background textures, and swaps in the
+// resident textures of the current frame (these may be empty if not created yet);
+// returns whether the texture sets were swapped.
+// NOTE: if the background was modified and the frame changed before the next
+// render (e.g. by drawing on it and then calling SetBackgroundFrame), the active
+// textures do not match the old frame's image anymore, and are discarded.
+static bool switch_background_frame_textures()
+{
+    const int old_frame = bgFrameTxNum;
+    const int new_frame = play.bg_frame;
+    bgFrameTxNum = new_frame;
+    if (!can_keep_background_frames())
+    {
+        bgFrameTxs.clear();
+        return false;
+    }
+    // Active textures are not known to belong to any valid frame
+    if (old_frame < 0)
+        return false;
+
+    bgFrameTxs.resize(thisroom.BgFrameCount);
+    BgFrameTextures &old_set = bgFrameTxs[old_frame];
+    old_set = BgFrameTextures();
+    std::swap(old_set.Bg, roomBackgroundBmp);
+    std::swap(old_set.WalkBehinds, walkbehindobj);
+    old_set.HasWalkBehinds = (walkBehindsCachedForBgNum == old_frame);
+    if (current_background_is_dirty)
+        old_set = BgFrameTextures();
+
+    BgFrameTextures &new_set = bgFrameTxs[new_frame];
+    std::swap(roomBackgroundBmp, new_set.Bg);
+    std::swap(walkbehindobj, new_set.WalkBehinds);
+    walkBehindsCachedForBgNum = new_set.HasWalkBehinds ? new_frame : -1;
+    new_set = BgFrameTextures();
+    return true;
+}
+
 
 void draw_and_invalidate_text(Bitmap *ds, int x1, int y1, int font, color_t text_color, const char *text)
 {
@@ -1411,6 +1595,8 @@ static void add_thing_to_draw(IDriverDependantBitmap* ddb, int x, int y)
     sprite.ddb = ddb;
     sprite.x = x;
     sprite.y = y;
+    sprite.width = ddb->GetWidth();
+    sprite.height = ddb->GetHeight();
     thingsToDrawList.push_back(sprite);
 }
 
@@ -1426,7 +1612,10 @@ static void clear_sprite_list()
     sprlist.clear();
 }
 
-static void add_to_sprite_list(IDriverDependantBitmap* ddb, int x, int y, int zorder, bool isWalkBehind, int id = -1)
+// Adds a sprite to the list; the optional draw_size tells the size of the sprite
+// on screen, if it's different from the texture size (e.g. when it's stretched).
+static void add_to_sprite_list(IDriverDependantBitmap* ddb, int x, int y, int zorder, bool isWalkBehind, int id = -1,
+    const Size &draw_size = Size())
 {
     assert(ddb);
     // completely invisible, so don't draw it at all
@@ -1439,6 +1628,8 @@ static void add_to_sprite_list(IDriverDependantBitmap* ddb, int x, int y, int zo
     sprite.zorder = zorder;
     sprite.x = x;
     sprite.y = y;
+    sprite.width = draw_size.IsNull() ? ddb->GetWidth() : draw_size.Width;
+    sprite.height = draw_size.IsNull() ? ddb->GetHeight() : draw_size.Height;
 
     if (drawstate.WalkBehindMethod == DrawAsSeparateSprite)
         sprite.takesPriorityIfEqual = !isWalkBehind;
@@ -1477,8 +1668,9 @@ static void draw_sprite_list(bool is_room)
     thingsToDrawList.insert(thingsToDrawList.end(), sprlist.begin(), sprlist.end());
 }
 
-// Push the gathered list of sprites into the active graphic renderer
-void put_sprite_list_on_screen(bool in_room);
+// Push the gathered list of sprites into the active graphic renderer;
+// optional cull_rc tells to skip sprites which do not intersect with it.
+void put_sprite_list_on_screen(bool in_room, const Rect *cull_rc = nullptr, int cam_id = -1);
 //
 //------------------------------------------------------------------------
 
@@ -2082,7 +2274,8 @@ void prepare_objects_for_drawing()
             Size(obj.last_width, obj.last_height), atx, aty, usebasel,
             (obj.flags & OBJF_NOWALKBEHINDS) == 0, obj.transparent, hw_accel);
         // Finally, add the texture to the draw list
-        add_to_sprite_list(actsp.Ddb, atx, aty, usebasel, false);
+        add_to_sprite_list(actsp.Ddb, atx, aty, usebasel, false, -1,
+            Size(obj.last_width, obj.last_height));
     }
 }
 
@@ -2192,7 +2385,8 @@ void prepare_characters_for_drawing()
             Size(chex.width, chex.height), atx, aty, usebasel,
             (chin.flags & CHF_NOWALKBEHINDS) == 0, chin.transparency, hw_accel);
         // Finally, add the texture to the draw list
-        add_to_sprite_list(actsp.Ddb, atx, aty, usebasel, false);
+        add_to_sprite_list(actsp.Ddb, atx, aty, usebasel, false, -1,
+            Size(chex.width, chex.height));
     }
 }
 
@@ -2216,17 +2410,40 @@ void add_walkbehind_image(size_t index, Common::Bitmap *bmp, int x, int y)
 }
 
 
+// Add visible particle emitters to the sprite list
+static void add_particle_emitters_for_drawing()
+{
+    const size_t count = get_particle_emitter_count();
+    for (size_t i = 0; i < count; ++i)
+    {
+        Rect area;
+        int zorder;
+        if (!prepare_particle_emitter_for_drawing(i, area, zorder))
+            continue;
+        SpriteListEntry sprite;
+        sprite.emitter = static_cast<int>(i);
+        sprite.x = area.Left;
+        sprite.y = area.Top;
+        sprite.width = area.GetWidth();
+        sprite.height = area.GetHeight();
+        sprite.zorder = zorder;
+        sprite.takesPriorityIfEqual = (drawstate.WalkBehindMethod == DrawAsSeparateSprite);
+        sprlist.push_back(sprite);
+    }
+}
+
 // Add active room overlays to the sprite list
 static void add_roomovers_for_drawing()
 {
     const auto &overs = get_overlays();
-    for (const auto &over : overs)
+    for (int over_id : get_active_overlays())
     {
-        if (over.type < 0) continue; // empty slot
+        const auto &over = overs[over_id];
         if (!over.IsRoomLayer()) continue; // not a room layer
         if (over.transparency == 255) continue; // skip fully transparent
         Point pos = get_overlay_position(over);
-        add_to_sprite_list(overtxs[over.type].Ddb, pos.X, pos.Y, over.zorder, false, over.creation_id);
+        add_to_sprite_list(overtxs[over.type].Ddb, pos.X, pos.Y, over.zorder, false, over.creation_id,
+            Size(over.scaleWidth, over.scaleHeight));
     }
 }
 
@@ -2236,7 +2453,14 @@ void prepare_room_sprites()
     // Background sprite is required for the non-software renderers always,
     // and for software renderer in case there are overlapping viewports.
     // Note that software DDB is just a tiny wrapper around bitmap, so overhead is negligible.
-    if (current_background_is_dirty || !roomBackgroundBmp)
+    bool bg_needs_update = false;
+    if (bgFrameTxNum != play.bg_frame)
+    {
+        // If the new frame's textures are kept, then the texture sets are swapped,
+        // otherwise the active textures are recreated from the new frame
+        bg_needs_update = !switch_background_frame_textures();
+    }
+    if (current_background_is_dirty || bg_needs_update || !roomBackgroundBmp)
     {
         roomBackgroundBmp =
             recycle_ddb_bitmap(roomBackgroundBmp, thisroom.BgFrames[play.bg_frame].Graphic.get(), false, true);
@@ -2261,6 +2485,7 @@ void prepare_room_sprites()
         prepare_objects_for_drawing();
         prepare_characters_for_drawing();
         add_roomovers_for_drawing();
+        add_particle_emitters_for_drawing();
 
         if ((debug_flags & DBG_NODRAWSPRITES) == 0)
         {
@@ -2288,6 +2513,16 @@ void prepare_room_sprites()
     }
     set_our_eip(36);
 
+    // Lighting layer goes over all the room sprites
+    if (is_lighting_enabled())
+    {
+        update_lighting(thisroom.Width, thisroom.Height);
+        if (drawstate.SoftwareRender)
+            add_render_stage(kRenderStage_Lighting);
+        else
+            add_thing_to_draw(get_lighting_ddb(), 0, 0);
+    }
+
     // Debug room overlay
     update_room_debug();
     if ((debugRoomMask != kRoomAreaNone) && debugRoomMaskObj.Ddb)
@@ -2489,13 +2724,14 @@ void draw_gui_and_overlays()
 
     // Add active overlays to the sprite list
     const auto &overs = get_overlays();
-    for (const auto &over : overs)
+    for (int over_id : get_active_overlays())
     {
-        if (over.type < 0) continue; // empty slot
+        const auto &over = overs[over_id];
         if (over.IsRoomLayer()) continue; // not a ui layer
         if (over.transparency == 255) continue; // skip fully transparent
         Point pos = get_overlay_position(over);
-        add_to_sprite_list(overtxs[over.type].Ddb, pos.X, pos.Y, over.zorder, false, over.creation_id);
+        add_to_sprite_list(overtxs[over.type].Ddb, pos.X, pos.Y, over.zorder, false, over.creation_id,
+            Size(over.scaleWidth, over.scaleHeight));
     }
 
     // Add GUIs
@@ -2510,6 +2746,8 @@ void draw_gui_and_overlays()
         else
             GUI::Context.InventoryPic = game.invinfo[playerchar->activeinv].pic;
         set_our_eip(37);
+        // Update labels which display special macros, if their values had changed
+        GUIE::UpdateSpecialLabels();
         // Prepare and update GUI textures
         {
             for (int index = 0; index < game.numgui; ++index)
@@ -2594,20 +2832,47 @@ void draw_gui_and_overlays()
 }
 
 // Push the gathered list of sprites into the active graphic renderer
-void put_sprite_list_on_screen(bool in_room)
+void put_sprite_list_on_screen(bool in_room, const Rect *cull_rc, int cam_id)
 {
     for (const auto &t : thingsToDrawList)
     {
-        assert(t.ddb || (t.renderStage >= 0));
+        assert(t.ddb || (t.renderStage >= 0) || (t.emitter >= 0));
         if (t.ddb)
         {
             if (t.ddb->GetAlpha() == 0)
                 continue; // skip completely invisible things
+            if (cull_rc && !AreRectsIntersecting(*cull_rc, RectWH(t.x, t.y, t.width, t.height)))
+                continue; // skip things outside of the camera
             // mark the image's region as dirty
             invalidate_sprite(t.x, t.y, t.ddb, in_room);
             // push to the graphics driver
             gfxDriver->DrawSprite(t.x, t.y, t.ddb);
         }
+        else if (t.emitter >= 0)
+        {
+            if (cull_rc && !AreRectsIntersecting(*cull_rc, RectWH(t.x, t.y, t.width, t.height)))
+                continue;
+            invalidate_rect(t.x, t.y, t.x + t.width, t.y + t.height, in_room);
+            // Particles are pushed as a nested batch, which inherits the room
+            // camera's transform; except for the software renderer, which does
+            // not combine the batch transforms, and draws them in the room's batch
+            if (!drawstate.SoftwareRender)
+                gfxDriver->BeginSpriteBatch(Rect(), SpriteTransform());
+            draw_particle_emitter(t.emitter);
+            if (!drawstate.SoftwareRender)
+                gfxDriver->EndSpriteBatch();
+        }
+        else if (t.renderStage == kRenderStage_Lighting)
+        {
+            // Darkness is blended right into the camera surface, so the pixels
+            // kept from the previous frame would get darkened again. Because of
+            // that the whole camera is marked dirty, and its background is fully
+            // restored on the next frame: while lighting is enabled the software
+            // renderer redraws the whole room camera every frame.
+            if (cull_rc)
+                invalidate_rect(cull_rc->Left, cull_rc->Top, cull_rc->Right + 1, cull_rc->Bottom + 1, in_room);
+            gfxDriver->DrawSprite(t.renderStage, cam_id, nullptr);
+        }
         else if (t.renderStage >= 0)
         {
             // meta entry to run the plugin hook
@@ -2625,6 +2890,13 @@ bool GfxDriverSpriteEvtCallback(int evt, int data)
         // if no room loaded, various stuff won't be initialized yet
         return false;
     }
+    if (evt == kRenderStage_Lighting)
+    {
+        // software renderer's stage is the camera's surface, data is camera's ID
+        const Rect &cam_rc = play.GetRoomCamera(data)->GetRect();
+        draw_lighting(gfxDriver->GetStageBackBuffer(true), cam_rc.Left, cam_rc.Top);
+        return true;
+    }
     return (pl_run_plugin_hooks(evt, data) != 0);
 }
 
@@ -2634,6 +2906,8 @@ void GfxDriverOnInitCallback(void *data)
 }
 
 // Schedule room rendering: background, objects, characters
+// NOTE: the room sprite list is prepared only once, and then shared by all
+// the visible cameras; each camera only receives sprites that intersect it.
 static void construct_room_view()
 {
     draw_preroom_background();
@@ -2665,7 +2939,7 @@ static void construct_room_view()
             gfxDriver->BeginSpriteBatch(view_rc, view_trans);
             gfxDriver->BeginSpriteBatch(Rect(), cam_trans);
             gfxDriver->SetStageScreen(cam_rc.GetSize(), cam_rc.Left, cam_rc.Top);
-            put_sprite_list_on_screen(true);
+            put_sprite_list_on_screen(true, &cam_rc, camera->GetID());
             gfxDriver->EndSpriteBatch();
             gfxDriver->EndSpriteBatch();
         }
@@ -2694,7 +2968,7 @@ static void construct_room_view()
                 PBitmap bg_surface = draw_room_background(viewport.get());
                 gfxDriver->BeginSpriteBatch(Rect(), cam_trans, kFlip_None, bg_surface);
             }
-            put_sprite_list_on_screen(true);
+            put_sprite_list_on_screen(true, &cam_rc, camera->GetID());
             gfxDriver->EndSpriteBatch();
             gfxDriver->EndSpriteBatch();
         }
@@ -2719,18 +2993,18 @@ static void construct_overlays()
     const bool is_software_mode = drawstate.SoftwareRender;
     const bool crop_walkbehinds = (drawstate.WalkBehindMethod == DrawOverCharSprite);
 
+    // Textures follow the overlay slots, which may grow or be trimmed
     auto &overs = get_overlays();
-    if (overtxs.size() < overs.size())
+    if (overtxs.size() != overs.size())
     {
         overtxs.resize(overs.size());
         if (is_software_mode)
             overcache.resize(overs.size(), Point(INT32_MIN, INT32_MIN));
     }
 
-    for (size_t i = 0; i < overs.size(); ++i)
+    for (int i : get_active_overlays())
     {
         auto &over = overs[i];
-        if (over.type < 0) continue; // empty slot
         if (over.transparency == 255) continue; // skip fully transparent
 
         auto &overtx = overtxs[i];
@@ -99,6 +99,31 @@ void clear_shared_texture(uint32_t sprite_id);
 // Prepares a texture for the given sprite and stores in the cache
 void texturecache_precache(uint32_t sprite_id);
 
+// Identifies a generated variant of the mouse cursor image,
+// such as inventory cursor with a hotspot marker drawn over
+struct CursorVariantKey
+{
+    int Sprite = -1; // base cursor sprite
+    int HotX = 0, HotY = 0; // hotspot position
+    int DotColor = 0, DotOuterColor = 0; // hotspot dot colors
+    int DotSprite = 0; // hotspot marker sprite
+
+    bool operator ==(const CursorVariantKey &other) const
+    {
+        return Sprite == other.Sprite && HotX == other.HotX && HotY == other.HotY &&
+            DotColor == other.DotColor && DotOuterColor == other.DotOuterColor &&
+            DotSprite == other.DotSprite;
+    }
+};
+// Assigns mouse cursor image: either a sprite, which texture is shared with
+// other objects, or a generated bitmap (pass sprite_id = UINT32_MAX)
+void update_mouse_cursor_texture(uint32_t sprite_id, Common::Bitmap *bmp, bool has_alpha);
+// Assigns mouse cursor image from the cached generated variant;
+// returns false if such variant is not cached
+bool use_cached_cursor_variant(const CursorVariantKey &key);
+// Assigns mouse cursor image from the newly generated variant, and caches it
+void update_cursor_variant(const CursorVariantKey &key, Common::Bitmap *bmp, bool has_alpha);
+
 // whether there are currently remnants of a DisplaySpeech
 void mark_screen_dirty();
 bool is_screen_dirty();
@@ -112,6 +137,10 @@ void invalidate_camera_frame(int index);
 void invalidate_rect(int x1, int y1, int x2, int y2, bool in_room);
 
 void mark_current_background_dirty();
+// Notifies that the given room background frame was modified
+void mark_background_frame_dirty(int frame);
+// Discards the resident textures of the inactive room background frames
+void reset_background_frame_cache();
 
 // Avoid freeing and reallocating the memory if possible
 Common::Bitmap *recycle_bitmap(Common::Bitmap *bimp, int coldep, int wid, int hit, bool make_transparent = false);
@@ -51,8 +51,8 @@ void DrawingSurface_Release(ScriptDrawingSurface* sds)
             if (sds->roomBackgroundNumber == play.bg_frame)
             {
                 invalidate_screen();
-                mark_current_background_dirty();
             }
+            mark_background_frame_dirty(sds->roomBackgroundNumber);
             play.raw_modified[sds->roomBackgroundNumber] = 1;
         }
 
@@ -63,6 +63,7 @@ void DrawingSurface_Release(ScriptDrawingSurface* sds)
         if (sds->roomMaskType == kRoomAreaWalkBehind)
         {
             walkbehinds_recalc();
+            reset_background_frame_cache();
         }
         sds->roomMaskType = kRoomAreaNone;
     }
@@ -377,19 +378,8 @@ void DrawingSurface_DrawLine(ScriptDrawingSurface *sds, int fromx, int fromy, in
     sds->PointToGameResolution(&fromx, &fromy);
     sds->PointToGameResolution(&tox, &toy);
     sds->SizeToGameResolution(&thickness);
-    int ii,jj,xx,yy;
     Bitmap *ds = sds->StartDrawing();
-    // draw several lines to simulate the thickness
-    color_t draw_color = sds->currentColour;
-    for (ii = 0; ii < thickness; ii++) 
-    {
-        xx = (ii - (thickness / 2));
-        for (jj = 0; jj < thickness; jj++)
-        {
-            yy = (jj - (thickness / 2));
-            ds->DrawLine (Line(fromx + xx, fromy + yy, tox + xx, toy + yy), draw_color);
-        }
-    }
+    ds->DrawThickLine(Line(fromx, fromy, tox, toy), thickness, sds->currentColour);
     sds->FinishedDrawing();
 }
 
@@ -397,17 +387,9 @@ void DrawingSurface_DrawPixel(ScriptDrawingSurface *sds, int x, int y) {
     sds->PointToGameResolution(&x, &y);
     int thickness = 1;
     sds->SizeToGameResolution(&thickness);
-    int ii,jj;
     Bitmap *ds = sds->StartDrawing();
-    // draw several pixels to simulate the thickness
-    color_t draw_color = sds->currentColour;
-    for (ii = 0; ii < thickness; ii++) 
-    {
-        for (jj = 0; jj < thickness; jj++)
-        {
-            ds->PutPixel(x + ii, y + jj, draw_color);
-        }
-    }
+    // draw a square to simulate the thickness
+    ds->FillRect(RectWH(x, y, thickness, thickness), sds->currentColour);
     sds->FinishedDrawing();
 }
 
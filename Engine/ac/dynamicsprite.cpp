@@ -25,12 +25,15 @@
 #include "ac/roomobject.h"
 #include "ac/roomstatus.h"
 #include "ac/system.h"
+#include "ac/dynobj/cc_dynamicarray.h"
 #include "ac/dynobj/dynobj_manager.h"
 #include "debug/debug_log.h"
 #include "game/roomstruct.h"
 #include "gui/guibutton.h"
 #include "ac/spritecache.h"
+#include "gfx/gfx_util.h"
 #include "gfx/graphicsdriver.h"
+#include "gfx/image_filter.h"
 #include "script/runtimescriptvalue.h"
 
 using namespace Common;
@@ -257,6 +260,131 @@ void DynamicSprite_Tint(ScriptDynamicSprite *sds, int red, int green, int blue,
     game_sprite_updated(sds->slot);
 }
 
+// Makes a 32-bit copy of the sprite for the image filters, which represents
+// the sprite's transparency with the alpha channel
+static std::unique_ptr<Bitmap> create_filter_bitmap(int slot)
+{
+    Bitmap *sprite = spriteset[slot];
+    std::unique_ptr<Bitmap> bmp(sprite->GetColorDepth() == 32 ?
+        BitmapHelper::CreateBitmapCopy(sprite) : GfxUtil::ConvertBitmap(sprite, 32));
+    if ((game.SpriteInfos[slot].Flags & SPF_ALPHACHANNEL) == 0)
+        BitmapHelper::MakeOpaqueSkipMask(bmp.get());
+    return bmp;
+}
+
+// Runs the filter function over the dynamic sprite's image and replaces it.
+// Filters may produce partially transparent pixels, so the 32-bit sprites
+// receive an alpha channel; the sprites of lower color depth are converted
+// back, keeping only the fully transparent pixels.
+template <typename TFilterFn>
+static void apply_image_filter(ScriptDynamicSprite *sds, const char *api_name, const TFilterFn &filter_fn)
+{
+    if (sds->slot == 0)
+        quitprintf("!%s: sprite has been deleted", api_name);
+    const int color_depth = spriteset[sds->slot]->GetColorDepth();
+    if (color_depth == 8)
+        quitprintf("!%s: image filters are not supported for 8-bit sprites", api_name);
+
+    std::unique_ptr<Bitmap> new_pic = create_filter_bitmap(sds->slot);
+    filter_fn(new_pic.get());
+    if (color_depth < 32)
+    {
+        BitmapHelper::ReplaceAlphaWithRGBMask(new_pic.get());
+        new_pic.reset(GfxUtil::ConvertBitmap(new_pic.get(), color_depth));
+    }
+
+    add_dynamic_sprite(sds->slot, std::move(new_pic), color_depth == 32);
+    game_sprite_updated(sds->slot);
+}
+
+// Gets the number of elements in the script float array, fails if it's null
+static uint32_t get_float_array_length(void *arr, const char *api_name)
+{
+    if (!arr)
+        quitprintf("!%s: array is null", api_name);
+    return CCDynamicArray::GetHeader(arr).ElemCount & (~ARRAY_MANAGED_TYPE_FLAG);
+}
+
+void DynamicSprite_BoxBlur(ScriptDynamicSprite *sds, int radius)
+{
+    if (radius < 0)
+        quit("!DynamicSprite.BoxBlur: radius cannot be negative");
+    radius = data_to_game_coord(radius);
+    apply_image_filter(sds, "DynamicSprite.BoxBlur",
+        [radius](Bitmap *bmp) { ImageFilter::BoxBlur(bmp, radius); });
+}
+
+void DynamicSprite_GaussianBlur(ScriptDynamicSprite *sds, int radius)
+{
+    if (radius < 0)
+        quit("!DynamicSprite.GaussianBlur: radius cannot be negative");
+    radius = data_to_game_coord(radius);
+    apply_image_filter(sds, "DynamicSprite.GaussianBlur",
+        [radius](Bitmap *bmp) { ImageFilter::GaussianBlur(bmp, radius); });
+}
+
+void DynamicSprite_HighPass(ScriptDynamicSprite *sds, int radius)
+{
+    if (radius < 0)
+        quit("!DynamicSprite.HighPass: radius cannot be negative");
+    radius = data_to_game_coord(radius);
+    apply_image_filter(sds, "DynamicSprite.HighPass",
+        [radius](Bitmap *bmp) { ImageFilter::HighPass(bmp, radius); });
+}
+
+void DynamicSprite_Threshold(ScriptDynamicSprite *sds, int level)
+{
+    apply_image_filter(sds, "DynamicSprite.Threshold",
+        [level](Bitmap *bmp) { ImageFilter::Threshold(bmp, level); });
+}
+
+void DynamicSprite_Convolve(ScriptDynamicSprite *sds, void *kernel_arr, int width, int height, int bias)
+{
+    const uint32_t arr_len = get_float_array_length(kernel_arr, "DynamicSprite.Convolve");
+    if ((width < 1) || (width > ImageFilter::MaxKernelSize) || (width % 2 == 0) ||
+        (height < 1) || (height > ImageFilter::MaxKernelSize) || (height % 2 == 0))
+        quitprintf("!DynamicSprite.Convolve: kernel size must be odd, from 1 to %d, got %d x %d",
+            ImageFilter::MaxKernelSize, width, height);
+    if (arr_len < static_cast<uint32_t>(width * height))
+        quitprintf("!DynamicSprite.Convolve: kernel array is too short, %u elements for %d x %d",
+            arr_len, width, height);
+
+    const float *kernel = static_cast<const float*>(kernel_arr);
+    apply_image_filter(sds, "DynamicSprite.Convolve",
+        [=](Bitmap *bmp) { ImageFilter::Convolve(bmp, kernel, width, height, static_cast<float>(bias)); });
+}
+
+void DynamicSprite_ApplyColorMatrix(ScriptDynamicSprite *sds, void *matrix_arr)
+{
+    const uint32_t arr_len = get_float_array_length(matrix_arr, "DynamicSprite.ApplyColorMatrix");
+    if (arr_len < ImageFilter::ColorMatrixSize)
+        quitprintf("!DynamicSprite.ApplyColorMatrix: matrix array must have %d elements, got %u",
+            ImageFilter::ColorMatrixSize, arr_len);
+
+    const float *matrix = static_cast<const float*>(matrix_arr);
+    apply_image_filter(sds, "DynamicSprite.ApplyColorMatrix",
+        [matrix](Bitmap *bmp) { ImageFilter::ApplyColorMatrix(bmp, matrix); });
+}
+
+void DynamicSprite_BlendSprite(ScriptDynamicSprite *sds, int slot, int mode, int x, int y, int transparency)
+{
+    if (!spriteset.DoesSpriteExist(slot))
+        quitprintf("!DynamicSprite.BlendSprite: sprite %d does not exist", slot);
+    if ((mode < kImageBlend_Normal) || (mode >= kNumImageBlendModes))
+        quitprintf("!DynamicSprite.BlendSprite: invalid blend mode %d", mode);
+    if (spriteset[slot]->GetColorDepth() == 8)
+        quit("!DynamicSprite.BlendSprite: image filters are not supported for 8-bit sprites");
+    if ((transparency < 0) || (transparency > 100))
+        quitprintf("!DynamicSprite.BlendSprite: invalid transparency %d, must be between 0 and 100", transparency);
+
+    data_to_game_coords(&x, &y);
+    // NOTE: the source may be the same sprite, so make its copy first
+    std::unique_ptr<Bitmap> src = create_filter_bitmap(slot);
+    const int alpha = GfxDef::Trans100ToAlpha255(transparency);
+    apply_image_filter(sds, "DynamicSprite.BlendSprite", [&](Bitmap *bmp)
+        { ImageFilter::Blend(bmp, src.get(), x, y, static_cast<ImageBlendMode>(mode), alpha); });
+}
+
 int DynamicSprite_SaveToFile(ScriptDynamicSprite *sds, const char* namm)
 {
     if (sds->slot == 0)
@@ -544,6 +672,48 @@ RuntimeScriptValue Sc_DynamicSprite_Rotate(void *self, const RuntimeScriptValue
     API_OBJCALL_VOID_PINT3(ScriptDynamicSprite, DynamicSprite_Rotate);
 }
 
+// void (ScriptDynamicSprite *sds, void *matrix_arr)
+RuntimeScriptValue Sc_DynamicSprite_ApplyColorMatrix(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_POBJ(ScriptDynamicSprite, DynamicSprite_ApplyColorMatrix, void);
+}
+
+// void (ScriptDynamicSprite *sds, int slot, int mode, int x, int y, int transparency)
+RuntimeScriptValue Sc_DynamicSprite_BlendSprite(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT5(ScriptDynamicSprite, DynamicSprite_BlendSprite);
+}
+
+// void (ScriptDynamicSprite *sds, int radius)
+RuntimeScriptValue Sc_DynamicSprite_BoxBlur(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptDynamicSprite, DynamicSprite_BoxBlur);
+}
+
+// void (ScriptDynamicSprite *sds, void *kernel_arr, int width, int height, int bias)
+RuntimeScriptValue Sc_DynamicSprite_Convolve(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_POBJ_PINT3(ScriptDynamicSprite, DynamicSprite_Convolve, void);
+}
+
+// void (ScriptDynamicSprite *sds, int radius)
+RuntimeScriptValue Sc_DynamicSprite_GaussianBlur(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptDynamicSprite, DynamicSprite_GaussianBlur);
+}
+
+// void (ScriptDynamicSprite *sds, int radius)
+RuntimeScriptValue Sc_DynamicSprite_HighPass(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptDynamicSprite, DynamicSprite_HighPass);
+}
+
+// void (ScriptDynamicSprite *sds, int level)
+RuntimeScriptValue Sc_DynamicSprite_Threshold(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptDynamicSprite, DynamicSprite_Threshold);
+}
+
 // int (ScriptDynamicSprite *sds, const char* namm)
 RuntimeScriptValue Sc_DynamicSprite_SaveToFile(void *self, const RuntimeScriptValue *params, int32_t param_count)
 {
@@ -655,6 +825,14 @@ void RegisterDynamicSpriteAPI()
         { "DynamicSprite::get_Graphic",               API_FN_PAIR(DynamicSprite_GetGraphic) },
         { "DynamicSprite::get_Height",                API_FN_PAIR(DynamicSprite_GetHeight) },
         { "DynamicSprite::get_Width",                 API_FN_PAIR(DynamicSprite_GetWidth) },
+
+        { "DynamicSprite::ApplyColorMatrix^1",        API_FN_PAIR(DynamicSprite_ApplyColorMatrix) },
+        { "DynamicSprite::BlendSprite^5",             API_FN_PAIR(DynamicSprite_BlendSprite) },
+        { "DynamicSprite::BoxBlur^1",                 API_FN_PAIR(DynamicSprite_BoxBlur) },
+        { "DynamicSprite::Convolve^4",                API_FN_PAIR(DynamicSprite_Convolve) },
+        { "DynamicSprite::GaussianBlur^1",            API_FN_PAIR(DynamicSprite_GaussianBlur) },
+        { "DynamicSprite::HighPass^1",                API_FN_PAIR(DynamicSprite_HighPass) },
+        { "DynamicSprite::Threshold^1",               API_FN_PAIR(DynamicSprite_Threshold) },
     };
 
     ccAddExternalFunctions(dynsprite_api);
@@ -34,6 +34,13 @@ void	DynamicSprite_ChangeCanvasSize(ScriptDynamicSprite *sds, int width, int hei
 void	DynamicSprite_Crop(ScriptDynamicSprite *sds, int x1, int y1, int width, int height);
 void	DynamicSprite_Rotate(ScriptDynamicSprite *sds, int angle, int width, int height);
 void	DynamicSprite_Tint(ScriptDynamicSprite *sds, int red, int green, int blue, int saturation, int luminance);
+void	DynamicSprite_BoxBlur(ScriptDynamicSprite *sds, int radius);
+void	DynamicSprite_GaussianBlur(ScriptDynamicSprite *sds, int radius);
+void	DynamicSprite_HighPass(ScriptDynamicSprite *sds, int radius);
+void	DynamicSprite_Threshold(ScriptDynamicSprite *sds, int level);
+void	DynamicSprite_Convolve(ScriptDynamicSprite *sds, void *kernel_arr, int width, int height, int bias);
+void	DynamicSprite_ApplyColorMatrix(ScriptDynamicSprite *sds, void *matrix_arr);
+void	DynamicSprite_BlendSprite(ScriptDynamicSprite *sds, int slot, int mode, int x, int y, int transparency);
 int		DynamicSprite_SaveToFile(ScriptDynamicSprite *sds, const char* namm);
 ScriptDynamicSprite* DynamicSprite_CreateFromSaveGame(int sgslot, int width, int height);
 ScriptDynamicSprite* DynamicSprite_CreateFromFile(const char *filename);
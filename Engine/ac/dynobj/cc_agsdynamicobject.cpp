@@ -28,6 +28,16 @@ int CCBasicObject::Serialize(void* /*address*/, uint8_t* /*buffer*/, int /*bufsi
     return 0; // does not save data
 }
 
+size_t CCBasicObject::CalcSerializeSize(const void* /*address*/)
+{
+    return 0; // does not save data
+}
+
+void CCBasicObject::Serialize(const void* /*address*/, Stream* /*out*/)
+{
+    // does not save data
+}
+
 void *CCBasicObject::GetFieldPtr(void *address, intptr_t offset)
 {
     return static_cast<uint8_t*>(address) + offset;
@@ -52,6 +52,9 @@ public:
     // Serialize the object into BUFFER (which is BUFSIZE bytes)
     // return number of bytes used
     int Serialize(void* /*address*/, uint8_t* /*buffer*/, int /*bufsize*/) override;
+    // Does not save any data
+    size_t CalcSerializeSize(const void* /*address*/) override;
+    void Serialize(const void* /*address*/, AGS::Common::Stream* /*out*/) override;
 
     //
     // Legacy support for reading and writing object fields by their relative offset
@@ -86,12 +89,11 @@ public:
     // Try unserializing the object from the given input stream
     virtual void Unserialize(int index, AGS::Common::Stream *in, size_t data_sz) = 0;
 
-protected:
     // Savegame serialization
     // Calculate and return required space for serialization, in bytes
-    virtual size_t CalcSerializeSize(const void *address) = 0;
+    size_t CalcSerializeSize(const void *address) override = 0;
     // Write object data into the provided stream
-    virtual void Serialize(const void *address, AGS::Common::Stream *out) = 0;
+    void Serialize(const void *address, AGS::Common::Stream *out) override = 0;
 };
 
 
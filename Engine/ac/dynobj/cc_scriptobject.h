@@ -25,6 +25,7 @@
 #include <utility>
 #include "core/types.h"
 
+namespace AGS { namespace Common { class Stream; } }
 
 struct IScriptObject;
 
@@ -94,6 +95,12 @@ struct IScriptObject
     virtual void    WriteInt32(void *address, intptr_t offset, int32_t val)   = 0;
     virtual void    WriteFloat(void *address, intptr_t offset, float val)     = 0;
 
+    // Savegame serialization, writing directly into the output stream.
+    // Calculate and return the exact required space for serialization, in bytes
+    virtual size_t  CalcSerializeSize(const void *address)                    = 0;
+    // Write object data into the provided stream
+    virtual void    Serialize(const void *address, AGS::Common::Stream *out)  = 0;
+
 protected:
     IScriptObject() = default;
     ~IScriptObject() = default;
@@ -104,6 +111,11 @@ struct ICCObjectCollectionReader
 {
     // TODO: pass savegame format version
     virtual void Unserialize(int32_t handle, const char *objectType, const char *serializedData, int dataSize) = 0;
+    // Finds a reader for the given type name, returns its id, or -1 if no such type is supported.
+    // The id is only valid until the list of registered readers changes.
+    virtual int  FindTypeReader(const char *objectType) = 0;
+    // Unserializes an object of data_sz bytes from the stream, using the reader found by FindTypeReader
+    virtual void Unserialize(int32_t handle, int type_reader, AGS::Common::Stream *in, size_t data_sz) = 0;
 };
 
 // The interface of a script objects deserializer that handles a single type.
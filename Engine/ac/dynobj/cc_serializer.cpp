@@ -20,7 +20,9 @@
 #include "ac/dynobj/scriptuserobject.h"
 #include "ac/dynobj/scriptcamera.h"
 #include "ac/dynobj/scriptcontainers.h"
+#include "ac/dynobj/scriptcoroutine.h"
 #include "ac/dynobj/scriptfile.h"
+#include "ac/dynobj/scriptparticleemitter.h"
 #include "ac/dynobj/scriptviewport.h"
 #include "ac/game.h"
 #include "debug/debug_log.h"
@@ -46,131 +48,156 @@ extern std::vector<PluginObjectReader> pluginReaders;
 
 // *** De-serialization of script objects
 
-void AGSDeSerializer::Unserialize(int index, const char *objectType, const char *serializedData, int dataSize) {
+// TODO: consider this: there are object types that are part of the
+// script's foundation, because they are created by the bytecode ops:
+// such as DynamicArray and UserObject. *Maybe* these should be moved
+// to certain "base serializer" class which guarantees their restoration.
+//
+// TODO: should we support older save versions here (DynArray, UserObj)?
+// might have to use older class names to distinguish save formats
 
-    if (dataSize < 0)
-    {
-        quitprintf("Unserialise: invalid data size (%d) for object type '%s'", dataSize, objectType);
-        return; // TODO: don't quit, return error
-    }
-    // Note that while our builtin classes may accept Stream object,
-    // classes registered by plugin cannot, because streams are not (yet)
-    // part of the plugin API.
-    size_t data_sz = static_cast<size_t>(dataSize);
-    assert(data_sz <= INT32_MAX); // dynamic object API does not support size > int32
-    Stream mems(std::make_unique<MemoryStream>(reinterpret_cast<const uint8_t*>(serializedData), dataSize));
+typedef void (*PfnUnserializeObject)(int index, Stream *in, size_t data_sz);
 
-    // TODO: consider this: there are object types that are part of the
-    // script's foundation, because they are created by the bytecode ops:
-    // such as DynamicArray and UserObject. *Maybe* these should be moved
-    // to certain "base serializer" class which guarantees their restoration.
-    //
-    // TODO: should we support older save versions here (DynArray, UserObj)?
-    // might have to use older class names to distinguish save formats
-    if (strcmp(objectType, CCDynamicArray::TypeName) == 0) {
-        globalDynamicArray.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, ScriptUserObject::TypeName) == 0) {
-        ScriptUserObject *suo = new ScriptUserObject();
-        suo->Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "GUIObject") == 0) {
-        ccDynamicGUIObject.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Character") == 0) {
-        ccDynamicCharacter.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Hotspot") == 0) {
-        ccDynamicHotspot.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Region") == 0) {
-        ccDynamicRegion.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Inventory") == 0) {
-        ccDynamicInv.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Dialog") == 0) {
-        ccDynamicDialog.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "GUI") == 0) {
-        ccDynamicGUI.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "Object") == 0) {
-        ccDynamicObject.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "String") == 0) {
-        myScriptStringImpl.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "File") == 0) {
-        // files cannot be restored properly -- so just recreate
-        // the object; attempting any operations on it will fail
-        sc_File *scf = new sc_File();
-        ccRegisterUnserializedObject(index, scf, scf);
-    }
-    else if (strcmp(objectType, "Overlay") == 0) {
-        ScriptOverlay *scf = new ScriptOverlay();
-        scf->Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "DateTime") == 0) {
-        ScriptDateTime *scf = new ScriptDateTime();
-        scf->Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "ViewFrame") == 0) {
-        ScriptViewFrame *scf = new ScriptViewFrame();
-        scf->Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "DynamicSprite") == 0) {
-        ScriptDynamicSprite *scf = new ScriptDynamicSprite();
-        scf->Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "DrawingSurface") == 0) {
-        ScriptDrawingSurface *sds = new ScriptDrawingSurface();
-        sds->Unserialize(index, &mems, data_sz);
+struct BuiltinObjectReader
+{
+    const char *Type;
+    PfnUnserializeObject Unserialize;
+};
 
-        if (sds->isLinkedBitmapOnly)
+static const BuiltinObjectReader BuiltinReaders[] = {
+    { CCDynamicArray::TypeName, [](int index, Stream *in, size_t data_sz)
+        { globalDynamicArray.Unserialize(index, in, data_sz); } },
+    { ScriptUserObject::TypeName, [](int index, Stream *in, size_t data_sz)
+        { ScriptUserObject *suo = new ScriptUserObject(); suo->Unserialize(index, in, data_sz); } },
+    { "GUIObject", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicGUIObject.Unserialize(index, in, data_sz); } },
+    { "Character", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicCharacter.Unserialize(index, in, data_sz); } },
+    { "Hotspot", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicHotspot.Unserialize(index, in, data_sz); } },
+    { "Region", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicRegion.Unserialize(index, in, data_sz); } },
+    { "Inventory", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicInv.Unserialize(index, in, data_sz); } },
+    { "Dialog", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicDialog.Unserialize(index, in, data_sz); } },
+    { "GUI", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicGUI.Unserialize(index, in, data_sz); } },
+    { "Object", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicObject.Unserialize(index, in, data_sz); } },
+    { "String", [](int index, Stream *in, size_t data_sz)
+        { myScriptStringImpl.Unserialize(index, in, data_sz); } },
+    { "File", [](int index, Stream* /*in*/, size_t /*data_sz*/)
         {
-            dialogOptionsRenderingSurface = sds;
-        }
-    }
-    else if (strcmp(objectType, "DialogOptionsRendering") == 0)
-    {
-        ccDialogOptionsRendering.Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "StringDictionary") == 0)
-    {
-        Dict_Unserialize(index, &mems, data_sz);
-    }
-    else if (strcmp(objectType, "StringSet") == 0)
+            // files cannot be restored properly -- so just recreate
+            // the object; attempting any operations on it will fail
+            sc_File *scf = new sc_File();
+            ccRegisterUnserializedObject(index, scf, scf);
+        } },
+    { "Overlay", [](int index, Stream *in, size_t data_sz)
+        { ScriptOverlay *scf = new ScriptOverlay(); scf->Unserialize(index, in, data_sz); } },
+    { "DateTime", [](int index, Stream *in, size_t data_sz)
+        { ScriptDateTime *scf = new ScriptDateTime(); scf->Unserialize(index, in, data_sz); } },
+    { "ViewFrame", [](int index, Stream *in, size_t data_sz)
+        { ScriptViewFrame *scf = new ScriptViewFrame(); scf->Unserialize(index, in, data_sz); } },
+    { "DynamicSprite", [](int index, Stream *in, size_t data_sz)
+        { ScriptDynamicSprite *scf = new ScriptDynamicSprite(); scf->Unserialize(index, in, data_sz); } },
+    { "DrawingSurface", [](int index, Stream *in, size_t data_sz)
+        {
+            ScriptDrawingSurface *sds = new ScriptDrawingSurface();
+            sds->Unserialize(index, in, data_sz);
+            if (sds->isLinkedBitmapOnly)
+            {
+                dialogOptionsRenderingSurface = sds;
+            }
+        } },
+    { "DialogOptionsRendering", [](int index, Stream *in, size_t data_sz)
+        { ccDialogOptionsRendering.Unserialize(index, in, data_sz); } },
+    { "StringDictionary", [](int index, Stream *in, size_t data_sz)
+        { Dict_Unserialize(index, in, data_sz); } },
+    { "StringSet", [](int index, Stream *in, size_t data_sz)
+        { Set_Unserialize(index, in, data_sz); } },
+    { "Viewport2", [](int index, Stream *in, size_t data_sz)
+        { Viewport_Unserialize(index, in, data_sz); } },
+    { "Camera2", [](int index, Stream *in, size_t data_sz)
+        { Camera_Unserialize(index, in, data_sz); } },
+    { "AudioChannel", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicAudio.Unserialize(index, in, data_sz); } },
+    { "AudioClip", [](int index, Stream *in, size_t data_sz)
+        { ccDynamicAudioClip.Unserialize(index, in, data_sz); } },
+    { "ParticleEmitter", [](int index, Stream *in, size_t data_sz)
+        { ScriptParticleEmitter *scf = new ScriptParticleEmitter(); scf->Unserialize(index, in, data_sz); } },
+    { "Coroutine", [](int index, Stream *in, size_t data_sz)
+        { ScriptCoroutine *scf = new ScriptCoroutine(); scf->Unserialize(index, in, data_sz); } },
+};
+
+static const int BuiltinReaderCount = sizeof(BuiltinReaders) / sizeof(BuiltinReaders[0]);
+
+int AGSDeSerializer::FindTypeReader(const char *objectType)
+{
+    if (_builtinReaderIds.empty())
     {
-        Set_Unserialize(index, &mems, data_sz);
+        for (int i = 0; i < BuiltinReaderCount; ++i)
+            _builtinReaderIds[BuiltinReaders[i].Type] = i;
     }
-    else if (strcmp(objectType, "Viewport2") == 0)
+
+    const auto it = _builtinReaderIds.find(objectType);
+    if (it != _builtinReaderIds.end())
+        return it->second;
+    // check if the type is read by a plugin
+    for (size_t i = 0; i < pluginReaders.size(); ++i)
     {
-        Viewport_Unserialize(index, &mems, data_sz);
+        if (pluginReaders[i].Type == objectType)
+            return BuiltinReaderCount + static_cast<int>(i);
     }
-    else if (strcmp(objectType, "Camera2") == 0)
+    return -1;
+}
+
+void AGSDeSerializer::Unserialize(int index, const char *objectType, const char *serializedData, int dataSize) {
+
+    if (dataSize < 0)
     {
-        Camera_Unserialize(index, &mems, data_sz);
+        quitprintf("Unserialise: invalid data size (%d) for object type '%s'", dataSize, objectType);
+        return; // TODO: don't quit, return error
     }
-    else if (strcmp(objectType, "AudioChannel") == 0)
+
+    const int type_reader = FindTypeReader(objectType);
+    if (type_reader < 0)
     {
-        ccDynamicAudio.Unserialize(index, &mems, data_sz);
+        quitprintf("Unserialise: unknown object type: '%s'", objectType);
+        return;
     }
-    else if (strcmp(objectType, "AudioClip") == 0)
+    if (type_reader >= BuiltinReaderCount)
     {
-        ccDynamicAudioClip.Unserialize(index, &mems, data_sz);
+        pluginReaders[type_reader - BuiltinReaderCount].Reader->Unserialize(index, serializedData, dataSize);
+        return;
     }
-    else
+
+    // Note that while our builtin classes may accept Stream object,
+    // classes registered by plugin cannot, because streams are not (yet)
+    // part of the plugin API.
+    size_t data_sz = static_cast<size_t>(dataSize);
+    assert(data_sz <= INT32_MAX); // dynamic object API does not support size > int32
+    Stream mems(std::make_unique<MemoryStream>(reinterpret_cast<const uint8_t*>(serializedData), dataSize));
+    BuiltinReaders[type_reader].Unserialize(index, &mems, data_sz);
+}
+
+void AGSDeSerializer::Unserialize(int index, int type_reader, Stream *in, size_t data_sz)
+{
+    assert(type_reader >= 0 && type_reader < BuiltinReaderCount + static_cast<int>(pluginReaders.size()));
+    if (type_reader < BuiltinReaderCount)
     {
-        // check if the type is read by a plugin
-        for (const auto &pr : pluginReaders) {
-            if (pr.Type == objectType) {
-                pr.Reader->Unserialize(index, serializedData, dataSize);
-                return;
-            }
-        }
-        quitprintf("Unserialise: unknown object type: '%s'", objectType);
+        BuiltinReaders[type_reader].Unserialize(index, in, data_sz);
+        return;
     }
+
+    // Plugin readers only accept the raw buffer
+    assert(data_sz <= INT32_MAX); // dynamic object API does not support size > int32
+    if (_pluginBuffer.size() < data_sz)
+        _pluginBuffer.resize(data_sz);
+    in->Read(_pluginBuffer.data(), data_sz);
+    pluginReaders[type_reader - BuiltinReaderCount].Reader->Unserialize(
+        index, _pluginBuffer.data(), static_cast<int>(data_sz));
 }
 
 AGSDeSerializer ccUnserializer;
@@ -15,11 +15,22 @@
 #ifndef __AC_SERIALIZER_H
 #define __AC_SERIALIZER_H
 
+#include <unordered_map>
+#include <vector>
 #include "ac/dynobj/cc_scriptobject.h"
+#include "util/string_types.h"
 
 struct AGSDeSerializer : ICCObjectCollectionReader {
 
     void Unserialize(int index, const char *objectType, const char *serializedData, int dataSize) override;
+    int  FindTypeReader(const char *objectType) override;
+    void Unserialize(int index, int type_reader, AGS::Common::Stream *in, size_t data_sz) override;
+
+private:
+    // Builtin type readers' ids, by type name
+    std::unordered_map<AGS::Common::String, int> _builtinReaderIds;
+    // Intermediate buffer for the objects restored by plugins
+    std::vector<char> _pluginBuffer;
 };
 
 extern AGSDeSerializer ccUnserializer;
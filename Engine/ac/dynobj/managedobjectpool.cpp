@@ -11,10 +11,12 @@
 // https://opensource.org/license/artistic-2-0/
 //
 //=============================================================================
+#include <unordered_map>
 #include <vector>
 #include <string.h>
 #include "ac/dynobj/managedobjectpool.h"
 #include "debug/out.h"
+#include "util/string_types.h"
 #include "util/string_utils.h"               // fputstring, etc
 #include "script/cc_common.h"
 #include "util/stream.h"
@@ -22,6 +24,11 @@
 using namespace AGS::Common;
 
 const auto OBJECT_CACHE_MAGIC_NUMBER = 0xa30b;
+// Pool format versions:
+// 1 - legacy, nextHandle-indexed list with a type name per object;
+// 2 - list of used handles with a type name per object;
+// 3 - type name table, followed by the list of used handles with type ids
+const auto OBJECT_CACHE_VERSION = 3;
 const auto SERIALIZE_BUFFER_SIZE = 10240;
 const auto GARBAGE_COLLECTION_INTERVAL = 1024;
 const auto RESERVED_SIZE = 2048;
@@ -177,21 +184,45 @@ void ManagedObjectPool::WriteToDisk(Stream *out) {
     // use this opportunity to clean up any non-referenced pointers
     RunGarbageCollection();
 
-    std::vector<uint8_t> serializeBuffer;
-    serializeBuffer.resize(SERIALIZE_BUFFER_SIZE);
-
-    out->WriteInt32(OBJECT_CACHE_MAGIC_NUMBER);
-    out->WriteInt32(2);  // version
-
+    // Gather the table of object types, and assign each used object a type id;
+    // builtin types are looked up by their name pointer, which is constant
+    std::vector<String> typeNames;
+    std::unordered_map<String, int> typeByName;
+    std::unordered_map<const char*, int> typeByPtr;
+    std::vector<int> objectTypes(nextHandle, -1);
     int size = 0;
     for (int i = 1; i < nextHandle; i++) {
         auto const & o = objects[i];
-        if (o.isUsed()) { 
-            size += 1;
+        if (!o.isUsed()) { continue; }
+
+        const char *type = o.callback->GetType();
+        const bool is_plugin = o.obj_type == kScValPluginObject;
+        auto ptr_it = is_plugin ? typeByPtr.end() : typeByPtr.find(type);
+        if (ptr_it != typeByPtr.end()) {
+            objectTypes[i] = ptr_it->second;
+        } else {
+            auto name_it = typeByName.find(type);
+            if (name_it == typeByName.end()) {
+                name_it = typeByName.insert(std::make_pair(String(type), static_cast<int>(typeNames.size()))).first;
+                typeNames.push_back(type);
+            }
+            objectTypes[i] = name_it->second;
+            if (!is_plugin)
+                typeByPtr[type] = name_it->second;
         }
+        size += 1;
+    }
+    assert(typeNames.size() <= INT16_MAX);
+
+    out->WriteInt32(OBJECT_CACHE_MAGIC_NUMBER);
+    out->WriteInt32(OBJECT_CACHE_VERSION);
+    out->WriteInt32(static_cast<int32_t>(typeNames.size()));
+    for (const auto &type : typeNames) {
+        StrUtil::WriteCStr(type, out);
     }
     out->WriteInt32(size);
 
+    std::vector<uint8_t> serializeBuffer;
     for (int i = 1; i < nextHandle; i++) {
         auto const & o = objects[i];
         if (!o.isUsed()) { continue; }
@@ -199,18 +230,32 @@ void ManagedObjectPool::WriteToDisk(Stream *out) {
         // handle
         out->WriteInt32(o.handle);
         // write the type of the object
-        StrUtil::WriteCStr(o.callback->GetType(), out);
+        out->WriteInt16(static_cast<int16_t>(objectTypes[i]));
         // now write the object data
-        int bytesWritten = o.callback->Serialize(o.addr, &serializeBuffer.front(), serializeBuffer.size());
-        if ((bytesWritten < 0) && ((size_t)(-bytesWritten) > serializeBuffer.size()))
-        {
-            // buffer not big enough, re-allocate with requested size
-            serializeBuffer.resize(-bytesWritten);
-            bytesWritten = o.callback->Serialize(o.addr, &serializeBuffer.front(), serializeBuffer.size());
+        if (o.obj_type == kScValPluginObject) {
+            // plugin objects may only serialize into a buffer
+            if (serializeBuffer.empty())
+                serializeBuffer.resize(SERIALIZE_BUFFER_SIZE);
+            int bytesWritten = o.callback->Serialize(o.addr, &serializeBuffer.front(), serializeBuffer.size());
+            if ((bytesWritten < 0) && ((size_t)(-bytesWritten) > serializeBuffer.size()))
+            {
+                // buffer not big enough, re-allocate with requested size
+                serializeBuffer.resize(-bytesWritten);
+                bytesWritten = o.callback->Serialize(o.addr, &serializeBuffer.front(), serializeBuffer.size());
+            }
+            assert(bytesWritten >= 0);
+            out->WriteInt32(bytesWritten);
+            out->Write(&serializeBuffer.front(), bytesWritten);
+        } else {
+            size_t data_sz = o.callback->CalcSerializeSize(o.addr);
+            assert(data_sz <= INT32_MAX); // dynamic object API does not support size > int32
+            out->WriteInt32(static_cast<int32_t>(data_sz));
+#ifndef NDEBUG
+            const soff_t data_pos = out->GetPosition();
+#endif
+            o.callback->Serialize(o.addr, out);
+            assert(out->GetPosition() - data_pos == static_cast<soff_t>(data_sz));
         }
-        assert(bytesWritten >= 0);
-        out->WriteInt32(bytesWritten);
-        out->Write(&serializeBuffer.front(), bytesWritten);
         out->WriteInt32(o.refCount);
 
         ManagedObjectLog("Wrote handle = %d", o.handle);
@@ -271,6 +316,43 @@ int ManagedObjectPool::ReadFromDisk(Stream *in, ICCObjectCollectionReader *reade
                 }
             }
             break;
+        case 3:
+            {
+                // Resolve type readers once per type
+                int typeCount = in->ReadInt32();
+                std::vector<int> typeReaders;
+                std::vector<String> typeNames;
+                for (int i = 0; i < typeCount; i++) {
+                    StrUtil::ReadCStr(typeNameBuffer, in, sizeof(typeNameBuffer));
+                    typeNames.push_back(typeNameBuffer);
+                    typeReaders.push_back(reader->FindTypeReader(typeNameBuffer));
+                }
+
+                int objectsSize = in->ReadInt32();
+                for (int i = 0; i < objectsSize; i++) {
+                    auto handle = in->ReadInt32();
+                    assert (handle >= 1);
+                    int type_id = in->ReadInt16();
+                    size_t numBytes = in->ReadInt32();
+                    if (type_id < 0 || type_id >= typeCount) {
+                        cc_error("Invalid object type id %d for handle %d", type_id, handle);
+                        return -1;
+                    }
+                    if (typeReaders[type_id] < 0) {
+                        cc_error("Unknown object type: '%s'", typeNames[type_id].GetCStr());
+                        return -1;
+                    }
+                    // Delegate work to ICCObjectReader, and make sure that
+                    // we proceed from the end of the object data regardless
+                    const soff_t data_end = in->GetPosition() + numBytes;
+                    reader->Unserialize(handle, typeReaders[type_id], in, numBytes);
+                    if (in->GetPosition() != data_end)
+                        in->Seek(data_end, kSeekBegin);
+                    objects[handle].refCount = in->ReadInt32();
+                    ManagedObjectLog("Read handle = %d", handle);
+                }
+            }
+            break;
         default:
             cc_error("Invalid data version: %d", version);
             return -1;
@@ -0,0 +1,49 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/dynobj/scriptcoroutine.h"
+#include "ac/dynobj/dynobj_manager.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+
+int ScriptCoroutine::Dispose(void* /*address*/, bool /*force*/)
+{
+    // the coroutine itself is not stopped when the handle is released
+    delete this;
+    return 1;
+}
+
+const char *ScriptCoroutine::GetType()
+{
+    return "Coroutine";
+}
+
+size_t ScriptCoroutine::CalcSerializeSize(const void* /*address*/)
+{
+    return sizeof(int32_t);
+}
+
+void ScriptCoroutine::Serialize(const void* /*address*/, Stream *out)
+{
+    out->WriteInt32(_id);
+}
+
+void ScriptCoroutine::Unserialize(int index, Stream *in, size_t /*data_sz*/)
+{
+    // coroutines are not saved, so the restored handle does not refer to any;
+    // 0 is never given to a coroutine
+    in->ReadInt32(); // saved id
+    _id = 0;
+    ccRegisterUnserializedObject(index, this, this);
+}
@@ -0,0 +1,46 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Script handle of a coroutine; the coroutine itself is owned by the
+// scheduler, and keeps running regardless of the handle's lifetime.
+//
+//=============================================================================
+#ifndef __AGS_EE_DYNOBJ__SCRIPTCOROUTINE_H
+#define __AGS_EE_DYNOBJ__SCRIPTCOROUTINE_H
+
+#include "ac/dynobj/cc_agsdynamicobject.h"
+
+struct ScriptCoroutine final : AGSCCDynamicObject
+{
+public:
+    ScriptCoroutine() = default;
+    ScriptCoroutine(int id) : _id(id) {}
+
+    int GetID() const { return _id; }
+
+    int Dispose(void *address, bool force) override;
+    const char *GetType() override;
+    void Unserialize(int index, AGS::Common::Stream *in, size_t data_sz) override;
+
+protected:
+    // Calculate and return required space for serialization, in bytes
+    size_t CalcSerializeSize(const void *address) override;
+    // Write object data into the provided stream
+    void Serialize(const void *address, AGS::Common::Stream *out) override;
+
+private:
+    int _id = 0;
+};
+
+#endif // __AGS_EE_DYNOBJ__SCRIPTCOROUTINE_H
@@ -0,0 +1,103 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/dynobj/scriptparticleemitter.h"
+#include <algorithm>
+#include "ac/particleemitter.h"
+#include "ac/dynobj/dynobj_manager.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+
+// Size of the emitter's parameters in the stream, preceding the particles
+static const size_t HeaderSize = sizeof(int32_t) * 16 + sizeof(float) * 6 + sizeof(int32_t);
+
+int ScriptParticleEmitter::Dispose(void* /*address*/, bool /*force*/)
+{
+    unregister_particle_emitter(this);
+    delete this;
+    return 1;
+}
+
+const char *ScriptParticleEmitter::GetType()
+{
+    return "ParticleEmitter";
+}
+
+size_t ScriptParticleEmitter::CalcSerializeSize(const void* /*address*/)
+{
+    return HeaderSize + Particles.CalcSerializeSize();
+}
+
+void ScriptParticleEmitter::Serialize(const void* /*address*/, Stream *out)
+{
+    out->WriteInt32(Room);
+    out->WriteInt32(X);
+    out->WriteInt32(Y);
+    out->WriteInt32(Width);
+    out->WriteInt32(Height);
+    out->WriteInt32(Enabled ? 1 : 0);
+    out->WriteInt32(Rate);
+    out->WriteInt32(MaxParticles);
+    out->WriteInt32(Baseline);
+    out->WriteFloat32(MinVelX);
+    out->WriteFloat32(MaxVelX);
+    out->WriteFloat32(MinVelY);
+    out->WriteFloat32(MaxVelY);
+    out->WriteFloat32(Gravity);
+    out->WriteInt32(MinLifetime);
+    out->WriteInt32(MaxLifetime);
+    out->WriteInt32(Fade ? 1 : 0);
+    out->WriteInt32(Sprite);
+    out->WriteInt32(View);
+    out->WriteInt32(Loop);
+    out->WriteInt32(FrameDelay);
+    out->WriteFloat32(SpawnAccum);
+    out->WriteInt32(RandState);
+    Particles.WriteToFile(out);
+}
+
+void ScriptParticleEmitter::Unserialize(int index, Stream *in, size_t data_sz)
+{
+    Room = in->ReadInt32();
+    X = in->ReadInt32();
+    Y = in->ReadInt32();
+    // Restore the parameters within the limits which the script API enforces
+    Width = std::max(0, in->ReadInt32());
+    Height = std::max(0, in->ReadInt32());
+    Enabled = in->ReadInt32() != 0;
+    Rate = std::max(0, in->ReadInt32());
+    MaxParticles = std::max(0, in->ReadInt32());
+    if (MaxParticles > MaxParticlesLimit)
+        MaxParticles = MaxParticlesLimit;
+    Baseline = in->ReadInt32();
+    MinVelX = in->ReadFloat32();
+    MaxVelX = in->ReadFloat32();
+    MinVelY = in->ReadFloat32();
+    MaxVelY = in->ReadFloat32();
+    Gravity = in->ReadFloat32();
+    MinLifetime = std::max(1, in->ReadInt32());
+    MaxLifetime = std::max(MinLifetime, in->ReadInt32());
+    Fade = in->ReadInt32() != 0;
+    Sprite = in->ReadInt32();
+    View = in->ReadInt32();
+    Loop = std::max(0, in->ReadInt32());
+    FrameDelay = std::max(1, in->ReadInt32());
+    SpawnAccum = in->ReadFloat32();
+    RandState = static_cast<uint32_t>(in->ReadInt32()) | 1u; // xorshift state must not be 0
+    // Drop the particles if their count does not match the limit or the data size
+    Particles.ReadFromFile(in, static_cast<size_t>(MaxParticles),
+        (data_sz > HeaderSize) ? data_sz - HeaderSize : 0);
+    ccRegisterUnserializedObject(index, this, this);
+    register_particle_emitter(this);
+}
@@ -0,0 +1,88 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// ScriptParticleEmitter is a script object which owns a particle emitter:
+// its parameters and the live particles. The emitter exists for as long as
+// there are script references to it, but it's only updated and drawn while
+// the room where it was created is displayed.
+//
+//=============================================================================
+#ifndef __AC_SCRIPTPARTICLEEMITTER_H
+#define __AC_SCRIPTPARTICLEEMITTER_H
+
+#include <vector>
+#include "ac/particleset.h"
+#include "ac/dynobj/cc_agsdynamicobject.h"
+#include "util/geometry.h"
+
+namespace AGS { namespace Engine { class IDriverDependantBitmap; } }
+
+struct ScriptParticleEmitter final : AGSCCDynamicObject
+{
+    // Upper limit of particles per emitter
+    static const int MaxParticlesLimit = 100000;
+
+    int     Room = -1; // room the emitter belongs to, -1 until the first room is loaded
+    // Spawn area, in room coordinates
+    int     X = 0;
+    int     Y = 0;
+    int     Width = 0;
+    int     Height = 0;
+    bool    Enabled = true; // whether new particles are spawned by rate
+    int     Rate = 10; // particles spawned per second
+    int     MaxParticles = 500;
+    int     Baseline = 0; // 0 means using the bottom of the spawn area
+    // Particle's velocity range, in pixels per game loop
+    float   MinVelX = -1.f;
+    float   MaxVelX = 1.f;
+    float   MinVelY = -1.f;
+    float   MaxVelY = 1.f;
+    float   Gravity = 0.f; // added to vertical velocity each game loop
+    // Particle's lifetime range, in game loops
+    int     MinLifetime = 40;
+    int     MaxLifetime = 40;
+    bool    Fade = false; // particles fade out towards the end of their life
+    // Particle's image: either a single sprite or a view loop
+    int     Sprite = 0;
+    int     View = -1; // 0-based view, or -1 for no view
+    int     Loop = 0;
+    int     FrameDelay = 5; // game loops per view frame
+
+    // Live particles
+    ParticleSet Particles;
+    // Fraction of a particle accumulated by the spawn rate
+    float   SpawnAccum = 0.f;
+    uint32_t RandState = 1;
+
+    // Textures of the particles being drawn, attached to the shared sprite
+    // textures, and the particles' positions in the room
+    std::vector<AGS::Engine::IDriverDependantBitmap*> Ddbs;
+    std::vector<Point> DrawPos;
+
+    ScriptParticleEmitter() = default;
+
+    size_t GetParticleCount() const { return Particles.GetCount(); }
+
+    int Dispose(void *address, bool force) override;
+    const char *GetType() override;
+    void Unserialize(int index, AGS::Common::Stream *in, size_t data_sz) override;
+
+protected:
+    // Calculate and return required space for serialization, in bytes
+    size_t CalcSerializeSize(const void *address) override;
+    // Write object data into the provided stream
+    void Serialize(const void *address, AGS::Common::Stream *out) override;
+};
+
+#endif // __AC_SCRIPTPARTICLEEMITTER_H
@@ -107,7 +107,7 @@ void run_on_event(int evtype, RuntimeScriptValue &wparam)
 }
 
 void run_room_event(int id) {
-    auto obj_evt = ObjectEvent("room");
+    auto obj_evt = ObjectEvent(kObjEvent_Room);
     if (thisroom.EventHandlers != nullptr)
     {
         run_interaction_script(obj_evt, thisroom.EventHandlers.get(), id);
@@ -167,7 +167,7 @@ void process_event(const EventHappened *evp) {
             else
                 evpt=&croom->intrHotspot[hotspot_id];
 
-            obj_evt = ObjectEvent("hotspot%d", hotspot_id,
+            obj_evt = ObjectEvent(kObjEvent_Hotspot, hotspot_id,
                 RuntimeScriptValue().SetScriptObject(&scrHotspot[hotspot_id], &ccDynamicHotspot));
             //Debug::Printf("Running hotspot interaction for hotspot %d, event %d", evp->data2, evp->data3);
         }
@@ -178,7 +178,7 @@ void process_event(const EventHappened *evp) {
             else
                 evpt=&croom->intrRoom;
 
-            obj_evt = ObjectEvent("room");
+            obj_evt = ObjectEvent(kObjEvent_Room);
             if (evp->data3 == EVROM_BEFOREFADEIN) {
                 in_enters_screen ++;
                 run_on_event (GE_ENTER_ROOM, RuntimeScriptValue().SetInt32(displayed_room));
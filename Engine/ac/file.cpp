@@ -11,6 +11,7 @@
 // https://opensource.org/license/artistic-2-0/
 //
 //=============================================================================
+#include <algorithm>
 #include "ac/asset_helper.h"
 #include "ac/audiocliptype.h"
 #include "ac/file.h"
@@ -22,6 +23,7 @@
 #include "ac/path_helper.h"
 #include "ac/runtime_defines.h"
 #include "ac/string.h"
+#include "ac/dynobj/cc_dynamicarray.h"
 #include "ac/dynobj/dynobj_manager.h"
 #include "debug/debug_log.h"
 #include "debug/debugger.h"
@@ -112,28 +114,8 @@ void File_WriteRawLine(sc_File *fil, const char *towrite) {
 // returns whether reached the end of line (false in case not enough buffer);
 // guarantees null-terminator in the buffer.
 static bool File_ReadRawLineImpl(sc_File *fil, char* buffer, size_t buf_len) {
-    if (buf_len == 0) return false;
     Stream *in = get_file_stream(fil->handle, "File.ReadRawLine");
-    for (size_t i = 0; i < buf_len - 1; ++i)
-    {
-        int c = in->ReadByte();
-        if (c < 0 || c == '\n') // EOF or LF
-        {
-            buffer[i] = 0;
-            return true;
-        }
-        if (c == '\r') // CR or CRLF
-        {
-            c = in->ReadByte();
-            // Look for '\n', but it may be missing, which is also a valid case
-            if (c >= 0 && c != '\n') in->Seek(-1, kSeekCurrent);
-            buffer[i] = 0;
-            return true;
-        }
-        buffer[i] = c;
-    }
-    buffer[buf_len - 1] = 0;
-    return false; // not enough buffer
+    return StrUtil::ReadTextLine(buffer, in, buf_len);
 }
 
 void File_ReadRawLine(sc_File *fil, char* buffer) {
@@ -156,6 +138,30 @@ const char* File_ReadRawLineBack(sc_File *fil) {
   return CreateNewScriptString(sbuf.GetCStr());
 }
 
+// Returns the number of bytes to read, clamped by the remaining file length;
+// negative count means "read till the end"
+static size_t File_GetBulkReadCount(Stream *in, int count) {
+    soff_t remains = std::max<soff_t>(0, in->GetLength() - in->GetPosition());
+    return static_cast<size_t>(count < 0 ? remains : std::min<soff_t>(count, remains));
+}
+
+const char* File_ReadRawText(sc_File *fil, int count) {
+    Stream *in = get_file_stream(fil->handle, "File.ReadRawText");
+    return CreateNewScriptString(String::FromStreamCount(in, File_GetBulkReadCount(in, count)));
+}
+
+void *File_ReadRawBytes(sc_File *fil, int count) {
+    Stream *in = get_file_stream(fil->handle, "File.ReadRawBytes");
+    size_t read_sz = File_GetBulkReadCount(in, count);
+    if (read_sz == 0)
+        return nullptr;
+    DynObjectRef arr = globalDynamicArray.Create(read_sz, sizeof(uint8_t), false);
+    if (!arr.Obj)
+        return nullptr;
+    in->Read(arr.Obj, read_sz);
+    return arr.Obj;
+}
+
 void File_ReadString(sc_File *fil, char *toread) {
   FileRead(fil->handle, toread);
 }
@@ -816,6 +822,18 @@ RuntimeScriptValue Sc_File_ReadString(void *self, const RuntimeScriptValue *para
     API_OBJCALL_VOID_POBJ(sc_File, File_ReadString, char);
 }
 
+// const char* (sc_File *fil, int count)
+RuntimeScriptValue Sc_File_ReadRawText(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_OBJ_PINT(sc_File, const char, myScriptStringImpl, File_ReadRawText);
+}
+
+// void* (sc_File *fil, int count)
+RuntimeScriptValue Sc_File_ReadRawBytes(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_OBJ_PINT(sc_File, void, globalDynamicArray, File_ReadRawBytes);
+}
+
 // const char* (sc_File *fil)
 RuntimeScriptValue Sc_File_ReadStringBack(void *self, const RuntimeScriptValue *params, int32_t param_count)
 {
@@ -893,6 +911,8 @@ void RegisterFileAPI()
         { "File::ReadRawInt^0",       API_FN_PAIR(File_ReadRawInt) },
         { "File::ReadRawLine^1",      API_FN_PAIR(File_ReadRawLine) },
         { "File::ReadRawLineBack^0",  API_FN_PAIR(File_ReadRawLineBack) },
+        { "File::ReadRawText^1",      API_FN_PAIR(File_ReadRawText) },
+        { "File::ReadRawBytes^1",     API_FN_PAIR(File_ReadRawBytes) },
         { "File::ReadString^1",       API_FN_PAIR(File_ReadString) },
         { "File::ReadStringBack^0",   API_FN_PAIR(File_ReadStringBack) },
         { "File::WriteInt^1",         API_FN_PAIR(File_WriteInt) },
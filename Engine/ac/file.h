@@ -35,6 +35,8 @@ void	File_WriteRawInt(sc_File *fil, int towrite);
 void	File_WriteRawLine(sc_File *fil, const char *towrite);
 void	File_ReadRawLine(sc_File *fil, char* buffer);
 const char* File_ReadRawLineBack(sc_File *fil);
+const char* File_ReadRawText(sc_File *fil, int count);
+void*   File_ReadRawBytes(sc_File *fil, int count);
 void	File_ReadString(sc_File *fil, char *toread);
 const char* File_ReadStringBack(sc_File *fil);
 int		File_ReadInt(sc_File *fil);
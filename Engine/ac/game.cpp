@@ -117,7 +117,8 @@ AGS::Common::SpriteCache::Callbacks spritecallbacks = {
     get_new_size_for_sprite,
     initialize_sprite,
     post_init_sprite,
-    nullptr
+    nullptr,
+    get_sprite_conversion
 };
 SpriteCache spriteset(game.SpriteInfos, spritecallbacks);
 
@@ -494,6 +495,7 @@ void unload_game()
     scrGui.clear();
 
     get_overlays().clear();
+    restore_overlays();
 
     resetRoomStatuses();
 
@@ -61,6 +61,8 @@ struct GameSetup
     static const size_t DefSpriteCacheSize = (128 * 1024); // 128 MB
 #endif
     static const size_t DefTexCacheSize = (128 * 1024); // 128 MB
+    static const size_t DefBgFrameCacheSize = (64 * 1024); // 64 MB
+    static const size_t DefBitmapPoolSize = (32 * 1024); // 32 MB
     static const size_t DefSoundLoadAtOnce = 1024; // 1 MB
     static const size_t DefSoundCache = 1024u * 32; // 32 MB
 
@@ -99,6 +101,8 @@ struct GameSetup
     bool  RenderAtScreenRes; // render sprites at screen resolution, as opposed to native one
     size_t SpriteCacheSize = DefSpriteCacheSize; // in KB
     size_t TextureCacheSize = DefTexCacheSize; // in KB
+    size_t BgFrameCacheSize = DefBgFrameCacheSize; // resident room background frames limit, in KB
+    size_t BitmapPoolSize = DefBitmapPoolSize; // freed bitmap buffers kept for reuse, in KB
     size_t SoundLoadAtOnceSize = DefSoundLoadAtOnce; // threshold for loading sounds immediately, in KB
     size_t SoundCacheSize = DefSoundCache; // sound cache limit, in KB
     bool  clear_cache_on_room_change; // for low-end devices: clear resource caches on room change
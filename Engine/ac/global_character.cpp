@@ -393,7 +393,7 @@ void RunCharacterInteraction (int cc, int mood) {
         play.usedinv = playerchar->activeinv;
     }
 
-    const auto obj_evt = ObjectEvent("character%d", cc,
+    const auto obj_evt = ObjectEvent(kObjEvent_Character, cc,
         RuntimeScriptValue().SetScriptObject(&game.chars[cc], &ccDynamicCharacter), mood);
     if (loaded_game_file_version > kGameVersion_272)
     {
@@ -551,11 +551,11 @@ int DisplaySpeechBackground(int charid, const char*speel) {
     // remove any previous background speech for this character
     // TODO: have a map character -> bg speech over?
     const auto &overs = get_overlays();
-    for (size_t i = 0; i < overs.size(); ++i)
+    for (int over_id : get_active_overlays())
     {
-        if (overs[i].bgSpeechForChar == charid)
+        if (overs[over_id].bgSpeechForChar == charid)
         {
-            remove_screen_overlay(i);
+            remove_screen_overlay(over_id);
             break;
         }
     }
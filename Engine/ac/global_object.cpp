@@ -456,7 +456,7 @@ void RunObjectInteraction (int aa, int mood) {
         play.usedinv = playerchar->activeinv;
     }
 
-    const auto obj_evt = ObjectEvent("object%d", aa,
+    const auto obj_evt = ObjectEvent(kObjEvent_Object, aa,
         RuntimeScriptValue().SetScriptObject(&scrObj[aa], &ccDynamicObject), mood);
     if (loaded_game_file_version > kGameVersion_272)
     {
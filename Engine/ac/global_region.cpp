@@ -143,14 +143,20 @@ void RunRegionInteraction (int regnum, int mood) {
 
     // NOTE: for Regions the mode has specific meanings (NOT verbs):
     // 0 - stands on region, 1 - walks onto region, 2 - walks off region
-    const auto obj_evt = ObjectEvent("region%d", regnum,
-        RuntimeScriptValue().SetScriptObject(&scrRegion[regnum], &ccDynamicRegion), mood);
     if (loaded_game_file_version > kGameVersion_272)
     {
-        run_interaction_script(obj_evt, thisroom.Regions[regnum].EventHandlers.get(), mood);
+        // regions do not have unhandled_event, so skip the missing handlers right away
+        const auto *handlers = thisroom.Regions[regnum].EventHandlers.get();
+        if (!handlers || !handlers->HasHandler(mood))
+            return;
+        const auto obj_evt = ObjectEvent(kObjEvent_Region, regnum,
+            RuntimeScriptValue().SetScriptObject(&scrRegion[regnum], &ccDynamicRegion), mood);
+        run_interaction_script(obj_evt, handlers, mood);
     }
     else
     {
+        const auto obj_evt = ObjectEvent(kObjEvent_Region, regnum,
+            RuntimeScriptValue().SetScriptObject(&scrRegion[regnum], &ccDynamicRegion), mood);
         run_interaction_event(obj_evt, &croom->intrRegion[regnum], mood);
     }
 }
@@ -141,13 +141,65 @@ void MarkForFontUpdate(int font)
     }
 }
 
+// Number of distinct GUILabelMacro flags
+static const int LabelMacroFlagCount = 5;
+// Index of labels which use each macro, stored per macro's flag bit
+static std::vector<int> SpecialLabels[LabelMacroFlagCount];
+static bool SpecialLabelsIndexValid = false;
+// Macros which values were changed since the last labels update
+static int PendingLabelMacros = kLabelMacro_None;
+
+static void RebuildSpecialLabelsIndex()
+{
+    for (auto &labels : SpecialLabels)
+        labels.clear();
+    for (size_t i = 0; i < guilabels.size(); ++i)
+    {
+        const int macros = guilabels[i].GetTextMacros();
+        for (int bit = 0; bit < LabelMacroFlagCount; ++bit)
+        {
+            if ((macros & (1 << bit)) != 0)
+                SpecialLabels[bit].push_back(static_cast<int>(i));
+        }
+    }
+    SpecialLabelsIndexValid = true;
+}
+
 void MarkSpecialLabelsForUpdate(GUILabelMacro macro)
 {
-    for (auto &lbl : guilabels)
+    PendingLabelMacros |= macro;
+}
+
+void MarkSpecialLabelsIndexChanged()
+{
+    SpecialLabelsIndexValid = false;
+}
+
+void UpdateSpecialLabels()
+{
+    if (PendingLabelMacros == kLabelMacro_None)
+        return;
+    if (!SpecialLabelsIndexValid)
+        RebuildSpecialLabelsIndex();
+
+    // NOTE: reset pending flags before resolving macros, as resolving
+    // some of them may mark labels for update again (e.g. @OVERHOTSPOT@)
+    const int macros = PendingLabelMacros;
+    PendingLabelMacros = kLabelMacro_None;
+    for (int bit = 0; bit < LabelMacroFlagCount; ++bit)
     {
-        if ((lbl.GetTextMacros() & macro) != 0)
+        if ((macros & (1 << bit)) == 0)
+            continue;
+        for (int index : SpecialLabels[bit])
         {
-            lbl.MarkChanged();
+            auto &lbl = guilabels[index];
+            if (lbl.HasChanged())
+                continue; // already marked
+            const int gui_id = lbl.ParentId;
+            // Only test for the text change if the label's gui is on screen,
+            // otherwise just mark it as a cheap operation
+            if ((gui_id < 0) || !guis[gui_id].IsDisplayed() || lbl.IsTextOutdated())
+                lbl.MarkChanged();
         }
     }
 }
@@ -581,6 +633,7 @@ void prepare_gui_runtime(bool startup)
     play.gui_draw_order.resize(guis.size());
     std::iota(play.gui_draw_order.begin(), play.gui_draw_order.end(), 0);
     update_gui_zorder();
+    GUIE::MarkSpecialLabelsIndexChanged();
 
     GUI::Options.DisabledStyle = static_cast<GuiDisableStyle>(game.options[OPT_DISABLEOFF]);
     GUIE::MarkAllGUIForUpdate(true, true);
@@ -104,8 +104,16 @@ namespace GUIE
     // Mark all GUI which use the given font for recalculate/redraw;
     // pass -1 to update all the textual controls together
     void MarkForFontUpdate(int font);
-    // Mark labels that acts as special text placeholders for redraw
+    // Mark labels that acts as special text placeholders for redraw;
+    // the labels are not updated immediately, but checked for the actual
+    // text change next time the GUI are prepared for drawing
     void MarkSpecialLabelsForUpdate(AGS::Common::GUILabelMacro macro);
+    // Notify that the set of macros used by labels has changed,
+    // this invalidates the labels lookup index
+    void MarkSpecialLabelsIndexChanged();
+    // Checks the labels that were marked by MarkSpecialLabelsForUpdate,
+    // and marks for redraw only those which text has really changed
+    void UpdateSpecialLabels();
     // Mark inventory windows for redraw, optionally only ones linked to given character;
     // also marks buttons with inventory icon mode
     void MarkInventoryForUpdate(int char_id, bool is_player);
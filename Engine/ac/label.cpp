@@ -15,11 +15,13 @@
 #include "ac/common.h" // quit
 #include "ac/gamesetupstruct.h"
 #include "ac/global_translation.h"
+#include "ac/gui.h"
 #include "ac/label.h"
 #include "ac/runtime_defines.h"
 #include "ac/string.h"
 
 using namespace AGS::Common;
+using namespace AGS::Engine;
 
 extern GameSetupStruct game;
 
@@ -37,7 +39,10 @@ void Label_SetText(GUILabel *labl, const char *newtx) {
     newtx = get_translation(newtx);
 
     if (labl->GetText() != newtx) {
+        const GUILabelMacro old_macros = labl->GetTextMacros();
         labl->SetText(newtx);
+        if (labl->GetTextMacros() != old_macros)
+            GUIE::MarkSpecialLabelsIndexChanged();
     }
 }
 
@@ -0,0 +1,535 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/lighting.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "ac/common.h"
+#include "ac/draw.h"
+#include "ac/gamesetupstruct.h"
+#include "ac/lightmask.h"
+#include "ac/spritecache.h"
+#include "debug/debug_log.h"
+#include "game/savegame_internal.h"
+#include "gfx/bitmap.h"
+#include "gfx/graphicsdriver.h"
+#include "util/geometry.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+using namespace AGS::Engine;
+
+extern GameSetupStruct game;
+extern SpriteCache spriteset;
+extern IGraphicsDriver *gfxDriver;
+
+struct LightingLayer
+{
+    int  DarknessLevel = 0; // 0-100
+    int  DarknessColor = 0; // game color
+    std::vector<LightSource> Lights;
+
+    // The darkness mask of the whole room
+    std::vector<uint8_t> Mask;
+    Size MaskSize;
+    // The room areas, where the mask has to be recomposed
+    std::vector<Rect> DirtyRects;
+    // The darkness image for the hardware renderers, and the mask area
+    // which was changed since the image was last updated
+    std::unique_ptr<Bitmap> Image;
+    IDriverDependantBitmap *Ddb = nullptr;
+    Rect ImageDirtyRect;
+    bool ImageDirty = false;
+};
+
+static LightingLayer lighting;
+
+
+static void invalidate_lighting_rect(const Rect &r)
+{
+    add_light_dirty_rect(lighting.DirtyRects, r);
+}
+
+static void invalidate_lighting()
+{
+    lighting.DirtyRects.clear();
+    lighting.DirtyRects.push_back(RectWH(lighting.MaskSize));
+}
+
+// Makes a shape from the sprite's alpha channel; sprites without alpha
+// give full light on every pixel which is not transparent
+static void make_sprite_shape(LightSource &light)
+{
+    Bitmap *sprite = spriteset[light.Sprite];
+    if (!sprite)
+    {
+        light.ShapeW = light.ShapeH = 0;
+        light.Shape.clear();
+        return;
+    }
+    const int w = sprite->GetWidth(), h = sprite->GetHeight();
+    const bool has_alpha = (sprite->GetColorDepth() == 32) &&
+        ((game.SpriteInfos[light.Sprite].Flags & SPF_ALPHACHANNEL) != 0);
+    const int mask_color = sprite->GetMaskColor();
+    light.ShapeW = w;
+    light.ShapeH = h;
+    light.Shape.resize(w * h);
+    for (int y = 0; y < h; ++y)
+    {
+        uint8_t *row = &light.Shape[y * w];
+        for (int x = 0; x < w; ++x)
+        {
+            const int px = sprite->GetPixel(x, y);
+            row[x] = has_alpha ? geta32(px) : ((px == mask_color) ? 0 : 0xFF);
+        }
+    }
+}
+
+static LightSource *get_light(int light, const char *apiname)
+{
+    if ((light < 0) || (static_cast<size_t>(light) >= lighting.Lights.size()) ||
+        !lighting.Lights[light].InUse)
+    {
+        quitprintf("!%s: invalid light ID specified: %d", apiname, light);
+        return nullptr;
+    }
+    return &lighting.Lights[light];
+}
+
+static int add_light(const LightSource &new_light, const char *apiname)
+{
+    size_t index = 0;
+    for (; index < lighting.Lights.size() && lighting.Lights[index].InUse; ++index);
+    if (index == LIGHTING_MAX_LIGHTS)
+    {
+        quitprintf("!%s: too many lights, the limit is %d", apiname, LIGHTING_MAX_LIGHTS);
+        return -1;
+    }
+    if (index == lighting.Lights.size())
+        lighting.Lights.emplace_back();
+    LightSource &light = lighting.Lights[index];
+    light = new_light;
+    light.InUse = true;
+    if (light.Sprite >= 0)
+        make_sprite_shape(light);
+    else
+        make_circle_light_shape(light);
+    invalidate_lighting_rect(light.GetRect());
+    return static_cast<int>(index);
+}
+
+int Lighting_GetDarknessLevel()
+{
+    return lighting.DarknessLevel;
+}
+
+void Lighting_SetDarknessLevel(int level)
+{
+    if ((level < 0) || (level > 100))
+        quitprintf("!Lighting.DarknessLevel: level must be 0-100, got %d", level);
+    if (game.GetColorDepth() == 8)
+        debug_script_warn("Lighting.DarknessLevel: lighting is not supported in 8-bit games");
+    if (level == lighting.DarknessLevel)
+        return;
+    lighting.DarknessLevel = level;
+    invalidate_lighting();
+}
+
+int Lighting_GetDarknessColor()
+{
+    return lighting.DarknessColor;
+}
+
+void Lighting_SetDarknessColor(int color)
+{
+    if (color == lighting.DarknessColor)
+        return;
+    lighting.DarknessColor = color;
+    // color is only used for the image
+    lighting.ImageDirtyRect = RectWH(lighting.MaskSize);
+    lighting.ImageDirty = true;
+}
+
+int Lighting_AddLight(int x, int y, int radius, int falloff)
+{
+    if ((radius <= 0) || (radius > LIGHTING_MAX_LIGHT_RADIUS))
+        quitprintf("!Lighting.AddLight: radius must be 1-%d, got %d", LIGHTING_MAX_LIGHT_RADIUS, radius);
+    LightSource light;
+    light.X = x;
+    light.Y = y;
+    light.Radius = radius;
+    light.Falloff = std::min(radius, std::max(0, falloff));
+    return add_light(light, "Lighting.AddLight");
+}
+
+int Lighting_AddSpriteLight(int x, int y, int sprite)
+{
+    if (!spriteset.DoesSpriteExist(sprite))
+        quitprintf("!Lighting.AddSpriteLight: invalid sprite specified: %d", sprite);
+    LightSource light;
+    light.X = x;
+    light.Y = y;
+    light.Sprite = sprite;
+    return add_light(light, "Lighting.AddSpriteLight");
+}
+
+void Lighting_SetLightPosition(int light_id, int x, int y)
+{
+    LightSource *light = get_light(light_id, "Lighting.SetLightPosition");
+    if ((light->X == x) && (light->Y == y))
+        return;
+    invalidate_lighting_rect(light->GetRect());
+    light->X = x;
+    light->Y = y;
+    invalidate_lighting_rect(light->GetRect());
+}
+
+void Lighting_SetLightIntensity(int light_id, int intensity)
+{
+    LightSource *light = get_light(light_id, "Lighting.SetLightIntensity");
+    intensity = std::min(100, std::max(0, intensity));
+    if (light->Intensity == intensity)
+        return;
+    light->Intensity = intensity;
+    invalidate_lighting_rect(light->GetRect());
+}
+
+void Lighting_RemoveLight(int light_id)
+{
+    LightSource *light = get_light(light_id, "Lighting.RemoveLight");
+    invalidate_lighting_rect(light->GetRect());
+    *light = LightSource();
+}
+
+void Lighting_RemoveAllLights()
+{
+    lighting.Lights.clear();
+    invalidate_lighting();
+}
+
+//=============================================================================
+//
+// Darkness composition.
+//
+// The per-pixel loops below are kept free of branches, so that they could be
+// vectorized by the compiler.
+//
+//=============================================================================
+
+static void get_darkness_rgb(uint32_t &r, uint32_t &g, uint32_t &b)
+{
+    const int color_depth = game.GetColorDepth();
+    const int color = MakeColor(lighting.DarknessColor);
+    r = getr_depth(color_depth, color);
+    g = getg_depth(color_depth, color);
+    b = getb_depth(color_depth, color);
+}
+
+// Writes the darkness color with the mask's alpha into the image row
+static void make_image_row(uint32_t *dst, const uint8_t *mask, int count, uint32_t rgb)
+{
+    const int a_shift = _rgb_a_shift_32;
+    for (int i = 0; i < count; ++i)
+        dst[i] = rgb | (static_cast<uint32_t>(mask[i]) << a_shift);
+}
+
+static void update_image_rect(const Rect &r)
+{
+    uint32_t cr, cg, cb;
+    get_darkness_rgb(cr, cg, cb);
+    const uint32_t rgb = (cr << _rgb_r_shift_32) | (cg << _rgb_g_shift_32) | (cb << _rgb_b_shift_32);
+    const int mask_w = lighting.MaskSize.Width;
+    for (int y = r.Top; y <= r.Bottom; ++y)
+    {
+        make_image_row(reinterpret_cast<uint32_t*>(lighting.Image->GetScanLineForWriting(y)) + r.Left,
+            &lighting.Mask[y * mask_w + r.Left], r.GetWidth(), rgb);
+    }
+}
+
+// Blends the darkness color over the 32-bit pixel row, using the mask as alpha
+static void darken_row32(uint32_t *px, const uint8_t *mask, int count,
+    uint32_t cr, uint32_t cg, uint32_t cb)
+{
+    const int r_shift = _rgb_r_shift_32, g_shift = _rgb_g_shift_32, b_shift = _rgb_b_shift_32;
+    const uint32_t keep_mask = ~((0xFFu << r_shift) | (0xFFu << g_shift) | (0xFFu << b_shift));
+    for (int i = 0; i < count; ++i)
+    {
+        const uint32_t a = mask[i];
+        const uint32_t inv_a = 255u - a;
+        const uint32_t p = px[i];
+        const uint32_t r = div_255(((p >> r_shift) & 0xFF) * inv_a + cr * a);
+        const uint32_t g = div_255(((p >> g_shift) & 0xFF) * inv_a + cg * a);
+        const uint32_t b = div_255(((p >> b_shift) & 0xFF) * inv_a + cb * a);
+        px[i] = (p & keep_mask) | (r << r_shift) | (g << g_shift) | (b << b_shift);
+    }
+}
+
+// Blends the darkness color over the 16-bit (5-6-5) pixel row, using the mask as alpha
+static void darken_row16(uint16_t *px, const uint8_t *mask, int count,
+    uint32_t cr, uint32_t cg, uint32_t cb)
+{
+    const int r_shift = _rgb_r_shift_16, g_shift = _rgb_g_shift_16, b_shift = _rgb_b_shift_16;
+    cr >>= 3; cg >>= 2; cb >>= 3;
+    for (int i = 0; i < count; ++i)
+    {
+        const uint32_t a = mask[i];
+        const uint32_t inv_a = 255u - a;
+        const uint32_t p = px[i];
+        const uint32_t r = div_255(((p >> r_shift) & 0x1F) * inv_a + cr * a);
+        const uint32_t g = div_255(((p >> g_shift) & 0x3F) * inv_a + cg * a);
+        const uint32_t b = div_255(((p >> b_shift) & 0x1F) * inv_a + cb * a);
+        px[i] = static_cast<uint16_t>((r << r_shift) | (g << g_shift) | (b << b_shift));
+    }
+}
+
+bool is_lighting_enabled()
+{
+    return (lighting.DarknessLevel > 0) && (game.GetColorDepth() > 8);
+}
+
+void update_lighting(int room_width, int room_height)
+{
+    if (lighting.MaskSize != Size(room_width, room_height))
+    {
+        lighting.MaskSize = Size(room_width, room_height);
+        lighting.Mask.resize(room_width * room_height);
+        lighting.Image.reset();
+        invalidate_lighting();
+    }
+
+    const Rect room_rc = RectWH(lighting.MaskSize);
+    for (const auto &dirty_rc : lighting.DirtyRects)
+    {
+        const Rect rc = IntersectRects(dirty_rc, room_rc);
+        if (rc.IsEmpty())
+            continue;
+        compose_darkness_mask(lighting.Mask.data(), lighting.MaskSize, rc,
+            lighting.DarknessLevel, lighting.Lights);
+        lighting.ImageDirtyRect = lighting.ImageDirty ? SumRects(lighting.ImageDirtyRect, rc) : rc;
+        lighting.ImageDirty = true;
+    }
+    lighting.DirtyRects.clear();
+}
+
+void draw_lighting(Bitmap *ds, int cam_x, int cam_y)
+{
+    const int color_depth = ds->GetColorDepth();
+    if ((color_depth != 16) && (color_depth != 32))
+        return;
+    const Rect rc = IntersectRects(RectWH(cam_x, cam_y, ds->GetWidth(), ds->GetHeight()),
+        RectWH(lighting.MaskSize));
+    if (rc.IsEmpty())
+        return;
+
+    uint32_t cr, cg, cb;
+    get_darkness_rgb(cr, cg, cb);
+    const int mask_w = lighting.MaskSize.Width;
+    for (int y = rc.Top; y <= rc.Bottom; ++y)
+    {
+        uint8_t *dst = ds->GetScanLineForWriting(y - cam_y);
+        const uint8_t *mask = &lighting.Mask[y * mask_w + rc.Left];
+        if (color_depth == 32)
+            darken_row32(reinterpret_cast<uint32_t*>(dst) + (rc.Left - cam_x), mask, rc.GetWidth(), cr, cg, cb);
+        else
+            darken_row16(reinterpret_cast<uint16_t*>(dst) + (rc.Left - cam_x), mask, rc.GetWidth(), cr, cg, cb);
+    }
+}
+
+IDriverDependantBitmap *get_lighting_ddb()
+{
+    if (!lighting.Image)
+    {
+        lighting.Image.reset(new Bitmap(lighting.MaskSize.Width, lighting.MaskSize.Height, 32));
+        lighting.ImageDirtyRect = RectWH(lighting.MaskSize);
+        lighting.ImageDirty = true;
+    }
+    if (lighting.ImageDirty)
+    {
+        const Rect rc = IntersectRects(lighting.ImageDirtyRect, RectWH(lighting.MaskSize));
+        if (!rc.IsEmpty())
+            update_image_rect(rc);
+        // Upload only the changed part if the texture is already made for this image
+        if (lighting.Ddb && (lighting.Ddb->GetWidth() == lighting.Image->GetWidth()) &&
+            (lighting.Ddb->GetHeight() == lighting.Image->GetHeight()))
+        {
+            if (!rc.IsEmpty())
+                gfxDriver->UpdateDDBRegionFromBitmap(lighting.Ddb, lighting.Image.get(), true, rc);
+        }
+        else
+        {
+            lighting.Ddb = recycle_ddb_bitmap(lighting.Ddb, lighting.Image.get(), true, false);
+        }
+        lighting.ImageDirty = false;
+    }
+    return lighting.Ddb;
+}
+
+void dispose_lighting_drawdata()
+{
+    if (lighting.Ddb)
+        gfxDriver->DestroyDDB(lighting.Ddb);
+    lighting.Ddb = nullptr;
+    lighting.Image.reset();
+    lighting.ImageDirty = false;
+    lighting.Mask.clear();
+    lighting.MaskSize = Size();
+    lighting.DirtyRects.clear();
+}
+
+void reset_lighting()
+{
+    lighting.DarknessLevel = 0;
+    lighting.DarknessColor = 0;
+    lighting.Lights.clear();
+    invalidate_lighting();
+}
+
+void write_lighting(Stream *out)
+{
+    out->WriteInt32(lighting.DarknessLevel);
+    out->WriteInt32(lighting.DarknessColor);
+    out->WriteInt32(static_cast<int32_t>(lighting.Lights.size()));
+    for (const auto &light : lighting.Lights)
+    {
+        out->WriteInt8(light.InUse ? 1 : 0);
+        out->WriteInt32(light.X);
+        out->WriteInt32(light.Y);
+        out->WriteInt32(light.Radius);
+        out->WriteInt32(light.Falloff);
+        out->WriteInt32(light.Sprite);
+        out->WriteInt32(light.Intensity);
+    }
+}
+
+HSaveError read_lighting(Stream *in, LightingSvgVersion /*svg_ver*/)
+{
+    HSaveError err;
+    reset_lighting();
+    const int darkness_level = in->ReadInt32();
+    if (!AssertCompatRange(err, darkness_level, 0, 100, "darkness level"))
+        return err;
+    lighting.DarknessLevel = darkness_level;
+    lighting.DarknessColor = in->ReadInt32();
+    const int light_count = in->ReadInt32();
+    if (!AssertCompatRange(err, light_count, 0, LIGHTING_MAX_LIGHTS, "lights"))
+        return err;
+    const int sprite_count = static_cast<int>(spriteset.GetSpriteSlotCount());
+    lighting.Lights.resize(light_count);
+    for (auto &light : lighting.Lights)
+    {
+        light.InUse = in->ReadInt8() != 0;
+        light.X = in->ReadInt32();
+        light.Y = in->ReadInt32();
+        light.Radius = in->ReadInt32();
+        light.Falloff = in->ReadInt32();
+        light.Sprite = in->ReadInt32();
+        light.Intensity = in->ReadInt32();
+        if (!light.InUse)
+            continue;
+        if (!AssertCompatRange(err, light.Sprite, -1, sprite_count - 1, "light sprite") ||
+            !AssertCompatRange(err, light.Intensity, 0, 100, "light intensity"))
+            return err;
+        if (light.Sprite < 0)
+        {
+            if (!AssertCompatRange(err, light.Radius, 1, LIGHTING_MAX_LIGHT_RADIUS, "light radius"))
+                return err;
+            light.Falloff = std::min(light.Radius, std::max(0, light.Falloff));
+            make_circle_light_shape(light);
+        }
+        else if (spriteset.DoesSpriteExist(light.Sprite))
+        {
+            make_sprite_shape(light);
+        }
+    }
+    invalidate_lighting();
+    return err;
+}
+
+//=============================================================================
+//
+// Script API Functions
+//
+//=============================================================================
+
+#include "debug/out.h"
+#include "script/script_api.h"
+#include "script/script_runtime.h"
+
+RuntimeScriptValue Sc_Lighting_GetDarknessLevel(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_INT(Lighting_GetDarknessLevel);
+}
+
+RuntimeScriptValue Sc_Lighting_SetDarknessLevel(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT(Lighting_SetDarknessLevel);
+}
+
+RuntimeScriptValue Sc_Lighting_GetDarknessColor(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_INT(Lighting_GetDarknessColor);
+}
+
+RuntimeScriptValue Sc_Lighting_SetDarknessColor(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT(Lighting_SetDarknessColor);
+}
+
+RuntimeScriptValue Sc_Lighting_AddLight(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_INT_PINT4(Lighting_AddLight);
+}
+
+RuntimeScriptValue Sc_Lighting_AddSpriteLight(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_INT_PINT3(Lighting_AddSpriteLight);
+}
+
+RuntimeScriptValue Sc_Lighting_SetLightPosition(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT3(Lighting_SetLightPosition);
+}
+
+RuntimeScriptValue Sc_Lighting_SetLightIntensity(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT2(Lighting_SetLightIntensity);
+}
+
+RuntimeScriptValue Sc_Lighting_RemoveLight(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID_PINT(Lighting_RemoveLight);
+}
+
+RuntimeScriptValue Sc_Lighting_RemoveAllLights(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_VOID(Lighting_RemoveAllLights);
+}
+
+void RegisterLightingAPI()
+{
+    ScFnRegister lighting_api[] = {
+        { "Lighting::get_DarknessLevel",    API_FN_PAIR(Lighting_GetDarknessLevel) },
+        { "Lighting::set_DarknessLevel",    API_FN_PAIR(Lighting_SetDarknessLevel) },
+        { "Lighting::get_DarknessColor",    API_FN_PAIR(Lighting_GetDarknessColor) },
+        { "Lighting::set_DarknessColor",    API_FN_PAIR(Lighting_SetDarknessColor) },
+        { "Lighting::AddLight^4",           API_FN_PAIR(Lighting_AddLight) },
+        { "Lighting::AddSpriteLight^3",     API_FN_PAIR(Lighting_AddSpriteLight) },
+        { "Lighting::SetLightPosition^3",   API_FN_PAIR(Lighting_SetLightPosition) },
+        { "Lighting::SetLightIntensity^2",  API_FN_PAIR(Lighting_SetLightIntensity) },
+        { "Lighting::RemoveLight^1",        API_FN_PAIR(Lighting_RemoveLight) },
+        { "Lighting::RemoveAllLights^0",    API_FN_PAIR(Lighting_RemoveAllLights) },
+    };
+
+    ccAddExternalFunctions(lighting_api);
+}
@@ -0,0 +1,79 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Lighting layer is a darkness drawn over the room sprites, which may be lit
+// up by the lights placed by script. A light's shape is either a circle with
+// a linear falloff, or an alpha mask taken from a sprite. The lights belong
+// to the current room and are removed when the room is unloaded, while the
+// darkness level and color persist across rooms.
+//
+// The darkness is kept as an 8-bit mask covering the whole room, and is only
+// recomposed in the areas where the lights have changed; the light shapes
+// are made once, when a light is created. Software renderer applies the mask
+// right onto the room camera's surface, which makes it redraw the whole camera
+// each frame while the lighting is on. Hardware-accelerated renderers draw it
+// as a single room-sized texture, and only upload its changed part.
+//
+//=============================================================================
+#ifndef __AGS_EE_AC__LIGHTING_H
+#define __AGS_EE_AC__LIGHTING_H
+
+#include "core/types.h"
+#include "game/savegame.h"
+
+namespace AGS { namespace Common { class Bitmap; class Stream; } }
+namespace AGS { namespace Engine { class IDriverDependantBitmap; }}
+using namespace AGS; // FIXME later
+
+enum LightingSvgVersion
+{
+    kLightingSvgVersion_Initial = 0
+};
+
+// Max number of lights which may exist at the same time
+#define LIGHTING_MAX_LIGHTS       1000
+// Max radius of a round light
+#define LIGHTING_MAX_LIGHT_RADIUS 2048
+
+int  Lighting_GetDarknessLevel();
+void Lighting_SetDarknessLevel(int level);
+int  Lighting_GetDarknessColor();
+void Lighting_SetDarknessColor(int color);
+int  Lighting_AddLight(int x, int y, int radius, int falloff);
+int  Lighting_AddSpriteLight(int x, int y, int sprite);
+void Lighting_SetLightPosition(int light, int x, int y);
+void Lighting_SetLightIntensity(int light, int intensity);
+void Lighting_RemoveLight(int light);
+void Lighting_RemoveAllLights();
+
+// Tells whether the darkness layer should be drawn over the room
+bool is_lighting_enabled();
+// Recomposes the darkness mask where the lights have changed since the last
+// update; the mask is reset if the room size is different.
+void update_lighting(int room_width, int room_height);
+// Applies the darkness onto the camera's surface; cam_x, cam_y is the camera's
+// position in the room. This is used by the software renderer.
+void draw_lighting(Common::Bitmap *ds, int cam_x, int cam_y);
+// Returns the texture of the darkness covering the whole room, synced with
+// the current mask. This is used by the hardware-accelerated renderers.
+Engine::IDriverDependantBitmap *get_lighting_ddb();
+// Frees the darkness mask and its texture; these will be recreated on the next update
+void dispose_lighting_drawdata();
+// Removes all the lights and the darkness
+void reset_lighting();
+
+void write_lighting(Common::Stream *out);
+Engine::HSaveError read_lighting(Common::Stream *in, LightingSvgVersion svg_ver);
+
+#endif // __AGS_EE_AC__LIGHTING_H
@@ -0,0 +1,92 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/lightmask.h"
+#include <algorithm>
+#include <cmath>
+
+void add_light_dirty_rect(std::vector<Rect> &rects, const Rect &r)
+{
+    if (r.IsEmpty())
+        return;
+    if (rects.size() < LIGHTING_MAX_DIRTY_RECTS)
+    {
+        rects.push_back(r);
+        return;
+    }
+    Rect sum = r;
+    for (const auto &dr : rects)
+        sum = SumRects(sum, dr);
+    rects.clear();
+    rects.push_back(sum);
+}
+
+void make_circle_light_shape(LightSource &light)
+{
+    const int size = light.Radius * 2 + 1;
+    const float inner = static_cast<float>(light.Radius - light.Falloff);
+    const float falloff = static_cast<float>(std::max(1, light.Falloff));
+    light.ShapeW = light.ShapeH = size;
+    light.Shape.resize(size * size);
+    for (int y = 0; y < size; ++y)
+    {
+        uint8_t *row = &light.Shape[y * size];
+        const float dy = static_cast<float>(y - light.Radius);
+        for (int x = 0; x < size; ++x)
+        {
+            const float dx = static_cast<float>(x - light.Radius);
+            const float dist = std::sqrt(dx * dx + dy * dy);
+            const int value = static_cast<int>((1.f - (dist - inner) / falloff) * 255.f + 0.5f);
+            row[x] = static_cast<uint8_t>(std::min(255, std::max(0, value)));
+        }
+    }
+}
+
+// Removes darkness from the mask row by the light's shape, scaled by factor (0-256);
+// kept free of branches, so that it could be vectorized by the compiler
+static void apply_light_row(uint8_t *mask, const uint8_t *shape, int count, uint32_t factor)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const uint32_t light = (shape[i] * factor) >> 8;
+        mask[i] = static_cast<uint8_t>(div_255(mask[i] * (255u - light)));
+    }
+}
+
+void compose_darkness_mask(uint8_t *mask, const Size &mask_size, const Rect &r,
+    int darkness_level, const std::vector<LightSource> &lights)
+{
+    const int mask_w = mask_size.Width;
+    const uint8_t darkness = static_cast<uint8_t>(darkness_level * 255 / 100);
+    for (int y = r.Top; y <= r.Bottom; ++y)
+        std::fill_n(&mask[y * mask_w + r.Left], r.GetWidth(), darkness);
+    if (darkness == 0)
+        return;
+
+    for (const auto &light : lights)
+    {
+        if (!light.InUse || (light.Intensity == 0) || light.Shape.empty())
+            continue;
+        const Rect light_rc = light.GetRect();
+        const Rect rc = IntersectRects(light_rc, r);
+        if (rc.IsEmpty())
+            continue;
+        const uint32_t factor = light.Intensity * 256 / 100;
+        for (int y = rc.Top; y <= rc.Bottom; ++y)
+        {
+            apply_light_row(&mask[y * mask_w + rc.Left],
+                &light.Shape[(y - light_rc.Top) * light.ShapeW + (rc.Left - light_rc.Left)],
+                rc.GetWidth(), factor);
+        }
+    }
+}
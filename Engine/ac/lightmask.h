@@ -0,0 +1,70 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Darkness mask of the lighting layer: the light sources with their shapes,
+// composition of the mask from the lights, and tracking of the mask's areas
+// which have to be recomposed.
+//
+//=============================================================================
+#ifndef __AGS_EE_AC__LIGHTMASK_H
+#define __AGS_EE_AC__LIGHTMASK_H
+
+#include <vector>
+#include "core/types.h"
+#include "util/geometry.h"
+
+struct LightSource
+{
+    bool InUse = false;
+    int  X = 0;
+    int  Y = 0;
+    int  Radius = 0; // circle radius
+    int  Falloff = 0; // width of the circle's fading edge
+    int  Sprite = -1; // sprite which gives the light's shape, or -1 for a circle
+    int  Intensity = 100; // 0-100
+    // The light's shape, an alpha mask centered at the light's position
+    std::vector<uint8_t> Shape;
+    int  ShapeW = 0;
+    int  ShapeH = 0;
+
+    Rect GetRect() const
+    {
+        return RectWH(X - ShapeW / 2, Y - ShapeH / 2, ShapeW, ShapeH);
+    }
+};
+
+// Max number of the separate areas of the mask to recompose, if there are
+// more changes then they are merged into one
+#define LIGHTING_MAX_DIRTY_RECTS  16
+
+// Divides a product of two 8-bit values by 255, with rounding
+inline uint32_t div_255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Adds the area to the list of areas to recompose; if the list is full,
+// then merges all of them into one
+void add_light_dirty_rect(std::vector<Rect> &rects, const Rect &r);
+// Makes the light's shape, a circle with a linear falloff from the inner
+// radius to the edge
+void make_circle_light_shape(LightSource &light);
+// Recomposes the area of the darkness mask of mask_size, filling it with
+// the darkness level (0-100) and then removing darkness by the lights;
+// the area must be within the mask
+void compose_darkness_mask(uint8_t *mask, const Size &mask_size, const Rect &r,
+    int darkness_level, const std::vector<LightSource> &lights);
+
+#endif // __AGS_EE_AC__LIGHTMASK_H
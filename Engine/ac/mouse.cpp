@@ -52,10 +52,8 @@ int lastmx=-1,lastmy=-1;
 std::unique_ptr<Bitmap> dotted_mouse_cursor;
 std::unique_ptr<Bitmap> blank_mouse_cursor;
 // Current mouse cursor, may be a sprite or a generated bitmap
-// TODO: refactor, replace these with ObjTexture, and move to draw.cpp
 int mouse_cur_pic = 0;
 bool alpha_blend_cursor = false;
-IDriverDependantBitmap *mouse_cur_ddb = nullptr;
 
 // The Mouse:: functions are static so the script doesn't pass
 // in an object parameter
@@ -104,11 +102,6 @@ void SetMouseBounds(int x1, int y1, int x2, int y2)
 }
 
 // mouse cursor functions:
-void update_cached_mouse_cursor(Bitmap *use_bmp) 
-{
-    mouse_cur_ddb = recycle_ddb_bitmap(mouse_cur_ddb, use_bmp, alpha_blend_cursor);
-}
-
 // set_mouse_cursor: changes visual appearance to specified cursor
 void set_mouse_cursor(int newcurs, bool force_update)
 {
@@ -138,6 +131,17 @@ void set_mouse_cursor(int newcurs, bool force_update)
     // If it's inventory cursor, draw hotspot crosshair sprite upon it
     if ((newcurs == MODE_USE) && (game.mcurs[newcurs].pic > 0) &&
         ((game.hotdot > 0) || (game.invhotdotsprite > 0)) ) {
+            // Generated cursor variants are cached by the renderer, try using one
+            CursorVariantKey key;
+            key.Sprite = mouse_cur_pic;
+            key.HotX = hotspotx;
+            key.HotY = hotspoty;
+            key.DotColor = game.hotdot;
+            key.DotOuterColor = game.hotdotouter;
+            key.DotSprite = game.invhotdotsprite;
+            if (use_cached_cursor_variant(key))
+                return;
+
             // If necessary, create a copy of the cursor and put the hotspot dot onto it
             Bitmap *mouse_cur_bmp = (mouse_cur_pic >= 0) ? spriteset[mouse_cur_pic] : blank_mouse_cursor.get();
             dotted_mouse_cursor.reset(BitmapHelper::CreateBitmapCopy(mouse_cur_bmp));
@@ -162,7 +166,7 @@ void set_mouse_cursor(int newcurs, bool force_update)
                 }
             }
 
-            update_cached_mouse_cursor(dotted_mouse_cursor.get());
+            update_cursor_variant(key, dotted_mouse_cursor.get(), alpha_blend_cursor);
     }
 }
 
@@ -411,7 +415,7 @@ void set_new_cursor_graphic (int spriteslot)
     mouse_cur_pic = spriteslot;
     alpha_blend_cursor = (spriteslot >= 0) ?
         ((game.SpriteInfos[spriteslot].Flags & SPF_ALPHACHANNEL) != 0) : false;
-    update_cached_mouse_cursor(mouse_cur_bmp);
+    update_mouse_cursor_texture((spriteslot >= 0) ? spriteslot : UINT32_MAX, mouse_cur_bmp, alpha_blend_cursor);
 }
 
 bool is_standard_cursor_enabled(int curs) {
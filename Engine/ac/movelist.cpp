@@ -20,6 +20,30 @@
 using namespace AGS::Common;
 using namespace AGS::Engine;
 
+void MoveList::Reset()
+{
+    numstage = 0;
+    pos.clear();
+    xpermove.clear();
+    ypermove.clear();
+    onstage = 0;
+    from = {};
+    onpart = 0.f;
+    doneflag = 0u;
+    direct = 0;
+    fin_move = 0;
+    fin_from_part = 0.f;
+}
+
+void MoveList::SetStageCount(int num_stages)
+{
+    assert(num_stages >= 0);
+    numstage = num_stages;
+    pos.resize(num_stages);
+    xpermove.resize(num_stages);
+    ypermove.resize(num_stages);
+}
+
 float MoveList::GetStepLength() const
 {
     assert(numstage > 0);
@@ -50,18 +74,18 @@ HSaveError MoveList::ReadFromSavegame(Stream *in, int32_t cmp_ver)
             String::FromFormat("Movelist format %d is no longer supported", cmp_ver));
     }
 
-    *this = MoveList(); // reset struct
-    numstage = in->ReadInt32();
-    if ((numstage == 0) && cmp_ver >= kMoveSvgVersion_36109)
+    Reset();
+    const int num_stages = in->ReadInt32();
+    if ((num_stages == 0) && cmp_ver >= kMoveSvgVersion_36109)
     {
         return HSaveError::None();
     }
-    // TODO: reimplement MoveList stages as vector to avoid these limits
-    if (numstage > MAXNEEDSTAGES)
+    if (num_stages < 0)
     {
-        return new SavegameError(kSvgErr_IncompatibleEngine,
-            String::FromFormat("Incompatible number of movelist steps (count: %d, max : %d).", numstage, MAXNEEDSTAGES));
+        return new SavegameError(kSvgErr_InconsistentData,
+            String::FromFormat("Invalid number of movelist steps: %d.", num_stages));
     }
+    SetStageCount(num_stages);
 
     from.X = in->ReadInt32();
     from.Y = in->ReadInt32();
@@ -77,8 +101,8 @@ HSaveError MoveList::ReadFromSavegame(Stream *in, int32_t cmp_ver)
         pos[i].Y = in->ReadInt16();
         pos[i].X = in->ReadInt16();
     }
-    in->ReadArrayOfInt32(xpermove, numstage);
-    in->ReadArrayOfInt32(ypermove, numstage);
+    in->ReadArrayOfInt32(xpermove.data(), numstage);
+    in->ReadArrayOfInt32(ypermove.data(), numstage);
 
     // Some variables require conversion depending on a save version
     if (cmp_ver < kMoveSvgVersion_36109)
@@ -109,6 +133,6 @@ void MoveList::WriteToSavegame(Stream *out) const
         out->WriteInt16(pos[i].Y);
         out->WriteInt16(pos[i].X);
     }
-    out->WriteArrayOfInt32(xpermove, numstage);
-    out->WriteArrayOfInt32(ypermove, numstage);
+    out->WriteArrayOfInt32(xpermove.data(), numstage);
+    out->WriteArrayOfInt32(ypermove.data(), numstage);
 }
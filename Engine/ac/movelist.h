@@ -13,6 +13,7 @@
 //=============================================================================
 #ifndef __AGS_EN_AC__MOVELIST_H
 #define __AGS_EN_AC__MOVELIST_H
+#include <vector>
 #include <allegro.h> // fixed math
 #include "game/savegame.h"
 #include "util/geometry.h"
@@ -21,9 +22,6 @@
 namespace AGS { namespace Common { class Stream; } }
 using namespace AGS; // FIXME later
 
-#define MAXNEEDSTAGES 256
-#define MAXNEEDSTAGES_LEGACY 40
-
 enum MoveListDoneFlags
 {
     kMoveListDone_X = 0x01,
@@ -38,15 +36,19 @@ enum MoveListSvgVersion
     kMoveSvgVersion_36109, // skip empty lists, progress as float
 };
 
+// MoveList describes a path of a moving character or object.
+// The stage arrays are allocated dynamically, and are at least numstage long;
+// the lists are stored per mover slot and reused, so that after a path is
+// reset its memory stays reserved for the next one.
 struct MoveList
 {
     int     numstage = 0;
     // Waypoints, per stage
-    Point   pos[MAXNEEDSTAGES];
+    std::vector<Point> pos;
     // xpermove and ypermove contain number of pixels done per a single step
     // along x and y axes; i.e. this is a movement vector, per path stage
-    fixed   xpermove[MAXNEEDSTAGES]{};
-    fixed   ypermove[MAXNEEDSTAGES]{};
+    std::vector<fixed> xpermove;
+    std::vector<fixed> ypermove;
     int     onstage = 0; // current path stage
     Point   from; // current stage's starting position
     // Steps made during current stage;
@@ -62,7 +64,14 @@ struct MoveList
     fixed   fin_move = 0;
     float   fin_from_part = 0.f;
 
-    const Point &GetLastPos() const { return numstage > 0 ? pos[numstage - 1] : pos[0]; }
+    const Point &GetLastPos() const { return numstage > 0 ? pos[numstage - 1] : from; }
+
+    // Resets the movelist to the initial state, but keeps the stage arrays
+    // allocated, so that they may be reused by the next path
+    void  Reset();
+    // Sets the number of path stages, resizing the stage arrays;
+    // existing stages are kept, new ones are zero-initialized
+    void  SetStageCount(int num_stages);
 
     // Gets a movelist's step length, in coordinate units
     // (normally the coord unit is a game pixel)
@@ -13,6 +13,7 @@
 //=============================================================================
 #include "ac/overlay.h"
 #include <algorithm>
+#include <functional>
 #include <queue>
 #include "ac/common.h"
 #include "ac/view.h"
@@ -46,8 +47,20 @@ extern IGraphicsDriver *gfxDriver;
 
 // TODO: consider some kind of a "object pool" template,
 // which handles this kind of storage; share with ManagedPool's handles?
+//
+// Overlays are stored in slots indexed by their id. Ids of removed overlays
+// are reused, lowest first, and the trailing empty slots are trimmed, so that
+// the storage shrinks back after many short-lived overlays. Ids of existing
+// overlays are also kept in a dense list, which lets per-frame processing
+// skip the empty slots.
 std::vector<ScreenOverlay> screenover;
-std::queue<int32_t> over_free_ids;
+// Free ids within the slots range; may contain ids past the range after
+// the slots were trimmed, these are discarded when met
+std::priority_queue<int32_t, std::vector<int32_t>, std::greater<int32_t>> over_free_ids;
+// Ids of existing overlays, in no particular order
+std::vector<int32_t> over_active;
+// Position of each slot's id in the over_active list
+std::vector<uint32_t> over_active_pos;
 
 
 void Overlay_Remove(ScriptOverlay *sco) {
@@ -400,6 +413,15 @@ void remove_screen_overlay(int type)
     screenover[type] = ScreenOverlay();
     if (type >= OVER_FIRSTFREE)
         over_free_ids.push(type);
+    // Remove from the active list by moving the last id in its place
+    const uint32_t pos = over_active_pos[type];
+    over_active[pos] = over_active.back();
+    over_active_pos[over_active[pos]] = pos;
+    over_active.pop_back();
+    // Trim the trailing empty slots
+    while ((screenover.size() > OVER_FIRSTFREE) && (screenover.back().type < 0))
+        screenover.pop_back();
+    over_active_pos.resize(screenover.size());
 
     reset_drawobj_for_overlay(type);
 
@@ -411,8 +433,8 @@ void remove_screen_overlay(int type)
 
 void remove_all_overlays()
 {
-    for (auto &over : screenover)
-        remove_screen_overlay(over.type);
+    while (!over_active.empty())
+        remove_screen_overlay(over_active.back());
 }
 
 ScreenOverlay *get_overlay(int type)
@@ -426,20 +448,24 @@ size_t add_screen_overlay_impl(bool roomlayer, int x, int y, int type, int sprnu
 {
     if (type == OVER_CUSTOM)
     {
-        // Find a free ID
-        if (over_free_ids.size() > 0)
+        // Find a free ID, skipping the ones left past the trimmed slots
+        type = -1;
+        while (!over_free_ids.empty() && (type < 0))
         {
-            type = over_free_ids.front();
+            const int32_t free_id = over_free_ids.top();
             over_free_ids.pop();
+            if (static_cast<uint32_t>(free_id) < screenover.size())
+                type = free_id;
         }
-        else
-        {
+        if (type < 0)
             type = std::max(static_cast<size_t>(OVER_FIRSTFREE), screenover.size());
-        }
     }
 
     if (screenover.size() <= static_cast<uint32_t>(type))
+    {
         screenover.resize(type + 1);
+        over_active_pos.resize(type + 1);
+    }
 
     ScreenOverlay over;
     over.type = type;
@@ -480,6 +506,11 @@ size_t add_screen_overlay_impl(bool roomlayer, int x, int y, int type, int sprnu
         play.speech_face_schandle = over.associatedOverlayHandle;
     }
     over.MarkChanged();
+    if (screenover[type].type < 0)
+    {
+        over_active_pos[type] = over_active.size();
+        over_active.push_back(type);
+    }
     screenover[type] = std::move(over);
     play.overlay_count++;
     return type;
@@ -548,13 +579,19 @@ Point get_overlay_position(const ScreenOverlay &over)
 void restore_overlays()
 {
     // Will have to readjust free ids records, as overlays may be restored in any random slots
-    while (!over_free_ids.empty()) { over_free_ids.pop(); }
+    while ((screenover.size() > OVER_FIRSTFREE) && (screenover.back().type < 0))
+        screenover.pop_back();
+    over_free_ids = decltype(over_free_ids)();
+    over_active.clear();
+    over_active_pos.resize(screenover.size());
     for (size_t i = 0; i < screenover.size(); ++i)
     {
         auto &over = screenover[i];
         if (over.type >= 0)
         {
             over.MarkChanged(); // force recreate texture on next draw
+            over_active_pos[i] = over_active.size();
+            over_active.push_back(i);
         }
         else if (i >= OVER_FIRSTFREE)
         {
@@ -568,6 +605,11 @@ std::vector<ScreenOverlay> &get_overlays()
     return screenover;
 }
 
+const std::vector<int32_t> &get_active_overlays()
+{
+    return over_active;
+}
+
 //=============================================================================
 //
 // Script API Functions
@@ -49,13 +49,17 @@ void remove_all_overlays();
 // Creates and registers a managed script object for existing overlay object;
 // optionally adds an internal engine reference to prevent object's disposal
 ScriptOverlay* create_scriptoverlay(ScreenOverlay &over, bool internal_ref = false);
-// Restores overlays, e.g. after restoring a game save
+// Restores overlays, e.g. after restoring a game save;
+// also rebuilds the records of free and active overlay ids
 void restore_overlays();
 // Returns a ref to overlays list, useful for iterating over them
 // FIXME: this should be a CONST ref (if any at all), strictly for reading,
 // but unfortunately some batch operations on overlays are currently performed
 // by external code...
 std::vector<ScreenOverlay> &get_overlays();
+// Returns ids of the existing overlays, in no particular order;
+// this is preferred for iterating, as the overlays list may have empty slots
+const std::vector<int32_t> &get_active_overlays();
 
 
 #endif // __AGS_EE_AC__OVERLAY_H
@@ -0,0 +1,592 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/particleemitter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "ac/common.h"
+#include "ac/draw.h"
+#include "ac/game.h"
+#include "ac/gamesetupstruct.h"
+#include "ac/spritecache.h"
+#include "ac/view.h"
+#include "ac/dynobj/dynobj_manager.h"
+#include "debug/debug_log.h"
+#include "game/roomstruct.h"
+#include "gfx/graphicsdriver.h"
+#include "main/game_run.h"
+
+using namespace AGS::Common;
+using namespace AGS::Engine;
+
+extern GameSetupStruct game;
+extern RoomStruct thisroom;
+extern SpriteCache spriteset;
+extern std::vector<ViewStruct> views;
+extern IGraphicsDriver *gfxDriver;
+
+static const int MaxParticlesLimit = ScriptParticleEmitter::MaxParticlesLimit;
+
+// Emitters which are currently updated and drawn
+static std::vector<ScriptParticleEmitter*> emitters;
+
+
+static uint32_t next_random(ScriptParticleEmitter *em)
+{
+    // xorshift32
+    uint32_t x = em->RandState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    em->RandState = x;
+    return x;
+}
+
+// Returns a random value within [min, max]
+static float random_range(ScriptParticleEmitter *em, float min, float max)
+{
+    return min + (max - min) * (next_random(em) >> 8) * (1.f / 16777215.f);
+}
+
+static int random_range(ScriptParticleEmitter *em, int min, int max)
+{
+    return min + static_cast<int>(next_random(em) % static_cast<uint32_t>(max - min + 1));
+}
+
+static void spawn_particles(ScriptParticleEmitter *em, int count)
+{
+    const size_t old_count = em->GetParticleCount();
+    count = std::min(count, em->MaxParticles - static_cast<int>(old_count));
+    if (count <= 0)
+        return;
+    const size_t new_count = old_count + count;
+    ParticleSet &ps = em->Particles;
+    ps.Resize(new_count);
+    for (size_t i = old_count; i < new_count; ++i)
+    {
+        ps.PosX[i] = static_cast<float>(em->X) + random_range(em, 0.f, static_cast<float>(em->Width));
+        ps.PosY[i] = static_cast<float>(em->Y) + random_range(em, 0.f, static_cast<float>(em->Height));
+        ps.VelX[i] = random_range(em, em->MinVelX, em->MaxVelX);
+        ps.VelY[i] = random_range(em, em->MinVelY, em->MaxVelY);
+        ps.Age[i] = 0;
+        ps.Life[i] = random_range(em, em->MinLifetime, em->MaxLifetime);
+    }
+}
+
+static void update_particle_emitter(ScriptParticleEmitter *em)
+{
+    em->Particles.Update(em->Gravity);
+
+    if (em->Enabled && (em->Rate > 0))
+    {
+        em->SpawnAccum += em->Rate / std::max(1.f, get_game_fps());
+        const int spawn = static_cast<int>(em->SpawnAccum);
+        em->SpawnAccum -= spawn;
+        spawn_particles(em, spawn);
+    }
+}
+
+ScriptParticleEmitter *ParticleEmitter_Create(int x, int y, int sprite)
+{
+    if (!spriteset.DoesSpriteExist(sprite))
+        quitprintf("!ParticleEmitter.Create: invalid sprite specified: %d", sprite);
+    ScriptParticleEmitter *em = new ScriptParticleEmitter();
+    em->X = x;
+    em->Y = y;
+    em->Sprite = sprite;
+    em->Room = displayed_room;
+    em->RandState = static_cast<uint32_t>(rand()) | 1u;
+    ccRegisterManagedObject(em, em);
+    register_particle_emitter(em);
+    return em;
+}
+
+int ParticleEmitter_GetX(ScriptParticleEmitter *em)
+{
+    return em->X;
+}
+
+void ParticleEmitter_SetX(ScriptParticleEmitter *em, int x)
+{
+    em->X = x;
+}
+
+int ParticleEmitter_GetY(ScriptParticleEmitter *em)
+{
+    return em->Y;
+}
+
+void ParticleEmitter_SetY(ScriptParticleEmitter *em, int y)
+{
+    em->Y = y;
+}
+
+int ParticleEmitter_GetWidth(ScriptParticleEmitter *em)
+{
+    return em->Width;
+}
+
+void ParticleEmitter_SetWidth(ScriptParticleEmitter *em, int width)
+{
+    em->Width = std::max(0, width);
+}
+
+int ParticleEmitter_GetHeight(ScriptParticleEmitter *em)
+{
+    return em->Height;
+}
+
+void ParticleEmitter_SetHeight(ScriptParticleEmitter *em, int height)
+{
+    em->Height = std::max(0, height);
+}
+
+bool ParticleEmitter_GetEnabled(ScriptParticleEmitter *em)
+{
+    return em->Enabled;
+}
+
+void ParticleEmitter_SetEnabled(ScriptParticleEmitter *em, bool on)
+{
+    em->Enabled = on;
+}
+
+int ParticleEmitter_GetRate(ScriptParticleEmitter *em)
+{
+    return em->Rate;
+}
+
+void ParticleEmitter_SetRate(ScriptParticleEmitter *em, int rate)
+{
+    em->Rate = std::max(0, rate);
+}
+
+int ParticleEmitter_GetMaxParticles(ScriptParticleEmitter *em)
+{
+    return em->MaxParticles;
+}
+
+void ParticleEmitter_SetMaxParticles(ScriptParticleEmitter *em, int max_particles)
+{
+    if ((max_particles < 0) || (max_particles > MaxParticlesLimit))
+        quitprintf("!ParticleEmitter.MaxParticles: value must be 0-%d, got %d", MaxParticlesLimit, max_particles);
+    em->MaxParticles = max_particles;
+}
+
+int ParticleEmitter_GetBaseline(ScriptParticleEmitter *em)
+{
+    return em->Baseline;
+}
+
+void ParticleEmitter_SetBaseline(ScriptParticleEmitter *em, int baseline)
+{
+    em->Baseline = baseline;
+}
+
+float ParticleEmitter_GetGravity(ScriptParticleEmitter *em)
+{
+    return em->Gravity;
+}
+
+void ParticleEmitter_SetGravity(ScriptParticleEmitter *em, float gravity)
+{
+    em->Gravity = gravity;
+}
+
+bool ParticleEmitter_GetFade(ScriptParticleEmitter *em)
+{
+    return em->Fade;
+}
+
+void ParticleEmitter_SetFade(ScriptParticleEmitter *em, bool fade)
+{
+    em->Fade = fade;
+}
+
+int ParticleEmitter_GetSprite(ScriptParticleEmitter *em)
+{
+    return em->Sprite;
+}
+
+void ParticleEmitter_SetSprite(ScriptParticleEmitter *em, int sprite)
+{
+    if (!spriteset.DoesSpriteExist(sprite))
+        quitprintf("!ParticleEmitter.Sprite: invalid sprite specified: %d", sprite);
+    em->Sprite = sprite;
+    em->View = -1;
+}
+
+int ParticleEmitter_GetParticleCount(ScriptParticleEmitter *em)
+{
+    return static_cast<int>(em->GetParticleCount());
+}
+
+void ParticleEmitter_SetVelocity(ScriptParticleEmitter *em, float min_vx, float max_vx, float min_vy, float max_vy)
+{
+    em->MinVelX = std::min(min_vx, max_vx);
+    em->MaxVelX = std::max(min_vx, max_vx);
+    em->MinVelY = std::min(min_vy, max_vy);
+    em->MaxVelY = std::max(min_vy, max_vy);
+}
+
+void ParticleEmitter_SetLifetime(ScriptParticleEmitter *em, int min_loops, int max_loops)
+{
+    if ((min_loops <= 0) || (max_loops < min_loops))
+        quitprintf("!ParticleEmitter.SetLifetime: invalid lifetime range: %d - %d", min_loops, max_loops);
+    em->MinLifetime = min_loops;
+    em->MaxLifetime = max_loops;
+}
+
+void ParticleEmitter_SetView(ScriptParticleEmitter *em, int view, int loop, int delay)
+{
+    if ((view < 1) || (view > game.numviews))
+        quitprintf("!ParticleEmitter.SetView: invalid view number specified: %d", view);
+    view--; // convert to 0-based
+    if ((loop < 0) || (loop >= views[view].numLoops))
+        quitprintf("!ParticleEmitter.SetView: invalid loop number specified: %d", loop);
+    if (views[view].loops[loop].numFrames == 0)
+        quitprintf("!ParticleEmitter.SetView: loop %d of view %d has no frames", loop, view + 1);
+    em->View = view;
+    em->Loop = loop;
+    em->FrameDelay = std::max(1, delay);
+}
+
+void ParticleEmitter_Burst(ScriptParticleEmitter *em, int count)
+{
+    spawn_particles(em, count);
+}
+
+void ParticleEmitter_Clear(ScriptParticleEmitter *em)
+{
+    em->Particles.Clear();
+    em->SpawnAccum = 0.f;
+}
+
+static void dispose_particle_textures(ScriptParticleEmitter *em)
+{
+    if (gfxDriver)
+    {
+        for (auto *ddb : em->Ddbs)
+            gfxDriver->DestroyDDB(ddb);
+    }
+    em->Ddbs.clear();
+    em->DrawPos.clear();
+}
+
+void register_particle_emitter(ScriptParticleEmitter *em)
+{
+    emitters.push_back(em);
+}
+
+void unregister_particle_emitter(ScriptParticleEmitter *em)
+{
+    auto it = std::find(emitters.begin(), emitters.end(), em);
+    if (it != emitters.end())
+        emitters.erase(it);
+    dispose_particle_textures(em);
+}
+
+// Tells if the emitter belongs to the currently displayed room
+static bool is_emitter_in_room(ScriptParticleEmitter *em)
+{
+    if (displayed_room < 0)
+        return false;
+    // Emitters created before any room was loaded belong to the first room
+    if (em->Room < 0)
+        em->Room = displayed_room;
+    return em->Room == displayed_room;
+}
+
+void update_particle_emitters()
+{
+    for (auto *em : emitters)
+    {
+        // Emitters of other rooms are paused until their room is displayed again
+        if (is_emitter_in_room(em))
+            update_particle_emitter(em);
+    }
+}
+
+size_t get_particle_emitter_count()
+{
+    return emitters.size();
+}
+
+// Gets the sprite of the particle of given age
+static int get_particle_sprite(const ScriptParticleEmitter *em, int age)
+{
+    if ((em->View < 0) || (em->View >= game.numviews) || (em->Loop >= views[em->View].numLoops))
+        return em->Sprite;
+    const ViewLoopNew &loop = views[em->View].loops[em->Loop];
+    if (loop.numFrames == 0)
+        return em->Sprite;
+    return loop.frames[(std::max(0, age) / std::max(1, em->FrameDelay)) % loop.numFrames].pic;
+}
+
+bool prepare_particle_emitter_for_drawing(size_t index, Rect &area, int &zorder)
+{
+    ScriptParticleEmitter *em = emitters[index];
+    const ParticleSet &ps = em->Particles;
+    const size_t count = ps.GetCount();
+    if ((count == 0) || !is_emitter_in_room(em))
+        return false;
+
+    // Attach each particle's texture to the shared texture of its sprite,
+    // and find out the area which the particles cover;
+    // particle's position is the center of its sprite
+    const size_t old_count = em->Ddbs.size();
+    for (size_t i = count; i < old_count; ++i)
+        gfxDriver->DestroyDDB(em->Ddbs[i]);
+    em->Ddbs.resize(count);
+    em->DrawPos.resize(count);
+    int left = INT32_MAX, top = INT32_MAX, right = INT32_MIN, bottom = INT32_MIN;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int pic = get_particle_sprite(em, ps.Age[i]);
+        if (!spriteset.DoesSpriteExist(pic))
+            pic = 0;
+        const bool has_alpha = (game.SpriteInfos[pic].Flags & SPF_ALPHACHANNEL) != 0;
+        IDriverDependantBitmap *ddb = recycle_ddb_sprite(i < old_count ? em->Ddbs[i] : nullptr, pic, nullptr, has_alpha);
+        em->Ddbs[i] = ddb;
+        if (!ddb)
+            continue;
+        ddb->SetAlpha(em->Fade ? (ps.Life[i] - ps.Age[i]) * 0xFF / std::max(1, ps.Life[i]) : 0xFF);
+        const int w = game.SpriteInfos[pic].Width, h = game.SpriteInfos[pic].Height;
+        const int px = static_cast<int>(std::floor(ps.PosX[i])) - w / 2;
+        const int py = static_cast<int>(std::floor(ps.PosY[i])) - h / 2;
+        em->DrawPos[i] = Point(px, py);
+        left = std::min(left, px);
+        top = std::min(top, py);
+        right = std::max(right, px + w);
+        bottom = std::max(bottom, py + h);
+    }
+    if ((right <= left) || (bottom <= top))
+        return false;
+
+    area = Rect(left, top, right - 1, bottom - 1);
+    zorder = (em->Baseline != 0) ? em->Baseline : (em->Y + em->Height);
+    return true;
+}
+
+void draw_particle_emitter(size_t index)
+{
+    if (index >= emitters.size())
+        return;
+    const ScriptParticleEmitter *em = emitters[index];
+    for (size_t i = 0; i < em->Ddbs.size(); ++i)
+    {
+        if (em->Ddbs[i] && (em->Ddbs[i]->GetAlpha() > 0))
+            gfxDriver->DrawSprite(em->DrawPos[i].X, em->DrawPos[i].Y, em->Ddbs[i]);
+    }
+}
+
+void dispose_particle_emitters_drawdata()
+{
+    for (auto *em : emitters)
+        dispose_particle_textures(em);
+}
+
+//=============================================================================
+//
+// Script API Functions
+//
+//=============================================================================
+
+#include "debug/out.h"
+#include "script/script_api.h"
+#include "script/script_runtime.h"
+
+// ScriptParticleEmitter* (int x, int y, int sprite)
+RuntimeScriptValue Sc_ParticleEmitter_Create(const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_SCALL_OBJAUTO_PINT3(ScriptParticleEmitter, ParticleEmitter_Create);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetX(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetX);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetX(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetX);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetY(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetY);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetY(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetY);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetWidth(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetWidth);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetWidth(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetWidth);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetHeight(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetHeight);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetHeight(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetHeight);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetEnabled(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_BOOL(ScriptParticleEmitter, ParticleEmitter_GetEnabled);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetEnabled(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PBOOL(ScriptParticleEmitter, ParticleEmitter_SetEnabled);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetRate(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetRate);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetRate(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetRate);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetMaxParticles(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetMaxParticles);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetMaxParticles(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetMaxParticles);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetBaseline(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetBaseline);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetBaseline(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetBaseline);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetGravity(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_FLOAT(ScriptParticleEmitter, ParticleEmitter_GetGravity);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetGravity(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PFLOAT(ScriptParticleEmitter, ParticleEmitter_SetGravity);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetFade(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_BOOL(ScriptParticleEmitter, ParticleEmitter_GetFade);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetFade(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PBOOL(ScriptParticleEmitter, ParticleEmitter_SetFade);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetSprite(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetSprite);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetSprite(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_SetSprite);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_GetParticleCount(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_INT(ScriptParticleEmitter, ParticleEmitter_GetParticleCount);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetVelocity(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PFLOAT4(ScriptParticleEmitter, ParticleEmitter_SetVelocity);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetLifetime(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT2(ScriptParticleEmitter, ParticleEmitter_SetLifetime);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_SetView(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT3(ScriptParticleEmitter, ParticleEmitter_SetView);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_Burst(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID_PINT(ScriptParticleEmitter, ParticleEmitter_Burst);
+}
+
+RuntimeScriptValue Sc_ParticleEmitter_Clear(void *self, const RuntimeScriptValue *params, int32_t param_count)
+{
+    API_OBJCALL_VOID(ScriptParticleEmitter, ParticleEmitter_Clear);
+}
+
+void RegisterParticleEmitterAPI()
+{
+    ScFnRegister emitter_api[] = {
+        { "ParticleEmitter::Create^3",          API_FN_PAIR(ParticleEmitter_Create) },
+
+        { "ParticleEmitter::Burst^1",           API_FN_PAIR(ParticleEmitter_Burst) },
+        { "ParticleEmitter::Clear^0",           API_FN_PAIR(ParticleEmitter_Clear) },
+        { "ParticleEmitter::SetLifetime^2",     API_FN_PAIR(ParticleEmitter_SetLifetime) },
+        { "ParticleEmitter::SetVelocity^4",     API_FN_PAIR(ParticleEmitter_SetVelocity) },
+        { "ParticleEmitter::SetView^3",         API_FN_PAIR(ParticleEmitter_SetView) },
+        { "ParticleEmitter::get_Baseline",      API_FN_PAIR(ParticleEmitter_GetBaseline) },
+        { "ParticleEmitter::set_Baseline",      API_FN_PAIR(ParticleEmitter_SetBaseline) },
+        { "ParticleEmitter::get_Enabled",       API_FN_PAIR(ParticleEmitter_GetEnabled) },
+        { "ParticleEmitter::set_Enabled",       API_FN_PAIR(ParticleEmitter_SetEnabled) },
+        { "ParticleEmitter::get_Fade",          API_FN_PAIR(ParticleEmitter_GetFade) },
+        { "ParticleEmitter::set_Fade",          API_FN_PAIR(ParticleEmitter_SetFade) },
+        { "ParticleEmitter::get_Gravity",       API_FN_PAIR(ParticleEmitter_GetGravity) },
+        { "ParticleEmitter::set_Gravity",       API_FN_PAIR(ParticleEmitter_SetGravity) },
+        { "ParticleEmitter::get_Height",        API_FN_PAIR(ParticleEmitter_GetHeight) },
+        { "ParticleEmitter::set_Height",        API_FN_PAIR(ParticleEmitter_SetHeight) },
+        { "ParticleEmitter::get_MaxParticles",  API_FN_PAIR(ParticleEmitter_GetMaxParticles) },
+        { "ParticleEmitter::set_MaxParticles",  API_FN_PAIR(ParticleEmitter_SetMaxParticles) },
+        { "ParticleEmitter::get_ParticleCount", API_FN_PAIR(ParticleEmitter_GetParticleCount) },
+        { "ParticleEmitter::get_Rate",          API_FN_PAIR(ParticleEmitter_GetRate) },
+        { "ParticleEmitter::set_Rate",          API_FN_PAIR(ParticleEmitter_SetRate) },
+        { "ParticleEmitter::get_Sprite",        API_FN_PAIR(ParticleEmitter_GetSprite) },
+        { "ParticleEmitter::set_Sprite",        API_FN_PAIR(ParticleEmitter_SetSprite) },
+        { "ParticleEmitter::get_Width",         API_FN_PAIR(ParticleEmitter_GetWidth) },
+        { "ParticleEmitter::set_Width",         API_FN_PAIR(ParticleEmitter_SetWidth) },
+        { "ParticleEmitter::get_X",             API_FN_PAIR(ParticleEmitter_GetX) },
+        { "ParticleEmitter::set_X",             API_FN_PAIR(ParticleEmitter_SetX) },
+        { "ParticleEmitter::get_Y",             API_FN_PAIR(ParticleEmitter_GetY) },
+        { "ParticleEmitter::set_Y",             API_FN_PAIR(ParticleEmitter_SetY) },
+    };
+
+    ccAddExternalFunctions(emitter_api);
+}
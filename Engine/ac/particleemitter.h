@@ -0,0 +1,79 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Particle emitters spawn particles within an area of the room, move them
+// by their velocity and gravity, and remove them when their lifetime ends.
+//
+// Each particle is drawn as a separate sprite, which texture is shared with
+// the other users of the same sprite; particles fade out by the sprite's
+// alpha. All particles of an emitter are passed to the renderer together,
+// as one room sprite list entry, sorted by emitter's baseline.
+//
+// An emitter belongs to the room where it was created, and is paused
+// while any other room is displayed.
+//
+//=============================================================================
+#ifndef __AGS_EE_AC__PARTICLEEMITTER_H
+#define __AGS_EE_AC__PARTICLEEMITTER_H
+
+#include "ac/dynobj/scriptparticleemitter.h"
+
+ScriptParticleEmitter *ParticleEmitter_Create(int x, int y, int sprite);
+int  ParticleEmitter_GetX(ScriptParticleEmitter *em);
+void ParticleEmitter_SetX(ScriptParticleEmitter *em, int x);
+int  ParticleEmitter_GetY(ScriptParticleEmitter *em);
+void ParticleEmitter_SetY(ScriptParticleEmitter *em, int y);
+int  ParticleEmitter_GetWidth(ScriptParticleEmitter *em);
+void ParticleEmitter_SetWidth(ScriptParticleEmitter *em, int width);
+int  ParticleEmitter_GetHeight(ScriptParticleEmitter *em);
+void ParticleEmitter_SetHeight(ScriptParticleEmitter *em, int height);
+bool ParticleEmitter_GetEnabled(ScriptParticleEmitter *em);
+void ParticleEmitter_SetEnabled(ScriptParticleEmitter *em, bool on);
+int  ParticleEmitter_GetRate(ScriptParticleEmitter *em);
+void ParticleEmitter_SetRate(ScriptParticleEmitter *em, int rate);
+int  ParticleEmitter_GetMaxParticles(ScriptParticleEmitter *em);
+void ParticleEmitter_SetMaxParticles(ScriptParticleEmitter *em, int max_particles);
+int  ParticleEmitter_GetBaseline(ScriptParticleEmitter *em);
+void ParticleEmitter_SetBaseline(ScriptParticleEmitter *em, int baseline);
+float ParticleEmitter_GetGravity(ScriptParticleEmitter *em);
+void ParticleEmitter_SetGravity(ScriptParticleEmitter *em, float gravity);
+bool ParticleEmitter_GetFade(ScriptParticleEmitter *em);
+void ParticleEmitter_SetFade(ScriptParticleEmitter *em, bool fade);
+int  ParticleEmitter_GetSprite(ScriptParticleEmitter *em);
+void ParticleEmitter_SetSprite(ScriptParticleEmitter *em, int sprite);
+int  ParticleEmitter_GetParticleCount(ScriptParticleEmitter *em);
+void ParticleEmitter_SetVelocity(ScriptParticleEmitter *em, float min_vx, float max_vx, float min_vy, float max_vy);
+void ParticleEmitter_SetLifetime(ScriptParticleEmitter *em, int min_loops, int max_loops);
+void ParticleEmitter_SetView(ScriptParticleEmitter *em, int view, int loop, int delay);
+void ParticleEmitter_Burst(ScriptParticleEmitter *em, int count);
+void ParticleEmitter_Clear(ScriptParticleEmitter *em);
+
+// Adds the emitter to the list of updated and drawn emitters
+void register_particle_emitter(ScriptParticleEmitter *em);
+// Removes the emitter from the list, and disposes its textures
+void unregister_particle_emitter(ScriptParticleEmitter *em);
+// Spawns, moves and removes particles of all emitters, for one game loop
+void update_particle_emitters();
+// Gets the number of registered emitters
+size_t get_particle_emitter_count();
+// Prepares the emitter's particle textures for drawing; returns whether
+// there's anything to draw, along with the area covered by the particles
+// in room coordinates, and the emitter's z-order.
+bool prepare_particle_emitter_for_drawing(size_t index, Rect &area, int &zorder);
+// Pushes the particles of the prepared emitter to the renderer
+void draw_particle_emitter(size_t index);
+// Disposes all the emitters' textures
+void dispose_particle_emitters_drawdata();
+
+#endif // __AGS_EE_AC__PARTICLEEMITTER_H
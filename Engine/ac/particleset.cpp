@@ -0,0 +1,108 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "ac/particleset.h"
+#include <algorithm>
+#include "util/stream.h"
+
+using namespace AGS::Common;
+
+void ParticleSet::Resize(size_t count)
+{
+    PosX.resize(count);
+    PosY.resize(count);
+    VelX.resize(count);
+    VelY.resize(count);
+    Age.resize(count);
+    Life.resize(count);
+}
+
+void ParticleSet::Clear()
+{
+    Resize(0);
+}
+
+void ParticleSet::Update(float gravity)
+{
+    const size_t count = GetCount();
+    // Move particles; kept free of branches for the sake of vectorization
+    float *pos_x = PosX.data(), *pos_y = PosY.data();
+    const float *vel_x = VelX.data();
+    float *vel_y = VelY.data();
+    int32_t *age = Age.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        vel_y[i] += gravity;
+        pos_x[i] += vel_x[i];
+        pos_y[i] += vel_y[i];
+        age[i]++;
+    }
+
+    // Remove expired particles, keeping the order of the rest
+    const int32_t *life = Life.data();
+    size_t live = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (age[i] >= life[i])
+            continue;
+        if (live != i)
+        {
+            PosX[live] = PosX[i];
+            PosY[live] = PosY[i];
+            VelX[live] = VelX[i];
+            VelY[live] = VelY[i];
+            Age[live] = Age[i];
+            Life[live] = Life[i];
+        }
+        live++;
+    }
+    if (live != count)
+        Resize(live);
+}
+
+size_t ParticleSet::CalcSerializeSize() const
+{
+    return sizeof(int32_t) + GetCount() * ParticleDataSize;
+}
+
+void ParticleSet::ReadFromFile(Stream *in, size_t max_count, size_t data_sz)
+{
+    size_t count = static_cast<uint32_t>(in->ReadInt32());
+    if ((count > max_count) || (data_sz < sizeof(int32_t)) ||
+        (count > (data_sz - sizeof(int32_t)) / ParticleDataSize))
+        count = 0;
+    Resize(count);
+    in->ReadArrayOfFloat32(PosX.data(), count);
+    in->ReadArrayOfFloat32(PosY.data(), count);
+    in->ReadArrayOfFloat32(VelX.data(), count);
+    in->ReadArrayOfFloat32(VelY.data(), count);
+    in->ReadArrayOfInt32(Age.data(), count);
+    in->ReadArrayOfInt32(Life.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Age[i] = std::max(0, Age[i]);
+        Life[i] = std::max(1, Life[i]);
+    }
+}
+
+void ParticleSet::WriteToFile(Stream *out) const
+{
+    const size_t count = GetCount();
+    out->WriteInt32(static_cast<int32_t>(count));
+    out->WriteArrayOfFloat32(PosX.data(), count);
+    out->WriteArrayOfFloat32(PosY.data(), count);
+    out->WriteArrayOfFloat32(VelX.data(), count);
+    out->WriteArrayOfFloat32(VelY.data(), count);
+    out->WriteArrayOfInt32(Age.data(), count);
+    out->WriteArrayOfInt32(Life.data(), count);
+}
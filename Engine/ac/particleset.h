@@ -0,0 +1,56 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// ParticleSet keeps the live particles of an emitter. Particles are stored
+// as separate arrays of each property, so that they may be updated in tight
+// loops. The order of particles is kept as they are added and removed.
+//
+//=============================================================================
+#ifndef __AGS_EE_AC__PARTICLESET_H
+#define __AGS_EE_AC__PARTICLESET_H
+
+#include <vector>
+#include "core/types.h"
+
+namespace AGS { namespace Common { class Stream; } }
+
+struct ParticleSet
+{
+    // Size of a single particle's data in the stream
+    static const size_t ParticleDataSize = sizeof(float) * 4 + sizeof(int32_t) * 2;
+
+    std::vector<float>   PosX;
+    std::vector<float>   PosY;
+    std::vector<float>   VelX;
+    std::vector<float>   VelY;
+    std::vector<int32_t> Age; // in game loops
+    std::vector<int32_t> Life; // in game loops
+
+    size_t GetCount() const { return PosX.size(); }
+    // Resizes all the arrays; new particles have zero properties
+    void Resize(size_t count);
+    void Clear();
+    // Moves the particles by their velocity for one game loop, adding
+    // gravity to the vertical velocity; then removes the expired ones
+    void Update(float gravity);
+
+    // Calculates the size of the serialized particles, in bytes
+    size_t CalcSerializeSize() const;
+    // Reads particles, dropping them all if their count is more than
+    // max_count, or if they do not fit into the data_sz bytes
+    void ReadFromFile(AGS::Common::Stream *in, size_t max_count, size_t data_sz);
+    void WriteToFile(AGS::Common::Stream *out) const;
+};
+
+#endif // __AGS_EE_AC__PARTICLESET_H
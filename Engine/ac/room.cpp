@@ -31,6 +31,7 @@
 #include "ac/global_object.h"
 #include "ac/global_translation.h"
 #include "ac/gui.h"
+#include "ac/lighting.h"
 #include "ac/movelist.h"
 #include "ac/mouse.h"
 #include "ac/overlay.h"
@@ -67,6 +68,7 @@
 #include "gfx/graphicsdriver.h"
 #include "core/assetmanager.h"
 #include "gfx/bitmap.h"
+#include "gfx/bitmappool.h"
 #include "gfx/gfxfilter.h"
 #include "media/audio/audio_system.h"
 #include "main/game_run.h"
@@ -302,6 +304,8 @@ void unload_old_room() {
     play.bg_frame = 0;
     play.bg_frame_locked = 0;
     remove_all_overlays();
+    // lights are placed in room coordinates, so they do not carry over
+    Lighting_RemoveAllLights();
     raw_saved_screen = nullptr;
     for (int ff = 0; ff < MAX_ROOM_BGFRAMES; ff++)
         play.raw_modified[ff] = 0;
@@ -944,6 +948,7 @@ void new_room(int newnum,CharacterInfo*forchar) {
         spriteset.DisposeAllCached();
         soundcache_clear();
         texturecache_clear();
+        BitmapPool::Clear();
     }
 
     load_new_room(newnum,forchar);
@@ -1026,8 +1031,8 @@ int bg_just_changed = 0;
 
 void on_background_frame_change () {
 
+    // NOTE: the frame's textures are switched by the room renderer itself
     invalidate_screen();
-    mark_current_background_dirty();
 
     // get the new frame's palette
     memcpy (palette, thisroom.BgFrames[play.bg_frame].Palette, sizeof(RGB) * 256);
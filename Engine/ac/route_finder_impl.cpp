@@ -39,9 +39,7 @@ namespace AGS {
 namespace Engine {
 namespace RouteFinder {
 
-static const int MAXNAVPOINTS = MAXNEEDSTAGES;
-static Point navpoints[MAXNAVPOINTS];
-static int num_navpoints;
+static std::vector<Point> navpoints;
 static Navigation nav;
 static Bitmap *wallscreen;
 static int lastcx, lastcy;
@@ -99,17 +97,13 @@ static int find_route_jps(int fromx, int fromy, int destx, int desty)
   if (nav.NavigateRefined(fromx, fromy, destx, desty, path, cpath) == Navigation::NAV_UNREACHABLE)
     return 0;
 
-  num_navpoints = 0;
-
-  // new behavior: cut path if too complex rather than abort with error message
-  int count = std::min<int>((int)cpath.size(), MAXNAVPOINTS);
-
-  for (int i = 0; i<count; i++)
+  navpoints.clear();
+  for (size_t i = 0; i < cpath.size(); i++)
   {
     int x, y;
     nav.UnpackSquare(cpath[i], x, y);
 
-    navpoints[num_navpoints++] = { x, y };
+    navpoints.push_back({ x, y });
   }
 
   return 1;
@@ -262,13 +256,12 @@ int find_route(short srcx, short srcy, short xx, short yy, int move_speed_x, int
 {
   wallscreen = onscreen;
 
-  num_navpoints = 0;
+  navpoints.clear();
 
   if (ignore_walls || can_see_from(srcx, srcy, xx, yy))
   {
-    num_navpoints = 2;
-    navpoints[0] = { srcx, srcy };
-    navpoints[1] = { xx, yy };
+    navpoints.push_back({ srcx, srcy });
+    navpoints.push_back({ xx, yy });
   } else {
     if ((nocross == 0) && (wallscreen->GetPixel(xx, yy) == 0))
       return 0; // clicked on a wall
@@ -276,22 +269,24 @@ int find_route(short srcx, short srcy, short xx, short yy, int move_speed_x, int
     find_route_jps(srcx, srcy, xx, yy);
   }
 
-  if (!num_navpoints)
+  if (navpoints.empty())
     return 0;
 
   // FIXME: really necessary?
-  if (num_navpoints == 1)
-    navpoints[num_navpoints++] = navpoints[0];
+  if (navpoints.size() == 1)
+    navpoints.push_back(navpoints[0]);
 
-  assert(num_navpoints <= MAXNAVPOINTS);
+  const int num_navpoints = static_cast<int>(navpoints.size());
 
 #ifdef DEBUG_PATHFINDER
   AGS::Common::Debug::Printf("Route from %d,%d to %d,%d - %d stages", srcx,srcy,xx,yy,num_navpoints);
 #endif
 
-  MoveList mlist;
-  mlist.numstage = num_navpoints;
-  memcpy(&mlist.pos[0], &navpoints[0], sizeof(Point) * num_navpoints);
+  // Reuse the existing movelist's storage
+  MoveList &mlist = mls[move_id];
+  mlist.Reset();
+  mlist.SetStageCount(num_navpoints);
+  std::copy(navpoints.begin(), navpoints.end(), mlist.pos.begin());
 #ifdef DEBUG_PATHFINDER
   AGS::Common::Debug::Printf("stages: %d\n",num_navpoints);
 #endif
@@ -302,20 +297,17 @@ int find_route(short srcx, short srcy, short xx, short yy, int move_speed_x, int
     calculate_move_stage(&mlist, i, fix_speed_x, fix_speed_y);
 
   mlist.from = { srcx, srcy };
-  mls[move_id] = mlist;
   return move_id;
 }
 
 bool add_waypoint_direct(MoveList * mlsp, short x, short y, int move_speed_x, int move_speed_y)
 {
-  if (mlsp->numstage >= MAXNEEDSTAGES)
-    return false;
-
   const fixed fix_speed_x = input_speed_to_fixed(move_speed_x);
   const fixed fix_speed_y = input_speed_to_fixed(move_speed_y);
-  mlsp->pos[mlsp->numstage] = { x, y };
-  calculate_move_stage(mlsp, mlsp->numstage - 1, fix_speed_x, fix_speed_y);
-  mlsp->numstage++;
+  const int last_stage = mlsp->numstage;
+  mlsp->SetStageCount(last_stage + 1);
+  mlsp->pos[last_stage] = { x, y };
+  calculate_move_stage(mlsp, last_stage - 1, fix_speed_x, fix_speed_y);
   return true;
 }
 
@@ -19,6 +19,7 @@
 
 #include "ac/route_finder_impl_legacy.h"
 
+#include <algorithm>
 #include <string.h>
 #include <math.h>
 
@@ -43,6 +44,8 @@ namespace RouteFinderLegacy {
 #define MANOBJNUM 99
 
 #define MAXPATHBACK 1000
+// Max number of stages in the path made by the legacy pathfinder
+#define MAXNEEDSTAGES 256
 static int *pathbackx = nullptr;
 static int *pathbacky = nullptr;
 static int waspossible = 1;
@@ -859,9 +862,11 @@ stage_again:
 #ifdef DEBUG_PATHFINDER
     AGS::Common::Debug::Printf("Route from %d,%d to %d,%d - %d stage, %d stages", orisrcx,orisrcy,xx,yy,pathbackstage,numstages);
 #endif
-    MoveList mlist;
-    mlist.numstage = numstages;
-    memcpy(&mlist.pos[0], &reallyneed[0], sizeof(Point) * numstages);
+    // Reuse the existing movelist's storage
+    MoveList &mlist = mls[move_id];
+    mlist.Reset();
+    mlist.SetStageCount(numstages);
+    std::copy(&reallyneed[0], &reallyneed[numstages], mlist.pos.begin());
 #ifdef DEBUG_PATHFINDER
     AGS::Common::Debug::Printf("stages: %d\n",numstages);
 #endif
@@ -873,7 +878,6 @@ stage_again:
     }
 
     mlist.from = { orisrcx, orisrcy };
-    mls[move_id] = mlist;
 #ifdef DEBUG_PATHFINDER
     // getch();
 #endif
@@ -894,9 +898,10 @@ bool add_waypoint_direct(MoveList * mlsp, short x, short y, int move_speed_x, in
 
   const fixed fix_speed_x = input_speed_to_fixed(move_speed_x);
   const fixed fix_speed_y = input_speed_to_fixed(move_speed_y);
-  mlsp->pos[mlsp->numstage] = { x, y };
-  calculate_move_stage(mlsp, mlsp->numstage - 1, fix_speed_x, fix_speed_y);
-  mlsp->numstage++;
+  const int last_stage = mlsp->numstage;
+  mlsp->SetStageCount(last_stage + 1);
+  mlsp->pos[last_stage] = { x, y };
+  calculate_move_stage(mlsp, last_stage - 1, fix_speed_x, fix_speed_y);
   return true;
 }
 
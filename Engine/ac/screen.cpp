@@ -29,6 +29,7 @@
 #include "plugin/agsplugin_evts.h"
 #include "plugin/plugin_engine.h"
 #include "gfx/bitmap.h"
+#include "gfx/gfx_util.h"
 #include "gfx/graphicsdriver.h"
 
 using namespace AGS::Common;
@@ -236,6 +237,9 @@ public:
             _bmpBuff = gfxDriver->GetMemoryBackBuffer();
             const int col_depth = _bmpBuff->GetColorDepth();
             _clearCol = makecol_depth(col_depth, _fadeCol.r, _fadeCol.g, _fadeCol.b);
+            _fillBorders = !IsRectInsideRect(
+                RectWH(_view.Left, _view.Top, _bmpFrame->GetWidth(), _bmpFrame->GetHeight()),
+                RectWH(_bmpBuff->GetSize()));
         }
         else
         {
@@ -279,9 +283,17 @@ public:
     {
         if (game.color_depth > 1)
         {
-            _bmpBuff->Fill(_clearCol);
-            set_trans_blender(0, 0, 0, _fadein ? _alpha : 255 - _alpha);
-            _bmpBuff->TransBlendBlt(_bmpFrame.get(), _view.Left, _view.Top);
+            const int alpha = _fadein ? _alpha : 255 - _alpha;
+            // Only clear the parts of the buffer that are not covered by the frame,
+            // the rest is done by a single-pass blend of the frame over fade color
+            if (_fillBorders)
+                _bmpBuff->Fill(_clearCol);
+            if (!GfxUtil::DrawSpriteOverColor(_bmpBuff, _bmpFrame.get(), _view.Left, _view.Top, _clearCol, alpha))
+            {
+                _bmpBuff->Fill(_clearCol);
+                set_trans_blender(0, 0, 0, alpha);
+                _bmpBuff->TransBlendBlt(_bmpFrame.get(), _view.Left, _view.Top);
+            }
             render_to_screen();
         }
         else
@@ -328,6 +340,7 @@ private:
     Bitmap *_bmpBuff = nullptr;
     std::unique_ptr<Bitmap> _bmpFrame;
     int _clearCol = 0;
+    bool _fillBorders = true;
 
     // 256-color state
     PALETTE _fadePal{};
@@ -595,20 +608,44 @@ public:
             set_palette_range(_interpal, 0, 255, 0);
         }
         // do the dissolving
-        int maskCol = saved_viewport_bitmap->GetMaskColor();
-        for (int x = 0; x < _view.GetWidth(); x += 4)
-        {
-            for (int y = 0; y < _view.GetHeight(); y += 4)
-            {
-                saved_viewport_bitmap->PutPixel(x + _pattern[_step] / 4, y + _pattern[_step] % 4, maskCol);
-            }
-        }
+        DissolveStep(saved_viewport_bitmap.get(), _pattern[_step] / 4, _pattern[_step] % 4);
         gfxDriver->UpdateDDBFromBitmap(_shot_ddb, saved_viewport_bitmap.get(), false);
 
         return ++_step < 16;
     }
 
 private:
+    template <typename TPixel>
+    static void PutMaskInGrid(Bitmap *bmp, int x_from, int y_from, int x_to, int y_to)
+    {
+        const TPixel mask_col = static_cast<TPixel>(bmp->GetMaskColor());
+        for (int y = y_from; y < y_to; y += 4)
+        {
+            TPixel *line = reinterpret_cast<TPixel*>(bmp->GetScanLineForWriting(y));
+            for (int x = x_from; x < x_to; x += 4)
+                line[x] = mask_col;
+        }
+    }
+
+    // Erases every 4th pixel in both directions, starting at the given offset;
+    // writes directly into the scanlines, as this is run over the whole screen
+    void DissolveStep(Bitmap *bmp, int off_x, int off_y)
+    {
+        const int x_to = std::min(bmp->GetWidth(), _view.GetWidth() + off_x);
+        const int y_to = std::min(bmp->GetHeight(), _view.GetHeight() + off_y);
+        switch (bmp->GetBPP())
+        {
+        case 1: PutMaskInGrid<uint8_t>(bmp, off_x, off_y, x_to, y_to); break;
+        case 2: PutMaskInGrid<uint16_t>(bmp, off_x, off_y, x_to, y_to); break;
+        case 4: PutMaskInGrid<uint32_t>(bmp, off_x, off_y, x_to, y_to); break;
+        default:
+            for (int y = off_y; y < y_to; y += 4)
+                for (int x = off_x; x < x_to; x += 4)
+                    bmp->PutPixel(x, y, bmp->GetMaskColor());
+            break;
+        }
+    }
+
     IDriverDependantBitmap *_shot_ddb = nullptr;
     int _step = 0;
     const int _pattern[16] = {0,4,14,9,5,11,2,8,10,3,12,7,15,6,13,1};
@@ -40,6 +40,22 @@ Size get_new_size_for_sprite(const Size &size, const uint32_t sprite_flags)
     return newsz;
 }
 
+SpriteConversion get_sprite_conversion(sprkey_t /*index*/, const uint32_t sprite_flags)
+{
+    // Only the conversions which match the ones done by the
+    // AdjustBitmapForUseWithDisplayMode in a 32-bit game are supported
+    SpriteConversion conv;
+    if (!gfxDriver || game.GetColorDepth() != 32 || gfxDriver->GetCompatibleBitmapFormat(32) != 32)
+        return conv;
+    const bool has_alpha = (sprite_flags & (SPF_ALPHACHANNEL | SPF_HADALPHACHANNEL)) != 0;
+    conv.AlphaToMask = has_alpha;
+#if !defined (AGS_INVERTED_COLOR_ORDER)
+    if (!has_alpha)
+        conv.HiColorToDepth = 32;
+#endif
+    return conv;
+}
+
 // from is a 32-bit RGBA image, to is a 15/16/24-bit destination image
 Bitmap *remove_alpha_channel(Bitmap *from)
 {
@@ -99,6 +115,9 @@ Bitmap *initialize_sprite(sprkey_t index, Bitmap *image, uint32_t &sprite_flags)
     int oldeip = get_our_eip();
     set_our_eip(4300);
 
+    // Some of the conversions could have been done by the sprite reader already
+    const SpriteConversion conv = get_sprite_conversion(index, sprite_flags);
+
     if (sprite_flags & SPF_HADALPHACHANNEL)
     {
         // we stripped the alpha channel out last time, put
@@ -121,7 +140,8 @@ Bitmap *initialize_sprite(sprkey_t index, Bitmap *image, uint32_t &sprite_flags)
         delete image;
     }
 
-    use_bmp = PrepareSpriteForUse(use_bmp, (sprite_flags & SPF_ALPHACHANNEL) != 0);
+    use_bmp = PrepareSpriteForUse(use_bmp,
+        ((sprite_flags & SPF_ALPHACHANNEL) != 0) && !conv.AlphaToMask);
     if (game.GetColorDepth() < 32)
     {
         sprite_flags &= ~SPF_ALPHACHANNEL;
@@ -21,6 +21,9 @@
 // replacing more than half-translucent alpha pixels with transparency mask pixels.
 Common::Bitmap *remove_alpha_channel(Common::Bitmap *from);
 Size get_new_size_for_sprite(const Size &size, const uint32_t sprite_flags);
+// Tells which pixel conversions the sprite reader may do for the game's
+// color depth and the graphics driver, while loading the sprite image.
+Common::SpriteConversion get_sprite_conversion(Common::sprkey_t index, const uint32_t sprite_flags);
 // Initializes a loaded sprite for use in the game, adjusts the sprite flags.
 // Returns a resulting bitmap, which may be a new or old bitmap; or null on failure.
 // Original bitmap **gets deleted** if a new bitmap had to be created,
@@ -0,0 +1,104 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "gfx/bitmap.h"
+#include "gfx/blender.h"
+#include "gfx/gfx_util.h"
+
+using namespace AGS::Common;
+using namespace AGS::Engine;
+
+typedef uint32_t(*PfnBlender)(uint32_t src_col, uint32_t dst_col, uint32_t src_alpha);
+
+static const size_t PixelCount = 64 * 1024;
+
+// Generates a row of pixels with varying color and alpha
+static std::vector<uint32_t> MakePixels(uint32_t seed) {
+    std::vector<uint32_t> px(PixelCount);
+    for (auto &p : px)
+        p = (seed = seed * 1103515245u + 12345u);
+    return px;
+}
+
+// Runs the blender function over the arrays of pixels, the way Allegro's
+// sprite drawing calls it per each pixel
+static void BM_BlenderKernel(benchmark::State &state, PfnBlender blender) {
+    const std::vector<uint32_t> src = MakePixels(1u);
+    const std::vector<uint32_t> dst = MakePixels(2u);
+    std::vector<uint32_t> out(PixelCount);
+    const uint32_t alpha = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        for (size_t i = 0; i < PixelCount; ++i)
+            out[i] = blender(src[i], dst[i], alpha);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * PixelCount);
+}
+
+BENCHMARK_CAPTURE(BM_BlenderKernel, argb2argb, _argb2argb_blender)->Arg(0)->Arg(128);
+BENCHMARK_CAPTURE(BM_BlenderKernel, argb2rgb, _argb2rgb_blender)->Arg(0)->Arg(128);
+BENCHMARK_CAPTURE(BM_BlenderKernel, rgb2argb, _rgb2argb_blender)->Arg(0)->Arg(128);
+BENCHMARK_CAPTURE(BM_BlenderKernel, color32, _myblender_color32)->Arg(128);
+BENCHMARK_CAPTURE(BM_BlenderKernel, color32_light, _myblender_color32_light)->Arg(128);
+BENCHMARK_CAPTURE(BM_BlenderKernel, color16, _myblender_color16)->Arg(128);
+
+static const int SpriteSize = 256;
+
+static std::unique_ptr<Bitmap> MakeSprite(int color_depth) {
+    std::unique_ptr<Bitmap> sprite(BitmapHelper::CreateBitmap(SpriteSize, SpriteSize, color_depth));
+    sprite->ClearTransparent();
+    for (int y = 0; y < SpriteSize; y += 8)
+        sprite->FillRect(Rect(y / 2, y, SpriteSize - 1 - y / 2, y + 3), 0x80000000 | (y * 0x010101));
+    return sprite;
+}
+
+// Draws a 32-bit sprite over a 32-bit surface with alpha blending
+static void BM_DrawSpriteBlend(benchmark::State &state) {
+    std::unique_ptr<Bitmap> sprite = MakeSprite(32);
+    std::unique_ptr<Bitmap> ds(BitmapHelper::CreateBitmap(SpriteSize, SpriteSize, 32));
+    ds->Clear(0xFF204060);
+    const int alpha = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        GfxUtil::DrawSpriteBlend(ds.get(), Point(), sprite.get(), kBlendMode_Alpha, false, true, alpha);
+    }
+    state.SetItemsProcessed(state.iterations() * SpriteSize * SpriteSize);
+}
+BENCHMARK(BM_DrawSpriteBlend)->Arg(0xFF)->Arg(128);
+
+// Draws a sprite with uniform transparency, ignoring its alpha channel
+static void BM_DrawSpriteWithTransparency(benchmark::State &state) {
+    const int color_depth = static_cast<int>(state.range(0));
+    std::unique_ptr<Bitmap> sprite = MakeSprite(color_depth);
+    std::unique_ptr<Bitmap> ds(BitmapHelper::CreateBitmap(SpriteSize, SpriteSize, color_depth));
+    ds->Clear(0);
+    for (auto _ : state) {
+        GfxUtil::DrawSpriteWithTransparency(ds.get(), sprite.get(), 0, 0, 128);
+    }
+    state.SetItemsProcessed(state.iterations() * SpriteSize * SpriteSize);
+}
+BENCHMARK(BM_DrawSpriteWithTransparency)->Arg(16)->Arg(32);
+
+// Draws a sprite over a solid color, as used by the software fade
+static void BM_DrawSpriteOverColor(benchmark::State &state) {
+    const int color_depth = static_cast<int>(state.range(0));
+    std::unique_ptr<Bitmap> sprite = MakeSprite(color_depth);
+    std::unique_ptr<Bitmap> ds(BitmapHelper::CreateBitmap(SpriteSize, SpriteSize, color_depth));
+    for (auto _ : state) {
+        GfxUtil::DrawSpriteOverColor(ds.get(), sprite.get(), 0, 0, 0, 128);
+    }
+    state.SetItemsProcessed(state.iterations() * SpriteSize * SpriteSize);
+}
+BENCHMARK(BM_DrawSpriteOverColor)->Arg(16)->Arg(32);
@@ -0,0 +1,83 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "script/cc_instance.h"
+#include "script/cc_internal.h"
+#include "script/cc_script.h"
+
+using namespace AGS::Common;
+
+static const int32_t LoopCount = 1000;
+
+// Synthetic script with two exported functions, which both sum numbers
+// from LoopCount down to 1 and return the result.
+static PScript MakeLoopScript() {
+    PScript script = std::make_shared<ccScript>();
+    script->code = {
+        // int SumRegs(): uses only registers
+        /*  0 */ SCMD_LITTOREG, SREG_CX, LoopCount,
+        /*  3 */ SCMD_LITTOREG, SREG_BX, 0,
+        /*  6 */ SCMD_ADDREG, SREG_BX, SREG_CX,     // loop start
+        /*  9 */ SCMD_SUB, SREG_CX, 1,
+        /* 12 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+        /* 15 */ SCMD_JZ, 2,                        // -> 19
+        /* 17 */ SCMD_JMP, -13,                     // -> 6
+        /* 19 */ SCMD_REGTOREG, SREG_BX, SREG_AX,
+        /* 22 */ SCMD_RET,
+        // int SumLocal(): accumulates into a local variable, like compiled code does
+        /* 23 */ SCMD_LITTOREG, SREG_CX, LoopCount,
+        /* 26 */ SCMD_LITTOREG, SREG_AX, 0,
+        /* 29 */ SCMD_PUSHREG, SREG_AX,
+        /* 31 */ SCMD_LINENUM, 1,                   // loop start
+        /* 33 */ SCMD_LOADSPOFFS, 4,
+        /* 35 */ SCMD_MEMREAD, SREG_BX,
+        /* 37 */ SCMD_ADDREG, SREG_BX, SREG_CX,
+        /* 40 */ SCMD_MEMWRITE, SREG_BX,
+        /* 42 */ SCMD_SUB, SREG_CX, 1,
+        /* 45 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+        /* 48 */ SCMD_JZ, 2,                        // -> 52
+        /* 50 */ SCMD_JMP, -21,                     // -> 31
+        /* 52 */ SCMD_LOADSPOFFS, 4,
+        /* 54 */ SCMD_MEMREAD, SREG_AX,
+        /* 56 */ SCMD_SUB, SREG_SP, 4,
+        /* 59 */ SCMD_RET
+    };
+    script->exports = { "SumRegs$0", "SumLocal$0" };
+    script->export_addr = { (EXPORT_FUNCTION << 24) | 0, (EXPORT_FUNCTION << 24) | 23 };
+    return script;
+}
+
+static void BM_ccInstance_Run(benchmark::State &state, const char *funcname) {
+    PScript script = MakeLoopScript();
+    std::unique_ptr<ccInstance> inst(ccInstance::CreateFromScript(script));
+    if (!inst) {
+        state.SkipWithError("failed to create script instance");
+        return;
+    }
+    for (auto _ : state) {
+        if (inst->CallScriptFunction(funcname, 0, nullptr) != 0) {
+            state.SkipWithError("script function failed");
+            break;
+        }
+    }
+    if (inst->returnValue != LoopCount * (LoopCount + 1) / 2)
+        state.SkipWithError("script function returned wrong result");
+    // Each loop iteration runs a fixed number of instructions, count loops
+    state.SetItemsProcessed(state.iterations() * LoopCount);
+}
+
+BENCHMARK_CAPTURE(BM_ccInstance_Run, Registers, "SumRegs");
+BENCHMARK_CAPTURE(BM_ccInstance_Run, LocalVar, "SumLocal");
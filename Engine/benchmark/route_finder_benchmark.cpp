@@ -0,0 +1,77 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "ac/movelist.h"
+#include "ac/route_finder_impl.h"
+#include "gfx/bitmap.h"
+
+using namespace AGS::Common;
+using namespace AGS::Engine;
+
+extern std::vector<MoveList> mls;
+
+static const int MaskWidth = 640;
+static const int MaskHeight = 360;
+
+// Walkable area with a number of rectangular obstacles scattered around
+static std::unique_ptr<Bitmap> MakeOpenMask() {
+    std::unique_ptr<Bitmap> mask(BitmapHelper::CreateBitmap(MaskWidth, MaskHeight, 8));
+    mask->Clear(1);
+    for (int y = 40; y < MaskHeight - 40; y += 60)
+        for (int x = 40 + (y / 60 % 2) * 30; x < MaskWidth - 40; x += 60)
+            mask->FillRect(Rect(x, y, x + 29, y + 29), 0);
+    return mask;
+}
+
+// Walkable area split into a serpentine corridor by long walls
+static std::unique_ptr<Bitmap> MakeMazeMask() {
+    std::unique_ptr<Bitmap> mask(BitmapHelper::CreateBitmap(MaskWidth, MaskHeight, 8));
+    mask->Clear(1);
+    for (int i = 0, x = 40; x < MaskWidth - 20; ++i, x += 40) {
+        if (i % 2 == 0)
+            mask->FillRect(Rect(x, 0, x + 7, MaskHeight - 30), 0);
+        else
+            mask->FillRect(Rect(x, 30, x + 7, MaskHeight - 1), 0);
+    }
+    return mask;
+}
+
+static void BM_FindRoute(benchmark::State &state, std::unique_ptr<Bitmap>(*make_mask)()) {
+    std::unique_ptr<Bitmap> mask = make_mask();
+    mls.resize(1);
+    RouteFinder::init_pathfinder();
+    RouteFinder::set_wallscreen(mask.get());
+    for (auto _ : state) {
+        int res = RouteFinder::find_route(5, 5, MaskWidth - 6, MaskHeight - 6, 4, 4, mask.get(), 0);
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["stages"] = mls[0].numstage;
+    RouteFinder::shutdown_pathfinder();
+}
+
+BENCHMARK_CAPTURE(BM_FindRoute, Open, MakeOpenMask);
+BENCHMARK_CAPTURE(BM_FindRoute, Maze, MakeMazeMask);
+
+static void BM_CanSeeFrom(benchmark::State &state) {
+    std::unique_ptr<Bitmap> mask = MakeOpenMask();
+    RouteFinder::init_pathfinder();
+    RouteFinder::set_wallscreen(mask.get());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RouteFinder::can_see_from(5, 5, MaskWidth - 6, 5));
+    }
+    RouteFinder::shutdown_pathfinder();
+}
+BENCHMARK(BM_CanSeeFrom);
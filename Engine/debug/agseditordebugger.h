@@ -27,6 +27,9 @@ public:
     virtual void Shutdown() = 0;
     virtual bool SendMessageToEditor(const char *message) = 0;
     virtual bool IsMessageAvailable() = 0;
+    // Waits until a message becomes available, or timeout (in ms) expires;
+    // returns whether there's a message available
+    virtual bool WaitForMessage(int timeout_ms) = 0;
     // Message will be allocated on heap with malloc
     virtual char* GetNextMessage() = 0;
 };
@@ -74,13 +74,24 @@ IAGSEditorDebugger *GetEditorDebugger(const char *instanceToken)
 
 #else   // AGS_PLATFORM_OS_WINDOWS
 
+#include "debug/filebasedagsdebugger.h"
+#include "platform/linux/debug/inotifyagsdebugger.h"
+
 IAGSEditorDebugger *GetEditorDebugger(const char* /*instanceToken*/)
 {
-    return nullptr;
+#if AGS_PLATFORM_OS_LINUX && !defined(AGS_DISABLE_THREADS)
+    return new INotifyAGSDebugger();
+#else
+    return new FileBasedAGSDebugger();
+#endif
 }
 
 #endif
 
+// Max time to wait for the debugger's message at once, in ms;
+// lets the engine check for other conditions while it waits for the editor
+const int DEBUGGER_WAIT_TIMEOUT = 100;
+
 int debug_flags=0;
 
 FPSDisplayMode display_fps = kFPS_Hide;
@@ -453,13 +464,7 @@ bool send_state_to_debugger(const char *msg)
 
 bool init_editor_debugging(const ConfigTree &cfg) 
 {
-#if AGS_PLATFORM_OS_WINDOWS
     editor_debugger = GetEditorDebugger(editor_debugger_instance_token);
-#else
-    // Editor isn't ported yet
-    editor_debugger = nullptr;
-#endif
-
     if (editor_debugger == nullptr)
         quit("editor_debugger is NULL but debugger enabled");
 
@@ -471,7 +476,7 @@ bool init_editor_debugging(const ConfigTree &cfg)
         // and then its READY message
         while (check_for_messages_from_debugger() != 2)
         {
-            platform->Delay(10);
+            editor_debugger->WaitForMessage(DEBUGGER_WAIT_TIMEOUT);
         }
 
         send_state_to_debugger("START");
@@ -587,43 +592,46 @@ int check_for_messages_from_debugger()
 
 bool send_exception_to_debugger(const char *qmsg)
 {
-#if AGS_PLATFORM_OS_WINDOWS
     want_exit = false;
+#if AGS_PLATFORM_OS_WINDOWS
     // allow the editor to break with the error message
     if (editor_window_handle != NULL)
         SetForegroundWindow(editor_window_handle);
+#endif
 
     if (!send_state_to_debugger("ERROR", qmsg))
         return false;
 
     while ((check_for_messages_from_debugger() == 0) && (!want_exit))
     {
-        platform->Delay(10);
+        editor_debugger->WaitForMessage(DEBUGGER_WAIT_TIMEOUT);
     }
-#else
-    (void)qmsg;
-#endif
     return true;
 }
 
+bool wait_for_debugger_message(int timeout_ms)
+{
+    return editor_debugger->WaitForMessage(timeout_ms);
+}
+
 
 void break_into_debugger() 
 {
 #if AGS_PLATFORM_OS_WINDOWS
-
     if (editor_window_handle != NULL)
         SetForegroundWindow(editor_window_handle);
+#endif
 
     send_state_to_debugger("BREAK");
     game_paused_in_debugger = 1;
 
+    // sleep until the editor tells to resume
     while (game_paused_in_debugger) 
     {
         update_polled_stuff();
-        platform->YieldCPU();
+        if (game_paused_in_debugger)
+            editor_debugger->WaitForMessage(DEBUGGER_WAIT_TIMEOUT);
     }
-
-#endif
 }
 
 int scrDebugWait = 0;
@@ -27,6 +27,9 @@ extern IAGSEditorDebugger *editor_debugger;
 extern int break_on_next_script_step;
 
 int check_for_messages_from_debugger();
+// Sleeps until the debugger sends a message, or timeout (in ms) expires;
+// returns whether there's a message available
+bool wait_for_debugger_message(int timeout_ms);
 bool send_state_to_debugger(const char *msg);
 bool send_exception_to_debugger(const char *qmsg);
 // Returns current script's location and callstack
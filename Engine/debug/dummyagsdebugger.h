@@ -24,6 +24,7 @@ public:
     void Shutdown() override { }
     bool SendMessageToEditor(const char *message) override { return false; }
     bool IsMessageAvailable() override { return false; }
+    bool WaitForMessage(int timeout_ms) override { return false; }
     char* GetNextMessage() override { return NULL; }
 };
 
@@ -25,6 +25,9 @@
 using namespace AGS::Common;
 
 const char* SENT_MESSAGE_FILE_NAME = "dbgrecv.tmp";
+const char* RECEIVED_MESSAGE_FILE_NAME = "dbgsend.tmp";
+// Delay between tests for the message file, in ms
+const int MESSAGE_POLL_DELAY = 10;
 
 bool FileBasedAGSDebugger::Initialize()
 {
@@ -56,12 +59,23 @@ bool FileBasedAGSDebugger::SendMessageToEditor(const char *message)
 
 bool FileBasedAGSDebugger::IsMessageAvailable()
 {
-    return (File::IsFile("dbgsend.tmp") != 0);
+    return (File::IsFile(RECEIVED_MESSAGE_FILE_NAME) != 0);
+}
+
+bool FileBasedAGSDebugger::WaitForMessage(int timeout_ms)
+{
+    for (int waited = 0; !IsMessageAvailable(); waited += MESSAGE_POLL_DELAY)
+    {
+        if (waited >= timeout_ms)
+            return false;
+        platform->Delay(MESSAGE_POLL_DELAY);
+    }
+    return true;
 }
 
 char* FileBasedAGSDebugger::GetNextMessage()
 {
-    auto in = File::OpenFileRead("dbgsend.tmp");
+    auto in = File::OpenFileRead(RECEIVED_MESSAGE_FILE_NAME);
     if (in == nullptr)
     {
         // check again, because the editor might have deleted the file in the meantime
@@ -70,7 +84,7 @@ char* FileBasedAGSDebugger::GetNextMessage()
     size_t fileSize = (size_t)std::min((soff_t)std::numeric_limits<size_t>::max, in->GetLength());
     char *msg = (char*)malloc(fileSize + 1);
     in->Read(msg, fileSize);
-    File::DeleteFile("dbgsend.tmp");
+    File::DeleteFile(RECEIVED_MESSAGE_FILE_NAME);
     msg[fileSize] = 0;
     return msg;
 }
@@ -25,10 +25,12 @@ public:
     void Shutdown() override;
     bool SendMessageToEditor(const char *message) override;
     bool IsMessageAvailable() override;
+    bool WaitForMessage(int timeout_ms) override;
     char* GetNextMessage() override;
 
 };
 
 extern const char* SENT_MESSAGE_FILE_NAME;
+extern const char* RECEIVED_MESSAGE_FILE_NAME;
 
 #endif // __AC_FILEBASEDAGSDEBUGGER_H
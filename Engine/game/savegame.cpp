@@ -25,6 +25,7 @@
 #include "ac/global_audio.h"
 #include "ac/global_character.h"
 #include "ac/gui.h"
+#include "ac/lighting.h"
 #include "ac/mouse.h"
 #include "ac/overlay.h"
 #include "ac/region.h"
@@ -322,6 +323,7 @@ void DoBeforeRestore(PreservedParams &pp)
     unload_old_room();
     raw_saved_screen = nullptr;
     remove_all_overlays();
+    reset_lighting();
     play.complete_overlay_on = 0;
     play.text_overlay_on = 0;
 
@@ -543,6 +545,8 @@ HSaveError DoAfterRestore(const PreservedParams &pp, RestoredData &r_data)
                 thisroom.BgFrames[i].Graphic = r_data.RoomBkgScene[i];
             }
         }
+        reset_background_frame_cache();
+        mark_current_background_dirty();
 
         in_new_room=3;  // don't run "enters screen" events
         // now that room has loaded, copy saved light levels in
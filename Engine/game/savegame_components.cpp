@@ -24,6 +24,7 @@
 #include "ac/gamesetupstruct.h"
 #include "ac/gamestate.h"
 #include "ac/gui.h"
+#include "ac/lighting.h"
 #include "ac/mouse.h"
 #include "ac/movelist.h"
 #include "ac/overlay.h"
@@ -116,30 +117,6 @@ bool AssertFormatTagStrict(HSaveError &err, Stream *in, const String &tag, bool
     return true;
 }
 
-inline bool AssertCompatLimit(HSaveError &err, int count, int max_count, const char *content_name)
-{
-    if (count > max_count)
-    {
-        err = new SavegameError(kSvgErr_IncompatibleEngine,
-            String::FromFormat("Incompatible number of %s (count: %d, max: %d).",
-            content_name, count, max_count));
-        return false;
-    }
-    return true;
-}
-
-inline bool AssertCompatRange(HSaveError &err, int value, int min_value, int max_value, const char *content_name)
-{
-    if (value < min_value || value > max_value)
-    {
-        err = new SavegameError(kSvgErr_IncompatibleEngine,
-            String::FromFormat("Restore game error: incompatible %s (id: %d, range: %d - %d).",
-            content_name, value, min_value, max_value));
-        return false;
-    }
-    return true;
-}
-
 inline bool AssertGameContent(HSaveError &err, int new_val, int original_val, const char *content_name)
 {
     if (new_val != original_val)
@@ -925,6 +902,17 @@ HSaveError ReadDynamicSurfaces(Stream *in, int32_t /*cmp_ver*/, soff_t cmp_size,
     return err;
 }
 
+HSaveError WriteLighting(Stream *out)
+{
+    write_lighting(out);
+    return HSaveError::None();
+}
+
+HSaveError ReadLighting(Stream *in, int32_t cmp_ver, soff_t /*cmp_size*/, const PreservedParams& /*pp*/, RestoredData& /*r_data*/)
+{
+    return read_lighting(in, static_cast<LightingSvgVersion>(cmp_ver));
+}
+
 HSaveError WriteScriptModules(Stream *out)
 {
     // write the data segment of the global script
@@ -1267,6 +1255,13 @@ ComponentHandler ComponentHandlers[] =
         WriteDynamicSurfaces,
         ReadDynamicSurfaces
     },
+    {
+        "Lighting",
+        kLightingSvgVersion_Initial,
+        kLightingSvgVersion_Initial,
+        WriteLighting,
+        ReadLighting
+    },
     {
         "Script Modules",
         0,
@@ -18,6 +18,7 @@
 #include <vector>
 #include <unordered_map>
 #include "ac/common_defines.h"
+#include "game/savegame.h"
 #include "game/roomstruct.h"
 #include "gfx/bitmap.h"
 #include "media/audio/audiodefines.h"
@@ -146,6 +147,33 @@ struct RestoredData
 };
 
 
+// Tests that the number of saved entries does not exceed the engine's limit
+inline bool AssertCompatLimit(HSaveError &err, int count, int max_count, const char *content_name)
+{
+    if (count > max_count)
+    {
+        err = new SavegameError(kSvgErr_IncompatibleEngine,
+            String::FromFormat("Incompatible number of %s (count: %d, max: %d).",
+            content_name, count, max_count));
+        return false;
+    }
+    return true;
+}
+
+// Tests that the saved value is within the range supported by the engine
+inline bool AssertCompatRange(HSaveError &err, int value, int min_value, int max_value, const char *content_name)
+{
+    if (value < min_value || value > max_value)
+    {
+        err = new SavegameError(kSvgErr_IncompatibleEngine,
+            String::FromFormat("Restore game error: incompatible %s (id: %d, range: %d - %d).",
+            content_name, value, min_value, max_value));
+        return false;
+    }
+    return true;
+}
+
+
 enum PluginSvgVersion
 {
     kPluginSvgVersion_Initial = 0,
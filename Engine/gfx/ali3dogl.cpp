@@ -1696,6 +1696,89 @@ void OGLGraphicsDriver::UpdateTexture(Texture *txdata, const Bitmap *bitmap, boo
       unselect_palette();
 }
 
+void OGLGraphicsDriver::UpdateTextureRegionPart(OGLTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque,
+    const Rect &area)
+{
+  // The tile's image may be surrounded by the edge pixels, see UpdateTextureRegion()
+  const int tilex = (tile->allocWidth > tile->width) ? std::min(tile->allocWidth - tile->width - 1, 1) : 0;
+  const int tiley = (tile->allocHeight > tile->height) ? std::min(tile->allocHeight - tile->height - 1, 1) : 0;
+  // Part's position inside the tile's image, and the edges it touches
+  const int part_x = area.Left - tile->x;
+  const int part_y = area.Top - tile->y;
+  const int part_w = area.GetWidth();
+  const int part_h = area.GetHeight();
+  const int edge_l = (part_x == 0 && tilex > 0) ? 1 : 0;
+  const int edge_t = (part_y == 0 && tiley > 0) ? 1 : 0;
+  const int edge_r = (part_x + part_w == tile->width && tile->allocWidth > tile->width) ? 1 : 0;
+  const int edge_b = (part_y + part_h == tile->height && tile->allocHeight > tile->height) ? 1 : 0;
+  const int buf_w = part_w + edge_l + edge_r;
+  const int buf_h = part_h + edge_t + edge_b;
+
+  std::vector<uint32_t> buf(buf_w * buf_h);
+  const int pitch = buf_w * sizeof(uint32_t);
+  uint8_t *memPtr = reinterpret_cast<uint8_t*>(&buf[edge_t * buf_w + edge_l]);
+  TextureTile part;
+  part.x = area.Left;
+  part.y = area.Top;
+  part.width = part_w;
+  part.height = part_h;
+  assert(!opaque || !has_alpha); // has_alpha is meaningless with opaque
+  if (opaque)
+    BitmapToVideoMemOpaque(bitmap, &part, memPtr, pitch);
+  else
+    BitmapToVideoMem(bitmap, has_alpha, &part, memPtr, pitch, _filter->UseLinearFiltering());
+
+  // Update the edge pixels which the part touches, same as UpdateTextureRegion() does
+  for (int y = edge_t; y < edge_t + part_h; ++y)
+  {
+    uint32_t *row = &buf[y * buf_w];
+    if (edge_l)
+      row[0] = row[1] & 0x00FFFFFF;
+    if (edge_r)
+      row[buf_w - 1] = row[buf_w - 2] & 0x00FFFFFF;
+  }
+  if (edge_t)
+  {
+    for (int x = 0; x < buf_w; ++x)
+      buf[x] = buf[buf_w + x] & 0x00FFFFFF;
+  }
+  if (edge_b)
+  {
+    for (int x = 0; x < buf_w; ++x)
+      buf[(buf_h - 1) * buf_w + x] = buf[(buf_h - 2) * buf_w + x] & 0x00FFFFFF;
+  }
+
+  glBindTexture(GL_TEXTURE_2D, tile->texture);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, tilex + part_x - edge_l, tiley + part_y - edge_t, buf_w, buf_h,
+    GL_RGBA, GL_UNSIGNED_BYTE, buf.data());
+}
+
+void OGLGraphicsDriver::UpdateDDBRegionFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha,
+    const Rect &area)
+{
+  OGLBitmap *target = (OGLBitmap*)ddb;
+  OGLTexture *ogldata = target->_data.get();
+  if (bitmap->GetColorDepth() != ogldata->Res.ColorDepth)
+    throw Ali3DException("UpdateDDBRegionFromBitmap: mismatched colour depths");
+  if (ogldata->Res.Width != bitmap->GetWidth() || ogldata->Res.Height != bitmap->GetHeight())
+    throw Ali3DException("UpdateDDBRegionFromBitmap: mismatched bitmap size");
+
+  if (bitmap->GetColorDepth() == 8)
+      select_palette(palette);
+
+  for (size_t i = 0; i < ogldata->_numTiles; ++i)
+  {
+    OGLTextureTile *tile = &ogldata->_tiles[i];
+    const Rect rc = IntersectRects(area, RectWH(tile->x, tile->y, tile->width, tile->height));
+    if (!rc.IsEmpty())
+      UpdateTextureRegionPart(tile, bitmap, has_alpha, target->_opaque, rc);
+  }
+  target->_hasAlpha = has_alpha;
+
+  if (bitmap->GetColorDepth() == 8)
+      unselect_palette();
+}
+
 int OGLGraphicsDriver::GetCompatibleBitmapFormat(int color_depth)
 {
   if (color_depth == 8)
@@ -248,6 +248,7 @@ public:
     IDriverDependantBitmap* CreateDDB(int width, int height, int color_depth, bool opaque) override;
     IDriverDependantBitmap* CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) override;
     void UpdateDDBFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha) override;
+    void UpdateDDBRegionFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha, const Rect &area) override;
     void DestroyDDB(IDriverDependantBitmap* ddb) override;
     
     // Create texture data with the given parameters
@@ -390,6 +391,8 @@ private:
     void ReleaseDisplayMode();
     void AdjustSizeToNearestSupportedByCard(int *width, int *height);
     void UpdateTextureRegion(OGLTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque);
+    // Updates the part of the texture tile, given in bitmap coordinates
+    void UpdateTextureRegionPart(OGLTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque, const Rect &area);
     void CreateVirtualScreen();
     void RenderSprite(const OGLDrawListEntry *entry, const glm::mat4 &projection, const glm::mat4 &matGlobal,
         const SpriteColorTransform &color, const Size &rend_sz);
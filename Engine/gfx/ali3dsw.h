@@ -180,6 +180,9 @@ public:
     IDriverDependantBitmap* CreateDDBFromBitmap(const Bitmap *bitmap, bool has_alpha, bool opaque) override;
     IDriverDependantBitmap* CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) override;
     void UpdateDDBFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha) override;
+    // Software DDB refers to the bitmap itself, so there's nothing to upload
+    void UpdateDDBRegionFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha, const Rect&) override
+    { UpdateDDBFromBitmap(ddb, bitmap, has_alpha); }
     void DestroyDDB(IDriverDependantBitmap* ddb) override;
 
     // Create texture data with the given parameters
@@ -15,6 +15,7 @@
 #include "core/platform.h"
 #include "gfx/gfx_util.h"
 #include "gfx/blender.h"
+#include "util/math.h"
 
 namespace AGS
 {
@@ -163,6 +164,83 @@ void DrawSpriteWithTransparency(Bitmap *ds, Bitmap *sprite, int x, int y, int al
     }
 }
 
+// Blends a row of 32-bit pixels over a solid color; this reproduces Allegro's
+// _blender_trans24 with a constant destination, which lets compiler
+// keep all the invariants in registers and vectorize the loop.
+static void BlendRowOverColor32(uint32_t *dst, const uint32_t *src, int width,
+    uint32_t mask_color, uint32_t fill_color, uint32_t n)
+{
+    const uint32_t fill_rb = fill_color & 0xFF00FF;
+    const uint32_t fill_g = fill_color & 0xFF00;
+    for (int x = 0; x < width; ++x)
+    {
+        const uint32_t c = src[x];
+        const uint32_t rb = (((c & 0xFF00FF) - fill_rb) * n / 256 + fill_color) & 0xFF00FF;
+        const uint32_t g = (((c & 0xFF00) - fill_g) * n / 256 + fill_g) & 0xFF00;
+        dst[x] = (c == mask_color) ? fill_color : (rb | g);
+    }
+}
+
+// Blends a row of 15 or 16-bit pixels over a solid color; this reproduces
+// Allegro's _blender_trans15 and _blender_trans16 with a constant destination.
+template <uint32_t SPLIT_MASK>
+static void BlendRowOverColor16(uint16_t *dst, const uint16_t *src, int width,
+    uint32_t mask_color, uint32_t fill_color, uint32_t n)
+{
+    const uint32_t fill_split = ((fill_color & 0xFFFF) | (fill_color << 16)) & SPLIT_MASK;
+    for (int x = 0; x < width; ++x)
+    {
+        const uint32_t c = src[x];
+        const uint32_t c_split = ((c & 0xFFFF) | (c << 16)) & SPLIT_MASK;
+        const uint32_t res = ((c_split - fill_split) * n / 32 + fill_split) & SPLIT_MASK;
+        dst[x] = static_cast<uint16_t>((c == mask_color) ? fill_color : ((res & 0xFFFF) | (res >> 16)));
+    }
+}
+
+bool DrawSpriteOverColor(Bitmap *ds, Bitmap *sprite, int x, int y, color_t fill_color, int alpha)
+{
+    const int color_depth = ds->GetColorDepth();
+    if ((sprite->GetColorDepth() != color_depth) ||
+        (color_depth != 15 && color_depth != 16 && color_depth != 32))
+        return false;
+
+    const Rect dst_rc = IntersectRects(ds->GetClip(),
+        RectWH(x, y, sprite->GetWidth(), sprite->GetHeight()));
+    if (dst_rc.IsEmpty())
+        return true;
+
+    const int src_x = dst_rc.Left - x;
+    const int src_y = dst_rc.Top - y;
+    const int width = dst_rc.GetWidth();
+    const uint32_t mask_color = sprite->GetMaskColor();
+    // Alpha factor is adjusted the same way as Allegro's blenders do
+    uint32_t n = Math::Clamp(alpha, 0, 0xFF);
+    for (int dy = dst_rc.Top, sy = src_y; dy <= dst_rc.Bottom; ++dy, ++sy)
+    {
+        uint8_t *dst_line = ds->GetScanLineForWriting(dy);
+        const uint8_t *src_line = sprite->GetScanLine(sy);
+        switch (color_depth)
+        {
+        case 32:
+            BlendRowOverColor32(reinterpret_cast<uint32_t*>(dst_line) + dst_rc.Left,
+                reinterpret_cast<const uint32_t*>(src_line) + src_x, width,
+                mask_color, fill_color, n ? n + 1 : 0);
+            break;
+        case 16:
+            BlendRowOverColor16<0x7E0F81F>(reinterpret_cast<uint16_t*>(dst_line) + dst_rc.Left,
+                reinterpret_cast<const uint16_t*>(src_line) + src_x, width,
+                mask_color, fill_color, n ? (n + 1) / 8 : 0);
+            break;
+        case 15:
+            BlendRowOverColor16<0x3E07C1F>(reinterpret_cast<uint16_t*>(dst_line) + dst_rc.Left,
+                reinterpret_cast<const uint16_t*>(src_line) + src_x, width,
+                mask_color, fill_color, n ? (n + 1) / 8 : 0);
+            break;
+        }
+    }
+    return true;
+}
+
 } // namespace GfxUtil
 
 } // namespace Engine
@@ -51,6 +51,14 @@ namespace GfxUtil
     // ignores image's alpha channel, even if there's one;
     // does proper conversion depending on respected color depths.
     void DrawSpriteWithTransparency(Bitmap *ds, Bitmap *sprite, int x, int y, int alpha = 0xFF);
+
+    // Draws a bitmap over a solid color with given alpha level (0 - 255);
+    // the result is same as filling the destination area with the color and
+    // then drawing a bitmap with TransBlendBlt, but done in a single pass.
+    // Pixels of the bitmap's mask color are replaced with the fill color.
+    // Supports only bitmaps of same 15, 16 or 32-bit color depth; returns
+    // false if the formats are not supported, in which case nothing is drawn.
+    bool DrawSpriteOverColor(Bitmap *ds, Bitmap *sprite, int x, int y, color_t fill_color, int alpha);
 } // namespace GfxUtil
 
 } // namespace Engine
@@ -150,6 +150,10 @@ public:
   // Updates DBB using the given bitmap; if bitmap has a different resolution,
   // then creates a new texture data and attaches to DDB
   virtual void UpdateDDBFromBitmap(IDriverDependantBitmap* bitmapToUpdate, const Bitmap *bitmap, bool has_alpha) = 0;
+  // Updates only the given area of DDB using the given bitmap; the bitmap
+  // must have same resolution and color depth as the DDB
+  virtual void UpdateDDBRegionFromBitmap(IDriverDependantBitmap* bitmapToUpdate, const Bitmap *bitmap,
+      bool has_alpha, const Rect &area) = 0;
   // Destroy the DDB; note that this does not dispose the texture unless there's no more refs to it
   virtual void DestroyDDB(IDriverDependantBitmap* bitmap) = 0;
 
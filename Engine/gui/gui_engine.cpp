@@ -152,6 +152,14 @@ int GUILabel::PrepareTextToDraw()
     return GUI::SplitLinesForDrawing(_textToDraw.GetCStr(), is_translated, Lines, Font, _width);
 }
 
+bool GUILabel::IsTextOutdated() const
+{
+    const bool is_translated = (Flags & kGUICtrl_Translated) != 0;
+    String text;
+    replace_macro_tokens(is_translated ? get_translation(Text.GetCStr()) : Text.GetCStr(), text);
+    return text != _textToDraw;
+}
+
 void GUITextBox::DrawTextBoxContents(Bitmap *ds, int x, int y, color_t text_color)
 {
     _textToDraw = Text;
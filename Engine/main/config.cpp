@@ -354,6 +354,8 @@ void apply_config(const ConfigTree &cfg)
         usetup.clear_cache_on_room_change = CfgReadBoolInt(cfg, "misc", "clear_cache_on_room_change", usetup.clear_cache_on_room_change);
         usetup.SpriteCacheSize = CfgReadInt(cfg, "graphics", "sprite_cache_size", usetup.SpriteCacheSize);
         usetup.TextureCacheSize = CfgReadInt(cfg, "graphics", "texture_cache_size", usetup.TextureCacheSize);
+        usetup.BgFrameCacheSize = CfgReadInt(cfg, "graphics", "bg_frame_cache_size", usetup.BgFrameCacheSize);
+        usetup.BitmapPoolSize = CfgReadInt(cfg, "graphics", "bitmap_pool_size", usetup.BitmapPoolSize);
         usetup.SoundCacheSize = CfgReadInt(cfg, "sound", "cache_size", usetup.SoundCacheSize);
         usetup.SoundLoadAtOnceSize = CfgReadInt(cfg, "sound", "stream_threshold", usetup.SoundLoadAtOnceSize);
 
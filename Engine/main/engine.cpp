@@ -60,6 +60,7 @@
 #include "gfx/graphicsdriver.h"
 #include "gfx/gfxdriverfactory.h"
 #include "gfx/ddb.h"
+#include "gfx/bitmappool.h"
 #include "media/audio/sound.h"
 #include "main/config.h"
 #include "main/game_file.h"
@@ -587,6 +588,8 @@ HError engine_init_sprites()
     if (usetup.SpriteCacheSize > 0)
         spriteset.SetMaxCacheSize(usetup.SpriteCacheSize * 1024);
     Debug::Printf("Sprite cache set: %zu KB", spriteset.GetMaxCacheSize() / 1024);
+    BitmapPool::SetMaxPooledSize(usetup.BitmapPoolSize * 1024);
+    Debug::Printf("Bitmap pool set: %zu KB", usetup.BitmapPoolSize);
     return HError::None();
 }
 
@@ -1156,10 +1159,12 @@ void engine_init_editor_debugging(const ConfigTree &cfg)
         return;
 
     auto waitUntil = AGS_Clock::now() + std::chrono::milliseconds(500);
-    while (waitUntil > AGS_Clock::now())
+    for (auto now = AGS_Clock::now(); now < waitUntil; now = AGS_Clock::now())
     {
         // pick up any breakpoints in game_start
-        check_for_messages_from_debugger();
+        if (check_for_messages_from_debugger() == 0)
+            wait_for_debugger_message(static_cast<int>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(waitUntil - now).count()));
     }
 
     ccSetDebugHook(scriptDebugHook);
@@ -24,6 +24,7 @@
 #include "ac/character.h"
 #include "ac/characterextras.h"
 #include "ac/characterinfo.h"
+#include "ac/coroutine.h"
 #include "ac/draw.h"
 #include "ac/event.h"
 #include "ac/game.h"
@@ -225,6 +226,7 @@ static void game_loop_do_early_script_update()
     if (in_new_room == 0) {
         // Run the room and game script repeatedly_execute
         run_function_on_non_blocking_thread(&repExecAlways);
+        update_coroutines();
         setevent(EV_TEXTSCRIPT, kTS_Repeat);
         setevent(EV_RUNEVBLOCK, EVB_ROOM, 0, EVROM_REPEXEC);
     }
@@ -245,8 +247,11 @@ static bool game_loop_check_ground_level_interactions()
     if ((play.ground_level_areas_disabled & GLED_INTERACTION) == 0) {
         // check if he's standing on a hotspot
         int hotspotThere = get_hotspot_at(playerchar->x, playerchar->y);
-        // run Stands on Hotspot event
-        setevent(EV_RUNEVBLOCK, EVB_HOTSPOT, hotspotThere, EVHOT_STANDSON);
+        // run Stands on Hotspot event, unless the hotspot has script handlers
+        // but no handler for this event (this event has no unhandled_event too)
+        const auto *hs_handlers = thisroom.Hotspots[hotspotThere].EventHandlers.get();
+        if (!hs_handlers || hs_handlers->HasHandler(EVHOT_STANDSON))
+            setevent(EV_RUNEVBLOCK, EVB_HOTSPOT, hotspotThere, EVHOT_STANDSON);
 
         // check current region
         int onRegion = GetRegionIDAtRoom(playerchar->x, playerchar->y);
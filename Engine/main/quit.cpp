@@ -40,6 +40,7 @@
 #include "ac/spritecache.h"
 #include "gfx/graphicsdriver.h"
 #include "gfx/bitmap.h"
+#include "gfx/bitmappool.h"
 #include "core/assetmanager.h"
 #include "platform/base/agsplatformdriver.h"
 #include "platform/base/sys_main.h"
@@ -100,6 +101,16 @@ void quit_check_dynamic_sprites(QuitReason qreason)
     }
 }
 
+// Prints the bitmap allocation stats and frees the pooled buffers
+void quit_release_bitmap_pool()
+{
+    const auto stats = BitmapPool::GetStats();
+    Debug::Printf("Bitmap pool: %llu hits, %llu misses, %llu buffers released; %zu KB kept",
+        static_cast<unsigned long long>(stats.Hits), static_cast<unsigned long long>(stats.Misses),
+        static_cast<unsigned long long>(stats.Rejects), stats.PooledSize / 1024);
+    BitmapPool::Clear();
+}
+
 void quit_shutdown_audio()
 {
     set_our_eip(9917);
@@ -216,6 +227,7 @@ void quit(const char *quitmsg)
     quit_check_dynamic_sprites(qreason);
     unload_game();
     AssetMgr.reset();
+    quit_release_bitmap_pool();
 
     // Be sure to unlock mouse on exit, or users will hate us
     sys_window_lock_mouse(false);
@@ -28,6 +28,7 @@
 #include "ac/lipsync.h"
 #include "ac/movelist.h"
 #include "ac/overlay.h"
+#include "ac/particleemitter.h"
 #include "ac/screenoverlay.h"
 #include "ac/spritecache.h"
 #include "ac/sys_events.h"
@@ -308,9 +309,12 @@ void update_following_exactly_characters(const std::vector<int> &followingAsShee
 void update_overlay_timers()
 {
 	// update overlay timers
+  // iterate backwards, because removing an overlay moves the last id in its place
   auto &overs = get_overlays();
-  for (auto &over : overs)
+  const auto &over_ids = get_active_overlays();
+  for (size_t i = over_ids.size(); i-- > 0;)
   {
+    auto &over = overs[over_ids[i]];
     if (over.timeout > 0) {
       over.timeout--;
       if (over.timeout == 0)
@@ -566,6 +570,8 @@ void update_stuff() {
 
   update_overlay_timers();
 
+  update_particle_emitters();
+
   update_speech_and_messages();
 
   set_our_eip(24);
@@ -0,0 +1,136 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "platform/linux/debug/inotifyagsdebugger.h"
+
+#if AGS_PLATFORM_OS_LINUX && !defined(AGS_DISABLE_THREADS)
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+INotifyAGSDebugger::~INotifyAGSDebugger()
+{
+    INotifyAGSDebugger::Shutdown();
+}
+
+bool INotifyAGSDebugger::Initialize()
+{
+    if (!FileBasedAGSDebugger::Initialize())
+        return false;
+
+    // The message files are exchanged in the current directory
+    _inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if ((_inotifyFd < 0) ||
+        (inotify_add_watch(_inotifyFd, ".", IN_CLOSE_WRITE | IN_MOVED_TO) < 0) ||
+        (pipe(_stopPipe) != 0))
+    {
+        CloseHandles();
+        return true; // fallback to polling the file
+    }
+
+    // The editor could have written a message before we began watching
+    _hasMessage = FileBasedAGSDebugger::IsMessageAvailable();
+    _watchThread = std::thread(&INotifyAGSDebugger::WatchFiles, this);
+    return true;
+}
+
+void INotifyAGSDebugger::Shutdown()
+{
+    if (_watchThread.joinable())
+    {
+        const char stop = 0;
+        if (write(_stopPipe[1], &stop, 1) == 1)
+            _watchThread.join();
+        else
+            _watchThread.detach(); // should not normally happen
+    }
+    CloseHandles();
+}
+
+bool INotifyAGSDebugger::IsMessageAvailable()
+{
+    if (_inotifyFd < 0)
+        return FileBasedAGSDebugger::IsMessageAvailable();
+    return _hasMessage;
+}
+
+bool INotifyAGSDebugger::WaitForMessage(int timeout_ms)
+{
+    if (_inotifyFd < 0)
+        return FileBasedAGSDebugger::WaitForMessage(timeout_ms);
+    std::unique_lock<std::mutex> lk(_mutex);
+    return _msgCond.wait_for(lk, std::chrono::milliseconds(timeout_ms),
+        [this]() { return _hasMessage.load(); });
+}
+
+char* INotifyAGSDebugger::GetNextMessage()
+{
+    // Reset the flag before reading, so that the next file's event is not lost;
+    // the editor does not write a new message until the old file is deleted.
+    _hasMessage = false;
+    return FileBasedAGSDebugger::GetNextMessage();
+}
+
+void INotifyAGSDebugger::WatchFiles()
+{
+    alignas(struct inotify_event) char buf[4096];
+    struct pollfd fds[2] = { { _inotifyFd, POLLIN, 0 }, { _stopPipe[0], POLLIN, 0 } };
+    for (;;)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].revents != 0)
+            break; // stop requested
+        if ((fds[0].revents & POLLIN) == 0)
+            continue;
+
+        ssize_t len = read(_inotifyFd, buf, sizeof(buf));
+        bool got_message = false;
+        for (const char *ptr = buf; ptr < buf + len;)
+        {
+            const auto *ev = reinterpret_cast<const struct inotify_event*>(ptr);
+            if ((ev->len > 0) && (strcmp(ev->name, RECEIVED_MESSAGE_FILE_NAME) == 0))
+                got_message = true;
+            ptr += sizeof(struct inotify_event) + ev->len;
+        }
+
+        if (got_message)
+        {
+            {
+                std::lock_guard<std::mutex> lk(_mutex);
+                _hasMessage = true;
+            }
+            _msgCond.notify_all();
+        }
+    }
+}
+
+void INotifyAGSDebugger::CloseHandles()
+{
+    if (_inotifyFd >= 0)
+        close(_inotifyFd);
+    if (_stopPipe[0] >= 0)
+        close(_stopPipe[0]);
+    if (_stopPipe[1] >= 0)
+        close(_stopPipe[1]);
+    _inotifyFd = -1;
+    _stopPipe[0] = _stopPipe[1] = -1;
+}
+
+#endif // AGS_PLATFORM_OS_LINUX && !AGS_DISABLE_THREADS
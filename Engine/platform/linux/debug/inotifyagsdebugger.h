@@ -0,0 +1,61 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// INotifyAGSDebugger uses the same file-based protocol as FileBasedAGSDebugger,
+// but instead of testing for the message file on each check, it has the system
+// notify it when the editor writes one. The directory is watched by a separate
+// thread, which sleeps until a file event arrives.
+// If inotify cannot be initialized, falls back to the regular file polling.
+//
+//=============================================================================
+#ifndef __AC_INOTIFYAGSDEBUGGER_H
+#define __AC_INOTIFYAGSDEBUGGER_H
+
+#include "core/platform.h"
+
+#if AGS_PLATFORM_OS_LINUX && !defined(AGS_DISABLE_THREADS)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "debug/filebasedagsdebugger.h"
+
+struct INotifyAGSDebugger : FileBasedAGSDebugger
+{
+public:
+    ~INotifyAGSDebugger();
+
+    bool Initialize() override;
+    void Shutdown() override;
+    bool IsMessageAvailable() override;
+    bool WaitForMessage(int timeout_ms) override;
+    char* GetNextMessage() override;
+
+private:
+    // Watches for the message file events, until stopped
+    void WatchFiles();
+    // Closes all the watch handles
+    void CloseHandles();
+
+    int _inotifyFd = -1;
+    int _stopPipe[2] = { -1, -1 };
+    std::thread _watchThread;
+    std::mutex _mutex;
+    std::condition_variable _msgCond;
+    std::atomic<bool> _hasMessage{false};
+};
+
+#endif // AGS_PLATFORM_OS_LINUX && !AGS_DISABLE_THREADS
+
+#endif // __AC_INOTIFYAGSDEBUGGER_H
@@ -76,6 +76,19 @@ bool NamedPipesAGSDebugger::IsMessageAvailable()
     return (bytesAvailable > 0);
 }
 
+bool NamedPipesAGSDebugger::WaitForMessage(int timeout_ms)
+{
+    // NOTE: synchronous pipes cannot be waited on, so we test them with short delays
+    const int poll_delay = 5;
+    for (int waited = 0; !IsMessageAvailable(); waited += poll_delay)
+    {
+        if (waited >= timeout_ms)
+            return false;
+        Sleep(poll_delay);
+    }
+    return true;
+}
+
 char* NamedPipesAGSDebugger::GetNextMessage()
 {
     DWORD bytesAvailable = 0;
@@ -32,6 +32,7 @@ public:
     void Shutdown() override;
     bool SendMessageToEditor(const char *message) override;
     bool IsMessageAvailable() override;
+    bool WaitForMessage(int timeout_ms) override;
     char* GetNextMessage() override;
 };
 
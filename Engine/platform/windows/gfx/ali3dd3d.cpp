@@ -1624,6 +1624,41 @@ void D3DGraphicsDriver::DestroyDDB(IDriverDependantBitmap* ddb)
     delete (D3DBitmap*)ddb;
 }
 
+// Tells which of the pixels beyond the tile's image (right column, bottom row)
+// belong to the texture and are touched by the given part of the tile
+static void GetTileEdges(const D3DTextureTile *tile, const Rect &part, int &edge_r, int &edge_b)
+{
+  edge_r = (part.Right == tile->width - 1 && tile->allocWidth > tile->width) ? 1 : 0;
+  edge_b = (part.Bottom == tile->height - 1 && tile->allocHeight > tile->height) ? 1 : 0;
+}
+
+// Copies the edge pixels of the tile's image, made fully transparent, into the
+// texture pixels just beyond the image, same as the OpenGL renderer does;
+// otherwise linear filtering would blend the image edges with undefined pixels.
+// part_ptr points to the part's first pixel in the locked texture.
+static void FillTileEdges(const D3DTextureTile *tile, const Rect &part, uint8_t *part_ptr, int pitch)
+{
+  int edge_r, edge_b;
+  GetTileEdges(tile, part, edge_r, edge_b);
+  const int part_w = part.GetWidth();
+  const int part_h = part.GetHeight();
+  if (edge_r)
+  {
+    for (int y = 0; y < part_h; ++y)
+    {
+      uint32_t *row = reinterpret_cast<uint32_t*>(part_ptr + y * pitch);
+      row[part_w] = row[part_w - 1] & 0x00FFFFFF;
+    }
+  }
+  if (edge_b)
+  {
+    const uint32_t *src_row = reinterpret_cast<const uint32_t*>(part_ptr + (part_h - 1) * pitch);
+    uint32_t *dst_row = reinterpret_cast<uint32_t*>(part_ptr + part_h * pitch);
+    for (int x = 0; x < part_w + edge_r; ++x)
+      dst_row[x] = src_row[x] & 0x00FFFFFF;
+  }
+}
+
 void D3DGraphicsDriver::UpdateTextureRegion(D3DTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque)
 {
   auto &texture = tile->texture;
@@ -1643,6 +1678,7 @@ void D3DGraphicsDriver::UpdateTextureRegion(D3DTextureTile *tile, const Bitmap *
     BitmapToVideoMemOpaque(bitmap, tile, memPtr, lockedRegion.Pitch);
   else
     BitmapToVideoMem(bitmap, has_alpha, tile, memPtr, lockedRegion.Pitch, usingLinearFiltering);
+  FillTileEdges(tile, RectWH(0, 0, tile->width, tile->height), memPtr, lockedRegion.Pitch);
 
   texture->UnlockRect(0);
 }
@@ -1676,6 +1712,67 @@ void D3DGraphicsDriver::UpdateTexture(Texture *txdata, const Bitmap *bitmap, boo
       unselect_palette();
 }
 
+void D3DGraphicsDriver::UpdateTextureRegionPart(D3DTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque,
+    const Rect &area)
+{
+  auto &texture = tile->texture;
+
+  // Lock only the part of the texture, keeping the rest of its contents;
+  // include the pixels beyond the tile's image if the part touches its edges
+  const Rect tile_rc = RectWH(area.Left - tile->x, area.Top - tile->y, area.GetWidth(), area.GetHeight());
+  int edge_r, edge_b;
+  GetTileEdges(tile, tile_rc, edge_r, edge_b);
+  RECT lockRect = { tile_rc.Left, tile_rc.Top, tile_rc.Right + 1 + edge_r, tile_rc.Bottom + 1 + edge_b };
+  D3DLOCKED_RECT lockedRegion;
+  HRESULT hr = texture->LockRect(0, &lockedRegion, &lockRect, D3DLOCK_NOSYSLOCK);
+  if (hr != D3D_OK)
+  {
+    throw Ali3DException("Unable to lock texture");
+  }
+
+  bool usingLinearFiltering = _filter->NeedToColourEdgeLines();
+  uint8_t *memPtr = static_cast<uint8_t*>(lockedRegion.pBits);
+  TextureTile part;
+  part.x = area.Left;
+  part.y = area.Top;
+  part.width = area.GetWidth();
+  part.height = area.GetHeight();
+
+  assert(!opaque || !has_alpha); // has_alpha is meaningless with opaque
+  if (opaque)
+    BitmapToVideoMemOpaque(bitmap, &part, memPtr, lockedRegion.Pitch);
+  else
+    BitmapToVideoMem(bitmap, has_alpha, &part, memPtr, lockedRegion.Pitch, usingLinearFiltering);
+  FillTileEdges(tile, tile_rc, memPtr, lockedRegion.Pitch);
+
+  texture->UnlockRect(0);
+}
+
+void D3DGraphicsDriver::UpdateDDBRegionFromBitmap(IDriverDependantBitmap *ddb, const Bitmap *bitmap, bool has_alpha,
+    const Rect &area)
+{
+  D3DBitmap *target = (D3DBitmap*)ddb;
+  D3DTexture *d3ddata = target->_data.get();
+  if (bitmap->GetColorDepth() != d3ddata->Res.ColorDepth)
+    throw Ali3DException("UpdateDDBRegionFromBitmap: mismatched colour depths");
+  if (d3ddata->Res.Width != bitmap->GetWidth() || d3ddata->Res.Height != bitmap->GetHeight())
+    throw Ali3DException("UpdateDDBRegionFromBitmap: mismatched bitmap size");
+
+  if (bitmap->GetColorDepth() == 8)
+      select_palette(palette);
+
+  for (auto &tile : d3ddata->_tiles)
+  {
+    const Rect rc = IntersectRects(area, RectWH(tile.x, tile.y, tile.width, tile.height));
+    if (!rc.IsEmpty())
+      UpdateTextureRegionPart(&tile, bitmap, has_alpha, target->_opaque, rc);
+  }
+  target->_hasAlpha = has_alpha;
+
+  if (bitmap->GetColorDepth() == 8)
+      unselect_palette();
+}
+
 int D3DGraphicsDriver::GetCompatibleBitmapFormat(int color_depth)
 {
   if (color_depth == 8)
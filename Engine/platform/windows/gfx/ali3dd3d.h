@@ -238,6 +238,7 @@ public:
     IDriverDependantBitmap* CreateDDB(int width, int height, int color_depth, bool opaque) override;
     IDriverDependantBitmap* CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) override;
     void UpdateDDBFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha) override;
+    void UpdateDDBRegionFromBitmap(IDriverDependantBitmap* ddb, const Bitmap *bitmap, bool has_alpha, const Rect &area) override;
     void DestroyDDB(IDriverDependantBitmap* ddb) override;
 
     // Create texture data with the given parameters
@@ -375,6 +376,8 @@ private:
     void set_up_default_vertices();
     void AdjustSizeToNearestSupportedByCard(int *width, int *height);
     void UpdateTextureRegion(D3DTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque);
+    // Updates the part of the texture tile, given in bitmap coordinates
+    void UpdateTextureRegionPart(D3DTextureTile *tile, const Bitmap *bitmap, bool has_alpha, bool opaque, const Rect &area);
     void CreateVirtualScreen();
     bool IsTextureFormatOk( D3DFORMAT TextureFormat, D3DFORMAT AdapterFormat );
 
@@ -744,13 +744,23 @@ int IAGSEngine::GetMovementPathLastWaypoint(int32 pathId) {
 }
 
 void IAGSEngine::GetMovementPathWaypointLocation(int32 pathId, int32 waypoint, int32 *x, int32 *y) {
-    *x = mls[pathId % TURNING_AROUND].pos[waypoint].X;
-    *y = mls[pathId % TURNING_AROUND].pos[waypoint].Y;
+    const MoveList &cmls = mls[pathId % TURNING_AROUND];
+    if ((waypoint < 0) || (waypoint >= cmls.numstage)) {
+        *x = 0; *y = 0;
+        return;
+    }
+    *x = cmls.pos[waypoint].X;
+    *y = cmls.pos[waypoint].Y;
 }
 
 void IAGSEngine::GetMovementPathWaypointSpeed(int32 pathId, int32 waypoint, int32 *xSpeed, int32 *ySpeed) {
-    *xSpeed = mls[pathId % TURNING_AROUND].xpermove[waypoint];
-    *ySpeed = mls[pathId % TURNING_AROUND].ypermove[waypoint];
+    const MoveList &cmls = mls[pathId % TURNING_AROUND];
+    if ((waypoint < 0) || (waypoint >= cmls.numstage)) {
+        *xSpeed = 0; *ySpeed = 0;
+        return;
+    }
+    *xSpeed = cmls.xpermove[waypoint];
+    *ySpeed = cmls.ypermove[waypoint];
 }
 
 int IAGSEngine::IsRunningUnderDebugger()
@@ -208,6 +208,25 @@ struct FunctionCallStack
 };
 
 
+#define MAXNEST 50  // number of recursive function calls allowed
+// Local state of the interpreter loop, saved when the script is suspended
+struct ScriptSuspendState
+{
+    int32_t Pc = 0;
+    int32_t ThisBase[MAXNEST]{};
+    int32_t FuncStart[MAXNEST]{};
+    int     CurNest = 0;
+    int     WasJustCallas = -1;
+    int     NumArgsToFunc = -1;
+    int     NextCallNeedsObject = 0;
+    int     LoopIterationCheckDisabled = 0;
+    FunctionCallStack FuncCallStack;
+};
+
+// Run() result telling that the script was suspended
+const int kRun_Suspended = 1;
+
+
 unsigned ccInstance::_timeoutCheckMs = 60u;
 unsigned ccInstance::_timeoutAbortMs = 0u;
 unsigned ccInstance::_maxWhileLoops = 0u;
@@ -401,42 +420,31 @@ int ccInstance::CallScriptFunction(const char *funcname, int32_t numargs, const
     // the function args are pushed to the stack in REVERSE order, first
     // parameters are always the last, so function code knows how to find them
     // using negative offsets, and does not care about any preceding entries.
-    int32_t startat = -1;
-    char mangledName[200];
-    const size_t mangled_len = snprintf(mangledName, sizeof(mangledName), "%s$", funcname);
-    int export_args = numargs;
+    uint32_t k;
+    if (!FindExport(funcname, k)) {
+        cc_error("function '%s' not found", funcname);
+        return -2;
+    }
 
-    for (size_t k = 0; k < instanceof->exports.size(); k++) {
-        const char *thisExportName = instanceof->exports[k].c_str();
-        bool match = false;
-
-        // check for a mangled name match
-        if (strncmp(thisExportName, mangledName, mangled_len) == 0) {
-            // found, compare the number of parameters
-            export_args = atoi(thisExportName + mangled_len);
-            if (export_args > numargs) {
-                cc_error("Not enough parameters to exported function '%s' (expected %d, supplied %d)",
-                    funcname, export_args, numargs);
-                return -1;
-            }
-            match = true;
-        }
-        // check for an exact match (if the script was compiled with an older version)
-        if (match || (strcmp(thisExportName, funcname) == 0)) {
-            const int32_t etype = (instanceof->export_addr[k] >> 24L) & 0x000ff;
-            if (etype != EXPORT_FUNCTION) {
-                cc_error("symbol is not a function");
-                return -1;
-            }
-            startat = (instanceof->export_addr[k] & 0x00ffffff);
-            break;
+    int export_args = numargs;
+    // check for a mangled name, which has the number of parameters appended;
+    // otherwise this is an exact match (if the script was compiled with an older version)
+    const char *mangled_args = strchr(instanceof->exports[k].c_str(), '$');
+    if (mangled_args) {
+        // compare the number of parameters
+        export_args = atoi(mangled_args + 1);
+        if (export_args > numargs) {
+            cc_error("Not enough parameters to exported function '%s' (expected %d, supplied %d)",
+                funcname, export_args, numargs);
+            return -1;
         }
     }
-
-    if (startat < 0) {
-        cc_error("function '%s' not found", funcname);
-        return -2;
+    const int32_t etype = (instanceof->export_addr[k] >> 24L) & 0x000ff;
+    if (etype != EXPORT_FUNCTION) {
+        cc_error("symbol is not a function");
+        return -1;
     }
+    const int32_t startat = (instanceof->export_addr[k] & 0x00ffffff);
 
     // Prepare instance for run
     flags &= ~INSTF_ABORTED;
@@ -458,7 +466,23 @@ int ccInstance::CallScriptFunction(const char *funcname, int32_t numargs, const
     InstThreads.push_back(this); // push instance thread
     runningInst = this;
     const int reterr = Run(startat);
+    return FinishScriptFunction(reterr, numargs);
+}
+
+int ccInstance::FinishScriptFunction(int run_result, int32_t numargs)
+{
+    if (run_result == kRun_Suspended)
+    {
+        // keep the stack and position, only leave the instance thread
+        InstThreads.pop_back();
+        _suspendedArgs = numargs;
+        flags |= INSTF_SUSPENDED;
+        return CC_RUN_SUSPENDED;
+    }
+
+    const int reterr = run_result;
     // Cleanup before returning, even if error
+    _stackRefs.clear();
     ASSERT_STACK_SIZE(numargs);
     PopValuesFromStack(numargs);
     pc = 0;
@@ -488,6 +512,65 @@ int ccInstance::CallScriptFunction(const char *funcname, int32_t numargs, const
     return cc_has_error();
 }
 
+bool ccInstance::Suspend()
+{
+    // only the top-level function of this instance may be suspended,
+    // because the far calls are run by the nested Run() calls
+    if ((pc == 0) || (runningInst != this) || (_farCallDepth > 0))
+        return false;
+    if (!_suspendState)
+        _suspendState.reset(new ScriptSuspendState());
+    flags |= INSTF_SUSPEND;
+    return true;
+}
+
+int ccInstance::Resume()
+{
+    if ((flags & INSTF_SUSPENDED) == 0)
+    {
+        cc_error("script instance is not suspended");
+        return -1;
+    }
+
+    cc_clear_error();
+    flags &= ~(INSTF_SUSPENDED | INSTF_ABORTED);
+    currentline = line_number;
+    InstThreads.push_back(this); // push instance thread
+    runningInst = this;
+    const int reterr = Run(_suspendState->Pc, _suspendState.get());
+    return FinishScriptFunction(reterr, _suspendedArgs);
+}
+
+bool ccInstance::IsSuspended() const
+{
+    return (flags & INSTF_SUSPENDED) != 0;
+}
+
+void ccInstance::TrackStackRefs()
+{
+    flags |= INSTF_TRACKSTACKREFS;
+}
+
+void ccInstance::CancelSuspended()
+{
+    if ((flags & INSTF_SUSPENDED) == 0)
+        return;
+
+    // the locals would be released by the script's own code when leaving
+    // their scope, which is never going to be run now
+    for (const auto &ref : _stackRefs)
+    {
+        const int32_t handle = ref.ReadInt32();
+        if (handle != 0)
+            ccReleaseObjectReference(handle);
+    }
+    _stackRefs.clear();
+    flags &= ~INSTF_SUSPENDED;
+    registers[SREG_SP].SetStackPtr(&stack[0]);
+    stackdata_ptr = stackdata;
+    pc = 0;
+}
+
 // Macros to maintain the call stack
 #define PUSH_CALL_STACK \
     if (callStackSize >= MAX_CALL_STACK) { \
@@ -579,8 +662,7 @@ inline bool FixupArgument(RuntimeScriptValue &arg, const int fixup, const uintpt
 }
 
 
-#define MAXNEST 50  // number of recursive function calls allowed
-int ccInstance::Run(int32_t curpc)
+int ccInstance::Run(int32_t curpc, const ScriptSuspendState *resume_from)
 {
     pc = curpc;
     returnValue = -1;
@@ -605,6 +687,17 @@ int ccInstance::Run(int32_t curpc)
     const bool dump_opcodes = ccGetOption(SCOPT_DEBUGRUN) != 0;
 #endif
     int loopIterationCheckDisabled = 0;
+    if (resume_from)
+    {
+        curnest = resume_from->CurNest;
+        std::copy(resume_from->ThisBase, resume_from->ThisBase + curnest + 1, thisbase);
+        std::copy(resume_from->FuncStart, resume_from->FuncStart + curnest + 1, funcstart);
+        was_just_callas = resume_from->WasJustCallas;
+        num_args_to_func = resume_from->NumArgsToFunc;
+        next_call_needs_object = resume_from->NextCallNeedsObject;
+        loopIterationCheckDisabled = resume_from->LoopIterationCheckDisabled;
+        func_callstack = resume_from->FuncCallStack;
+    }
     unsigned loopIterations = 0u; // any loop iterations (needed for timeout test)
     unsigned loopCheckIterations = 0u; // loop iterations accumulated only if check is enabled
 
@@ -1166,6 +1259,8 @@ int ccInstance::Run(int32_t curpc)
             }
             // Assign always, avoid leaving undefined value
             registers[SREG_MAR].WriteInt32(newHandle);
+            if ((flags & INSTF_TRACKSTACKREFS) && (registers[SREG_MAR].Type == kScValStackPtr))
+                AddStackRef(registers[SREG_MAR]);
             break;
         }
         case SCMD_MEMINITPTR:
@@ -1202,6 +1297,8 @@ int ccInstance::Run(int32_t curpc)
 
             ccAddObjectReference(newHandle);
             registers[SREG_MAR].WriteInt32(newHandle);
+            if ((flags & INSTF_TRACKSTACKREFS) && (registers[SREG_MAR].Type == kScValStackPtr))
+                AddStackRef(registers[SREG_MAR]);
             break;
         }
         case SCMD_MEMZEROPTR:
@@ -1209,6 +1306,8 @@ int ccInstance::Run(int32_t curpc)
             int32_t handle = registers[SREG_MAR].ReadInt32();
             ccReleaseObjectReference(handle);
             registers[SREG_MAR].WriteInt32(0);
+            if ((flags & INSTF_TRACKSTACKREFS) && (registers[SREG_MAR].Type == kScValStackPtr))
+                RemoveStackRef(registers[SREG_MAR]);
             break;
         }
         case SCMD_MEMZEROPTRND:
@@ -1224,6 +1323,8 @@ int ccInstance::Run(int32_t curpc)
             ccReleaseObjectReference(handle);
             pool.disableDisposeForObject = nullptr;
             registers[SREG_MAR].WriteInt32(0);
+            if ((flags & INSTF_TRACKSTACKREFS) && (registers[SREG_MAR].Type == kScValStackPtr))
+                RemoveStackRef(registers[SREG_MAR]);
             break;
         }
         case SCMD_CHECKNULL:
@@ -1290,7 +1391,10 @@ int ccInstance::Run(int32_t curpc)
             }
             callAddr /= sizeof(uintptr_t); // size of ccScript::code elements
 
-            if (Run(static_cast<int32_t>(callAddr)))
+            _farCallDepth++;
+            const int far_result = Run(static_cast<int32_t>(callAddr));
+            _farCallDepth--;
+            if (far_result)
                 return -1;
 
             runningInst = wasRunning;
@@ -1385,6 +1489,23 @@ int ccInstance::Run(int32_t curpc)
             registers[SREG_AX] = return_value;
             next_call_needs_object = 0;
             num_args_to_func = -1;
+
+            if (flags & INSTF_SUSPEND)
+            {
+                // save the interpreter state, and continue from the next instruction on resume
+                flags &= ~INSTF_SUSPEND;
+                ScriptSuspendState &state = *_suspendState;
+                state.Pc = pc + codeOp.ArgCount + 1;
+                state.CurNest = curnest;
+                std::copy(thisbase, thisbase + curnest + 1, state.ThisBase);
+                std::copy(funcstart, funcstart + curnest + 1, state.FuncStart);
+                state.WasJustCallas = was_just_callas;
+                state.NumArgsToFunc = num_args_to_func;
+                state.NextCallNeedsObject = next_call_needs_object;
+                state.LoopIterationCheckDisabled = loopIterationCheckDisabled;
+                state.FuncCallStack = func_callstack;
+                return kRun_Suspended;
+            }
             break;
         }
         case SCMD_PUSHREAL:
@@ -1668,18 +1789,10 @@ void ccInstance::GetScriptPosition(ScriptPosition &script_pos) const
 // get a pointer to a variable or function exported by the script
 RuntimeScriptValue ccInstance::GetSymbolAddress(const char *symname) const
 {
-    char altName[200];
-    snprintf(altName, sizeof(altName), "%s$", symname);
-    RuntimeScriptValue rval_null;
-    const size_t len_altName = strlen(altName);
-    for (size_t k = 0; k < instanceof->exports.size(); k++) {
-        if (strcmp(instanceof->exports[k].c_str(), symname) == 0)
-            return exports[k];
-        // mangled function name
-        if (strncmp(instanceof->exports[k].c_str(), altName, len_altName) == 0)
-            return exports[k];
-    }
-    return rval_null;
+    uint32_t k;
+    if (FindExport(symname, k))
+        return exports[k];
+    return RuntimeScriptValue();
 }
 
 void ccInstance::DumpInstruction(const ScriptOperation &op) const
@@ -1789,6 +1902,7 @@ bool ccInstance::_Create(PScript scri, const ccInstance * joined)
     if (joined != nullptr) {
         // share memory space with an existing instance (ie. this is a thread/fork)
         globalvars = joined->globalvars;
+        exportmap = joined->exportmap;
         globaldatasize = joined->globaldatasize;
         globaldata = joined->globaldata;
         code = joined->code;
@@ -1861,6 +1975,7 @@ bool ccInstance::_Create(PScript scri, const ccInstance * joined)
         {
             return false;
         }
+        CreateExportMap(scri.get());
     }
 
     exports = new RuntimeScriptValue[scri->exports.size()];
@@ -1937,6 +2052,7 @@ void ccInstance::Free()
             free(code);
     }
     globalvars.reset();
+    exportmap.reset();
     globaldata = nullptr;
     code = nullptr;
     strings = nullptr;
@@ -2097,6 +2213,29 @@ ScriptVariable *ccInstance::FindGlobalVar(const int32_t var_addr)
     return it != globalvars->end() ? &it->second : nullptr;
 }
 
+void ccInstance::CreateExportMap(const ccScript *scri)
+{
+    exportmap.reset(new ExportMap());
+    for (size_t i = 0; i < scri->exports.size(); ++i)
+    {
+        // function names may be mangled with the number of parameters ("name$N"),
+        // register these under the plain name; first found export has priority
+        const std::string &name = scri->exports[i];
+        exportmap->emplace(name.substr(0, name.find('$')), static_cast<uint32_t>(i));
+    }
+}
+
+bool ccInstance::FindExport(const char *name, uint32_t &index) const
+{
+    if (!exportmap)
+        return false;
+    const auto it = exportmap->find(name);
+    if (it == exportmap->end())
+        return false;
+    index = it->second;
+    return true;
+}
+
 static int DetermineScriptLine(const int32_t *code, const size_t codesz, const size_t at_pc)
 {
     int line = -1;
@@ -2275,6 +2414,29 @@ RuntimeScriptValue ccInstance::GetStackPtrOffsetRw(const int32_t rw_offset)
     return stack_ptr;
 }
 
+void ccInstance::AddStackRef(const RuntimeScriptValue &stack_ptr)
+{
+    for (const auto &ref : _stackRefs)
+    {
+        if ((ref.RValue == stack_ptr.RValue) && (ref.IValue == stack_ptr.IValue))
+            return;
+    }
+    _stackRefs.push_back(stack_ptr);
+}
+
+void ccInstance::RemoveStackRef(const RuntimeScriptValue &stack_ptr)
+{
+    for (auto it = _stackRefs.begin(); it != _stackRefs.end(); ++it)
+    {
+        if ((it->RValue == stack_ptr.RValue) && (it->IValue == stack_ptr.IValue))
+        {
+            *it = _stackRefs.back();
+            _stackRefs.pop_back();
+            return;
+        }
+    }
+}
+
 void ccInstance::PushToFuncCallStack(FunctionCallStack &func_callstack, const RuntimeScriptValue &rval)
 {
     if (func_callstack.Count >= MAX_FUNC_PARAMS)
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "ac/timer.h"
 #include "script/cc_script.h"  // ccScript
@@ -33,6 +34,12 @@ using namespace AGS;
 #define INSTF_ABORTED       2
 #define INSTF_FREE          4
 #define INSTF_RUNNING       8   // set by main code to confirm script isn't stuck
+#define INSTF_SUSPEND       16  // script requested to suspend after the current external call
+#define INSTF_SUSPENDED     32  // script is suspended and may be resumed
+#define INSTF_TRACKSTACKREFS 64 // remember the stack locations which hold managed references
+
+// CallScriptFunction and Resume result telling that the script was suspended
+#define CC_RUN_SUSPENDED    101
 
 // Size of stack in RuntimeScriptValues (aka distinct variables)
 #define CC_STACK_SIZE       256
@@ -113,12 +120,18 @@ struct ScriptPosition
 };
 
 
+// Saved interpreter state of a suspended script
+struct ScriptSuspendState;
+
 // Running instance of the script
 struct ccInstance
 {
 public:
     typedef std::unordered_map<int32_t, ScriptVariable> ScVarMap;
     typedef std::shared_ptr<ScVarMap>                   PScVarMap;
+    // Lookup of the export indexes by their unmangled names
+    typedef std::unordered_map<std::string, uint32_t>   ExportMap;
+    typedef std::shared_ptr<ExportMap>                  PExportMap;
 public:
     int32_t flags;
     PScVarMap globalvars;
@@ -133,6 +146,7 @@ public:
     const char *strings;
     int32_t stringssize;
     RuntimeScriptValue *exports;
+    PExportMap exportmap;
     RuntimeScriptValue *stack;
     int  num_stackentries;
     // An array for keeping stack data; stack entries reference unknown data from here
@@ -182,6 +196,23 @@ public:
     
     // Call an exported function in the script
     int     CallScriptFunction(const char *funcname, int32_t num_params, const RuntimeScriptValue *params);
+    // Requests to suspend the running script as soon as the current external
+    // (engine) function returns; the script may be continued with Resume().
+    // Only the script function which was called by CallScriptFunction may be
+    // suspended, not the functions imported from other scripts, because these
+    // are run recursively. Returns whether the suspension is possible.
+    bool    Suspend();
+    // Continues running the suspended script;
+    // returns same values as CallScriptFunction
+    int     Resume();
+    // Tells whether this instance is suspended and waiting to be resumed
+    bool    IsSuspended() const;
+    // Starts recording which stack locations hold managed references, so that
+    // these may be released if the suspended script is never resumed
+    void    TrackStackRefs();
+    // Releases the managed references held by the locals of the suspended
+    // script, and resets its stack; the script may not be resumed after this
+    void    CancelSuspended();
     
     // Get the script's execution position and callstack as human-readable text
     Common::String GetCallStack(int max_lines = INT_MAX) const;
@@ -210,10 +241,17 @@ private:
     bool    CreateGlobalVars(const ccScript *scri);
     bool    AddGlobalVar(const ScriptVariable &glvar);
     ScriptVariable *FindGlobalVar(int32_t var_addr);
+    // Fills the lookup of the exports by name
+    void    CreateExportMap(const ccScript *scri);
+    // Finds the export's index by its unmangled name; returns false if not found
+    bool    FindExport(const char *name, uint32_t &index) const;
     bool    CreateRuntimeCodeFixups(const ccScript *scri);
 
-    // Begin executing script starting from the given bytecode index
-    int     Run(int32_t curpc);
+    // Begin executing script starting from the given bytecode index,
+    // or continue from the saved suspended state
+    int     Run(int32_t curpc, const ScriptSuspendState *resume_from = nullptr);
+    // Cleans up after the top-level script function has returned
+    int     FinishScriptFunction(int run_result, int32_t numargs);
 
     // Stack processing
     // Push writes new value and increments stack ptr;
@@ -229,6 +267,9 @@ private:
     // Return stack ptr at given offset from stack tail;
     // Offset is in data bytes; program stack ptr is __not__ changed
     RuntimeScriptValue GetStackPtrOffsetRw(int32_t rw_offset);
+    // Record or forget the stack location which holds a managed reference
+    void    AddStackRef(const RuntimeScriptValue &stack_ptr);
+    void    RemoveStackRef(const RuntimeScriptValue &stack_ptr);
 
     // Function call stack processing
     void    PushToFuncCallStack(FunctionCallStack &func_callstack, const RuntimeScriptValue &rval);
@@ -245,6 +286,15 @@ private:
     static unsigned _maxWhileLoops;
     // Last time the script was noted of being "alive"
     AGS_FastClock::time_point _lastAliveTs;
+    // Number of nested calls to the functions of other scripts
+    int     _farCallDepth = 0;
+    // State of the suspended script, and the number of args
+    // passed to the suspended function
+    std::unique_ptr<ScriptSuspendState> _suspendState;
+    int32_t _suspendedArgs = 0;
+    // Stack locations which currently hold managed references,
+    // recorded only if INSTF_TRACKSTACKREFS is set
+    std::vector<RuntimeScriptValue> _stackRefs;
 };
 
 #endif // __CC_INSTANCE_H
@@ -23,6 +23,7 @@ extern void RegisterAudioClipAPI();
 extern void RegisterButtonAPI();
 extern void RegisterCharacterAPI(ScriptAPIVersion base_api, ScriptAPIVersion compat_api);
 extern void RegisterContainerAPI();
+extern void RegisterCoroutineAPI();
 extern void RegisterDateTimeAPI();
 extern void RegisterDialogAPI();
 extern void RegisterDialogOptionsRenderingAPI();
@@ -37,12 +38,14 @@ extern void RegisterHotspotAPI();
 extern void RegisterInventoryItemAPI();
 extern void RegisterInventoryWindowAPI();
 extern void RegisterLabelAPI();
+extern void RegisterLightingAPI();
 extern void RegisterListBoxAPI();
 extern void RegisterMathAPI();
 extern void RegisterMouseAPI();
 extern void RegisterObjectAPI();
 extern void RegisterOverlayAPI();
 extern void RegisterParserAPI();
+extern void RegisterParticleEmitterAPI();
 extern void RegisterRegionAPI();
 extern void RegisterRoomAPI();
 extern void RegisterScreenAPI();
@@ -63,6 +66,7 @@ void setup_script_exports(ScriptAPIVersion base_api, ScriptAPIVersion compat_api
     RegisterButtonAPI();
     RegisterCharacterAPI(base_api, compat_api);
     RegisterContainerAPI();
+    RegisterCoroutineAPI();
     RegisterDateTimeAPI();
     RegisterDialogAPI();
     RegisterDialogOptionsRenderingAPI();
@@ -77,12 +81,14 @@ void setup_script_exports(ScriptAPIVersion base_api, ScriptAPIVersion compat_api
     RegisterInventoryItemAPI();
     RegisterInventoryWindowAPI();
     RegisterLabelAPI();
+    RegisterLightingAPI();
     RegisterListBoxAPI();
     RegisterMathAPI();
     RegisterMouseAPI();
     RegisterObjectAPI();
     RegisterOverlayAPI();
     RegisterParserAPI();
+    RegisterParticleEmitterAPI();
     RegisterRegionAPI();
     RegisterRoomAPI();
     RegisterScreenAPI();
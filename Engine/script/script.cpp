@@ -16,6 +16,7 @@
 #include "script/script.h"
 #include "ac/common.h"
 #include "ac/character.h"
+#include "ac/coroutine.h"
 #include "ac/dialog.h"
 #include "ac/event.h"
 #include "ac/game.h"
@@ -137,6 +138,13 @@ void run_function_on_non_blocking_thread(NonBlockingScriptFunction* funcToRun) {
     funcToRun->roomHasFunction = DoRunScriptFuncCantBlock(roominstFork.get(), funcToRun, funcToRun->roomHasFunction);
 }
 
+const char *ObjectEvent::GetBlockName() const
+{
+    static const char *BlockNames[kNumObjEventTypes] =
+        { "room", "hotspot%d", "object%d", "character%d", "inventory%d", "region%d" };
+    return BlockNames[Type];
+}
+
 int run_interaction_event(const ObjectEvent &obj_evt, Interaction *nint, int evnt, int chkAny, bool isInv) {
 
     if (evnt < 0 || (size_t)evnt >= nint->Events.size() ||
@@ -174,15 +182,14 @@ int run_interaction_event(const ObjectEvent &obj_evt, Interaction *nint, int evn
 // Returns 0 normally, or -1 to indicate that the NewInteraction has
 // become invalid and don't run another interaction on it
 // (eg. a room change occured)
-int run_interaction_script(const ObjectEvent &obj_evt, InteractionScripts *nint, int evnt, int chkAny) {
+int run_interaction_script(const ObjectEvent &obj_evt, const InteractionScripts *nint, int evnt, int chkAny) {
 
-    if (evnt < 0 || static_cast<size_t>(evnt) >= nint->ScriptFuncNames.size() ||
-            nint->ScriptFuncNames[evnt].IsEmpty()) {
+    if (!nint->HasHandler(evnt)) {
         // no response defined for this event
         // If there is a response for "Any Click", then abort now so as to
         // run that instead
         if (chkAny < 0) ;
-        else if (!nint->ScriptFuncNames[chkAny].IsEmpty())
+        else if (nint->HasHandler(chkAny))
             return 0;
 
         // Otherwise, run unhandled_event
@@ -200,17 +207,14 @@ int run_interaction_script(const ObjectEvent &obj_evt, InteractionScripts *nint,
     // TODO: find a way to generalize all the following hard-coded behavior
 
     // Character or Inventory require a global script call
-    const ScriptInstType inst_type =
-        (strstr(obj_evt.BlockName.GetCStr(), "character") != nullptr) ||
-        (strstr(obj_evt.BlockName.GetCStr(), "inventory") != nullptr) ?
-        kScInstGame : kScInstRoom;
-    
+    const ScriptInstType inst_type = obj_evt.IsGlobalEvent() ? kScInstGame : kScInstRoom;
+
     // Room events do not require additional params
-    if ((strstr(obj_evt.BlockName.GetCStr(), "room") != nullptr)) {
+    if (obj_evt.Type == kObjEvent_Room) {
         QueueScriptFunction(inst_type, nint->ScriptFuncNames[evnt].GetCStr());
     }
     // Regions only require 1 param - dynobj ref
-    else if ((strstr(obj_evt.BlockName.GetCStr(), "region") != nullptr)) {
+    else if (obj_evt.Type == kObjEvent_Region) {
         QueueScriptFunction(inst_type, nint->ScriptFuncNames[evnt].GetCStr(), 1, &obj_evt.DynObj);
     }
     // Other types (characters, objects, invitems, hotspots) require
@@ -532,6 +536,7 @@ void AllocScriptModules()
 
 void FreeAllScriptInstances()
 {
+    stop_all_coroutines();
     ccInstance::FreeInstanceStack();
     FreeRoomScriptInstance();
 
@@ -546,6 +551,8 @@ void FreeAllScriptInstances()
 
 void FreeRoomScriptInstance()
 {
+    // coroutine threads are forks, so have to be deleted before the instance
+    stop_room_coroutines();
     // NOTE: don't know why, but Forks must be deleted prior to primary inst,
     // or bad things will happen; TODO: investigate and make this less fragile
     roominstFork.reset();
@@ -769,7 +776,7 @@ int run_interaction_commandlist(const ObjectEvent &obj_evt, InteractionCommandLi
     if (nicl == nullptr)
         return -1;
 
-    const char *evblockbasename = obj_evt.BlockName.GetCStr();
+    const char *evblockbasename = obj_evt.GetBlockName();
     const int evblocknum = obj_evt.BlockID;
     for (size_t i = 0; i < nicl->Cmds.size(); i++) {
         cmdsrun[0] ++;
@@ -782,7 +789,7 @@ int run_interaction_commandlist(const ObjectEvent &obj_evt, InteractionCommandLi
           { 
               TempEip tempip(4001);
               RuntimeScriptValue rval_null;
-                  if ((strstr(evblockbasename,"character")!=nullptr) || (strstr(evblockbasename,"inventory")!=nullptr)) {
+                  if (obj_evt.IsGlobalEvent()) {
                       // Character or Inventory (global script)
                       const char *torun = make_ts_func_name(evblockbasename,evblocknum,nicl->Cmds[i].Data[0].Value);
                       // we are already inside the mouseclick event of the script, can't nest calls
@@ -995,16 +1002,17 @@ void run_unhandled_event(const ObjectEvent &obj_evt, int evnt) {
     if (play.check_interaction_only)
         return;
 
-    const char *evblockbasename = obj_evt.BlockName.GetCStr();
     const int evblocknum = obj_evt.BlockID;
     int evtype=0;
 
-    if (ags_strnicmp(evblockbasename,"hotspot",7)==0) evtype=1;
-    else if (ags_strnicmp(evblockbasename,"object",6)==0) evtype=2;
-    else if (ags_strnicmp(evblockbasename,"character",9)==0) evtype=3;
-    else if (ags_strnicmp(evblockbasename,"inventory",9)==0) evtype=5;
-    else if (ags_strnicmp(evblockbasename,"region",6)==0)
-        return;  // no unhandled_events for regions
+    switch (obj_evt.Type) {
+    case kObjEvent_Hotspot: evtype=1; break;
+    case kObjEvent_Object: evtype=2; break;
+    case kObjEvent_Character: evtype=3; break;
+    case kObjEvent_Inventory: evtype=5; break;
+    case kObjEvent_Region: return; // no unhandled_events for regions
+    default: break;
+    }
 
     // clicked Hotspot 0, so change the type code
     if ((evtype == 1) & (evblocknum == 0) & (evnt != 0) & (evnt != 5) & (evnt != 6))
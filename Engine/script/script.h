@@ -33,13 +33,24 @@ using AGS::Common::InteractionVariable;
 #define REP_EXEC_ALWAYS_NAME "repeatedly_execute_always"
 #define REP_EXEC_NAME "repeatedly_execute"
 
+// Type of the object which interaction event is run
+enum ObjectEventType
+{
+    kObjEvent_Room,
+    kObjEvent_Hotspot,
+    kObjEvent_Object,
+    kObjEvent_Character,
+    kObjEvent_Inventory,
+    kObjEvent_Region,
+    kNumObjEventTypes
+};
+
 // ObjectEvent - a struct holds data of the object's interaction event,
 // such as object's reference and accompanying parameters
 struct ObjectEvent
 {
-    // Name of the script block to run, may be used as a formatting string;
-    // has a form of "objecttype%d"
-    String BlockName;
+    // Type of the object, defines the script block and the callback params
+    ObjectEventType Type = kObjEvent_Room;
     // Script block's ID, commonly corresponds to the object's ID
     int BlockID = 0;
     // Dynamic object this event was called for (if applicable)
@@ -48,11 +59,20 @@ struct ObjectEvent
     int Mode = MODE_NONE;
 
     ObjectEvent() = default;
-    ObjectEvent(const String &block_name, int block_id = 0)
-        : BlockName(block_name), BlockID(block_id) {}
-    ObjectEvent(const String &block_name, int block_id,
+    ObjectEvent(ObjectEventType type, int block_id = 0)
+        : Type(type), BlockID(block_id) {}
+    ObjectEvent(ObjectEventType type, int block_id,
                 const RuntimeScriptValue &dyn_obj, int mode = MODE_NONE)
-        : BlockName(block_name), BlockID(block_id), DynObj(dyn_obj), Mode(mode) {}
+        : Type(type), BlockID(block_id), DynObj(dyn_obj), Mode(mode) {}
+
+    // Gets the name of the script block to run, may be used as a formatting
+    // string; has a form of "objecttype%d"
+    const char *GetBlockName() const;
+    // Tells if this event's callbacks are located in the global script
+    bool IsGlobalEvent() const
+    {
+        return (Type == kObjEvent_Character) || (Type == kObjEvent_Inventory);
+    }
 };
 
 int     run_dialog_request (int parmtr);
@@ -71,7 +91,7 @@ int     run_interaction_event(const ObjectEvent &obj_evt, Interaction *nint, int
 // Runs the ObjectEvent using a script callback of 'evnt' index,
 // or alternatively of 'chkAny' index, if previous does not exist
 // Returns 0 normally, or -1 telling of a game state change (eg. a room change occured).
-int     run_interaction_script(const ObjectEvent &obj_evt, InteractionScripts *nint, int evnt, int chkAny = -1);
+int     run_interaction_script(const ObjectEvent &obj_evt, const InteractionScripts *nint, int evnt, int chkAny = -1);
 int     run_interaction_commandlist(const ObjectEvent &obj_evt, InteractionCommandList *nicl, int *timesrun, int*cmdsrun);
 void    run_unhandled_event(const ObjectEvent &obj_evt, int evnt);
 
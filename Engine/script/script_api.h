@@ -446,6 +446,11 @@ inline const char *ScriptVSprintf(char *buffer, size_t buf_length, const char *f
     METHOD((CLASS*)self, params[0].FValue, params[1].FValue); \
     return RuntimeScriptValue()
 
+#define API_OBJCALL_VOID_PFLOAT4(CLASS, METHOD) \
+    ASSERT_OBJ_PARAM_COUNT(METHOD, 4); \
+    METHOD((CLASS*)self, params[0].FValue, params[1].FValue, params[2].FValue, params[3].FValue); \
+    return RuntimeScriptValue()
+
 #define API_OBJCALL_VOID_PBOOL(CLASS, METHOD) \
     ASSERT_OBJ_PARAM_COUNT(METHOD, 1); \
     METHOD((CLASS*)self, params[0].GetAsBool()); \
@@ -486,6 +491,11 @@ inline const char *ScriptVSprintf(char *buffer, size_t buf_length, const char *f
     METHOD((CLASS*)self, (P1CLASS*)params[0].Ptr, params[1].IValue, params[2].IValue); \
     return RuntimeScriptValue((int32_t)0)
 
+#define API_OBJCALL_VOID_POBJ_PINT3(CLASS, METHOD, P1CLASS) \
+    ASSERT_OBJ_PARAM_COUNT(METHOD, 4); \
+    METHOD((CLASS*)self, (P1CLASS*)params[0].Ptr, params[1].IValue, params[2].IValue, params[3].IValue); \
+    return RuntimeScriptValue((int32_t)0)
+
 #define API_OBJCALL_VOID_POBJ2(CLASS, METHOD, P1CLASS, P2CLASS) \
     ASSERT_OBJ_PARAM_COUNT(METHOD, 2); \
     METHOD((CLASS*)self, (P1CLASS*)params[0].Ptr, (P2CLASS*)params[1].Ptr); \
@@ -0,0 +1,136 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <vector>
+#include "gtest/gtest.h"
+#include "ac/lightmask.h"
+
+static LightSource MakeCircleLight(int x, int y, int radius, int falloff, int intensity)
+{
+    LightSource light;
+    light.InUse = true;
+    light.X = x;
+    light.Y = y;
+    light.Radius = radius;
+    light.Falloff = falloff;
+    light.Intensity = intensity;
+    make_circle_light_shape(light);
+    return light;
+}
+
+TEST(LightMask, DirtyRects) {
+    std::vector<Rect> rects;
+    add_light_dirty_rect(rects, Rect());
+    add_light_dirty_rect(rects, RectWH(0, 0, 0, 10));
+    ASSERT_EQ(0u, rects.size());
+
+    for (int i = 0; i < LIGHTING_MAX_DIRTY_RECTS; ++i)
+        add_light_dirty_rect(rects, RectWH(i * 10, i * 5, 4, 4));
+    ASSERT_EQ(static_cast<size_t>(LIGHTING_MAX_DIRTY_RECTS), rects.size());
+    for (int i = 0; i < LIGHTING_MAX_DIRTY_RECTS; ++i)
+        EXPECT_EQ(RectWH(i * 10, i * 5, 4, 4), rects[i]);
+    // Empty rect does not cause a merge
+    add_light_dirty_rect(rects, Rect());
+    ASSERT_EQ(static_cast<size_t>(LIGHTING_MAX_DIRTY_RECTS), rects.size());
+
+    // The one over the limit merges all of them into their union
+    add_light_dirty_rect(rects, RectWH(-3, 200, 2, 2));
+    ASSERT_EQ(1u, rects.size());
+    EXPECT_EQ(Rect(-3, 0, (LIGHTING_MAX_DIRTY_RECTS - 1) * 10 + 3, 201), rects[0]);
+
+    // Then the list is filled again
+    add_light_dirty_rect(rects, RectWH(1, 1, 1, 1));
+    ASSERT_EQ(2u, rects.size());
+}
+
+TEST(LightMask, CircleShape) {
+    LightSource light = MakeCircleLight(0, 0, 3, 0, 100);
+    ASSERT_EQ(7, light.ShapeW);
+    ASSERT_EQ(7, light.ShapeH);
+    ASSERT_EQ(49u, light.Shape.size());
+    EXPECT_EQ(255, light.Shape[3 * 7 + 3]); // center
+    EXPECT_EQ(255, light.Shape[3 * 7 + 0]); // at the radius
+    EXPECT_EQ(255, light.Shape[0 * 7 + 3]);
+    EXPECT_EQ(0, light.Shape[0]); // corners are outside
+    EXPECT_EQ(0, light.Shape[6 * 7 + 6]);
+    EXPECT_EQ(RectWH(-3, -3, 7, 7), light.GetRect());
+
+    light = MakeCircleLight(0, 0, 3, 2, 100);
+    EXPECT_EQ(255, light.Shape[3 * 7 + 3]); // inner radius
+    EXPECT_EQ(255, light.Shape[3 * 7 + 2]);
+    EXPECT_EQ(128, light.Shape[3 * 7 + 1]); // half of the falloff
+    EXPECT_EQ(0, light.Shape[3 * 7 + 0]); // edge
+}
+
+TEST(LightMask, Compose) {
+    const Size mask_size(20, 10);
+    std::vector<uint8_t> mask(mask_size.Width * mask_size.Height, 0xAB);
+    std::vector<LightSource> lights;
+
+    // No lights: darkness level is converted to 0-255
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 100, lights);
+    for (auto m : mask)
+        ASSERT_EQ(255, m);
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 50, lights);
+    for (auto m : mask)
+        ASSERT_EQ(127, m);
+
+    // Full light removes all the darkness, half light removes half of it
+    lights.push_back(MakeCircleLight(5, 5, 2, 0, 100));
+    lights.push_back(MakeCircleLight(14, 5, 2, 0, 50));
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 100, lights);
+    EXPECT_EQ(0, mask[5 * 20 + 5]);
+    EXPECT_EQ(128, mask[5 * 20 + 14]);
+    EXPECT_EQ(255, mask[5 * 20 + 10]); // between the lights
+    EXPECT_EQ(255, mask[0]);
+
+    // Overlapping lights remove darkness in turn
+    lights.push_back(MakeCircleLight(14, 5, 2, 0, 50));
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 100, lights);
+    EXPECT_EQ(64, mask[5 * 20 + 14]);
+
+    // Unused and zero intensity lights are skipped
+    lights[0].InUse = false;
+    lights[1].Intensity = 0;
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 100, lights);
+    EXPECT_EQ(255, mask[5 * 20 + 5]);
+    EXPECT_EQ(128, mask[5 * 20 + 14]);
+
+    // Only the given area is composed, and lights are clipped by it
+    lights[0].InUse = true;
+    std::fill(mask.begin(), mask.end(), 0xAB);
+    const Rect rc = RectWH(4, 4, 3, 3);
+    compose_darkness_mask(mask.data(), mask_size, rc, 100, lights);
+    for (int y = 0; y < mask_size.Height; ++y)
+    {
+        for (int x = 0; x < mask_size.Width; ++x)
+        {
+            if (rc.IsInside(x, y))
+                ASSERT_EQ(0, mask[y * 20 + x]) << "x: " << x << ", y: " << y;
+            else
+                ASSERT_EQ(0xAB, mask[y * 20 + x]) << "x: " << x << ", y: " << y;
+        }
+    }
+
+    // Lights which cross the mask's border are clipped
+    lights.clear();
+    lights.push_back(MakeCircleLight(0, 0, 3, 0, 100));
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 100, lights);
+    EXPECT_EQ(0, mask[0]);
+    EXPECT_EQ(255, mask[5 * 20 + 5]);
+
+    // No darkness leaves the mask clear
+    compose_darkness_mask(mask.data(), mask_size, RectWH(mask_size), 0, lights);
+    for (auto m : mask)
+        ASSERT_EQ(0, m);
+}
@@ -0,0 +1,109 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ac/particleset.h"
+#include "util/memory_compat.h"
+#include "util/memorystream.h"
+
+using namespace AGS::Common;
+
+static void AddParticle(ParticleSet &ps, float x, float y, float vx, float vy, int age, int life)
+{
+    const size_t i = ps.GetCount();
+    ps.Resize(i + 1);
+    ps.PosX[i] = x;
+    ps.PosY[i] = y;
+    ps.VelX[i] = vx;
+    ps.VelY[i] = vy;
+    ps.Age[i] = age;
+    ps.Life[i] = life;
+}
+
+TEST(ParticleSet, Update) {
+    ParticleSet ps;
+    AddParticle(ps, 10.f, 20.f, 1.f, -2.f, 0, 3);
+    AddParticle(ps, 0.f, 0.f, 0.5f, 0.f, 0, 1); // expires on the first update
+    AddParticle(ps, -5.f, 5.f, 0.f, 1.f, 4, 10);
+
+    ps.Update(0.5f);
+    ASSERT_EQ(2u, ps.GetCount());
+    // Velocity gets the gravity before the particle moves
+    EXPECT_FLOAT_EQ(11.f, ps.PosX[0]);
+    EXPECT_FLOAT_EQ(18.5f, ps.PosY[0]);
+    EXPECT_FLOAT_EQ(1.f, ps.VelX[0]);
+    EXPECT_FLOAT_EQ(-1.5f, ps.VelY[0]);
+    EXPECT_EQ(1, ps.Age[0]);
+    EXPECT_EQ(3, ps.Life[0]);
+    // Remaining particles keep their order
+    EXPECT_FLOAT_EQ(-5.f, ps.PosX[1]);
+    EXPECT_FLOAT_EQ(6.5f, ps.PosY[1]);
+    EXPECT_FLOAT_EQ(1.5f, ps.VelY[1]);
+    EXPECT_EQ(5, ps.Age[1]);
+
+    ps.Update(0.5f);
+    ps.Update(0.5f);
+    ASSERT_EQ(1u, ps.GetCount());
+    EXPECT_FLOAT_EQ(-5.f, ps.PosX[0]);
+    EXPECT_EQ(7, ps.Age[0]);
+    // All the arrays are kept in sync
+    EXPECT_EQ(1u, ps.PosY.size());
+    EXPECT_EQ(1u, ps.VelX.size());
+    EXPECT_EQ(1u, ps.VelY.size());
+    EXPECT_EQ(1u, ps.Age.size());
+    EXPECT_EQ(1u, ps.Life.size());
+
+    ps.Clear();
+    ps.Update(0.5f);
+    ASSERT_EQ(0u, ps.GetCount());
+}
+
+TEST(ParticleSet, SerializeRoundTrip) {
+    ParticleSet ps;
+    for (int i = 0; i < 5; ++i)
+        AddParticle(ps, i * 1.5f, i * -2.25f, i * 0.125f, -i * 0.5f, i, 10 + i);
+    std::vector<uint8_t> buf;
+    {
+        Stream out(std::make_unique<VectorStream>(buf, kStream_Write));
+        ps.WriteToFile(&out);
+    }
+    ASSERT_EQ(ps.CalcSerializeSize(), buf.size());
+
+    ParticleSet ps2;
+    {
+        Stream in(std::make_unique<VectorStream>(buf));
+        ps2.ReadFromFile(&in, 5, buf.size());
+    }
+    ASSERT_EQ(5u, ps2.GetCount());
+    EXPECT_EQ(ps.PosX, ps2.PosX);
+    EXPECT_EQ(ps.PosY, ps2.PosY);
+    EXPECT_EQ(ps.VelX, ps2.VelX);
+    EXPECT_EQ(ps.VelY, ps2.VelY);
+    EXPECT_EQ(ps.Age, ps2.Age);
+    EXPECT_EQ(ps.Life, ps2.Life);
+
+    // Particles over the limit, or not fitting the data, are dropped
+    ParticleSet ps3;
+    {
+        Stream in(std::make_unique<VectorStream>(buf));
+        ps3.ReadFromFile(&in, 4, buf.size());
+    }
+    ASSERT_EQ(0u, ps3.GetCount());
+    {
+        Stream in(std::make_unique<VectorStream>(buf));
+        ps3.ReadFromFile(&in, 5, buf.size() - 1);
+    }
+    ASSERT_EQ(0u, ps3.GetCount());
+}
@@ -2103,6 +2103,7 @@ void AGS_EngineShutdown() {
   // we should delete them here
 	delete [] Reflection.Characters;
 	delete [] Reflection.Objects;
+	StopRaycastWorkers ();
 	//QuitCleanup ();
 }
 
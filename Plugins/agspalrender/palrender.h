@@ -50,10 +50,15 @@ public:
 //unsigned char MixColorAlpha (unsigned char fg,unsigned char bg,unsigned char alpha);
 //unsigned char MixColorAdditive (unsigned char fg,unsigned char bg,unsigned char alpha);
 __forceinline static unsigned char MixColorAlpha (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal=0)
+{
+	return MixColorAlpha (fg,bg,alpha,use_objpal,engine->GetPalette ());
+}
+
+// Variant with the palette passed by the caller, for use outside of the game thread
+__forceinline static unsigned char MixColorAlpha (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal,const AGSColor *palette)
 {
 	unsigned char rfg = cycle_remap [fg]; //Automatic remapping of palette slots.
 	//unsigned char rbg = cycle_remap [bg]; //Saves on typing elsewhere.
-	AGSColor *palette = engine->GetPalette ();
 	int i=0;
 	//int out_r = (palette[fg].r>>1) * alpha + (palette[bg].r>>1) * (255 - alpha);
 	//int out_g = palette[fg].g * alpha + palette[bg].g * (255 - alpha);
@@ -106,13 +111,18 @@ __forceinline static unsigned char MixColorLightLevel (unsigned char fg,unsigned
 }
 
 __forceinline static unsigned char MixColorAdditive (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal=0)
+{
+	return MixColorAdditive (fg,bg,alpha,use_objpal,engine->GetPalette ());
+}
+
+// Variant with the palette passed by the caller, for use outside of the game thread
+__forceinline static unsigned char MixColorAdditive (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal,const AGSColor *palette)
 {
 	unsigned char rfg = cycle_remap [fg]; //Automatic remapping of palette slots.
 	unsigned char rbg = cycle_remap [bg]; //Saves on typing elsewhere.
 	//BITMAP *clutspr = engine->GetSpriteGraphic (clutslot);
 	//if (!clutspr) engine->AbortGame ("MixColorAlpha: Can't load CLUT sprite into memory.");
 	//unsigned char **clutarray = engine->GetRawBitmapSurface (clutspr);
-	AGSColor *palette = engine->GetPalette ();
 	int i=0;
 	int add_r,add_b,add_g = 0;
 	//char ralpha = std::max(0,std::min(63,alpha>>2));
@@ -151,10 +161,15 @@ __forceinline static unsigned char MixColorAdditive (unsigned char fg,unsigned c
 }
 
 __forceinline static unsigned char MixColorMultiply (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal=0)
+{
+	return MixColorMultiply (fg,bg,alpha,use_objpal,engine->GetPalette ());
+}
+
+// Variant with the palette passed by the caller, for use outside of the game thread
+__forceinline static unsigned char MixColorMultiply (unsigned char fg,unsigned char bg,unsigned char alpha,int use_objpal,const AGSColor *palette)
 {
 	unsigned char rfg = cycle_remap [fg]; //Automatic remapping of palette slots.
 	unsigned char rbg = cycle_remap [bg]; //Saves on typing elsewhere.
-	AGSColor *palette = engine->GetPalette ();
 	int i=0;
 	int mul_r,mul_b,mul_g = 0;
 	int out_r,out_g,out_b = 0;
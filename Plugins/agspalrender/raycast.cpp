@@ -28,8 +28,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <functional>
 #include <stdio.h>
 #include <math.h>
+#if !defined(AGS_DISABLE_THREADS)
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
 
 #if defined(BUILTIN_PLUGINS)
 namespace agspalrender {
@@ -783,47 +790,166 @@ void Init_Raycaster ()
 	}
 }
 
-bool rendering;
-void Raycast_Render (int slot)
+// Screen columns are rendered in bands, one band per thread. The columns do
+// not share any pixels or z-buffer slices, but a few results are gathered
+// for the whole screen; each band collects them separately, and these are
+// merged in the column order after all the bands are done.
+struct ColumnBand
 {
-	ambientweight = 0;
-	raycastOn = true;
-	double playerrad = atan2 (dirY,dirX)+(2.0 * PI);
-	rendering=true;
-	int32 w=sWidth,h=sHeight;
-	BITMAP *screen = engine->GetSpriteGraphic (slot);
-	if (!screen) engine->AbortGame ("Raycast_Render: No valid sprite to draw on.");
-	engine->GetBitmapDimensions (screen,&w,&h,nullptr);
-	BITMAP *sbBm = engine->GetSpriteGraphic (skybox);
-	if (!sbBm) engine->AbortGame ("Raycast_Render: No valid skybox sprite.");
-	if (skybox > 0)
+	int startX, endX;
+	int ambientweight;
+	int transwallcount; // as left by the last column of the band
+	int transwallblendmode[mapWidth+1];
+	bool transwallblendset[mapWidth+1];
+	unsigned char seenMap[mapWidth][mapHeight];
+};
+
+std::vector<ColumnBand> columnBands;
+
+// Do not split the screen into bands narrower than this
+#define MinColumnsPerBand 32
+
+// Pool of the threads which render column bands along with the game thread.
+// The threads are created on the first use, and wait for the next frame
+// until stopped.
+class BandWorkers
+{
+public:
+	~BandWorkers () { Stop (); }
+
+	// Tells how many bands may be rendered simultaneously for the screen width
+	int GetBandCount (int w)
 	{
-		int bgdeg = (int)((playerrad / PI) * 180.0)+180;
-		int xoffset = (int)(playerrad*320.0);
-		BITMAP *virtsc = engine->GetVirtualScreen ();
-		engine->SetVirtualScreen (screen);
-		xoffset = abs(xoffset % w);
-		if (xoffset > 0)
+#if !defined(AGS_DISABLE_THREADS)
+		if (!started) Start ();
+		return std::max(1, std::min((int)threads.size() + 1, w / MinColumnsPerBand));
+#else
+		return 1;
+#endif
+	}
+
+	// Runs the job for each band; the first band is run on the calling thread
+	void Run (int band_count, const std::function<void(int)> &job)
+	{
+#if !defined(AGS_DISABLE_THREADS)
+		if (band_count > 1 && !threads.empty())
 		{
-			engine->BlitBitmap (xoffset-320,1,sbBm,false);
+			{
+				std::lock_guard<std::mutex> lk(mutex);
+				curJob = &job;
+				bandCount = band_count;
+				pending = (int)threads.size();
+				generation++;
+			}
+			startCond.notify_all();
+			job(0);
+			std::unique_lock<std::mutex> lk(mutex);
+			doneCond.wait(lk, [this]() { return pending == 0; });
+			curJob = nullptr;
+			return;
 		}
-		engine->BlitBitmap (xoffset,1,sbBm,false);
-		engine->SetVirtualScreen (virtsc);
+#endif
+		for (int band = 0; band < band_count; band++)
+			job(band);
 	}
-	int transwallcount = 0;
-	unsigned char** buffer = engine->GetRawBitmapSurface (screen);
-	for (int x = 0;x<w;x++)
+
+	void Stop ()
 	{
-		transslicedrawn [x] = false;
-		for (int y=0;y<h;y++)
+#if !defined(AGS_DISABLE_THREADS)
 		{
-			ZBuffer[x][y] = 0;
+			std::lock_guard<std::mutex> lk(mutex);
+			stopping = true;
 		}
+		startCond.notify_all();
+		for (auto &t : threads)
+			t.join();
+		threads.clear();
+		stopping = false;
+		generation = 0;
+		started = false;
+#endif
 	}
-	int multiplier = mapWidth;
-	memset (interactionmap,0,sizeof(short)*(sHeight*sWidth));
-  //start the main loop
-    for(int x = 0; x < w; x++)
+
+private:
+#if !defined(AGS_DISABLE_THREADS)
+	void Start ()
+	{
+		started = true;
+		const int max_bands = sWidth / MinColumnsPerBand;
+		const int thread_count = std::min(max_bands, (int)std::max(1u, std::thread::hardware_concurrency())) - 1;
+		for (int i = 0; i < thread_count; i++)
+		{
+			try
+			{
+				threads.emplace_back(&BandWorkers::Work, this, i + 1);
+			}
+			catch (const std::system_error &)
+			{
+				break; // render with as many threads as we have
+			}
+		}
+	}
+
+	void Work (int band)
+	{
+		unsigned last_generation = 0;
+		for (;;)
+		{
+			const std::function<void(int)> *job;
+			{
+				std::unique_lock<std::mutex> lk(mutex);
+				startCond.wait(lk, [this, last_generation]() { return stopping || generation != last_generation; });
+				if (stopping) return;
+				last_generation = generation;
+				job = band < bandCount ? curJob : nullptr;
+			}
+			if (job) (*job)(band);
+			{
+				std::lock_guard<std::mutex> lk(mutex);
+				pending--;
+			}
+			doneCond.notify_one();
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable startCond;
+	std::condition_variable doneCond;
+	const std::function<void(int)> *curJob = nullptr;
+	unsigned generation = 0;
+	int bandCount = 0;
+	int pending = 0;
+	bool stopping = false;
+	bool started = false;
+#endif
+};
+
+BandWorkers bandWorkers;
+
+// Sprite projection on screen, prepared for drawing the sprite's stripes
+struct SpriteCast
+{
+	BITMAP *texbm;
+	unsigned char **tex;
+	int sprw, sprh;
+	int flipped;
+	int spriteScreenX;
+	int spriteWidth, spriteHeight;
+	int vMoveScreen;
+	int drawStartX, drawEndX;
+	int drawStartY, drawEndY;
+	int light;
+};
+
+SpriteCast spriteCast[numSprites];
+
+// Casts walls, floor and ceiling for the columns of one band;
+// the palette is read by the caller, as the engine must not be called from the worker threads
+static void RenderColumns (ColumnBand &band, unsigned char **buffer, int w, int h, const AGSColor *palette)
+{
+	int transwallcount = 0;
+    for(int x = band.startX; x < band.endX; x++)
     {
 	  transwallcount=0;
       //calculate ray position and direction 
@@ -946,7 +1072,7 @@ void Raycast_Render (int slot)
 		if (rayDirY < 0 && side == 1) texside = 3;
 
 		//set this tile as seen.
-		seenMap[mapX][mapY] = 1;
+		band.seenMap[mapX][mapY] = 1;
         //Check if ray has hit a wall       
 		if (wallData[worldMap[mapX][mapY]].texture[texside])
 		{
@@ -1051,12 +1177,12 @@ void Raycast_Render (int slot)
      				int color = texture[texNum][texWidth * texY + texX];
      				if (color > 0)
 						{
-							if (ambientpixels && ambientcolor) color = Mix::MixColorMultiply (ambientcolor,color,ambientcolorAmount,1);
+							if (ambientpixels && ambientcolor) color = Mix::MixColorMultiply (ambientcolor,color,ambientcolorAmount,1,palette);
 							if (!wallData[worldMap[mapX][mapY]].ignorelighting[texside] && wall_light < 255) color = Mix::MixColorLightLevel (color,wall_light);
 							if (wallData[worldMap[mapX][mapY]].alpha[texside] == 255 && wallData[worldMap[mapX][mapY]].mask[texside] == 0)
 							{
 							buffer[y][x] = color;
-							if (ambientpixels) ambientweight++;
+							if (ambientpixels) band.ambientweight++;
 							//SET THE ZBUFFER FOR THE SPRITE CASTING
 							ZBuffer[x][y] = perpWallDist; //perpendicular distance is used
 							interactionmap [x*sWidth+y] = wallData[worldMap[mapX][mapY]].hotspotinteract;
@@ -1071,10 +1197,11 @@ void Raycast_Render (int slot)
 									//memset (transzbuffer[x],0,sizeof(double)*(sHeight*mapWidth));
 									transslicedrawn[x] = true;
 								}
-								transwallblendmode[transwallcount] = wallData[worldMap[mapX][mapY]].blendtype[texside];
+								band.transwallblendmode[transwallcount] = wallData[worldMap[mapX][mapY]].blendtype[texside];
+								band.transwallblendset[transwallcount] = true;
 								int transwalloffset = transwallcount*h;
 								transcolorbuffer[x][transwalloffset+y] = color;
-								if (ambientpixels) ambientweight++;
+								if (ambientpixels) band.ambientweight++;
 								if (wallData[worldMap[mapX][mapY]].mask[texside] == 0) transalphabuffer[x][transwalloffset+y] = wallData[worldMap[mapX][mapY]].alpha[texside];
 								else 
 								{
@@ -1227,7 +1354,7 @@ void Raycast_Render (int slot)
 			if (ceilingcolor == 0)
 			{
 				lighting = std::max (lighting,ambientlight);
-				ambientweight ++;
+				band.ambientweight++;
 			}
 			if (lighting < 255)
 			{
@@ -1284,7 +1411,7 @@ void Raycast_Render (int slot)
 			if (ceilingcolor == 0) 
 			{
 				lighting = std::max (lighting,ambientlight);
-				ambientweight++;
+				band.ambientweight++;
 			}
 			if (lighting < 255)
 			{
@@ -1359,8 +1486,8 @@ void Raycast_Render (int slot)
 				int color = transcolorbuffer[x][transwalloffset+y];
 				if (color !=0) 
 				{
-					  if (transwallblendmode[transwalldrawn] == 0) buffer[y][x] = Mix::MixColorAlpha (color,buffer[y][x],transalphabuffer[x][transwalloffset+y]); //paint pixel if it isn't black, black is the invisible color
-					  else if (transwallblendmode[transwalldrawn] == 1) buffer[y][x] = Mix::MixColorAdditive (color,buffer[y][x],transalphabuffer[x][transwalloffset+y]);
+					  if (band.transwallblendmode[transwalldrawn] == 0) buffer[y][x] = Mix::MixColorAlpha (color,buffer[y][x],transalphabuffer[x][transwalloffset+y],0,palette); //paint pixel if it isn't black, black is the invisible color
+					  else if (band.transwallblendmode[transwalldrawn] == 1) buffer[y][x] = Mix::MixColorAdditive (color,buffer[y][x],transalphabuffer[x][transwalloffset+y],0,palette);
 					  //if (ZBuffer[x][y] > transzbuffer[transwalldrawn*h+y]) ZBuffer[x][y] = transzbuffer[transwalldrawn*h+y]; //put the sprite on the zbuffer so we can draw around it.
 			    }
 		    }
@@ -1368,6 +1495,138 @@ void Raycast_Render (int slot)
 	  }
 		//End of wall loop.
     }
+	band.transwallcount = transwallcount;
+}
+
+// Draws the stripes of all the prepared sprites within the columns of one band,
+// from far to close
+static void RenderSpriteStripes (const ColumnBand &band, unsigned char **buffer, int w, int h, int transwallcount, const AGSColor *palette)
+{
+    for(int i = 0; i < numSprites; i++)
+    {
+      const SpriteCast &sc = spriteCast[i];
+      const Sprite &spr = sprite[spriteOrder[i]];
+      for(int stripe = std::max(sc.drawStartX, band.startX); stripe < std::min(sc.drawEndX, band.endX); stripe++)
+      {
+		int transwalldraw=0;
+		int texX = int(256 * (stripe - (-sc.spriteWidth / 2 + sc.spriteScreenX)) *  sc.sprw / sc.spriteWidth) / 256;
+		if (texX >= sc.sprw || texX < 0) continue;
+		if (sc.flipped) texX = sc.sprw-texX;
+        //the conditions in the if are:
+        //1) it's in front of camera plane so you don't see things behind you
+        //2) it's on the screen (left)
+        //3) it's on the screen (right)
+        //4) ZBuffer, with perpendicular distance
+        if(spriteTransformY[i] > 0 && stripe > 0 && stripe < w) 
+        for(int y = sc.drawStartY; y < sc.drawEndY; y++) //for every pixel of the current stripe
+        {
+		  if (spriteTransformY[i] < ZBuffer[stripe][y])
+		  {
+			  if (transslicedrawn[stripe]) while ((transzbuffer[stripe][transwalldraw*h+y] > spriteTransformY[i] && transzbuffer[stripe][transwalldraw*h+y] != 0) && (transwalldraw < transwallcount)) transwalldraw++;
+			int d = (y-sc.vMoveScreen) * 256 - h * 128 + sc.spriteHeight * 128; //256 and 128 factors to avoid floats
+			int texY = ((d * sc.sprh) / sc.spriteHeight) / 256;
+			if (texY >= sc.sprh || texY < 0) continue;
+			unsigned char color = sc.tex[texY][texX]; //get current color from the texture
+			if (color !=0) 
+			{
+				  if (spr.alpha < 255)
+				  {
+					  if (spr.blendmode == 0) color = Mix::MixColorAlpha (color,buffer[y][stripe],spr.alpha,0,palette);
+					  if (spr.blendmode == 1) color = Mix::MixColorAdditive (color,buffer[y][stripe],spr.alpha,0,palette);
+				  }
+				  color = Mix::MixColorLightLevel (color,sc.light);
+				  if (transzbuffer[stripe][transwalldraw*h+y] < spriteTransformY[i] && transzbuffer[stripe][transwalldraw*h+y] != 0 && transslicedrawn[stripe] && transcolorbuffer[stripe][transwalldraw*h+y] > 0 && transalphabuffer[stripe][transwalldraw*h+y]>0) 
+				  {
+					  if (transwallblendmode[transwalldraw] == 0) color = Mix::MixColorAlpha (color,transcolorbuffer[stripe][transwalldraw*h+y],transalphabuffer[stripe][transwalldraw*h+y],0,palette);
+					  else if (transwallblendmode[transwalldraw] == 1) color = Mix::MixColorAdditive (color,transcolorbuffer[stripe][transwalldraw*h+y],transalphabuffer[stripe][transwalldraw*h+y],0,palette);
+					  buffer[y][stripe] = color;
+					  ZBuffer[stripe][y] = transzbuffer[stripe][transwalldraw*h+y];
+				  }
+				  else
+				  {
+				  buffer[y][stripe] = color; //paint pixel if it isn't black, black is the invisible color
+				  ZBuffer[stripe][y] = spriteTransformY[i]; //put the sprite on the zbuffer so we can draw around it.
+				  }
+				  interactionmap [stripe*sWidth+y] = spr.objectinteract<<8;
+			}
+		  }
+        }
+      }
+    }
+}
+bool rendering;
+void Raycast_Render (int slot)
+{
+	ambientweight = 0;
+	raycastOn = true;
+	double playerrad = atan2 (dirY,dirX)+(2.0 * PI);
+	rendering=true;
+	int32 w=sWidth,h=sHeight;
+	BITMAP *screen = engine->GetSpriteGraphic (slot);
+	if (!screen) engine->AbortGame ("Raycast_Render: No valid sprite to draw on.");
+	engine->GetBitmapDimensions (screen,&w,&h,nullptr);
+	BITMAP *sbBm = engine->GetSpriteGraphic (skybox);
+	if (!sbBm) engine->AbortGame ("Raycast_Render: No valid skybox sprite.");
+	if (skybox > 0)
+	{
+		int bgdeg = (int)((playerrad / PI) * 180.0)+180;
+		int xoffset = (int)(playerrad*320.0);
+		BITMAP *virtsc = engine->GetVirtualScreen ();
+		engine->SetVirtualScreen (screen);
+		xoffset = abs(xoffset % w);
+		if (xoffset > 0)
+		{
+			engine->BlitBitmap (xoffset-320,1,sbBm,false);
+		}
+		engine->BlitBitmap (xoffset,1,sbBm,false);
+		engine->SetVirtualScreen (virtsc);
+	}
+	int transwallcount = 0;
+	unsigned char** buffer = engine->GetRawBitmapSurface (screen);
+	for (int x = 0;x<w;x++)
+	{
+		transslicedrawn [x] = false;
+		for (int y=0;y<h;y++)
+		{
+			ZBuffer[x][y] = 0;
+		}
+	}
+	int multiplier = mapWidth;
+	memset (interactionmap,0,sizeof(short)*(sHeight*sWidth));
+	// The screen is split into bands of columns, which are rendered in parallel;
+	// then the results gathered by each band are merged in the column order,
+	// so that they are the same as if the columns were rendered in sequence.
+	const int band_count = bandWorkers.GetBandCount (w);
+	// The palette is read once here, and passed to the bands
+	const AGSColor *palette = engine->GetPalette ();
+	columnBands.resize (band_count);
+	for (int band = 0; band < band_count; band++)
+	{
+		ColumnBand &cb = columnBands[band];
+		cb.startX = w * band / band_count;
+		cb.endX = w * (band + 1) / band_count;
+		cb.ambientweight = 0;
+		cb.transwallcount = 0;
+		memset (cb.transwallblendset,0,sizeof(cb.transwallblendset));
+		memset (cb.seenMap,0,sizeof(cb.seenMap));
+	}
+	bandWorkers.Run (band_count, [buffer,w,h,palette](int band) { RenderColumns (columnBands[band], buffer, w, h, palette); });
+	for (const auto &cb : columnBands)
+	{
+		ambientweight += cb.ambientweight;
+		for (int i = 0; i < mapWidth; i++)
+		{
+			if (cb.transwallblendset[i]) transwallblendmode[i] = cb.transwallblendmode[i];
+		}
+		for (int mx = 0; mx < mapWidth; mx++)
+		{
+			for (int my = 0; my < mapHeight; my++)
+			{
+				if (cb.seenMap[mx][my]) seenMap[mx][my] = 1;
+			}
+		}
+	}
+	transwallcount = columnBands[band_count-1].transwallcount;
     
 	
     //SPRITE CASTING
@@ -1389,8 +1648,7 @@ void Raycast_Render (int slot)
 		spriteTransformY[i] = invDet * (-planeY * spriteX + planeX * spriteY);
 	 }
 
-	int transwalldraw=0;
-    //after sorting the sprites, do the projection and draw them
+    //do the projection of the sorted sprites
     for(int i = 0; i < numSprites; i++)
     {
 		int flipped = 0;
@@ -1471,70 +1729,44 @@ void Raycast_Render (int slot)
 		  spr_light = std::max(spr_light,ambientlight);
 	  }
 	  else if (texture[ceilingMap [(int)sprite[spriteOrder[i]].x][(int)sprite[spriteOrder[i]].y]-1][texWidth * floorTexY + floorTexX] == 0) spr_light = std::max(spr_light,ambientlight);
-      //loop through every vertical stripe of the sprite on screen
-
-
-      for(int stripe = drawStartX; stripe < drawEndX; stripe++)
-      {
-		transwalldraw=0;
-        //int texX = int(256 * (stripe - (-spriteWidth / 2 + spriteScreenX)) * texWidth / spriteWidth) / 256;
-		int texX = int(256 * (stripe - (-spriteWidth / 2 + spriteScreenX)) *  sprw / spriteWidth) / 256;
-		if (texX >= sprw || texX < 0) continue;
-		if (flipped) texX = sprw-texX;
-        //the conditions in the if are:
-        //1) it's in front of camera plane so you don't see things behind you
-        //2) it's on the screen (left)
-        //3) it's on the screen (right)
-        //4) ZBuffer, with perpendicular distance
-        if(spriteTransformY[i] > 0 && stripe > 0 && stripe < w) 
-        for(int y = drawStartY; y < drawEndY; y++) //for every pixel of the current stripe
-        {
-		  if (spriteTransformY[i] < ZBuffer[stripe][y])
-		  {
-			  if (transslicedrawn[stripe]) while ((transzbuffer[stripe][transwalldraw*h+y] > spriteTransformY[i] && transzbuffer[stripe][transwalldraw*h+y] != 0) && (transwalldraw < transwallcount)) transwalldraw++;
-			int d = (y-vMoveScreen) * 256 - h * 128 + spriteHeight * 128; //256 and 128 factors to avoid floats
-			//int texY = ((d * texHeight) / spriteHeight) / 256;
-			int texY = ((d * sprh) / spriteHeight) / 256;
-			if (texY >= sprh || texY < 0) continue;
-			//unsigned char color = texture[sprite[spriteOrder[i]].texture][texWidth * texY + texX]; //get current color from the texture
-			unsigned char color = spritetex[texY][texX]; //get current color from the texture
-			if (color !=0) 
-			{
-				  if (sprite[spriteOrder[i]].alpha < 255)
-				  {
-					  if (sprite[spriteOrder[i]].blendmode == 0) color = Mix::MixColorAlpha (color,buffer[y][stripe],sprite[spriteOrder[i]].alpha);
-					  if (sprite[spriteOrder[i]].blendmode == 1) color = Mix::MixColorAdditive (color,buffer[y][stripe],sprite[spriteOrder[i]].alpha);
-				  }
-				  color = Mix::MixColorLightLevel (color,spr_light);
-				  if (transzbuffer[stripe][transwalldraw*h+y] < spriteTransformY[i] && transzbuffer[stripe][transwalldraw*h+y] != 0 && transslicedrawn[stripe] && transcolorbuffer[stripe][transwalldraw*h+y] > 0 && transalphabuffer[stripe][transwalldraw*h+y]>0) 
-				  {
-					  if (transwallblendmode[transwalldraw] == 0) color = Mix::MixColorAlpha (color,transcolorbuffer[stripe][transwalldraw*h+y],transalphabuffer[stripe][transwalldraw*h+y]);
-					  else if (transwallblendmode[transwalldraw] == 1) color = Mix::MixColorAdditive (color,transcolorbuffer[stripe][transwalldraw*h+y],transalphabuffer[stripe][transwalldraw*h+y]);
-					  buffer[y][stripe] = color;
-					  ZBuffer[stripe][y] = transzbuffer[stripe][transwalldraw*h+y];
-				  }
-				  else
-				  {
-				  buffer[y][stripe] = color; //paint pixel if it isn't black, black is the invisible color
-				  ZBuffer[stripe][y] = spriteTransformY[i]; //put the sprite on the zbuffer so we can draw around it.
-				  }
-				  interactionmap [stripe*sWidth+y] = sprite[spriteOrder[i]].objectinteract<<8;
-			}
-		  }
-        }
-      }
-	  engine->ReleaseBitmapSurface (spritetexbm);
+      SpriteCast &sc = spriteCast[i];
+      sc.texbm = spritetexbm;
+      sc.tex = spritetex;
+      sc.sprw = sprw;
+      sc.sprh = sprh;
+      sc.flipped = flipped;
+      sc.spriteScreenX = spriteScreenX;
+      sc.spriteWidth = spriteWidth;
+      sc.spriteHeight = spriteHeight;
+      sc.vMoveScreen = vMoveScreen;
+      sc.drawStartX = drawStartX;
+      sc.drawEndX = drawEndX;
+      sc.drawStartY = drawStartY;
+      sc.drawEndY = drawEndY;
+      sc.light = spr_light;
     }
+	//then draw the sprites, band by band
+	bandWorkers.Run (band_count, [buffer,w,h,transwallcount,palette](int band) { RenderSpriteStripes (columnBands[band], buffer, w, h, transwallcount, palette); });
+	for(int i = 0; i < numSprites; i++)
+	{
+		engine->ReleaseBitmapSurface (spriteCast[i].texbm);
+	}
 	engine->ReleaseBitmapSurface (screen);
 	engine->NotifySpriteUpdated (slot);
 	rendering=false;
 
 }
 
+void StopRaycastWorkers ()
+{
+	bandWorkers.Stop ();
+}
+
 void QuitCleanup ()
 {
 		if (!rendering)
 		{
+			bandWorkers.Stop ();
 			for(int i = 0; i < sWidth; ++i) 
 			{
 				if (transcolorbuffer[i])delete [] transcolorbuffer[i];
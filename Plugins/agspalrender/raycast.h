@@ -94,6 +94,7 @@ void RotateLeft ();
 void RotateRight ();
 void Init_Raycaster ();
 void QuitCleanup ();
+void StopRaycastWorkers ();
 void LoadMap (int worldmapSlot,int lightmapSlot,int ceilingmapSlot,int floormapSlot);
 void Ray_InitSprite (int id, SCRIPT_FLOAT(x), SCRIPT_FLOAT(y), int slot, unsigned char alpha, int blendmode, SCRIPT_FLOAT(scale_x), SCRIPT_FLOAT(scale_y), SCRIPT_FLOAT(vMove));
 void Ray_SetPlayerPosition (SCRIPT_FLOAT(x),SCRIPT_FLOAT(y));
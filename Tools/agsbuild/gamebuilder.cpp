@@ -0,0 +1,899 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "gamebuilder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "ac/game_version.h"
+#include "ac/gamestructdefines.h"
+#include "ac/inventoryiteminfo.h"
+#include "ac/mousecursor.h"
+#include "ac/wordsdictionary.h"
+#include "core/def_version.h"
+#include "data/agfreader.h"
+#include "data/dialogscriptconv.h"
+#include "data/mfl_utils.h"
+#include "data/room_utils.h"
+#include "data/scriptgen.h"
+#include "game/room_file.h"
+#include "preproc/preprocessor.h"
+#include "script/cc_common.h"
+#include "script/cc_internal.h"
+#include "script/cc_script.h"
+#include "script/cs_compiler.h"
+#include "util/data_ext.h"
+#include "util/directory.h"
+#include "util/file.h"
+#include "util/path.h"
+#include "util/stream.h"
+#include "util/string_compat.h"
+#include "util/string_utils.h"
+#include "util/textstreamreader.h"
+
+using namespace AGS::Common;
+
+namespace AGS
+{
+namespace DataUtil
+{
+
+// Script API versions, in the ascending order
+static const char *ScriptAPIVersions[] = { "v321", "v330", "v334", "v335", "v340", "v341",
+    "v350", "v3507", "v351", "v360", "v36026", "v361", "v362" };
+static const size_t NumScriptAPIVersions = sizeof(ScriptAPIVersions) / sizeof(ScriptAPIVersions[0]);
+
+static const char *BuiltinHeaderName = "_BuiltInScriptHeader.ash";
+static const char *AutoHeaderName = "_AutoGenerated.ash";
+static const char *GlobalVarsHeaderName = "_GlobalVariables.ash";
+static const char *GlobalVarsScriptName = "_GlobalVariables.asc";
+static const char *GlobalScriptName = "GlobalScript.asc";
+static const char *DialogScriptsName = "__DialogScripts.asc";
+static const char *RoomHeaderName = "_RoomAutoGenerated.ash";
+static const char *SpriteFileName = "acsprset.spr";
+static const char *SpriteIndexFileName = "sprindex.dat";
+static const char *MainGameFileName = "game28.dta";
+static const char *MainGameSignature = "Adventure Creator Game File v2";
+static const char *CacheFileName = "buildcache.txt";
+static const char *LibraryUnitName = "library";
+
+
+class RoomScNamesReader : public DataExtReader
+{
+public:
+    RoomScNamesReader(RoomScNames &data, RoomFileVersion data_ver, std::unique_ptr<Stream> &&in)
+        : DataExtReader(std::move(in),
+            kDataExt_NumID8 | ((data_ver < kRoomVersion_350) ? kDataExt_File32 : kDataExt_File64))
+        , _data(data)
+        , _dataVer(data_ver)
+    {}
+
+private:
+    HError ReadBlock(Stream *in, int block_id, const String &ext_id,
+        soff_t block_len, bool &/*read_next*/) override
+    {
+        return ReadRoomScNames(_data, in, (RoomFileBlock)block_id, ext_id, block_len, _dataVer);
+    }
+
+    RoomScNames &_data;
+    RoomFileVersion _dataVer;
+};
+
+class RoomBlockParser : public DataExtParser
+{
+public:
+    RoomBlockParser(std::unique_ptr<Stream> &&in, RoomFileVersion data_ver)
+        : DataExtParser(std::move(in), kDataExt_NumID8 | ((data_ver < kRoomVersion_350) ? kDataExt_File32 : kDataExt_File64))
+        {}
+    String GetOldBlockName(int block_id) const override
+    { return GetRoomBlockName((RoomFileBlock)block_id); }
+};
+
+
+static HError ReadTextFile(const String &filename, String &text)
+{
+    auto in = File::OpenFileRead(filename);
+    if (!in)
+        return new Error(String::FromFormat("Failed to open file for reading: %s", filename.GetCStr()));
+    TextStreamReader reader(std::move(in));
+    text = reader.ReadAll();
+    return HError::None();
+}
+
+static HError AppendFile(const String &filename, Stream *out)
+{
+    auto in = File::OpenFileRead(filename);
+    if (!in)
+        return new Error(String::FromFormat("Failed to open file for reading: %s", filename.GetCStr()));
+    CopyStream(in.get(), out, in->GetLength());
+    return HError::None();
+}
+
+static HError SkipScript(Stream *in)
+{
+    std::unique_ptr<ccScript> script(ccScript::CreateFromStream(in));
+    if (!script)
+        return new Error(String::FromFormat("Failed to read the game's compiled script: %s",
+            cc_get_error().ErrorString.GetCStr()));
+    return HError::None();
+}
+
+// Skips the main game data up to its compiled scripts, following the
+// order in which the classic data section is read by the engine.
+// Only the data format of the 3.5.0 and later editors is supported.
+static HError SkipToGameScripts(Stream *in, soff_t &ext_offset_pos, uint32_t &ext_offset)
+{
+    const String sig = String::FromStreamCount(in, strlen(MainGameSignature));
+    if (sig.Compare(MainGameSignature) != 0)
+        return new Error("Not a main game data file, signature mismatch");
+    const GameDataVersion data_ver = static_cast<GameDataVersion>(in->ReadInt32());
+    if (data_ver < kGameVersion_350 || data_ver > kGameVersion_Current)
+        return new Error(String::FromFormat("Unsupported game data format version: %d, supported %d - %d",
+            data_ver, kGameVersion_350, kGameVersion_Current));
+    StrUtil::ReadString(in); // compiled with
+    const size_t caps_count = in->ReadInt32();
+    for (size_t i = 0; i < caps_count; ++i)
+        StrUtil::ReadString(in);
+
+    // GameSetupStructBase
+    in->Seek(LEGACY_MAX_GAME_NAME_LENGTH + sizeof(int16_t)); // name and padding
+    in->Seek(sizeof(int32_t) * MAX_GAME_OPTIONS);
+    in->Seek(GAME_PALETTE_SIZE + GAME_PALETTE_SIZE * 4); // paluses, defpal
+    in->Seek(sizeof(int32_t)); // numviews
+    const int num_characters = in->ReadInt32();
+    in->Seek(sizeof(int32_t) * 2); // playercharacter, totalscore
+    const int num_invitems = in->ReadInt16();
+    in->Seek(sizeof(int16_t) + sizeof(int32_t) * 2); // padding, numdialog, numdlgmessage
+    const int num_fonts = in->ReadInt32();
+    // color_depth, target_win, dialog_bullet, hotdot, hotdotouter, uniqueid, numgui
+    in->Seek(sizeof(int32_t) * 3 + sizeof(int16_t) * 2 + sizeof(int32_t) * 2);
+    const int num_cursors = in->ReadInt32();
+    if (in->ReadInt32() == kGameResolution_Custom)
+        in->Seek(sizeof(int32_t) * 2); // custom game size
+    in->Seek(sizeof(int32_t) * 2); // default_lipsync_frame, invhotdotsprite
+    in->Seek(sizeof(int32_t) * NUM_GAME_INTS_RESERVED);
+    ext_offset_pos = in->GetPosition();
+    ext_offset = static_cast<uint32_t>(in->ReadInt32());
+    in->Seek(sizeof(int32_t) * MAXGLOBALMES); // has messages
+    const bool has_dict = in->ReadInt32() != 0;
+    in->Seek(sizeof(int32_t) * 2); // dummy pointers
+    const bool has_scripts = in->ReadInt32() != 0;
+
+    // Savegame info, fonts and sprite flags
+    in->Seek(MAX_GUID_LENGTH + MAX_SG_EXT_LENGTH + LEGACY_MAX_SG_FOLDER_LEN);
+    in->Seek(sizeof(int32_t) * 5 * num_fonts); // flags, size, outline, y offset, line spacing
+    const soff_t sprite_count = in->ReadInt32();
+    in->Seek(sprite_count);
+    // Inventory items and cursors
+    InventoryItemInfo invinfo;
+    for (int i = 0; i < num_invitems; ++i)
+        invinfo.ReadFromFile(in);
+    MouseCursor mcurs;
+    for (int i = 0; i < num_cursors; ++i)
+        mcurs.ReadFromFile(in);
+    // Event handlers of characters and inventory items, latter starting with 1
+    const int handler_count = num_characters + std::max(0, num_invitems - 1);
+    for (int i = 0; i < handler_count; ++i)
+    {
+        const int evt_count = in->ReadInt32();
+        for (int evt = 0; evt < evt_count; ++evt)
+            String::FromStream(in);
+    }
+    if (has_dict)
+    {
+        WordsDictionary dict;
+        read_dictionary(&dict, in);
+    }
+
+    if (in->EOS() || in->GetError())
+        return new Error("Unexpected end of the main game data");
+    if (!has_scripts)
+        return new Error("Main game data has no compiled scripts");
+    return HError::None();
+}
+
+// Finds the script API version's index; "Highest" and unknown names
+// result in the latest version
+static size_t FindScriptAPIVersion(const String &name)
+{
+    for (size_t i = 0; i < NumScriptAPIVersions; ++i)
+    {
+        if (name.CompareNoCase(ScriptAPIVersions[i]) == 0)
+            return i;
+    }
+    return NumScriptAPIVersions - 1;
+}
+
+
+GameBuilder::GameBuilder(const BuildOptions &opts)
+    : _opts(opts)
+{
+    _opts.Jobs = std::max(1, _opts.Jobs);
+}
+
+GameBuilder::~GameBuilder() = default;
+
+HError GameBuilder::Build()
+{
+    _stats = BuildStats();
+    _unitsDone = 0;
+    _projectDir = Path::GetParent(_opts.GameFile);
+    _objDir = Path::ConcatPaths(_opts.OutputDir, "obj");
+    _stageDir = Path::ConcatPaths(_objDir, "Data");
+    _dataDir = Path::ConcatPaths(_opts.OutputDir, "Data");
+    if (!Directory::CreateDirectory(_opts.OutputDir) ||
+        !Directory::CreateAllDirectories(_opts.OutputDir, "obj/scripts") ||
+        !Directory::CreateAllDirectories(_opts.OutputDir, "obj/Data") ||
+        !Directory::CreateAllDirectories(_opts.OutputDir, "Data"))
+        return new Error(String::FromFormat("Failed to create build directories in: %s", _opts.OutputDir.GetCStr()));
+
+    HError err = ReadGame();
+    if (!err)
+        return err;
+    err = AddUnits();
+    if (!err)
+        return err;
+
+    const String cache_file = Path::ConcatPaths(_objDir, CacheFileName);
+    if (!_opts.Rebuild)
+    {
+        err = _cache.Load(cache_file);
+        if (!err)
+            return err;
+    }
+
+    err = BuildUnits();
+    // Save the cache even if some of the units failed, to let the successful ones be reused
+    HError save_err = _cache.Save(cache_file);
+    if (!err)
+        return err;
+    if (!save_err)
+        return save_err;
+
+    err = PackLibrary();
+    if (!err)
+        return err;
+    return _cache.Save(cache_file);
+}
+
+HError GameBuilder::ReadGame()
+{
+    AGF::AGFReader reader;
+    HError err = reader.Open(_opts.GameFile.GetCStr());
+    if (!err)
+        return err;
+    AGF::ReadGameRef(_game, reader);
+
+    //-----------------------------------------------------------------------//
+    // Prepare the script headers, in the order of the game compilation:
+    // internal headers come first, followed by the script modules' headers
+    //-----------------------------------------------------------------------//
+    _headers.clear();
+    _units.clear();
+    ScriptHeader builtin;
+    builtin.Name = BuiltinHeaderName;
+    err = ReadTextFile(_opts.BuiltinHeader, builtin.Text);
+    if (!err)
+        return err;
+    _headers.push_back(builtin);
+    ScriptHeader autoheader;
+    autoheader.Name = AutoHeaderName;
+    autoheader.Text = MakeGameAutoScriptHeader(_game);
+    _headers.push_back(autoheader);
+    ScriptHeader varsheader;
+    varsheader.Name = GlobalVarsHeaderName;
+    varsheader.Text = MakeVariablesScriptHeader(_game.GlobalVars);
+    _headers.push_back(varsheader);
+    _internalHeaderCount = _headers.size();
+
+    //-----------------------------------------------------------------------//
+    // Global variables and dialog scripts are generated from the game data
+    //-----------------------------------------------------------------------//
+    BuildUnit glvars;
+    glvars.Type = kUnit_Script;
+    glvars.Name = String::FromFormat("script:%s", GlobalVarsScriptName);
+    glvars.ScriptName = GlobalVarsScriptName;
+    glvars.ScriptText = MakeVariablesScriptBody(_game.GlobalVars);
+    glvars.HeaderCount = _internalHeaderCount;
+    _units.push_back(glvars);
+
+    std::vector<std::pair<String, String>> modules;
+    AGF::ReadScriptModuleList(modules, reader.GetGameRoot());
+    for (const auto &m : modules)
+    {
+        ScriptHeader header;
+        header.Name = m.first;
+        if (!m.first.IsEmpty())
+        {
+            const String header_path = File::FindFileCI(_projectDir, m.first);
+            if (header_path.IsEmpty())
+                return new Error(String::FromFormat("Script header not found: %s", m.first.GetCStr()));
+            err = ReadTextFile(header_path, header.Text);
+            if (!err)
+                return err;
+        }
+        _headers.push_back(header);
+
+        BuildUnit unit;
+        unit.Type = kUnit_Script;
+        unit.Name = String::FromFormat("script:%s", m.second.GetCStr());
+        unit.Source = File::FindFileCI(_projectDir, m.second);
+        if (unit.Source.IsEmpty())
+            return new Error(String::FromFormat("Script not found: %s", m.second.GetCStr()));
+        unit.ScriptName = m.second;
+        unit.HeaderCount = _headers.size();
+        _units.push_back(unit);
+    }
+
+    AGF::Dialogs p_dialogs;
+    AGF::Dialog p_dialog;
+    std::vector<AGF::DocElem> dlg_elems;
+    p_dialogs.GetAll(reader.GetGameRoot(), dlg_elems);
+    String dialogs = DialogScriptDefault;
+    for (size_t i = 0; i < _game.Dialogs.size(); ++i)
+    {
+        const DialogRef &dialog_obj = _game.Dialogs[i];
+        DialogScriptConverter conv(p_dialog.ReadScript(dlg_elems[i]), _game, dialog_obj);
+        const String script = conv.Convert();
+        for (const auto &e : conv.GetErrors())
+        {
+            if (e.Error)
+                return new Error(String::FromFormat("Dialog %s: line %zu: %s",
+                    dialog_obj.ScriptName.GetCStr(), e.LineNumber, e.Message.GetCStr()));
+        }
+        dialogs.Append(String::FromFormat("%sDialog %d\"\n", NEW_SCRIPT_MARKER, dialog_obj.ID));
+        dialogs.Append(script);
+    }
+    BuildUnit dlgunit;
+    dlgunit.Type = kUnit_Script;
+    dlgunit.Name = String::FromFormat("script:%s", DialogScriptsName);
+    dlgunit.ScriptName = DialogScriptsName;
+    dlgunit.ScriptText = dialogs;
+    dlgunit.HeaderCount = _headers.size();
+    _units.push_back(dlgunit);
+
+    //-----------------------------------------------------------------------//
+    // Rooms are compiled with all the game headers
+    //-----------------------------------------------------------------------//
+    std::vector<std::pair<int, String>> rooms;
+    AGF::ReadRoomList(rooms, reader.GetGameRoot());
+    for (const auto &r : rooms)
+    {
+        BuildUnit unit;
+        unit.Type = kUnit_Room;
+        unit.Name = String::FromFormat("room:%d", r.first);
+        const String room_file = String::FromFormat("room%d.crm", r.first);
+        unit.Source = File::FindFileCI(_projectDir, room_file);
+        if (unit.Source.IsEmpty())
+            return new Error(String::FromFormat("Room file not found: %s", room_file.GetCStr()));
+        unit.ScriptName = String::FromFormat("room%d.asc", r.first);
+        unit.ScriptSource = File::FindFileCI(_projectDir, unit.ScriptName);
+        if (unit.ScriptSource.IsEmpty())
+            return new Error(String::FromFormat("Room script not found: %s", unit.ScriptName.GetCStr()));
+        unit.HeaderCount = _headers.size();
+        unit.Output = Path::ConcatPaths(_stageDir, room_file);
+        unit.InLibrary = true;
+        _units.push_back(unit);
+    }
+    return HError::None();
+}
+
+HError GameBuilder::AddUnits()
+{
+    // Compiled scripts may only be packaged inside the main game data,
+    // without it the game package would be incomplete
+    if (_opts.GameDataFile.IsEmpty())
+        return new Error("Main game data file is not given");
+    if (!File::IsFile(_opts.GameDataFile))
+        return new Error(String::FromFormat("Game data file not found: %s", _opts.GameDataFile.GetCStr()));
+
+    for (auto &unit : _units)
+    {
+        if (unit.Type == kUnit_Script)
+            unit.Output = Path::ConcatPaths(Path::ConcatPaths(_objDir, "scripts"),
+                Path::ReplaceExtension(unit.ScriptName, "o"));
+    }
+
+    // Data files which are copied as is; put the largest in front,
+    // to let them be processed while the scripts are compiled
+    std::vector<BuildUnit> copied;
+    const String sprite_file = File::FindFileCI(_projectDir, SpriteFileName);
+    if (sprite_file.IsEmpty())
+    {
+        printf("Warning: sprite file %s not found in the project.\n", SpriteFileName);
+    }
+    else
+    {
+        BuildUnit unit;
+        unit.Type = kUnit_Copy;
+        unit.Name = String::FromFormat("file:%s", SpriteFileName);
+        unit.Source = sprite_file;
+        unit.Output = Path::ConcatPaths(_stageDir, SpriteFileName);
+        unit.InLibrary = true;
+        copied.push_back(unit);
+        // the sprite index is optional, engine may recreate it from the sprite file
+        const String index_file = File::FindFileCI(_projectDir, SpriteIndexFileName);
+        if (!index_file.IsEmpty())
+        {
+            unit.Name = String::FromFormat("file:%s", SpriteIndexFileName);
+            unit.Source = index_file;
+            unit.Output = Path::ConcatPaths(_stageDir, SpriteIndexFileName);
+            copied.push_back(unit);
+        }
+    }
+    _units.insert(_units.begin(), copied.begin(), copied.end());
+
+    // The main game data receives the compiled scripts, so it must be
+    // the last unit, built after all the others
+    BuildUnit unit;
+    unit.Type = kUnit_GameData;
+    unit.Name = String::FromFormat("file:%s", MainGameFileName);
+    unit.Source = _opts.GameDataFile;
+    unit.Output = Path::ConcatPaths(_stageDir, MainGameFileName);
+    unit.InLibrary = true;
+    _units.push_back(unit);
+    return HError::None();
+}
+
+HError GameBuilder::BuildUnits()
+{
+    std::atomic<size_t> next_unit(0);
+    size_t end_unit = 0;
+    auto worker = [this, &next_unit, &end_unit]()
+    {
+        for (size_t i = next_unit++; i < end_unit; i = next_unit++)
+        {
+            bool reused = false;
+            HError err = BuildOne(_units[i], reused);
+            if (err)
+            {
+                _cache.Store(_units[i].Name, _units[i].Hash);
+            }
+            else
+            {
+                _cache.Remove(_units[i].Name);
+                File::DeleteFile(_units[i].Output);
+            }
+            PrintUnitResult(_units[i], reused, err);
+        }
+    };
+
+    // Independent units are built in parallel, the main game data follows them
+    const bool has_game_data = !_units.empty() && _units.back().Type == kUnit_GameData;
+    end_unit = has_game_data ? _units.size() - 1 : _units.size();
+    const size_t thread_count = std::min<size_t>(_opts.Jobs, end_unit);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &t : threads)
+        t.join();
+    if (has_game_data && _stats.Failed == 0)
+    {
+        next_unit = end_unit;
+        end_unit = _units.size();
+        worker();
+    }
+
+    if (_stats.Failed > 0)
+        return new Error(String::FromFormat("Failed to build %zu of %zu units", _stats.Failed, _units.size()));
+    return HError::None();
+}
+
+HError GameBuilder::BuildOne(BuildUnit &unit, bool &reused)
+{
+    HError err = HashUnit(unit);
+    if (!err)
+        return err;
+    reused = _cache.IsUpToDate(unit.Name, unit.Hash) && File::IsFile(unit.Output);
+    if (reused)
+        return HError::None();
+
+    switch (unit.Type)
+    {
+    case kUnit_Script:
+        return BuildScript(unit);
+    case kUnit_Room:
+        return BuildRoom(unit);
+    case kUnit_GameData:
+        return BuildGameData(unit);
+    case kUnit_Copy:
+        if (!File::CopyFile(unit.Source, unit.Output, true))
+            return new Error(String::FromFormat("Failed to copy %s", unit.Source.GetCStr()));
+        return HError::None();
+    default:
+        return new Error("Unknown build unit type");
+    }
+}
+
+HError GameBuilder::HashUnit(BuildUnit &unit)
+{
+    ContentHash hash;
+    hash.Add(static_cast<int>(unit.Type));
+    HError err = HError::None();
+    if (unit.Type == kUnit_Copy)
+    {
+        err = hash.AddFile(unit.Source);
+    }
+    else if (unit.Type == kUnit_GameData)
+    {
+        // Game data depends on all the compiled scripts, which are hashed by now
+        err = hash.AddFile(unit.Source);
+        for (const auto &script : _units)
+        {
+            if (script.Type == kUnit_Script)
+                hash.Add(script.Name).Add(script.Hash);
+        }
+    }
+    else
+    {
+        // Scripts depend on the compiler settings and all the preceding headers
+        const GameSettings &opt = _game.Settings;
+        hash.Add(String(ACI_VERSION_STR)).Add(opt.ScriptAPIVersion).Add(opt.ScriptCompatLevel)
+            .Add(opt.TextEncoding).Add(static_cast<int>(opt.DebugMode))
+            .Add(static_cast<int>(opt.EnforceObjectBasedScript)).Add(static_cast<int>(opt.LeftToRightPrecedence))
+            .Add(static_cast<int>(opt.EnforceNewStrings)).Add(static_cast<int>(opt.EnforceNewAudio))
+            .Add(static_cast<int>(opt.UseOldCustomDialogOptionsAPI)).Add(static_cast<int>(opt.UseOldKeyboardHandling))
+            .Add(static_cast<int>(opt.OptimizeScripts || _opts.Optimize));
+        for (size_t i = 0; i < unit.HeaderCount; ++i)
+            hash.Add(_headers[i].Name).Add(_headers[i].Text);
+        if (unit.Type == kUnit_Room)
+        {
+            err = hash.AddFile(unit.Source);
+            if (err)
+                err = hash.AddFile(unit.ScriptSource);
+        }
+        else if (!unit.Source.IsEmpty())
+        {
+            err = hash.AddFile(unit.Source);
+        }
+        else
+        {
+            hash.Add(unit.ScriptText);
+        }
+    }
+    unit.Hash = hash.Get();
+    return err;
+}
+
+HError GameBuilder::BuildScript(const BuildUnit &unit)
+{
+    String text = unit.ScriptText;
+    if (!unit.Source.IsEmpty())
+    {
+        HError err = ReadTextFile(unit.Source, text);
+        if (!err)
+            return err;
+    }
+    std::unique_ptr<ccScript> script;
+    HError err = CompileScript(text, unit.ScriptName, unit.HeaderCount, nullptr, script);
+    if (!err)
+        return err;
+    auto out = File::CreateFile(unit.Output);
+    if (!out)
+        return new Error(String::FromFormat("Failed to open file for writing: %s", unit.Output.GetCStr()));
+    script->Write(out.get());
+    return HError::None();
+}
+
+HError GameBuilder::BuildRoom(const BuildUnit &unit)
+{
+    //-----------------------------------------------------------------------//
+    // Read script names of the room's items, and make the room's header
+    //-----------------------------------------------------------------------//
+    RoomDataSource datasrc;
+    HError err = static_cast<PError>(OpenRoomFile(unit.Source, datasrc));
+    if (!err)
+        return err;
+    RoomScNames names;
+    RoomScNamesReader reader(names, datasrc.DataVersion, std::move(datasrc.InputStream));
+    err = reader.Read();
+    if (!err)
+        return err;
+    ScriptHeader room_header;
+    room_header.Name = RoomHeaderName;
+    room_header.Text = MakeRoomScriptHeader(names);
+
+    //-----------------------------------------------------------------------//
+    // Compile the room script
+    //-----------------------------------------------------------------------//
+    String text;
+    err = ReadTextFile(unit.ScriptSource, text);
+    if (!err)
+        return err;
+    std::unique_ptr<ccScript> script;
+    err = CompileScript(text, unit.ScriptName, unit.HeaderCount, &room_header, script);
+    if (!err)
+        return err;
+
+    //-----------------------------------------------------------------------//
+    // Write the room file, replacing the compiled script block
+    //-----------------------------------------------------------------------//
+    err = static_cast<PError>(OpenRoomFile(unit.Source, datasrc));
+    if (!err)
+        return err;
+    Stream *in = datasrc.InputStream.get();
+    const soff_t blocks_start = in->GetPosition();
+    std::vector<std::pair<soff_t, soff_t>> keep_blocks;
+    RoomBlockParser parser(std::move(datasrc.InputStream), datasrc.DataVersion);
+    for (soff_t block_head = in->GetPosition(); ; block_head = in->GetPosition())
+    {
+        err = parser.OpenBlock();
+        if (!err)
+            return err;
+        if (parser.AtEnd())
+            break;
+        parser.SkipBlock();
+        if (parser.GetBlockID() != kRoomFblk_CompScript3)
+            keep_blocks.push_back(std::make_pair(block_head, in->GetPosition()));
+    }
+    const int dataext_flags = parser.GetFlags();
+    auto room_in = parser.ReleaseStream();
+
+    auto out = File::CreateFile(unit.Output);
+    if (!out)
+        return new Error(String::FromFormat("Failed to open file for writing: %s", unit.Output.GetCStr()));
+    room_in->Seek(0, kSeekBegin);
+    CopyStream(room_in.get(), out.get(), blocks_start);
+    for (const auto &block : keep_blocks)
+    {
+        room_in->Seek(block.first, kSeekBegin);
+        CopyStream(room_in.get(), out.get(), block.second - block.first);
+    }
+    WriteExtBlock(kRoomFblk_CompScript3, [&script](Stream *out) { script->Write(out); },
+        dataext_flags, out.get());
+    WriteRoomEnding(out.get());
+    return HError::None();
+}
+
+HError GameBuilder::BuildGameData(const BuildUnit &unit)
+{
+    //-----------------------------------------------------------------------//
+    // Find the compiled scripts in the main game data
+    //-----------------------------------------------------------------------//
+    auto in = File::OpenFileRead(unit.Source);
+    if (!in)
+        return new Error(String::FromFormat("Failed to open file for reading: %s", unit.Source.GetCStr()));
+    soff_t ext_offset_pos;
+    uint32_t ext_offset;
+    HError err = SkipToGameScripts(in.get(), ext_offset_pos, ext_offset);
+    if (!err)
+        return err;
+    // Global script, dialog scripts and script modules
+    const soff_t scripts_start = in->GetPosition();
+    err = SkipScript(in.get());
+    if (err)
+        err = SkipScript(in.get());
+    const int old_module_count = err ? in->ReadInt32() : 0;
+    for (int i = 0; err && (i < old_module_count); ++i)
+        err = SkipScript(in.get());
+    if (!err)
+        return err;
+    const soff_t scripts_end = in->GetPosition();
+
+    //-----------------------------------------------------------------------//
+    // Collect the compiled scripts, in the order of the editor's game data
+    //-----------------------------------------------------------------------//
+    const BuildUnit *global_script = nullptr;
+    const BuildUnit *dialog_script = nullptr;
+    std::vector<const BuildUnit*> modules;
+    for (const auto &script : _units)
+    {
+        if (script.Type != kUnit_Script)
+            continue;
+        if (script.ScriptName.CompareNoCase(GlobalScriptName) == 0)
+            global_script = &script;
+        else if (script.ScriptName.Compare(DialogScriptsName) == 0)
+            dialog_script = &script;
+        else
+            modules.push_back(&script);
+    }
+    if (!global_script)
+        return new Error(String::FromFormat("Global script not found in the project: %s", GlobalScriptName));
+    soff_t scripts_size = File::GetFileSize(global_script->Output) + File::GetFileSize(dialog_script->Output)
+        + sizeof(int32_t);
+    for (const auto *script : modules)
+        scripts_size += File::GetFileSize(script->Output);
+
+    //-----------------------------------------------------------------------//
+    // Write the game data, replacing the compiled scripts; the extension
+    // blocks follow them, so their offset is shifted accordingly
+    //-----------------------------------------------------------------------//
+    auto out = File::CreateFile(unit.Output);
+    if (!out)
+        return new Error(String::FromFormat("Failed to open file for writing: %s", unit.Output.GetCStr()));
+    in->Seek(0, kSeekBegin);
+    CopyStream(in.get(), out.get(), ext_offset_pos);
+    in->ReadInt32();
+    if (ext_offset >= scripts_end)
+        out->WriteInt32(static_cast<uint32_t>(ext_offset + scripts_size - (scripts_end - scripts_start)));
+    else
+        out->WriteInt32(ext_offset);
+    CopyStream(in.get(), out.get(), scripts_start - in->GetPosition());
+    err = AppendFile(global_script->Output, out.get());
+    if (err)
+        err = AppendFile(dialog_script->Output, out.get());
+    out->WriteInt32(static_cast<int32_t>(modules.size()));
+    for (size_t i = 0; err && (i < modules.size()); ++i)
+        err = AppendFile(modules[i]->Output, out.get());
+    if (!err)
+        return err;
+    in->Seek(scripts_end, kSeekBegin);
+    CopyStream(in.get(), out.get(), in->GetLength() - scripts_end);
+    return HError::None();
+}
+
+HError GameBuilder::PackLibrary()
+{
+    ContentHash hash;
+    std::vector<AssetInfo> assets;
+    for (const auto &unit : _units)
+    {
+        if (!unit.InLibrary)
+            continue;
+        AssetInfo asset;
+        asset.FileName = Path::GetFilename(unit.Output);
+        asset.Size = File::GetFileSize(unit.Output);
+        assets.push_back(asset);
+        hash.Add(asset.FileName).Add(unit.Hash);
+    }
+    if (assets.empty())
+    {
+        printf("No data files to pack.\n");
+        return HError::None();
+    }
+
+    String lib_name = _game.Settings.GameFileName;
+    if (lib_name.IsEmpty())
+        lib_name = "game";
+    const String lib_file = Path::ConcatPaths(_dataDir, String::FromFormat("%s.ags", lib_name.GetCStr()));
+    hash.Add(lib_file);
+    if (_cache.IsUpToDate(LibraryUnitName, hash.Get()) && File::IsFile(lib_file))
+    {
+        printf("Game library is up to date: %s\n", lib_file.GetCStr());
+        return HError::None();
+    }
+
+    AssetLibInfo lib;
+    HError err = MakeAssetLib(lib, lib_file, assets);
+    if (!err)
+        return err;
+    err = WriteLibrary(lib, _stageDir, _dataDir, MFLUtil::kMFLVersion_MultiV30);
+    if (!err)
+    {
+        _cache.Remove(LibraryUnitName);
+        return err;
+    }
+    _cache.Store(LibraryUnitName, hash.Get());
+    _stats.LibraryWritten = true;
+    printf("Game library written: %s\n", lib_file.GetCStr());
+    return HError::None();
+}
+
+void GameBuilder::ConfigureCompiler(AGS::Preprocessor::Preprocessor &pp)
+{
+    const GameSettings &opt = _game.Settings;
+    pp.SetAppVersion(ACI_VERSION_STR);
+    pp.DefineMacro("AGS_NEW_STRINGS", "1");
+    pp.DefineMacro("AGS_SUPPORTS_IFVER", "1");
+    if (opt.DebugMode)
+        pp.DefineMacro("DEBUG", "1");
+    if (opt.EnforceObjectBasedScript)
+        pp.DefineMacro("STRICT", "1");
+    if (opt.LeftToRightPrecedence)
+        pp.DefineMacro("LRPRECEDENCE", "1");
+    if (opt.EnforceNewStrings)
+        pp.DefineMacro("STRICT_STRINGS", "1");
+    if (opt.EnforceNewAudio)
+        pp.DefineMacro("STRICT_AUDIO", "1");
+    if (!opt.UseOldCustomDialogOptionsAPI)
+        pp.DefineMacro("NEW_DIALOGOPTS_API", "1");
+    if (!opt.UseOldKeyboardHandling)
+        pp.DefineMacro("NEW_KEYINPUT_API", "1");
+    // API macros are defined up to the chosen version,
+    // compatibility macros are defined starting with the chosen level
+    const size_t api_version = FindScriptAPIVersion(opt.ScriptAPIVersion);
+    const size_t compat_level = FindScriptAPIVersion(opt.ScriptCompatLevel);
+    for (size_t i = 0; i <= api_version; ++i)
+        pp.DefineMacro(String::FromFormat("SCRIPT_API_%s", ScriptAPIVersions[i]), "1");
+    for (size_t i = compat_level; i < NumScriptAPIVersions; ++i)
+        pp.DefineMacro(String::FromFormat("SCRIPT_COMPAT_%s", ScriptAPIVersions[i]), "1");
+
+    ccSetSoftwareVersion(ACI_VERSION_STR);
+    ccSetOption(SCOPT_EXPORTALL, 1);
+    ccSetOption(SCOPT_LINENUMBERS, 1);
+    ccSetOption(SCOPT_LEFTTORIGHT, opt.LeftToRightPrecedence);
+    ccSetOption(SCOPT_OLDSTRINGS, !opt.EnforceNewStrings);
+    ccSetOption(SCOPT_UTF8, opt.TextEncoding.CompareNoCase("utf-8") == 0);
+    ccSetOption(SCOPT_OPTIMIZE, opt.OptimizeScripts || _opts.Optimize);
+}
+
+HError GameBuilder::CompileScript(const String &text, const String &name, size_t header_count,
+    const ScriptHeader *extra_header, std::unique_ptr<ccScript> &script)
+{
+    // The compiler and preprocessor keep a global state,
+    // so only one script may be compiled at a time
+    std::lock_guard<std::mutex> lk(_compilerMutex);
+    cc_clear_error();
+    AGS::Preprocessor::Preprocessor pp;
+    ConfigureCompiler(pp);
+
+    std::vector<const ScriptHeader*> headers;
+    for (size_t i = 0; i < header_count; ++i)
+        headers.push_back(&_headers[i]);
+    if (extra_header)
+        headers.push_back(extra_header);
+
+    // The compiler keeps only pointers to headers, so these must stay
+    // unchanged until the compilation ends
+    std::vector<String> pp_headers(headers.size());
+    ccRemoveDefaultHeaders();
+    for (size_t i = 0; i < headers.size(); ++i)
+    {
+        pp_headers[i] = pp.Preprocess(headers[i]->Text, headers[i]->Name);
+        if (cc_has_error())
+        {
+            ccRemoveDefaultHeaders();
+            const auto &error = cc_get_error();
+            return new Error(String::FromFormat("%s(%d): %s",
+                headers[i]->Name.GetCStr(), error.Line, error.ErrorString.GetCStr()));
+        }
+        ccAddDefaultHeader(pp_headers[i].GetCStr(), headers[i]->Name.GetCStr());
+    }
+
+    const String script_pp = pp.Preprocess(text, name);
+    if (cc_has_error())
+    {
+        ccRemoveDefaultHeaders();
+        const auto &error = cc_get_error();
+        return new Error(String::FromFormat("%s(%d): %s",
+            name.GetCStr(), error.Line, error.ErrorString.GetCStr()));
+    }
+
+    script.reset(ccCompileText(script_pp.GetCStr(), name.GetCStr()));
+    ccRemoveDefaultHeaders();
+    if (!script || cc_has_error())
+    {
+        script.reset();
+        const auto &error = cc_get_error();
+        return new Error(String::FromFormat("%s(%d): %s",
+            ccCurScriptName ? ccCurScriptName : name.GetCStr(), error.Line, error.ErrorString.GetCStr()));
+    }
+    return HError::None();
+}
+
+void GameBuilder::PrintUnitResult(const BuildUnit &unit, bool reused, const HError &err)
+{
+    std::lock_guard<std::mutex> lk(_statusMutex);
+    ++_unitsDone;
+    if (!err)
+    {
+        ++_stats.Failed;
+        printf("[%zu/%zu] Error: %s failed:\n%s\n", _unitsDone, _units.size(),
+            unit.Name.GetCStr(), err->FullMessage().GetCStr());
+    }
+    else if (reused)
+    {
+        ++_stats.Reused;
+        printf("[%zu/%zu] Up to date: %s\n", _unitsDone, _units.size(), unit.Name.GetCStr());
+    }
+    else
+    {
+        ++_stats.Built;
+        printf("[%zu/%zu] Built: %s\n", _unitsDone, _units.size(), unit.Name.GetCStr());
+    }
+}
+
+} // namespace DataUtil
+} // namespace AGS
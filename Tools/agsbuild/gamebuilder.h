@@ -0,0 +1,138 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// GameBuilder reads the game project and builds its data.
+//
+// The build is split into the independent units: game scripts, rooms and
+// copied data files. Each unit's inputs are hashed, and units which inputs
+// did not change since the last build are reused from the build directory.
+// Units are built by a number of worker threads; the script compilation
+// itself is serialized, because the compiler keeps a global state.
+// The main game data's compiled scripts are replaced with the newly
+// built ones, after all the scripts are compiled.
+// Finally, the data files are packed into the game library.
+//
+//=============================================================================
+#ifndef __AGS_TOOL_AGSBUILD__GAMEBUILDER_H
+#define __AGS_TOOL_AGSBUILD__GAMEBUILDER_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "data/buildcache.h"
+#include "data/game_utils.h"
+#include "util/error.h"
+#include "util/string.h"
+
+struct ccScript;
+namespace AGS { namespace Preprocessor { class Preprocessor; } }
+
+namespace AGS
+{
+namespace DataUtil
+{
+
+struct BuildOptions
+{
+    String GameFile;        // path to the project's Game.agf
+    String OutputDir;       // build directory
+    String BuiltinHeader;   // path to the built-in script header (agsdefns.sh)
+    String GameDataFile;    // main game data file to put in the library,
+                            // with its scripts replaced by the compiled ones
+    int    Jobs = 1;        // number of parallel build jobs
+    bool   Rebuild = false; // ignore the cached results
+    bool   Optimize = false; // optimize compiled scripts even if the game disables it
+};
+
+struct BuildStats
+{
+    size_t Built = 0;
+    size_t Reused = 0;
+    size_t Failed = 0;
+    bool   LibraryWritten = false;
+};
+
+class GameBuilder
+{
+public:
+    GameBuilder(const BuildOptions &opts);
+    ~GameBuilder();
+
+    HError Build();
+    const BuildStats &GetStats() const { return _stats; }
+
+private:
+    enum BuildUnitType
+    {
+        kUnit_Script,   // compile script into an object file
+        kUnit_Room,     // compile room script and write it into the room file
+        kUnit_Copy,     // copy the data file as is
+        kUnit_GameData  // write the main game data with the compiled scripts
+    };
+
+    struct ScriptHeader
+    {
+        String Name;
+        String Text;
+    };
+
+    struct BuildUnit
+    {
+        BuildUnitType Type = kUnit_Copy;
+        String Name;            // unit's name in the build cache
+        String Source;          // source file (script, room or copied file)
+        String ScriptSource;    // room's script file
+        String ScriptName;      // script name, used in compilation messages
+        String ScriptText;      // generated script text, used if there's no source file
+        size_t HeaderCount = 0; // number of headers visible to this script
+        String Output;          // output file
+        bool   InLibrary = false; // whether the output is packed into the game library
+        uint64_t Hash = 0;      // hash of the unit's inputs
+    };
+
+    HError ReadGame();
+    HError AddUnits();
+    HError BuildUnits();
+    HError BuildOne(BuildUnit &unit, bool &reused);
+    HError BuildScript(const BuildUnit &unit);
+    HError BuildRoom(const BuildUnit &unit);
+    HError BuildGameData(const BuildUnit &unit);
+    HError PackLibrary();
+
+    HError HashUnit(BuildUnit &unit);
+    HError CompileScript(const String &text, const String &name, size_t header_count,
+        const ScriptHeader *extra_header, std::unique_ptr<ccScript> &script);
+    void   ConfigureCompiler(AGS::Preprocessor::Preprocessor &pp);
+    void   PrintUnitResult(const BuildUnit &unit, bool reused, const HError &err);
+
+    BuildOptions _opts;
+    String _projectDir;
+    String _objDir;     // compiled scripts and the build cache
+    String _stageDir;   // data files which go into the library
+    String _dataDir;    // final game library
+    GameRef _game;
+    std::vector<ScriptHeader> _headers;
+    size_t _internalHeaderCount = 0;
+    std::vector<BuildUnit> _units;
+    BuildCache _cache;
+    BuildStats _stats;
+    size_t _unitsDone = 0;
+    std::mutex _compilerMutex;
+    std::mutex _statusMutex;
+};
+
+} // namespace DataUtil
+} // namespace AGS
+
+#endif // __AGS_TOOL_AGSBUILD__GAMEBUILDER_H
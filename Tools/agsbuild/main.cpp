@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdio.h>
+#include <thread>
+#include "gamebuilder.h"
+#include "script/cc_common.h"
+#include "util/file.h"
+#include "util/path.h"
+#include "util/string_compat.h"
+
+using namespace AGS::Common;
+using namespace AGS::DataUtil;
+
+// Compiler's error reporting callbacks
+String cc_format_error(const String &message)
+{
+    if (currentline > 0)
+        return String::FromFormat("Error (line %d): %s", currentline, message.GetCStr());
+    else
+        return String::FromFormat("Error (line unknown): %s", message.GetCStr());
+}
+
+String cc_get_callstack(int /*max_lines*/)
+{
+    return "";
+}
+
+
+const char *HELP_STRING = "Usage: agsbuild <in-game.agf> <out-dir> [OPTIONS]\n"
+"Options:\n"
+"  --defns <agsdefns.sh>  built-in script header (default: agsdefns.sh\n"
+"                         in the game's directory)\n"
+"  --game-data <file>     main game data file to put into the game package\n"
+"                         (required); its compiled scripts are replaced with\n"
+"                         the built ones\n"
+"  -j <N>                 number of parallel jobs (default: number of CPUs)\n"
+"  --rebuild              ignore the build cache and rebuild everything\n"
+"  --optimize             optimize the compiled scripts, even if the game's\n"
+"                         \"Optimize compiled scripts\" setting is off\n";
+
+int main(int argc, char *argv[])
+{
+    printf("agsbuild v0.1.0 - AGS game's data builder\n"\
+        "Copyright (c) 2024 AGS Team and contributors\n");
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        if (ags_stricmp(arg, "--help") == 0 || ags_stricmp(arg, "/?") == 0 || ags_stricmp(arg, "-?") == 0)
+        {
+            printf("%s\n", HELP_STRING);
+            return 0; // display help and bail out
+        }
+    }
+    if (argc < 3)
+    {
+        printf("Error: not enough arguments\n");
+        printf("%s\n", HELP_STRING);
+        return -1;
+    }
+
+    BuildOptions opts;
+    opts.GameFile = argv[1];
+    opts.OutputDir = argv[2];
+    opts.Jobs = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 3; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--defns") == 0 && i + 1 < argc)
+            opts.BuiltinHeader = argv[++i];
+        else if (strcmp(arg, "--game-data") == 0 && i + 1 < argc)
+            opts.GameDataFile = argv[++i];
+        else if (strcmp(arg, "-j") == 0 && i + 1 < argc)
+            opts.Jobs = std::max(1, atoi(argv[++i]));
+        else if (strcmp(arg, "--rebuild") == 0)
+            opts.Rebuild = true;
+        else if (strcmp(arg, "--optimize") == 0)
+            opts.Optimize = true;
+        else
+        {
+            printf("Error: unknown option: %s\n", arg);
+            printf("%s\n", HELP_STRING);
+            return -1;
+        }
+    }
+    if (opts.BuiltinHeader.IsEmpty())
+        opts.BuiltinHeader = File::FindFileCI(Path::GetParent(opts.GameFile), "agsdefns.sh");
+    if (opts.BuiltinHeader.IsEmpty() || !File::IsFile(opts.BuiltinHeader))
+    {
+        printf("Error: built-in script header not found, use --defns to specify one.\n");
+        return -1;
+    }
+
+    if (opts.GameDataFile.IsEmpty())
+    {
+        printf("Error: main game data is not given, use --game-data to specify one.\n");
+        return -1;
+    }
+
+    printf("Input game AGF: %s\n", opts.GameFile.GetCStr());
+    printf("Output directory: %s\n", opts.OutputDir.GetCStr());
+    printf("Built-in script header: %s\n", opts.BuiltinHeader.GetCStr());
+    printf("Main game data: %s\n", opts.GameDataFile.GetCStr());
+    printf("Jobs: %d\n", opts.Jobs);
+
+    GameBuilder builder(opts);
+    HError err = builder.Build();
+    const BuildStats &stats = builder.GetStats();
+    printf("Units built: %zu, up to date: %zu, failed: %zu\n",
+        stats.Built, stats.Reused, stats.Failed);
+    if (!err)
+    {
+        printf("Error: failed to build the game:\n");
+        printf("%s\n", err->FullMessage().GetCStr());
+        return -1;
+    }
+    printf("Done.\n");
+    return 0;
+}
@@ -322,6 +322,18 @@ void ReadGameSettings(DataUtil::GameSettings &opt, DocElem elem)
     DocElem set_elem = p_game.GetSettings(elem);
     opt.SayFunction = p_set.ReadSayFunction(set_elem);
     opt.NarrateFunction = p_set.ReadNarrateFunction(set_elem);
+    opt.GameFileName = p_set.ReadGameFileName(set_elem);
+    opt.TextEncoding = p_set.ReadTextEncoding(set_elem);
+    opt.DebugMode = p_set.ReadDebugMode(set_elem);
+    opt.ScriptAPIVersion = p_set.ReadScriptAPIVersion(set_elem);
+    opt.ScriptCompatLevel = p_set.ReadScriptCompatLevel(set_elem);
+    opt.EnforceObjectBasedScript = p_set.ReadEnforceObjectBasedScript(set_elem);
+    opt.LeftToRightPrecedence = p_set.ReadLeftToRightPrecedence(set_elem);
+    opt.EnforceNewStrings = p_set.ReadEnforceNewStrings(set_elem);
+    opt.EnforceNewAudio = p_set.ReadEnforceNewAudio(set_elem);
+    opt.UseOldCustomDialogOptionsAPI = p_set.ReadUseOldCustomDialogOptionsAPI(set_elem);
+    opt.UseOldKeyboardHandling = p_set.ReadUseOldKeyboardHandling(set_elem);
+    opt.OptimizeScripts = p_set.ReadOptimizeScripts(set_elem);
 }
 
 void ReadGameRef(DataUtil::GameRef &game, AGFReader &reader)
@@ -406,6 +418,23 @@ void ReadScriptList(std::vector<String> &script_list, DocElem root)
     }
 }
 
+void ReadScriptModuleList(std::vector<std::pair<String, String>> &module_list, DocElem root)
+{
+    AGF::ScriptModules scmodules;
+    AGF::ScriptWithHeader scmodule;
+    AGF::ScriptElem scelem;
+    std::vector<DocElem> modules;
+    scmodules.GetAll(root, modules);
+    for (const auto &m : modules)
+    {
+        DocElem header = scmodule.GetHeader(m);
+        DocElem body = scmodule.GetBody(m);
+        if (!body) continue;
+        module_list.push_back(std::make_pair(
+            header ? String(scelem.ReadFilename(header)) : String(), scelem.ReadFilename(body)));
+    }
+}
+
 void ReadRoomList(std::vector<std::pair<int, String>> &room_list, DocElem root)
 {
     AGF::Rooms rooms;
@@ -363,6 +363,18 @@ public:
 
     String ReadSayFunction(DocElem elem) { return ReadString(elem, "DialogScriptSayFunction"); }
     String ReadNarrateFunction(DocElem elem) { return ReadString(elem, "DialogScriptNarrateFunction"); }
+    String ReadGameFileName(DocElem elem) { return ReadString(elem, "GameFileName"); }
+    String ReadTextEncoding(DocElem elem) { return ReadString(elem, "GameTextEncoding"); }
+    bool   ReadDebugMode(DocElem elem) { return ReadBool(elem, "DebugMode"); }
+    String ReadScriptAPIVersion(DocElem elem) { return ReadString(elem, "ScriptAPIVersion", "Highest"); }
+    String ReadScriptCompatLevel(DocElem elem) { return ReadString(elem, "ScriptCompatLevel", "Highest"); }
+    bool   ReadEnforceObjectBasedScript(DocElem elem) { return ReadBool(elem, "EnforceObjectBasedScript", true); }
+    bool   ReadLeftToRightPrecedence(DocElem elem) { return ReadBool(elem, "LeftToRightPrecedence", true); }
+    bool   ReadEnforceNewStrings(DocElem elem) { return ReadBool(elem, "EnforceNewStrings", true); }
+    bool   ReadEnforceNewAudio(DocElem elem) { return ReadBool(elem, "EnforceNewAudio", true); }
+    bool   ReadUseOldCustomDialogOptionsAPI(DocElem elem) { return ReadBool(elem, "UseOldCustomDialogOptionsAPI"); }
+    bool   ReadUseOldKeyboardHandling(DocElem elem) { return ReadBool(elem, "UseOldKeyboardHandling"); }
+    bool   ReadOptimizeScripts(DocElem elem) { return ReadBool(elem, "OptimizeScripts", true); }
 };
 
 // Parses a description of an individual script file (header or body)
@@ -428,6 +440,8 @@ void ReadGameSettings(DataUtil::GameSettings &opt, DocElem root);
 void ReadGameRef(DataUtil::GameRef &game, AGFReader &reader);
 // Reads an ordered list of script module names (their order determines dependency).
 void ReadScriptList(std::vector<String> &script_list, DocElem root);
+// Reads the list of script modules as pairs of header and body filenames
+void ReadScriptModuleList(std::vector<std::pair<String, String>> &module_list, DocElem root);
 // Reads a list of room ID and descriptions found in the game document.
 void ReadRoomList(std::vector<std::pair<int, String>> &room_list, DocElem root);
 
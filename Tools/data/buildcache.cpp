@@ -0,0 +1,142 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include "data/buildcache.h"
+#include <cinttypes>
+#include <cstdlib>
+#include <vector>
+#include "util/file.h"
+#include "util/stream.h"
+#include "util/textstreamreader.h"
+
+using namespace AGS::Common;
+
+namespace AGS
+{
+namespace DataUtil
+{
+
+const uint64_t FNV_PRIME_64 = 1099511628211ULL;
+// Size of the buffer used when hashing files
+const size_t HASH_FILE_BUFFER = 64 * 1024;
+
+ContentHash &ContentHash::Add(const void *data, size_t len)
+{
+    const uint8_t *p = static_cast<const uint8_t*>(data);
+    uint64_t hash = _hash;
+    for (size_t i = 0; i < len; ++i)
+    {
+        hash ^= p[i];
+        hash *= FNV_PRIME_64;
+    }
+    _hash = hash;
+    return *this;
+}
+
+ContentHash &ContentHash::Add(const String &s)
+{
+    // add length too, so that the sequence of strings is not ambiguous
+    Add(static_cast<uint64_t>(s.GetLength()));
+    return Add(s.GetCStr(), s.GetLength());
+}
+
+ContentHash &ContentHash::Add(int value)
+{
+    return Add(static_cast<uint64_t>(static_cast<int64_t>(value)));
+}
+
+ContentHash &ContentHash::Add(uint64_t value)
+{
+    uint8_t buf[8];
+    for (int i = 0; i < 8; ++i)
+        buf[i] = static_cast<uint8_t>(value >> (i * 8));
+    return Add(buf, sizeof(buf));
+}
+
+HError ContentHash::AddFile(const String &filename)
+{
+    auto in = File::OpenFileRead(filename);
+    if (!in)
+        return new Error(String::FromFormat("Failed to open file for reading: %s", filename.GetCStr()));
+    Add(static_cast<uint64_t>(in->GetLength()));
+    std::vector<uint8_t> buf(HASH_FILE_BUFFER);
+    for (size_t read = in->Read(buf.data(), buf.size()); read > 0;
+         read = in->Read(buf.data(), buf.size()))
+    {
+        Add(buf.data(), read);
+    }
+    return HError::None();
+}
+
+
+HError BuildCache::Load(const String &filename)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _units.clear();
+    if (!File::IsFile(filename))
+        return HError::None();
+    auto in = File::OpenFileRead(filename);
+    if (!in)
+        return new Error(String::FromFormat("Failed to open build cache: %s", filename.GetCStr()));
+    // Each line has a hash in hex, followed by the unit name
+    TextStreamReader reader(std::move(in));
+    while (!reader.EOS())
+    {
+        String line = reader.ReadLine();
+        line.Trim();
+        const size_t sep = line.FindChar(' ');
+        if (sep == String::NoIndex)
+            continue;
+        const uint64_t hash = strtoull(line.Left(sep).GetCStr(), nullptr, 16);
+        const String unit = line.Mid(sep + 1);
+        if (!unit.IsEmpty())
+            _units[unit] = hash;
+    }
+    return HError::None();
+}
+
+HError BuildCache::Save(const String &filename) const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    auto out = File::CreateFile(filename);
+    if (!out)
+        return new Error(String::FromFormat("Failed to open build cache for writing: %s", filename.GetCStr()));
+    for (const auto &unit : _units)
+    {
+        const String line = String::FromFormat("%016" PRIx64 " %s\n", unit.second, unit.first.GetCStr());
+        out->Write(line.GetCStr(), line.GetLength());
+    }
+    return HError::None();
+}
+
+bool BuildCache::IsUpToDate(const String &unit, uint64_t hash) const
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    auto it = _units.find(unit);
+    return (it != _units.end()) && (it->second == hash);
+}
+
+void BuildCache::Store(const String &unit, uint64_t hash)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _units[unit] = hash;
+}
+
+void BuildCache::Remove(const String &unit)
+{
+    std::lock_guard<std::mutex> lk(_mutex);
+    _units.erase(unit);
+}
+
+} // namespace DataUtil
+} // namespace AGS
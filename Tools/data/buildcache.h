@@ -0,0 +1,80 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+//
+// Helpers for the incremental building of the game data.
+//
+// BuildCache remembers the hash of inputs of each build unit (a script,
+// a room, etc), so that the build tool may skip the units which inputs
+// did not change since the previous successful build.
+//
+//=============================================================================
+#ifndef __AGS_TOOL_DATA__BUILDCACHE_H
+#define __AGS_TOOL_DATA__BUILDCACHE_H
+
+#include <map>
+#include <mutex>
+#include "util/error.h"
+#include "util/string.h"
+
+namespace AGS
+{
+namespace DataUtil
+{
+
+using AGS::Common::HError;
+using AGS::Common::String;
+
+// ContentHash calculates a 64-bit FNV-1a hash of the sequence of data
+class ContentHash
+{
+public:
+    ContentHash &Add(const void *data, size_t len);
+    ContentHash &Add(const String &s);
+    ContentHash &Add(int value);
+    ContentHash &Add(uint64_t value);
+    // Adds the whole file's contents
+    HError AddFile(const String &filename);
+
+    uint64_t Get() const { return _hash; }
+
+private:
+    uint64_t _hash = 14695981039346656037ULL;
+};
+
+// BuildCache stores the input hashes of the build units;
+// is safe to use from multiple threads
+class BuildCache
+{
+public:
+    // Loads the unit records from the file; a missing file means an empty cache
+    HError Load(const String &filename);
+    // Saves the unit records to the file
+    HError Save(const String &filename) const;
+
+    // Tells whether the unit was last built from the inputs with this hash
+    bool   IsUpToDate(const String &unit, uint64_t hash) const;
+    // Records the hash of the unit's inputs after a successful build
+    void   Store(const String &unit, uint64_t hash);
+    // Forgets the unit, e.g. after a failed build
+    void   Remove(const String &unit);
+
+private:
+    mutable std::mutex _mutex;
+    std::map<String, uint64_t> _units;
+};
+
+} // namespace DataUtil
+} // namespace AGS
+
+#endif // __AGS_TOOL_DATA__BUILDCACHE_H
@@ -62,6 +62,19 @@ struct GameSettings
 {
     String SayFunction; // Custom speech function name
     String NarrateFunction; // Custom narrate function name
+    String GameFileName; // Base name of the compiled game file
+    String TextEncoding; // Game text's encoding
+    bool   DebugMode = false;
+    // Script compiler settings
+    String ScriptAPIVersion;
+    String ScriptCompatLevel;
+    bool   EnforceObjectBasedScript = true;
+    bool   LeftToRightPrecedence = true;
+    bool   EnforceNewStrings = true;
+    bool   EnforceNewAudio = true;
+    bool   UseOldCustomDialogOptionsAPI = false;
+    bool   UseOldKeyboardHandling = false;
+    bool   OptimizeScripts = true;
 };
 
 // GameRef contains only game data strictly necessary for generating scripts.
@@ -0,0 +1,135 @@
+//=============================================================================
+//
+// Adventure Game Studio (AGS)
+//
+// Copyright (C) 1999-2011 Chris Jones and 2011-2024 various contributors
+// The full list of copyright holders can be found in the Copyright.txt
+// file, which is part of this source code distribution.
+//
+// The AGS source code is provided under the Artistic License 2.0.
+// A copy of this license can be found in the file License.txt and at
+// https://opensource.org/license/artistic-2-0/
+//
+//=============================================================================
+#include <stdint.h>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "core/platform.h"
+#include "data/buildcache.h"
+#include "util/file.h"
+#include "util/stream.h"
+
+using namespace AGS::Common;
+using namespace AGS::DataUtil;
+
+TEST(BuildCache, ContentHashFNV1a) {
+    // Reference values of the 64-bit FNV-1a
+    ASSERT_EQ(0xcbf29ce484222325ULL, ContentHash().Get());
+    ASSERT_EQ(0xaf63dc4c8601ec8cULL, ContentHash().Add("a", 1).Get());
+    ASSERT_EQ(0x85944171f73967e8ULL, ContentHash().Add("foobar", 6).Get());
+    // Adding data in parts gives the same result
+    ASSERT_EQ(ContentHash().Add("foobar", 6).Get(),
+        ContentHash().Add("foo", 3).Add("bar", 3).Get());
+}
+
+TEST(BuildCache, ContentHashSequence) {
+    // Strings are length-prefixed, so their boundaries matter
+    ASSERT_NE(ContentHash().Add(String("ab")).Add(String("c")).Get(),
+        ContentHash().Add(String("a")).Add(String("bc")).Get());
+    ASSERT_NE(ContentHash().Add(String()).Get(), ContentHash().Get());
+    // Order of the values matters
+    ASSERT_NE(ContentHash().Add(1).Add(2).Get(), ContentHash().Add(2).Add(1).Get());
+    // Same sequence gives the same result
+    ASSERT_EQ(ContentHash().Add(String("x")).Add(5).Add(uint64_t(7)).Get(),
+        ContentHash().Add(String("x")).Add(5).Add(uint64_t(7)).Get());
+    // Integers are hashed as 64-bit values
+    ASSERT_EQ(ContentHash().Add(-1).Get(), ContentHash().Add(UINT64_MAX).Get());
+}
+
+TEST(BuildCache, StoreAndRemove) {
+    BuildCache cache;
+    ASSERT_FALSE(cache.IsUpToDate("script:a.asc", 0));
+    cache.Store("script:a.asc", 0x1234);
+    cache.Store("room:1", 0x5678);
+    ASSERT_TRUE(cache.IsUpToDate("script:a.asc", 0x1234));
+    ASSERT_FALSE(cache.IsUpToDate("script:a.asc", 0x5678));
+    ASSERT_TRUE(cache.IsUpToDate("room:1", 0x5678));
+    cache.Store("script:a.asc", 0x4321);
+    ASSERT_FALSE(cache.IsUpToDate("script:a.asc", 0x1234));
+    ASSERT_TRUE(cache.IsUpToDate("script:a.asc", 0x4321));
+    cache.Remove("script:a.asc");
+    ASSERT_FALSE(cache.IsUpToDate("script:a.asc", 0x4321));
+    ASSERT_TRUE(cache.IsUpToDate("room:1", 0x5678));
+}
+
+#if (AGS_PLATFORM_TEST_FILE_IO)
+
+static const char *DummyFile = "buildcache.tmp";
+static const char *DummyCacheFile = "buildcache_test.txt";
+
+class BuildCacheFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        File::DeleteFile(DummyFile);
+        File::DeleteFile(DummyCacheFile);
+    }
+
+    void TearDown() override {
+        File::DeleteFile(DummyFile);
+        File::DeleteFile(DummyCacheFile);
+    }
+};
+
+TEST_F(BuildCacheFileTest, ContentHashFile) {
+    const char *data = "file contents";
+    {
+        auto out = File::CreateFile(DummyFile);
+        ASSERT_TRUE(out);
+        out->Write(data, strlen(data));
+    }
+    ContentHash hash;
+    ASSERT_TRUE(hash.AddFile(DummyFile));
+    // File is hashed as its length followed by its contents
+    ASSERT_EQ(ContentHash().Add(static_cast<uint64_t>(strlen(data))).Add(data, strlen(data)).Get(),
+        hash.Get());
+
+    ContentHash missing;
+    ASSERT_FALSE(missing.AddFile("buildcache_missing.tmp"));
+}
+
+TEST_F(BuildCacheFileTest, SaveAndLoad) {
+    {
+        BuildCache cache;
+        cache.Store("script:a.asc", 0x0123456789abcdefULL);
+        cache.Store("file:name with spaces.dat", 0xfedcba9876543210ULL);
+        cache.Store("room:2", 0);
+        ASSERT_TRUE(cache.Save(DummyCacheFile));
+    }
+    BuildCache cache;
+    cache.Store("room:3", 1); // must be cleared by Load
+    ASSERT_TRUE(cache.Load(DummyCacheFile));
+    ASSERT_TRUE(cache.IsUpToDate("script:a.asc", 0x0123456789abcdefULL));
+    ASSERT_TRUE(cache.IsUpToDate("file:name with spaces.dat", 0xfedcba9876543210ULL));
+    ASSERT_TRUE(cache.IsUpToDate("room:2", 0));
+    ASSERT_FALSE(cache.IsUpToDate("room:3", 1));
+}
+
+TEST_F(BuildCacheFileTest, LoadMissingOrMalformed) {
+    BuildCache cache;
+    cache.Store("room:1", 1);
+    // Missing file is an empty cache
+    ASSERT_TRUE(cache.Load(DummyCacheFile));
+    ASSERT_FALSE(cache.IsUpToDate("room:1", 1));
+
+    {
+        auto out = File::CreateFile(DummyCacheFile);
+        ASSERT_TRUE(out);
+        const char *text = "garbage\n\n00000000000000ff room:1\n0000000000000001 \n";
+        out->Write(text, strlen(text));
+    }
+    ASSERT_TRUE(cache.Load(DummyCacheFile));
+    ASSERT_TRUE(cache.IsUpToDate("room:1", 0xff));
+    ASSERT_FALSE(cache.IsUpToDate("garbage", 0));
+}
+
+#endif // AGS_PLATFORM_TEST_FILE_IO